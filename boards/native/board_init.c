@@ -46,6 +46,12 @@ void board_init(void)
 #ifndef MTD_NATIVE_FILENAME
 #define MTD_NATIVE_FILENAME    "MEMORY.bin"
 #endif
+#ifndef MTD_NATIVE_PROGRAM_US
+#define MTD_NATIVE_PROGRAM_US  0
+#endif
+#ifndef MTD_NATIVE_ERASE_US
+#define MTD_NATIVE_ERASE_US    0
+#endif
 
 static mtd_native_dev_t mtd0_dev = {
     .dev = {
@@ -55,6 +61,8 @@ static mtd_native_dev_t mtd0_dev = {
         .page_size = MTD_NATIVE_PAGE_SIZE,
     },
     .fname = MTD_NATIVE_FILENAME,
+    .program_us = MTD_NATIVE_PROGRAM_US,
+    .erase_us = MTD_NATIVE_ERASE_US,
 };
 
 mtd_dev_t *mtd0 = (mtd_dev_t *)&mtd0_dev;
@@ -23,9 +23,14 @@
 #error "MODULE can_linux is only available on Linux"
 #else
 
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE     /* for recvmmsg() and sendmmsg() */
+#endif
+
 #include <string.h>
 #include <errno.h>
 #include <sys/ioctl.h>
+#include <sys/socket.h>
 #include <net/if.h>
 
 #include <linux/can/raw.h>
@@ -44,6 +49,8 @@
 
 static int _init(candev_t *candev);
 static int _send(candev_t *candev, const struct can_frame *frame);
+static int _send_batch(candev_t *candev, const struct can_frame *const *frames,
+                       size_t numof);
 static void _isr(candev_t *candev);
 static int _set(candev_t *candev, canopt_t opt, void *value, size_t value_len);
 static int _get(candev_t *candev, canopt_t opt, void *value, size_t max_len);
@@ -64,6 +71,7 @@ static const candev_driver_t candev_linux_driver = {
     .abort = _abort,
     .set_filter = _set_filter,
     .remove_filter = _remove_filter,
+    .send_batch = _send_batch,
 };
 
 static candev_event_t _can_error_to_can_evt(struct can_frame can_frame_err);
@@ -221,10 +229,61 @@ static int _send(candev_t *candev, const struct can_frame *frame)
     return 0;
 }
 
+static int _send_batch(candev_t *candev, const struct can_frame *const *frames,
+                       size_t numof)
+{
+    struct mmsghdr msgs[CANDEV_LINUX_BATCH_SIZE];
+    struct iovec iovs[CANDEV_LINUX_BATCH_SIZE];
+    candev_linux_t *dev = (candev_linux_t *)candev;
+    size_t sent = 0;
+
+    memset(msgs, 0, sizeof(msgs));
+    while (sent < numof) {
+        unsigned chunk = numof - sent;
+        int res;
+
+        if (chunk > CANDEV_LINUX_BATCH_SIZE) {
+            chunk = CANDEV_LINUX_BATCH_SIZE;
+        }
+        for (unsigned i = 0; i < chunk; i++) {
+            iovs[i].iov_base = (void *)frames[sent + i];
+            iovs[i].iov_len = sizeof(struct can_frame);
+            msgs[i].msg_hdr.msg_iov = &iovs[i];
+            msgs[i].msg_hdr.msg_iovlen = 1;
+        }
+        res = real_sendmmsg(dev->sock, msgs, chunk, 0);
+        DEBUG("candev_native _send_batch: %d of %u frames written\n", res, chunk);
+        if (res <= 0) {
+            real_printf("CAN write op failed, res=%i\n", res);
+            break;
+        }
+        if (dev->candev.event_callback) {
+            for (int i = 0; i < res; i++) {
+                dev->candev.event_callback(&dev->candev, CANDEV_EVENT_TX_CONFIRMATION,
+                                           (void *)frames[sent + i]);
+            }
+        }
+        sent += res;
+    }
+
+    /* report the frames which could not be written */
+    if (dev->candev.event_callback) {
+        for (size_t i = sent; i < numof; i++) {
+            dev->candev.event_callback(&dev->candev, CANDEV_EVENT_TX_ERROR,
+                                       (void *)frames[i]);
+        }
+    }
+
+    return sent;
+}
+
 static void _isr(candev_t *candev)
 {
-    int nbytes;
-    struct can_frame rcv_frame;
+    int res;
+    struct can_frame frames[CANDEV_LINUX_BATCH_SIZE];
+    struct iovec iovs[CANDEV_LINUX_BATCH_SIZE];
+    struct mmsghdr msgs[CANDEV_LINUX_BATCH_SIZE];
+    candev_rx_batch_t batch = { .frames = frames };
     candev_linux_t *dev = (candev_linux_t *)candev;
 
     if (dev == NULL) {
@@ -232,37 +291,59 @@ static void _isr(candev_t *candev)
     }
 
     DEBUG("candev_native _isr: CAN SIGIO interrupt received, sock = %i\n", dev->sock);
-    nbytes = real_read(dev->sock, &rcv_frame, sizeof(struct can_frame));
-
-    if (nbytes < 0) {   /* SIGIO signal was probably due to an error with the socket */
-        DEBUG("candev_native _isr: read: error during read\n");
-        return;
+    memset(msgs, 0, sizeof(msgs));
+    for (unsigned i = 0; i < CANDEV_LINUX_BATCH_SIZE; i++) {
+        iovs[i].iov_base = &frames[i];
+        iovs[i].iov_len = sizeof(struct can_frame);
+        msgs[i].msg_hdr.msg_iov = &iovs[i];
+        msgs[i].msg_hdr.msg_iovlen = 1;
     }
 
-    if (nbytes < (int)sizeof(struct can_frame)) {
-        DEBUG("candev_native _isr: read: incomplete CAN frame\n");
-        return;
-    }
+    /* drain the socket, so a single event handles a whole burst of frames */
+    do {
+        res = real_recvmmsg(dev->sock, msgs, CANDEV_LINUX_BATCH_SIZE, MSG_DONTWAIT, NULL);
 
-    if (rcv_frame.can_id & CAN_ERR_FLAG) {
-        DEBUG("candev_native _isr: error frame\n");
-        candev_event_t evt = _can_error_to_can_evt(rcv_frame);
-        if ((evt != CANDEV_EVENT_NOEVENT) && (dev->candev.event_callback)) {
-            dev->candev.event_callback(&dev->candev, evt, NULL);
+        if (res < 0) {  /* SIGIO signal was probably due to an error with the socket */
+            DEBUG("candev_native _isr: read: error during read\n");
+            return;
         }
-        return;
-    }
 
-    if (rcv_frame.can_id & CAN_RTR_FLAG) {
-        DEBUG("candev_native _isr: rtr frame\n");
-        return;
-    }
+        batch.numof = 0;
+        for (int i = 0; i < res; i++) {
+            struct can_frame *rcv_frame = &frames[i];
 
-    if (dev->candev.event_callback) {
-        DEBUG("candev_native _isr: calling event callback\n");
-        dev->candev.event_callback(&dev->candev, CANDEV_EVENT_RX_INDICATION, &rcv_frame);
-    }
+            if (msgs[i].msg_len < sizeof(struct can_frame)) {
+                DEBUG("candev_native _isr: read: incomplete CAN frame\n");
+                continue;
+            }
+
+            if (rcv_frame->can_id & CAN_ERR_FLAG) {
+                DEBUG("candev_native _isr: error frame\n");
+                candev_event_t evt = _can_error_to_can_evt(*rcv_frame);
+                if ((evt != CANDEV_EVENT_NOEVENT) && (dev->candev.event_callback)) {
+                    dev->candev.event_callback(&dev->candev, evt, NULL);
+                }
+                continue;
+            }
+
+            if (rcv_frame->can_id & CAN_RTR_FLAG) {
+                DEBUG("candev_native _isr: rtr frame\n");
+                continue;
+            }
 
+            /* move the frames to pass on to the start of the buffer */
+            if (batch.numof != (size_t)i) {
+                frames[batch.numof] = *rcv_frame;
+            }
+            batch.numof++;
+        }
+
+        if ((batch.numof > 0) && (dev->candev.event_callback)) {
+            DEBUG("candev_native _isr: calling event callback for %u frames\n",
+                  (unsigned)batch.numof);
+            dev->candev.event_callback(&dev->candev, CANDEV_EVENT_RX_BATCH, &batch);
+        }
+    } while (res == CANDEV_LINUX_BATCH_SIZE);
 }
 
 static int _set_bittiming(candev_linux_t *dev, struct can_bittiming *bittiming)
@@ -54,6 +54,13 @@ typedef struct candev_linux_conf {
 #define CANDEV_LINUX_MAX_FILTERS_RX  (16)
 #endif
 
+#ifndef CANDEV_LINUX_BATCH_SIZE
+/**
+ * Max number of frames read or written with a single system call
+ */
+#define CANDEV_LINUX_BATCH_SIZE      (16)
+#endif
+
 #ifndef CANDEV_LINUX_DEFAULT_BITRATE
 /**
  * Default bitrate setup
@@ -12,6 +12,16 @@
  * @{
  * @brief       mtd flash emulation for native
  *
+ * The flash is emulated by an image file on the host. By default the file is
+ * opened for every access. With the `mtd_native_mmap` module the image is
+ * mapped into memory once by mtd_init() instead, so accesses do not cost any
+ * system calls. Data is then written to the file by the host kernel at any
+ * time, or at the latest by mtd_native_flush() or mtd_flush().
+ *
+ * To benchmark file systems, the device can model the time a real flash
+ * needs to program a page and erase a sector. This needs the `xtimer`
+ * module, the calling thread sleeps meanwhile.
+ *
  * @file
  *
  * @author      Vincent Dupont <vincent@otakeys.com>
@@ -28,8 +38,13 @@ extern "C" {
 
 /** mtd native descriptor */
 typedef struct mtd_native_dev {
-    mtd_dev_t dev;      /**< mtd generic device */
-    const char *fname;  /**< filename to use for memory emulation */
+    mtd_dev_t dev;          /**< mtd generic device */
+    const char *fname;      /**< filename to use for memory emulation */
+    uint32_t program_us;    /**< duration of a page program in us */
+    uint32_t erase_us;      /**< duration of a sector erase in us */
+#if defined(MODULE_MTD_NATIVE_MMAP) || defined(DOXYGEN)
+    uint8_t *mem;           /**< the mapped image, set by mtd_init() */
+#endif
 } mtd_native_dev_t;
 
 /**
@@ -37,6 +52,19 @@ typedef struct mtd_native_dev {
  */
 extern const mtd_desc_t native_flash_driver;
 
+/**
+ * @brief   Writes the image to the file on the host
+ *
+ * This is only needed with the `mtd_native_mmap` module, otherwise the image
+ * is always up to date.
+ *
+ * @param[in] dev   The device
+ *
+ * @return  0 on success
+ * @return  -EIO on error
+ */
+int mtd_native_flush(mtd_native_dev_t *dev);
+
 #ifdef __cplusplus
 }
 #endif
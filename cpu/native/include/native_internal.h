@@ -130,11 +130,17 @@ extern int (*real_fseek)(FILE *stream, long offset, int whence);
 extern int (*real_fputc)(int c, FILE *stream);
 extern int (*real_fgetc)(FILE *stream);
 extern mode_t (*real_umask)(mode_t cmask);
+extern off_t (*real_lseek)(int fd, off_t offset, int whence);
 extern ssize_t (*real_writev)(int fildes, const struct iovec *iov, int iovcnt);
 
 #ifdef __MACH__
 #else
 extern int (*real_clock_gettime)(clockid_t clk_id, struct timespec *tp);
+struct mmsghdr;
+extern int (*real_recvmmsg)(int sockfd, struct mmsghdr *msgvec, unsigned int vlen,
+                            int flags, struct timespec *timeout);
+extern int (*real_sendmmsg)(int sockfd, struct mmsghdr *msgvec, unsigned int vlen,
+                            int flags);
 #endif
 
 /**
@@ -19,15 +19,177 @@
 #include <assert.h>
 #include <inttypes.h>
 #include <errno.h>
+#include <string.h>
+
+#ifdef MODULE_MTD_NATIVE_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
 
 #include "mtd.h"
 #include "mtd_native.h"
+#ifdef MODULE_XTIMER
+#include "xtimer.h"
+#endif
 
 #include "native_internal.h"
 
 #define ENABLE_DEBUG (0)
 #include "debug.h"
 
+/* models the duration of a flash operation */
+static void _delay(uint32_t us)
+{
+#ifdef MODULE_XTIMER
+    if (us) {
+        xtimer_usleep(us);
+    }
+#else
+    (void)us;
+#endif
+}
+
+#ifdef MODULE_MTD_NATIVE_MMAP
+static int _init(mtd_dev_t *dev)
+{
+    mtd_native_dev_t *_dev = (mtd_native_dev_t*) dev;
+    size_t size = dev->sector_count * dev->pages_per_sector * dev->page_size;
+
+    DEBUG("mtd_native: init, filename=%s\n", _dev->fname);
+
+    if (_dev->mem) {
+        return 0;
+    }
+
+    int fd = real_open(_dev->fname, O_RDWR | O_CREAT, 0644);
+    if (fd < 0) {
+        return -EIO;
+    }
+    off_t old_size = real_lseek(fd, 0, SEEK_END);
+    if ((old_size < 0) ||
+        (((size_t)old_size < size) && (ftruncate(fd, size) < 0))) {
+        real_close(fd);
+        return -EIO;
+    }
+
+    void *mem = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    real_close(fd);
+    if (mem == MAP_FAILED) {
+        return -EIO;
+    }
+    _dev->mem = mem;
+
+    /* a new or extended image is erased */
+    if ((size_t)old_size < size) {
+        DEBUG("mtd_native: init: erasing new image %s\n", _dev->fname);
+        memset(&_dev->mem[old_size], 0xff, size - old_size);
+    }
+
+    return 0;
+}
+
+static int _read(mtd_dev_t *dev, void *buff, uint32_t addr, uint32_t size)
+{
+    mtd_native_dev_t *_dev = (mtd_native_dev_t*) dev;
+    size_t mtd_size = dev->sector_count * dev->pages_per_sector * dev->page_size;
+
+    DEBUG("mtd_native: read from page %" PRIu32 " count %" PRIu32 "\n", addr, size);
+
+    if (addr + size > mtd_size) {
+        return -EOVERFLOW;
+    }
+    if (!_dev->mem) {
+        return -EIO;
+    }
+    memcpy(buff, &_dev->mem[addr], size);
+
+    return size;
+}
+
+static int _write(mtd_dev_t *dev, const void *buff, uint32_t addr, uint32_t size)
+{
+    mtd_native_dev_t *_dev = (mtd_native_dev_t*) dev;
+    size_t mtd_size = dev->sector_count * dev->pages_per_sector * dev->page_size;
+    size_t sector_size = dev->pages_per_sector * dev->page_size;
+    const uint8_t *src = buff;
+    uint8_t *dst;
+
+    DEBUG("mtd_native: write from page %" PRIu32 " count %" PRIu32 "\n", addr, size);
+
+    if (addr + size > mtd_size) {
+        return -EOVERFLOW;
+    }
+    if (((addr % sector_size) + size) > sector_size) {
+        return -EOVERFLOW;
+    }
+    if (!_dev->mem) {
+        return -EIO;
+    }
+
+    /* NOR flash can only clear bits */
+    dst = &_dev->mem[addr];
+    uint32_t left = size;
+    for (; left > 0 && ((uintptr_t)dst % sizeof(uint64_t)); left--) {
+        *dst++ &= *src++;
+    }
+    for (; left >= sizeof(uint64_t); left -= sizeof(uint64_t)) {
+        uint64_t word;
+
+        memcpy(&word, src, sizeof(word));
+        *(uint64_t *)dst &= word;
+        dst += sizeof(uint64_t);
+        src += sizeof(uint64_t);
+    }
+    for (; left > 0; left--) {
+        *dst++ &= *src++;
+    }
+
+    _delay(((addr % dev->page_size + size + dev->page_size - 1) /
+            dev->page_size) * _dev->program_us);
+
+    return size;
+}
+
+static int _erase(mtd_dev_t *dev, uint32_t addr, uint32_t size)
+{
+    mtd_native_dev_t *_dev = (mtd_native_dev_t*) dev;
+    size_t mtd_size = dev->sector_count * dev->pages_per_sector * dev->page_size;
+    size_t sector_size = dev->pages_per_sector * dev->page_size;
+
+    DEBUG("mtd_native: erase from sector %" PRIu32 " count %" PRIu32 "\n", addr, size);
+
+    if (addr + size > mtd_size) {
+        return -EOVERFLOW;
+    }
+    if (((addr % sector_size) != 0) || ((size % sector_size) != 0)) {
+        return -EOVERFLOW;
+    }
+    if (!_dev->mem) {
+        return -EIO;
+    }
+    memset(&_dev->mem[addr], 0xff, size);
+
+    _delay((size / sector_size) * _dev->erase_us);
+
+    return 0;
+}
+
+int mtd_native_flush(mtd_native_dev_t *dev)
+{
+    size_t size = dev->dev.sector_count * dev->dev.pages_per_sector *
+                  dev->dev.page_size;
+
+    if (!dev->mem) {
+        return -EIO;
+    }
+    if (msync(dev->mem, size, MS_SYNC) < 0) {
+        return -EIO;
+    }
+    return 0;
+}
+
+#else /* MODULE_MTD_NATIVE_MMAP */
 static int _init(mtd_dev_t *dev)
 {
     mtd_native_dev_t *_dev = (mtd_native_dev_t*) dev;
@@ -102,6 +264,9 @@ static int _write(mtd_dev_t *dev, const void *buff, uint32_t addr, uint32_t size
     }
     real_fclose(f);
 
+    _delay(((addr % dev->page_size + size + dev->page_size - 1) /
+            dev->page_size) * _dev->program_us);
+
     return size;
 }
 
@@ -130,9 +295,20 @@ static int _erase(mtd_dev_t *dev, uint32_t addr, uint32_t size)
     }
     real_fclose(f);
 
+    _delay((size / sector_size) * _dev->erase_us);
+
     return 0;
 }
 
+int mtd_native_flush(mtd_native_dev_t *dev)
+{
+    (void)dev;
+
+    /* the file is closed after every access */
+    return 0;
+}
+#endif /* MODULE_MTD_NATIVE_MMAP */
+
 static int _power(mtd_dev_t *dev, enum mtd_power_state power)
 {
     (void) dev;
@@ -141,6 +317,10 @@ static int _power(mtd_dev_t *dev, enum mtd_power_state power)
     return -ENOTSUP;
 }
 
+static int _flush(mtd_dev_t *dev)
+{
+    return mtd_native_flush((mtd_native_dev_t *)dev);
+}
 
 const mtd_desc_t native_flash_driver = {
     .read = _read,
@@ -148,6 +328,7 @@ const mtd_desc_t native_flash_driver = {
     .write = _write,
     .erase = _erase,
     .init = _init,
+    .flush = _flush,
 };
 
 /** @} */
@@ -95,11 +95,16 @@ int (*real_fseek)(FILE *stream, long offset, int whence);
 int (*real_fputc)(int c, FILE *stream);
 int (*real_fgetc)(FILE *stream);
 mode_t (*real_umask)(mode_t cmask);
+off_t (*real_lseek)(int fd, off_t offset, int whence);
 ssize_t (*real_writev)(int fildes, const struct iovec *iov, int iovcnt);
 
 #ifdef __MACH__
 #else
 int (*real_clock_gettime)(clockid_t clk_id, struct timespec *tp);
+int (*real_recvmmsg)(int sockfd, struct mmsghdr *msgvec, unsigned int vlen,
+                     int flags, struct timespec *timeout);
+int (*real_sendmmsg)(int sockfd, struct mmsghdr *msgvec, unsigned int vlen,
+                     int flags);
 #endif
 
 void _native_syscall_enter(void)
@@ -477,6 +482,7 @@ void _native_init_syscalls(void)
     *(void **)(&real_ferror) = dlsym(RTLD_NEXT, "ferror");
     *(void **)(&real_clearerr) = dlsym(RTLD_NEXT, "clearerr");
     *(void **)(&real_umask) = dlsym(RTLD_NEXT, "umask");
+    *(void **)(&real_lseek) = dlsym(RTLD_NEXT, "lseek");
     *(void **)(&real_writev) = dlsym(RTLD_NEXT, "writev");
     *(void **)(&real_fclose) = dlsym(RTLD_NEXT, "fclose");
     *(void **)(&real_fseek) = dlsym(RTLD_NEXT, "fseek");
@@ -485,5 +491,7 @@ void _native_init_syscalls(void)
 #ifdef __MACH__
 #else
     *(void **)(&real_clock_gettime) = dlsym(RTLD_NEXT, "clock_gettime");
+    *(void **)(&real_recvmmsg) = dlsym(RTLD_NEXT, "recvmmsg");
+    *(void **)(&real_sendmmsg) = dlsym(RTLD_NEXT, "sendmmsg");
 #endif
 }
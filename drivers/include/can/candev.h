@@ -52,9 +52,18 @@ typedef enum {
     CANDEV_EVENT_BUS_OFF,          /**< bus-off detected */
     CANDEV_EVENT_ERROR_PASSIVE,    /**< driver switched in error passive */
     CANDEV_EVENT_ERROR_WARNING,    /**< driver reached error warning */
+    CANDEV_EVENT_RX_BATCH,         /**< several packets have been received */
     /* expand this list if needed */
 } candev_event_t;
 
+/**
+ * @brief   Frames passed with a @ref CANDEV_EVENT_RX_BATCH event
+ */
+typedef struct {
+    struct can_frame *frames;      /**< received frames */
+    size_t numof;                  /**< number of frames in @p frames */
+} candev_rx_batch_t;
+
 /**
  * @brief   Forward declaration for candev struct
  */
@@ -172,6 +181,22 @@ typedef struct candev_driver {
      * @return              <0 on error
      */
     int (*remove_filter)(candev_t *dev, const struct can_filter *filter);
+
+    /**
+     * @brief   Send several packets at once
+     *
+     * Optional, may be NULL. Every frame is confirmed by a
+     * @ref CANDEV_EVENT_TX_CONFIRMATION or a @ref CANDEV_EVENT_TX_ERROR event.
+     *
+     * @param[in] dev       CAN device descriptor
+     * @param[in] frames    CAN frames to send
+     * @param[in] numof     number of frames in @p frames
+     *
+     * @return              number of frames sent
+     * @return              <0 on error
+     */
+    int (*send_batch)(candev_t *dev, const struct can_frame *const *frames,
+                      size_t numof);
 } candev_driver_t;
 
 #ifdef __cplusplus
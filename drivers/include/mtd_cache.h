@@ -0,0 +1,146 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    drivers_mtd_cache MTD page cache
+ * @ingroup     drivers_storage
+ * @brief       Write-back page cache stacked on top of another MTD
+ *
+ * The cache is a MTD itself and forwards to the MTD it is stacked on, the
+ * parent. It keeps a configurable number of pages in RAM, replaced in least
+ * recently used order:
+ *
+ * - reads of cached pages do not touch the parent
+ * - writes only modify the cached page, so consecutive small writes to a
+ *   page result in a single page program when the page is written back
+ * - a write that replaces a whole page does not read it from the parent
+ * - erases are deferred until the first page of the sector is written back or
+ *   the cache is flushed, reads of the erased sector meanwhile return 0xff
+ *   without touching the parent
+ *
+ * Unlike most MTDs the cache accepts writes that span several pages. Writes
+ * must still only clear bits of the existing content, unless the sector was
+ * erased before.
+ *
+ * Dirty pages are written back when they are evicted, on
+ * mtd_power(MTD_POWER_DOWN) and on mtd_cache_flush(), which must be called
+ * before the data is expected to be stored persistently. mtd_flush() does
+ * the same and flushes the parent afterwards.
+ *
+ * @code
+ *  static uint8_t cache_buf[4 * 256];
+ *  static mtd_cache_page_t cache_pages[4];
+ *
+ *  static mtd_cache_t cache = {
+ *      .base = { .driver = &mtd_cache_driver },
+ *      .parent = MTD_0,
+ *      .pages = cache_pages,
+ *      .buf = cache_buf,
+ *      .numof = 4,
+ *  };
+ *
+ *  mtd_init(&cache.base);
+ * @endcode
+ *
+ * @{
+ *
+ * @file
+ * @brief       Interface definition for the MTD page cache
+ */
+
+#ifndef MTD_CACHE_H
+#define MTD_CACHE_H
+
+#include <stdint.h>
+
+#include "mtd.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Maximum number of sector erases that are deferred at a time
+ */
+#ifndef MTD_CACHE_ERASE_NUMOF
+#define MTD_CACHE_ERASE_NUMOF   (4U)
+#endif
+
+/**
+ * @brief   Page number of an unused cache page
+ */
+#define MTD_CACHE_PAGE_INVALID  (UINT32_MAX)
+
+/**
+ * @brief   Descriptor of a cache page
+ */
+typedef struct {
+    uint32_t page;      /**< page of the parent, or MTD_CACHE_PAGE_INVALID */
+    uint32_t used;      /**< time of the last access */
+    uint8_t dirty;      /**< the page differs from the parent */
+} mtd_cache_page_t;
+
+/**
+ * @brief   Statistics of a MTD page cache
+ */
+typedef struct {
+    uint32_t hits;      /**< page accesses served from the cache */
+    uint32_t misses;    /**< page accesses that read from the parent */
+    uint32_t writes;    /**< pages written to the parent */
+    uint32_t erases;    /**< sectors erased on the parent */
+} mtd_cache_stats_t;
+
+/**
+ * @brief   Device descriptor of a MTD page cache
+ *
+ * This is an extension of the @c mtd_dev_t struct. The first five members
+ * must be set by the user, the rest is initialized by mtd_init().
+ */
+typedef struct {
+    mtd_dev_t base;             /**< inherit from mtd_dev_t object */
+    mtd_dev_t *parent;          /**< the cached device */
+    mtd_cache_page_t *pages;    /**< descriptors of the cache pages */
+    uint8_t *buf;               /**< data of the cache pages, @p numof times
+                                 *   the page size of @p parent bytes */
+    unsigned numof;             /**< number of cache pages */
+    uint32_t erase[MTD_CACHE_ERASE_NUMOF];  /**< sectors with deferred erase */
+    unsigned erase_numof;       /**< number of deferred erases */
+    uint32_t clock;             /**< LRU clock */
+    mtd_cache_stats_t stats;    /**< hit/miss statistics */
+} mtd_cache_t;
+
+/**
+ * @brief   MTD page cache operations table for mtd
+ */
+extern const mtd_desc_t mtd_cache_driver;
+
+/**
+ * @brief   Writes all dirty pages and deferred erases to the parent
+ *
+ * The pages stay in the cache.
+ *
+ * @param[in] cache     The cache to flush
+ *
+ * @return  0 on success
+ * @return  < 0 on error of the parent
+ */
+int mtd_cache_flush(mtd_cache_t *cache);
+
+/**
+ * @brief   Resets the statistics of a cache
+ *
+ * @param[in] cache     The cache
+ */
+void mtd_cache_reset_stats(mtd_cache_t *cache);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MTD_CACHE_H */
+/** @} */
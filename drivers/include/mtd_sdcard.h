@@ -54,6 +54,23 @@ typedef struct {
 #define MTD_SDCARD_SKIP_ERASE (1)
 #endif
 
+/**
+ * @brief   Keep multi-block transfers open between successive sequential reads
+ *          and writes, so each one only pays for the data packets.
+ *
+ *          The open transfer is stopped by the first non-sequential access,
+ *          by mtd_flush(), by mtd_power(MTD_POWER_DOWN) and by
+ *          sdcard_spi_stream_stop(). vfs_fsync() calls mtd_flush() for
+ *          file systems that support it.
+ *
+ *          Disabled by default: the card is left in a multi-block write after
+ *          mtd_write(), so the written data is only guaranteed to be stored
+ *          once mtd_flush() returned.
+ */
+#ifndef MTD_SDCARD_STREAM
+#define MTD_SDCARD_STREAM (0)
+#endif
+
 /**
  * @brief   sdcard device operations table for mtd
  */
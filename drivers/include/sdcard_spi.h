@@ -39,7 +39,7 @@ extern "C" {
 /**
  * @brief   CID register see section 5.2 in SD-Spec v5.00
  */
-struct {
+typedef struct {
     uint8_t MID;              /**< Manufacturer ID */
     char OID[SD_SIZE_OF_OID]; /**< OEM/Application ID*/
     char PNM[SD_SIZE_OF_PNM]; /**< Product name */
@@ -47,13 +47,13 @@ struct {
     uint32_t PSN;             /**< Product serial number */
     uint16_t MDT;             /**< Manufacturing date */
     uint8_t CID_CRC;          /**< CRC7 checksum */
-} typedef cid_t;
+} cid_t;
 
 /**
  * @brief   CSD register with csd structure version 1.0
  *          see section 5.3.2 in SD-Spec v5.00
  */
-struct {
+typedef struct {
     uint8_t CSD_STRUCTURE : 2;        /**< see section 5.3.2 in SD-Spec v5.00 */
     uint8_t TAAC : 8;                 /**< see section 5.3.2 in SD-Spec v5.00 */
     uint8_t NSAC : 8;                 /**< see section 5.3.2 in SD-Spec v5.00 */
@@ -83,13 +83,13 @@ struct {
     uint8_t TMP_WRITE_PROTECT : 1;    /**< see section 5.3.2 in SD-Spec v5.00 */
     uint8_t FILE_FORMAT : 2;          /**< see section 5.3.2 in SD-Spec v5.00 */
     uint8_t CSD_CRC : 8;              /**< see section 5.3.2 in SD-Spec v5.00 */
-} typedef csd_v1_t;
+} csd_v1_t;
 
 /**
  * @brief   CSD register with csd structure version 2.0
  *          see section 5.3.3 in SD-Spec v5.00
  */
-struct {
+typedef struct {
     uint8_t CSD_STRUCTURE : 2;        /**< see section 5.3.3 in SD-Spec v5.00 */
     uint8_t TAAC : 8;                 /**< see section 5.3.3 in SD-Spec v5.00 */
     uint8_t NSAC : 8;                 /**< see section 5.3.3 in SD-Spec v5.00 */
@@ -114,20 +114,20 @@ struct {
     uint8_t TMP_WRITE_PROTECT : 1;    /**< see section 5.3.3 in SD-Spec v5.00 */
     uint8_t FILE_FORMAT : 2;          /**< see section 5.3.3 in SD-Spec v5.00 */
     uint8_t CSD_CRC : 8;              /**< see section 5.3.3 in SD-Spec v5.00 */
-} typedef csd_v2_t;
+} csd_v2_t;
 
 /**
  * @brief   CSD register (see section 5.3 in SD-Spec v5.00)
  */
-union {
+typedef union {
     csd_v1_t v1;   /**< see section 5.3.2 in SD-Spec v5.00 */
     csd_v2_t v2;   /**< see section 5.3.3 in SD-Spec v5.00 */
-} typedef csd_t;
+} csd_t;
 
 /**
  * @brief   SD status register (see section 4.10.2 in SD-Spec v5.00)
  */
-struct {
+typedef struct {
     uint32_t SIZE_OF_PROTECTED_AREA : 32;   /**< see section 4.10.2 in SD-Spec v5.00 */
     uint32_t SUS_ADDR : 22;                 /**< see section 4.10.2.12 in SD-Spec v5.00 */
     uint32_t VSC_AU_SIZE : 10;              /**< see section 4.10.2.11 in SD-Spec v5.00 */
@@ -143,7 +143,7 @@ struct {
     uint8_t  AU_SIZE : 4;                   /**< see section 4.10.2.4 in SD-Spec v5.00 */
     uint8_t  DAT_BUS_WIDTH : 2;             /**< see section 4.10.2 in SD-Spec v5.00 */
     uint8_t  SECURED_MODE : 1;              /**< see section 4.10.2 in SD-Spec v5.00 */
-} typedef sd_status_t;
+} sd_status_t;
 
 /**
  * @brief   version type of SD-card
@@ -168,6 +168,15 @@ typedef enum {
     SD_RW_NOT_SUPPORTED     /**< operation not supported on used card */
 } sd_rw_response_t;
 
+/**
+ * @brief   type of the multi-block transfer that is kept open by the streaming API
+ */
+typedef enum {
+    SD_STREAM_NONE = 0,     /**< no transfer open */
+    SD_STREAM_READ,         /**< CMD18 multi-block read open */
+    SD_STREAM_WRITE         /**< CMD25 multi-block write open */
+} sd_stream_t;
+
 /**
  * @brief   sdcard_spi device params
  */
@@ -184,7 +193,7 @@ typedef struct {
 /**
  * @brief   Device descriptor for sdcard_spi
  */
-struct {
+typedef struct {
     sdcard_spi_params_t params;     /**< parameters for pin and spi config */
     spi_clk_t spi_clk;              /**< active SPI clock speed */
     bool use_block_addr;            /**< true if block adressing (vs. byte adressing) is used */
@@ -193,7 +202,9 @@ struct {
     int csd_structure;              /**< version of the CSD register structure */
     cid_t cid;                      /**< CID register */
     csd_t csd;                      /**< CSD register */
-} typedef sdcard_spi_t;
+    sd_stream_t stream;             /**< currently open multi-block transfer */
+    uint32_t stream_next;           /**< block address the open transfer continues at */
+} sdcard_spi_t;
 
 /**
  * @brief              Initializes the sd-card with the given parameters in sdcard_spi_t structure.
@@ -255,6 +266,93 @@ int sdcard_spi_read_blocks(sdcard_spi_t *card, int blockaddr, char *data, int bl
 int sdcard_spi_write_blocks(sdcard_spi_t *card, int blockaddr, const char *data, int blocksize,
                             int nblocks, sd_rw_response_t *state);
 
+/**
+ * @brief                 Opens a multi-block write (CMD25) that stays open across successive
+ *                        calls of sdcard_spi_write_stream() until sdcard_spi_stream_stop() is
+ *                        called.
+ *
+ *                        Compared to sdcard_spi_write_blocks() the command setup and the
+ *                        stop-tran handshake are only paid once for all blocks of a sequential
+ *                        write. A transfer that is already open is stopped first.
+ *
+ * @param[in] card        Initialized sd-card struct
+ * @param[in] blockaddr   Block address to start writing at (see sdcard_spi_write_blocks())
+ * @param[in] nblocks     Number of blocks that are going to be written. If > 0 it is passed to
+ *                        the card as pre-erase hint (ACMD23) so it can erase them in advance.
+ *                        The content of pre-erased blocks that are not written before the
+ *                        transfer is stopped is undefined. Use 0 if the length is unknown.
+ *
+ * @return                SD_RW_OK if the transfer was opened
+ * @return                SD_RW_RX_TX_ERROR if the card did not accept CMD25
+ */
+sd_rw_response_t sdcard_spi_write_stream_start(sdcard_spi_t *card, int blockaddr, int nblocks);
+
+/**
+ * @brief                 Writes blocks to the multi-block write opened by
+ *                        sdcard_spi_write_stream_start().
+ *
+ *                        The function returns as soon as the card accepted the last block, so
+ *                        the card programs it while the caller prepares the next data. The
+ *                        payload of each block is handed to the SPI driver as one transfer.
+ *
+ * @param[in] card        Initialized sd-card struct
+ * @param[in] data        Buffer that contains the data to be sent
+ * @param[in] blocksize   Size of data blocks (see sdcard_spi_write_blocks())
+ * @param[in] nblocks     Number of blocks to write
+ * @param[out] state      Contains information about the error state if something went wrong
+ *                        (if return value is lower than nblocks). SD_RW_NOT_SUPPORTED if no
+ *                        write transfer is open. The transfer is stopped on errors.
+ *
+ * @return                number of successfully written blocks (0 if no block was written).
+ */
+int sdcard_spi_write_stream(sdcard_spi_t *card, const char *data, int blocksize,
+                            int nblocks, sd_rw_response_t *state);
+
+/**
+ * @brief                 Opens a multi-block read (CMD18) that stays open across successive
+ *                        calls of sdcard_spi_read_stream() until sdcard_spi_stream_stop() is
+ *                        called. A transfer that is already open is stopped first.
+ *
+ * @param[in] card        Initialized sd-card struct
+ * @param[in] blockaddr   Block address to start reading at (see sdcard_spi_read_blocks())
+ *
+ * @return                SD_RW_OK if the transfer was opened
+ * @return                SD_RW_RX_TX_ERROR if the card did not accept CMD18
+ */
+sd_rw_response_t sdcard_spi_read_stream_start(sdcard_spi_t *card, int blockaddr);
+
+/**
+ * @brief                 Reads blocks from the multi-block read opened by
+ *                        sdcard_spi_read_stream_start().
+ *
+ * @param[in] card        Initialized sd-card struct
+ * @param[out] data       Buffer to store the read data in
+ * @param[in]  blocksize  Size of data blocks (see sdcard_spi_read_blocks())
+ * @param[in]  nblocks    Number of blocks to read
+ * @param[out] state      Contains information about the error state if something went wrong
+ *                        (if return value is lower than nblocks). SD_RW_NOT_SUPPORTED if no
+ *                        read transfer is open. The transfer is stopped on errors.
+ *
+ * @return                number of successfully read blocks (0 if no block was read).
+ */
+int sdcard_spi_read_stream(sdcard_spi_t *card, char *data, int blocksize,
+                           int nblocks, sd_rw_response_t *state);
+
+/**
+ * @brief                 Stops the open multi-block transfer, if any.
+ *
+ *                        sdcard_spi_read_blocks() and sdcard_spi_write_blocks() do this
+ *                        implicitly. The last block of a write transfer is only
+ *                        guaranteed to be programmed once this function returned.
+ *
+ * @param[in] card        Initialized sd-card struct
+ *
+ * @return                SD_RW_OK if no transfer was open or it was stopped successfully
+ * @return                SD_RW_TIMEOUT if the card stayed busy after a write transfer
+ * @return                SD_RW_RX_TX_ERROR if the card did not accept CMD12 after a read transfer
+ */
+sd_rw_response_t sdcard_spi_stream_stop(sdcard_spi_t *card);
+
 /**
  * @brief                 Gets the capacity of the card.
  *
@@ -36,12 +36,14 @@ static int mtd_vfs_fstat(vfs_file_t *filp, struct stat *buf);
 static off_t mtd_vfs_lseek(vfs_file_t *filp, off_t off, int whence);
 static ssize_t mtd_vfs_read(vfs_file_t *filp, void *dest, size_t nbytes);
 static ssize_t mtd_vfs_write(vfs_file_t *filp, const void *src, size_t nbytes);
+static int mtd_vfs_fsync(vfs_file_t *filp);
 
 const vfs_file_ops_t mtd_vfs_ops = {
     .fstat = mtd_vfs_fstat,
     .lseek = mtd_vfs_lseek,
     .read  = mtd_vfs_read,
     .write = mtd_vfs_write,
+    .fsync = mtd_vfs_fsync,
 };
 
 static int mtd_vfs_fstat(vfs_file_t *filp, struct stat *buf)
@@ -132,6 +134,15 @@ static ssize_t mtd_vfs_write(vfs_file_t *filp, const void *src, size_t nbytes)
     return res;
 }
 
+static int mtd_vfs_fsync(vfs_file_t *filp)
+{
+    mtd_dev_t *mtd = filp->private_data.ptr;
+    if (mtd == NULL) {
+        return -EFAULT;
+    }
+    return mtd_flush(mtd);
+}
+
 /** @} */
 
 #else
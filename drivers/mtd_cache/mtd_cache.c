@@ -0,0 +1,351 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     drivers_mtd_cache
+ * @{
+ *
+ * @file
+ * @brief       MTD page cache implementation
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+#include <string.h>
+
+#include "mtd.h"
+#include "mtd_cache.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+static int mtd_cache_init(mtd_dev_t *dev);
+static int mtd_cache_read(mtd_dev_t *dev, void *buff, uint32_t addr,
+                          uint32_t size);
+static int mtd_cache_write(mtd_dev_t *dev, const void *buff, uint32_t addr,
+                           uint32_t size);
+static int mtd_cache_erase(mtd_dev_t *dev, uint32_t addr, uint32_t size);
+static int mtd_cache_power(mtd_dev_t *dev, enum mtd_power_state power);
+static int mtd_cache_sync(mtd_dev_t *dev);
+
+const mtd_desc_t mtd_cache_driver = {
+    .init = mtd_cache_init,
+    .read = mtd_cache_read,
+    .write = mtd_cache_write,
+    .erase = mtd_cache_erase,
+    .power = mtd_cache_power,
+    .flush = mtd_cache_sync,
+};
+
+static inline uint8_t *_data(mtd_cache_t *cache, unsigned idx)
+{
+    return &cache->buf[idx * cache->base.page_size];
+}
+
+static inline uint32_t _sector(mtd_cache_t *cache, uint32_t page)
+{
+    return page / cache->base.pages_per_sector;
+}
+
+static int _find_erase(mtd_cache_t *cache, uint32_t sector)
+{
+    for (unsigned i = 0; i < cache->erase_numof; i++) {
+        if (cache->erase[i] == sector) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/* performs the i-th deferred erase, the dirty pages of the sector stay
+ * cached and are programmed later on */
+static int _commit_erase(mtd_cache_t *cache, unsigned i)
+{
+    uint32_t sector_size = cache->base.pages_per_sector * cache->base.page_size;
+    uint32_t sector = cache->erase[i];
+
+    DEBUG("mtd_cache: erase sector %" PRIu32 "\n", sector);
+    int res = mtd_erase(cache->parent, sector * sector_size, sector_size);
+    if (res < 0) {
+        return res;
+    }
+    cache->stats.erases++;
+    cache->erase_numof--;
+    memmove(&cache->erase[i], &cache->erase[i + 1],
+            (cache->erase_numof - i) * sizeof(cache->erase[0]));
+    return 0;
+}
+
+static int _write_back(mtd_cache_t *cache, unsigned idx)
+{
+    mtd_cache_page_t *p = &cache->pages[idx];
+    int i = _find_erase(cache, _sector(cache, p->page));
+
+    if (i >= 0) {
+        int res = _commit_erase(cache, i);
+        if (res < 0) {
+            return res;
+        }
+    }
+    DEBUG("mtd_cache: write back page %" PRIu32 "\n", p->page);
+    int res = mtd_write(cache->parent, _data(cache, idx),
+                        p->page * cache->base.page_size,
+                        cache->base.page_size);
+    if (res < 0) {
+        return res;
+    }
+    cache->stats.writes++;
+    p->dirty = 0;
+    return 0;
+}
+
+static int _lookup(mtd_cache_t *cache, uint32_t page)
+{
+    for (unsigned i = 0; i < cache->numof; i++) {
+        if (cache->pages[i].page == page) {
+            cache->pages[i].used = ++cache->clock;
+            return i;
+        }
+    }
+    return -1;
+}
+
+/* brings a page into the cache, its content is only loaded if @p fill is
+ * set */
+static int _load(mtd_cache_t *cache, uint32_t page, int fill)
+{
+    unsigned idx = 0;
+
+    /* take an unused page or else the least recently used one */
+    for (unsigned i = 0; i < cache->numof; i++) {
+        if (cache->pages[i].page == MTD_CACHE_PAGE_INVALID) {
+            idx = i;
+            break;
+        }
+        if ((cache->clock - cache->pages[i].used) >
+            (cache->clock - cache->pages[idx].used)) {
+            idx = i;
+        }
+    }
+    if (cache->pages[idx].dirty) {
+        int res = _write_back(cache, idx);
+        if (res < 0) {
+            return res;
+        }
+    }
+
+    cache->pages[idx].page = MTD_CACHE_PAGE_INVALID;
+    if (!fill) {
+        /* overwritten entirely by the caller */
+    }
+    else if (_find_erase(cache, _sector(cache, page)) >= 0) {
+        memset(_data(cache, idx), 0xff, cache->base.page_size);
+        cache->stats.hits++;
+    }
+    else {
+        int res = mtd_read(cache->parent, _data(cache, idx),
+                           page * cache->base.page_size,
+                           cache->base.page_size);
+        if (res < 0) {
+            return res;
+        }
+        cache->stats.misses++;
+    }
+    cache->pages[idx].page = page;
+    cache->pages[idx].used = ++cache->clock;
+    return idx;
+}
+
+static int mtd_cache_init(mtd_dev_t *dev)
+{
+    mtd_cache_t *cache = (mtd_cache_t *)dev;
+
+    if (!cache->parent || !cache->pages || !cache->buf || !cache->numof) {
+        return -EINVAL;
+    }
+    int res = mtd_init(cache->parent);
+    if (res < 0) {
+        return res;
+    }
+    dev->sector_count = cache->parent->sector_count;
+    dev->pages_per_sector = cache->parent->pages_per_sector;
+    dev->page_size = cache->parent->page_size;
+
+    for (unsigned i = 0; i < cache->numof; i++) {
+        cache->pages[i].page = MTD_CACHE_PAGE_INVALID;
+        cache->pages[i].dirty = 0;
+    }
+    cache->erase_numof = 0;
+    cache->clock = 0;
+    mtd_cache_reset_stats(cache);
+    return 0;
+}
+
+static int mtd_cache_read(mtd_dev_t *dev, void *buff, uint32_t addr,
+                          uint32_t size)
+{
+    mtd_cache_t *cache = (mtd_cache_t *)dev;
+    uint32_t mtd_size = dev->sector_count * dev->pages_per_sector *
+                        dev->page_size;
+    uint8_t *dst = buff;
+
+    if ((addr + size > mtd_size) || (addr + size < addr)) {
+        return -EOVERFLOW;
+    }
+
+    for (uint32_t done = 0; done < size;) {
+        uint32_t page = addr / dev->page_size;
+        uint32_t off = addr % dev->page_size;
+        uint32_t chunk = dev->page_size - off;
+        int idx = _lookup(cache, page);
+
+        if (chunk > size - done) {
+            chunk = size - done;
+        }
+        if (idx >= 0) {
+            cache->stats.hits++;
+        }
+        else {
+            idx = _load(cache, page, 1);
+            if (idx < 0) {
+                return idx;
+            }
+        }
+        memcpy(dst, _data(cache, idx) + off, chunk);
+        dst += chunk;
+        addr += chunk;
+        done += chunk;
+    }
+    return size;
+}
+
+static int mtd_cache_write(mtd_dev_t *dev, const void *buff, uint32_t addr,
+                           uint32_t size)
+{
+    mtd_cache_t *cache = (mtd_cache_t *)dev;
+    uint32_t mtd_size = dev->sector_count * dev->pages_per_sector *
+                        dev->page_size;
+    const uint8_t *src = buff;
+
+    if ((addr + size > mtd_size) || (addr + size < addr)) {
+        return -EOVERFLOW;
+    }
+
+    for (uint32_t done = 0; done < size;) {
+        uint32_t page = addr / dev->page_size;
+        uint32_t off = addr % dev->page_size;
+        uint32_t chunk = dev->page_size - off;
+        int idx = _lookup(cache, page);
+
+        if (chunk > size - done) {
+            chunk = size - done;
+        }
+        if (idx >= 0) {
+            cache->stats.hits++;
+        }
+        else {
+            idx = _load(cache, page, chunk < dev->page_size);
+            if (idx < 0) {
+                return idx;
+            }
+        }
+        memcpy(_data(cache, idx) + off, src, chunk);
+        cache->pages[idx].dirty = 1;
+        src += chunk;
+        addr += chunk;
+        done += chunk;
+    }
+    return size;
+}
+
+static int mtd_cache_erase(mtd_dev_t *dev, uint32_t addr, uint32_t size)
+{
+    mtd_cache_t *cache = (mtd_cache_t *)dev;
+    uint32_t sector_size = dev->pages_per_sector * dev->page_size;
+    uint32_t mtd_size = dev->sector_count * sector_size;
+
+    if ((addr + size > mtd_size) || (addr + size < addr)) {
+        return -EOVERFLOW;
+    }
+    if (((addr % sector_size) != 0) || ((size % sector_size) != 0)) {
+        return -EOVERFLOW;
+    }
+
+    for (uint32_t sector = addr / sector_size;
+         sector < (addr + size) / sector_size; sector++) {
+        /* the cached content is void */
+        for (unsigned i = 0; i < cache->numof; i++) {
+            if ((cache->pages[i].page != MTD_CACHE_PAGE_INVALID) &&
+                (_sector(cache, cache->pages[i].page) == sector)) {
+                cache->pages[i].page = MTD_CACHE_PAGE_INVALID;
+                cache->pages[i].dirty = 0;
+            }
+        }
+        if (_find_erase(cache, sector) >= 0) {
+            continue;
+        }
+        if (cache->erase_numof == MTD_CACHE_ERASE_NUMOF) {
+            int res = _commit_erase(cache, 0);
+            if (res < 0) {
+                return res;
+            }
+        }
+        cache->erase[cache->erase_numof++] = sector;
+    }
+    return 0;
+}
+
+static int mtd_cache_power(mtd_dev_t *dev, enum mtd_power_state power)
+{
+    mtd_cache_t *cache = (mtd_cache_t *)dev;
+
+    if (power == MTD_POWER_DOWN) {
+        int res = mtd_cache_flush(cache);
+        if (res < 0) {
+            return res;
+        }
+    }
+    return mtd_power(cache->parent, power);
+}
+
+static int mtd_cache_sync(mtd_dev_t *dev)
+{
+    mtd_cache_t *cache = (mtd_cache_t *)dev;
+    int res = mtd_cache_flush(cache);
+
+    if (res < 0) {
+        return res;
+    }
+    return mtd_flush(cache->parent);
+}
+
+int mtd_cache_flush(mtd_cache_t *cache)
+{
+    while (cache->erase_numof > 0) {
+        int res = _commit_erase(cache, 0);
+        if (res < 0) {
+            return res;
+        }
+    }
+    for (unsigned i = 0; i < cache->numof; i++) {
+        if (cache->pages[i].dirty) {
+            int res = _write_back(cache, i);
+            if (res < 0) {
+                return res;
+            }
+        }
+    }
+    return 0;
+}
+
+void mtd_cache_reset_stats(mtd_cache_t *cache)
+{
+    memset(&cache->stats, 0, sizeof(cache->stats));
+}
@@ -35,6 +35,7 @@ static int mtd_sdcard_write(mtd_dev_t *mtd, const void *src, uint32_t addr,
                             uint32_t size);
 static int mtd_sdcard_erase(mtd_dev_t *mtd, uint32_t addr, uint32_t size);
 static int mtd_sdcard_power(mtd_dev_t *mtd, enum mtd_power_state power);
+static int mtd_sdcard_flush(mtd_dev_t *mtd);
 
 const mtd_desc_t mtd_sdcard_driver = {
     .init = mtd_sdcard_init,
@@ -42,6 +43,7 @@ const mtd_desc_t mtd_sdcard_driver = {
     .write = mtd_sdcard_write,
     .erase = mtd_sdcard_erase,
     .power = mtd_sdcard_power,
+    .flush = mtd_sdcard_flush,
 };
 
 static int mtd_sdcard_init(mtd_dev_t *dev)
@@ -67,10 +69,24 @@ static int mtd_sdcard_read(mtd_dev_t *dev, void *buff, uint32_t addr,
 {
     DEBUG("mtd_sdcard_read: addr:%lu size:%lu\n", addr, size);
     mtd_sdcard_t *mtd_sd = (mtd_sdcard_t*)dev;
+    sdcard_spi_t *card = mtd_sd->sd_card;
+    uint32_t block = addr / SD_HC_BLOCK_SIZE;
     sd_rw_response_t err;
-    int res = sdcard_spi_read_blocks(mtd_sd->sd_card, addr / SD_HC_BLOCK_SIZE,
-                                     buff, SD_HC_BLOCK_SIZE,
-                                     size / SD_HC_BLOCK_SIZE, &err);
+    int res;
+
+#if MTD_SDCARD_STREAM == 1
+    /* sequential reads continue the open multi-block read */
+    if ((card->stream != SD_STREAM_READ) || (card->stream_next != block)) {
+        if (sdcard_spi_read_stream_start(card, block) != SD_RW_OK) {
+            return -EIO;
+        }
+    }
+    res = sdcard_spi_read_stream(card, buff, SD_HC_BLOCK_SIZE,
+                                 size / SD_HC_BLOCK_SIZE, &err);
+#else
+    res = sdcard_spi_read_blocks(card, block, buff, SD_HC_BLOCK_SIZE,
+                                 size / SD_HC_BLOCK_SIZE, &err);
+#endif
 
     if (err == SD_RW_OK) {
         return res * SD_HC_BLOCK_SIZE;
@@ -83,10 +99,25 @@ static int mtd_sdcard_write(mtd_dev_t *dev, const void *buff, uint32_t addr,
 {
     DEBUG("mtd_sdcard_write: addr:%lu size:%lu\n", addr, size);
     mtd_sdcard_t *mtd_sd = (mtd_sdcard_t*)dev;
+    sdcard_spi_t *card = mtd_sd->sd_card;
+    uint32_t block = addr / SD_HC_BLOCK_SIZE;
     sd_rw_response_t err;
-    int res = sdcard_spi_write_blocks(mtd_sd->sd_card, addr / SD_HC_BLOCK_SIZE,
-                                      buff, SD_HC_BLOCK_SIZE,
-                                      size / SD_HC_BLOCK_SIZE, &err);
+    int res;
+
+#if MTD_SDCARD_STREAM == 1
+    /* sequential writes continue the open multi-block write */
+    if ((card->stream != SD_STREAM_WRITE) || (card->stream_next != block)) {
+        if (sdcard_spi_write_stream_start(card, block,
+                                          size / SD_HC_BLOCK_SIZE) != SD_RW_OK) {
+            return -EIO;
+        }
+    }
+    res = sdcard_spi_write_stream(card, buff, SD_HC_BLOCK_SIZE,
+                                  size / SD_HC_BLOCK_SIZE, &err);
+#else
+    res = sdcard_spi_write_blocks(card, block, buff, SD_HC_BLOCK_SIZE,
+                                  size / SD_HC_BLOCK_SIZE, &err);
+#endif
 
     if (err == SD_RW_OK) {
         return res * SD_HC_BLOCK_SIZE;
@@ -112,10 +143,26 @@ static int mtd_sdcard_erase(mtd_dev_t *dev,
 
 static int mtd_sdcard_power(mtd_dev_t *dev, enum mtd_power_state power)
 {
-    (void)dev;
-    (void)power;
+    mtd_sdcard_t *mtd_sd = (mtd_sdcard_t*)dev;
+
+    if (power == MTD_POWER_DOWN) {
+        sdcard_spi_stream_stop(mtd_sd->sd_card);
+    }
 
     /* TODO: implement power down of sdcard in sdcard_spi
     (make use of sdcard_spi_params_t.power pin) */
     return -ENOTSUP; /* currently not supported */
 }
+
+static int mtd_sdcard_flush(mtd_dev_t *dev)
+{
+    DEBUG("mtd_sdcard_flush\n");
+    mtd_sdcard_t *mtd_sd = (mtd_sdcard_t*)dev;
+
+    /* the card programs the last block of a multi-block write only once the
+     * transfer is stopped */
+    if (sdcard_spi_stream_stop(mtd_sd->sd_card) != SD_RW_OK) {
+        return -EIO;
+    }
+    return 0;
+}
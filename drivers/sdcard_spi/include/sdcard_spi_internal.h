@@ -97,6 +97,7 @@ extern "C" {
 #define SD_CMD_17 17 /* Reads a block of the size selected by the SET_BLOCKLEN command */
 #define SD_CMD_18 18 /* Continuously transfers data blocks from card to host
                         until interrupted by a STOP_TRANSMISSION command */
+#define SD_CMD_23 23 /* Sent as ACMD23 sets the number of blocks to pre-erase before writing */
 #define SD_CMD_24 24 /* Writes a block of the size selected by the SET_BLOCKLEN command */
 #define SD_CMD_25 25 /* Continuously writes blocks of data until 'Stop Tran'token is sent */
 #define SD_CMD_41 41 /* Reserved (used for ACMD41) */
@@ -108,6 +109,7 @@ extern "C" {
 #define SD_CMD_8_VHS_2_7_V_TO_3_6_V 0x01
 #define SD_CMD_8_CHECK_PATTERN      0xB5
 #define SD_CMD_NO_ARG     0x00000000
+#define SD_ACMD_23_ARG_MAX 0x007FFFFF
 #define SD_ACMD_41_ARG_HC 0x40000000
 #define SD_CMD_59_ARG_EN  0x00000001
 #define SD_CMD_59_ARG_DIS 0x00000000
@@ -25,6 +25,7 @@
 #include "periph/spi.h"
 #include "periph/gpio.h"
 #include "xtimer.h"
+#include "checksum/crc16_ccitt.h"
 
 #include <stdio.h>
 #include <string.h>
@@ -45,7 +46,7 @@ static sd_rw_response_t _write_data_packet(sdcard_spi_t *card, char token, const
 /* CRC-7 (polynomial: x^7 + x^3 + 1) LSB of CRC-7 in a 8-bit variable is always 1*/
 static char _crc_7(const char *data, int n);
 
-/* CRC-16 (CRC-CCITT) (polynomial: x^16 + x^12 + x^5 + x^1) */
+/* CRC-16 (CRC-CCITT) (polynomial: x^16 + x^12 + x^5 + x^1), initial value 0 */
 static uint16_t _crc_16(const char *data, size_t n);
 
 /* use this transfer method instead of _transfer_bytes to force the use of 0xFF as dummy bytes */
@@ -66,6 +67,7 @@ int sdcard_spi_init(sdcard_spi_t *card, const sdcard_spi_params_t *params)
     sd_init_fsm_state_t state = SD_INIT_START;
     memcpy(&card->params, params, sizeof(sdcard_spi_params_t));
     card->spi_clk = SD_CARD_SPI_SPEED_PREINIT;
+    card->stream = SD_STREAM_NONE;
 
     do {
         state = _init_sd_fsm_step(card, state);
@@ -393,35 +395,55 @@ static inline bool _wait_for_not_busy(sdcard_spi_t *card, int32_t max_retries)
     return false;
 }
 
+/* CRC-7 of every byte value, shifted left by one bit */
+static const uint8_t _crc_7_table[256] = {
+    0x00, 0x12, 0x24, 0x36, 0x48, 0x5a, 0x6c, 0x7e,
+    0x90, 0x82, 0xb4, 0xa6, 0xd8, 0xca, 0xfc, 0xee,
+    0x32, 0x20, 0x16, 0x04, 0x7a, 0x68, 0x5e, 0x4c,
+    0xa2, 0xb0, 0x86, 0x94, 0xea, 0xf8, 0xce, 0xdc,
+    0x64, 0x76, 0x40, 0x52, 0x2c, 0x3e, 0x08, 0x1a,
+    0xf4, 0xe6, 0xd0, 0xc2, 0xbc, 0xae, 0x98, 0x8a,
+    0x56, 0x44, 0x72, 0x60, 0x1e, 0x0c, 0x3a, 0x28,
+    0xc6, 0xd4, 0xe2, 0xf0, 0x8e, 0x9c, 0xaa, 0xb8,
+    0xc8, 0xda, 0xec, 0xfe, 0x80, 0x92, 0xa4, 0xb6,
+    0x58, 0x4a, 0x7c, 0x6e, 0x10, 0x02, 0x34, 0x26,
+    0xfa, 0xe8, 0xde, 0xcc, 0xb2, 0xa0, 0x96, 0x84,
+    0x6a, 0x78, 0x4e, 0x5c, 0x22, 0x30, 0x06, 0x14,
+    0xac, 0xbe, 0x88, 0x9a, 0xe4, 0xf6, 0xc0, 0xd2,
+    0x3c, 0x2e, 0x18, 0x0a, 0x74, 0x66, 0x50, 0x42,
+    0x9e, 0x8c, 0xba, 0xa8, 0xd6, 0xc4, 0xf2, 0xe0,
+    0x0e, 0x1c, 0x2a, 0x38, 0x46, 0x54, 0x62, 0x70,
+    0x82, 0x90, 0xa6, 0xb4, 0xca, 0xd8, 0xee, 0xfc,
+    0x12, 0x00, 0x36, 0x24, 0x5a, 0x48, 0x7e, 0x6c,
+    0xb0, 0xa2, 0x94, 0x86, 0xf8, 0xea, 0xdc, 0xce,
+    0x20, 0x32, 0x04, 0x16, 0x68, 0x7a, 0x4c, 0x5e,
+    0xe6, 0xf4, 0xc2, 0xd0, 0xae, 0xbc, 0x8a, 0x98,
+    0x76, 0x64, 0x52, 0x40, 0x3e, 0x2c, 0x1a, 0x08,
+    0xd4, 0xc6, 0xf0, 0xe2, 0x9c, 0x8e, 0xb8, 0xaa,
+    0x44, 0x56, 0x60, 0x72, 0x0c, 0x1e, 0x28, 0x3a,
+    0x4a, 0x58, 0x6e, 0x7c, 0x02, 0x10, 0x26, 0x34,
+    0xda, 0xc8, 0xfe, 0xec, 0x92, 0x80, 0xb6, 0xa4,
+    0x78, 0x6a, 0x5c, 0x4e, 0x30, 0x22, 0x14, 0x06,
+    0xe8, 0xfa, 0xcc, 0xde, 0xa0, 0xb2, 0x84, 0x96,
+    0x2e, 0x3c, 0x0a, 0x18, 0x66, 0x74, 0x42, 0x50,
+    0xbe, 0xac, 0x9a, 0x88, 0xf6, 0xe4, 0xd2, 0xc0,
+    0x1c, 0x0e, 0x38, 0x2a, 0x54, 0x46, 0x70, 0x62,
+    0x8c, 0x9e, 0xa8, 0xba, 0xc4, 0xd6, 0xe0, 0xf2,
+};
+
 static char _crc_7(const char *data, int n)
 {
-    char crc = 0;
+    uint8_t crc = 0;
 
     for (int i = 0; i < n; i++) {
-        char d = data[i];
-        for (int j = 0; j < 8; j++) {
-            crc <<= 1;
-            if ((d & 0x80) ^ (crc & 0x80)) {
-                crc ^= 0x09;
-            }
-            d <<= 1;
-        }
+        crc = _crc_7_table[crc ^ (uint8_t)data[i]];
     }
-    return (crc << 1) | 1;
+    return crc | 1;
 }
 
 static uint16_t _crc_16(const char *data, size_t n)
 {
-    uint16_t crc = 0;
-
-    for (size_t i = 0; i < n; i++) {
-        crc = (uint8_t)(crc >> 8) | (crc << 8);
-        crc ^= data[i];
-        crc ^= (uint8_t)(crc & 0xFF) >> 4;
-        crc ^= crc << 12;
-        crc ^= (crc & 0xFF) << 5;
-    }
-    return crc;
+    return crc16_ccitt_update(0, (const unsigned char *)data, n);
 }
 
 char sdcard_spi_send_cmd(sdcard_spi_t *card, char sd_cmd_idx, uint32_t argument, int32_t max_retry)
@@ -457,7 +479,7 @@ char sdcard_spi_send_cmd(sdcard_spi_t *card, char sd_cmd_idx, uint32_t argument,
         }
 
         DEBUG("CMD%02d echo: ", sd_cmd_idx);
-        for (int i = 0; i < sizeof(echo); i++) {
+        for (unsigned i = 0; i < sizeof(echo); i++) {
             DEBUG("0x%02X ", echo[i]);
         }
         DEBUG("\n");
@@ -695,6 +717,8 @@ static inline int _read_blocks(sdcard_spi_t *card, int cmd_idx, int bladdr, char
 int sdcard_spi_read_blocks(sdcard_spi_t *card, int blockaddr, char *data, int blocksize,
                            int nblocks, sd_rw_response_t *state)
 {
+    sdcard_spi_stream_stop(card);
+
     if (nblocks > 1) {
         return _read_blocks(card, SD_CMD_18, blockaddr, data, blocksize, nblocks, state);
     }
@@ -705,55 +729,50 @@ int sdcard_spi_read_blocks(sdcard_spi_t *card, int blockaddr, char *data, int bl
 
 static sd_rw_response_t _write_data_packet(sdcard_spi_t *card, char token, const char *data, int size)
 {
+    uint16_t data__crc_16 = _crc_16(data, size);
+    char crc[sizeof(uint16_t)] = { data__crc_16 >> 8, data__crc_16 & 0xFF };
 
     spi_transfer_byte(card->params.spi_dev, GPIO_UNDEF, true, token);
 
-    if (_transfer_bytes(card, data, 0, size) == size) {
+    /* the payload is passed to the SPI driver in one go, so it can use DMA */
+    spi_transfer_bytes(card->params.spi_dev, GPIO_UNDEF, true, data, NULL, size);
 
-        uint16_t data__crc_16 = _crc_16(data, size);
-        char crc[sizeof(uint16_t)] = { data__crc_16 >> 8, data__crc_16 & 0xFF };
+    if (_transfer_bytes(card, crc, 0, sizeof(crc)) == sizeof(crc)) {
 
-        if (_transfer_bytes(card, crc, 0, sizeof(crc)) == sizeof(crc)) {
+        char data_response;
 
-            char data_response;
+        data_response = (char)spi_transfer_byte(card->params.spi_dev, GPIO_UNDEF,
+                                                true, SD_CARD_DUMMY_BYTE);
 
-            data_response = (char)spi_transfer_byte(card->params.spi_dev, GPIO_UNDEF,
-                                                    true, SD_CARD_DUMMY_BYTE);
+        DEBUG("_write_data_packet: DATA_RESPONSE: 0x%02x\n", data_response);
 
-            DEBUG("_write_data_packet: DATA_RESPONSE: 0x%02x\n", data_response);
+        if (DATA_RESPONSE_IS_VALID(data_response)) {
 
-            if (DATA_RESPONSE_IS_VALID(data_response)) {
+            if (DATA_RESPONSE_ACCEPTED(data_response)) {
+                DEBUG("_write_data_packet: DATA_RESPONSE: [OK]\n");
+                return SD_RW_OK;
+            }
+            else {
 
-                if (DATA_RESPONSE_ACCEPTED(data_response)) {
-                    DEBUG("_write_data_packet: DATA_RESPONSE: [OK]\n");
-                    return SD_RW_OK;
+                if (DATA_RESPONSE_WRITE_ERR(data_response)) {
+                    DEBUG("_write_data_packet: DATA_RESPONSE: [WRITE_ERROR]\n");
                 }
-                else {
-
-                    if (DATA_RESPONSE_WRITE_ERR(data_response)) {
-                        DEBUG("_write_data_packet: DATA_RESPONSE: [WRITE_ERROR]\n");
-                    }
 
-                    if (DATA_RESPONSE_CRC_ERR(data_response)) {
-                        DEBUG("_write_data_packet: DATA_RESPONSE: [CRC_ERROR]\n");
-                    }
-                    return SD_RW_WRITE_ERROR;
+                if (DATA_RESPONSE_CRC_ERR(data_response)) {
+                    DEBUG("_write_data_packet: DATA_RESPONSE: [CRC_ERROR]\n");
                 }
-
-            }
-            else {
-                DEBUG("_write_data_packet: DATA_RESPONSE invalid\n");
-                return SD_RW_RX_TX_ERROR;
+                return SD_RW_WRITE_ERROR;
             }
 
         }
         else {
-            DEBUG("_write_data_packet: [RX_TX_ERROR] (while transmitting CRC16)\n");
+            DEBUG("_write_data_packet: DATA_RESPONSE invalid\n");
             return SD_RW_RX_TX_ERROR;
         }
+
     }
     else {
-        DEBUG("_write_data_packet: [RX_TX_ERROR] (while transmitting payload)\n");
+        DEBUG("_write_data_packet: [RX_TX_ERROR] (while transmitting CRC16)\n");
         return SD_RW_RX_TX_ERROR;
     }
 }
@@ -826,6 +845,8 @@ static inline int _write_blocks(sdcard_spi_t *card, char cmd_idx, int bladdr, co
 int sdcard_spi_write_blocks(sdcard_spi_t *card, int blockaddr, const char *data, int blocksize,
                             int nblocks, sd_rw_response_t *state)
 {
+    sdcard_spi_stream_stop(card);
+
     if (nblocks > 1) {
         return _write_blocks(card, SD_CMD_25, blockaddr, data, blocksize, nblocks, state);
     }
@@ -834,6 +855,162 @@ int sdcard_spi_write_blocks(sdcard_spi_t *card, int blockaddr, const char *data,
     }
 }
 
+sd_rw_response_t sdcard_spi_write_stream_start(sdcard_spi_t *card, int blockaddr, int nblocks)
+{
+    sdcard_spi_stream_stop(card);
+
+    _select_card_spi(card);
+
+    if (nblocks > 0) {
+        uint32_t count = (nblocks > SD_ACMD_23_ARG_MAX) ? SD_ACMD_23_ARG_MAX : nblocks;
+        char r1 = sdcard_spi_send_acmd(card, SD_CMD_23, count, 0);
+
+        /* the hint is optional, e.g. MMC cards don't know ACMD23 */
+        if (!R1_VALID(r1) || R1_ERROR(r1)) {
+            DEBUG("sdcard_spi_write_stream_start: ACMD23: [IGNORED]\n");
+        }
+    }
+
+    uint32_t addr = card->use_block_addr ? blockaddr : (blockaddr * SD_HC_BLOCK_SIZE);
+    char r1 = sdcard_spi_send_cmd(card, SD_CMD_25, addr, SD_BLOCK_WRITE_CMD_RETRIES);
+
+    _unselect_card_spi(card);
+
+    if (!R1_VALID(r1) || R1_ERROR(r1)) {
+        DEBUG("sdcard_spi_write_stream_start: send CMD25: [RX_TX_ERROR]\n");
+        return SD_RW_RX_TX_ERROR;
+    }
+
+    card->stream = SD_STREAM_WRITE;
+    card->stream_next = blockaddr;
+    return SD_RW_OK;
+}
+
+int sdcard_spi_write_stream(sdcard_spi_t *card, const char *data, int blocksize,
+                            int nblocks, sd_rw_response_t *state)
+{
+    int written = 0;
+
+    if (card->stream != SD_STREAM_WRITE) {
+        *state = SD_RW_NOT_SUPPORTED;
+        return 0;
+    }
+
+    _select_card_spi(card);
+
+    *state = SD_RW_OK;
+    for (int i = 0; i < nblocks; i++) {
+        /* the card may still program the previous block */
+        if (!_wait_for_not_busy(card, SD_WAIT_FOR_NOT_BUSY_CNT)) {
+            DEBUG("sdcard_spi_write_stream: _wait_for_not_busy: [FAILED]\n");
+            *state = SD_RW_TIMEOUT;
+            break;
+        }
+        *state = _write_data_packet(card, SD_DATA_TOKEN_CMD_25, &(data[i * blocksize]), blocksize);
+        if (*state != SD_RW_OK) {
+            DEBUG("sdcard_spi_write_stream: _write_data_packet: [FAILED]\n");
+            break;
+        }
+        written++;
+    }
+
+    _unselect_card_spi(card);
+    card->stream_next += written;
+
+    if (*state != SD_RW_OK) {
+        sdcard_spi_stream_stop(card);
+    }
+    return written;
+}
+
+sd_rw_response_t sdcard_spi_read_stream_start(sdcard_spi_t *card, int blockaddr)
+{
+    sdcard_spi_stream_stop(card);
+
+    _select_card_spi(card);
+
+    uint32_t addr = card->use_block_addr ? blockaddr : (blockaddr * SD_HC_BLOCK_SIZE);
+    char r1 = sdcard_spi_send_cmd(card, SD_CMD_18, addr, SD_BLOCK_READ_CMD_RETRIES);
+
+    _unselect_card_spi(card);
+
+    if (!R1_VALID(r1) || R1_ERROR(r1)) {
+        DEBUG("sdcard_spi_read_stream_start: send CMD18: [RX_TX_ERROR]\n");
+        return SD_RW_RX_TX_ERROR;
+    }
+
+    card->stream = SD_STREAM_READ;
+    card->stream_next = blockaddr;
+    return SD_RW_OK;
+}
+
+int sdcard_spi_read_stream(sdcard_spi_t *card, char *data, int blocksize,
+                           int nblocks, sd_rw_response_t *state)
+{
+    int reads = 0;
+
+    if (card->stream != SD_STREAM_READ) {
+        *state = SD_RW_NOT_SUPPORTED;
+        return 0;
+    }
+
+    _select_card_spi(card);
+
+    *state = SD_RW_OK;
+    for (int i = 0; i < nblocks; i++) {
+        *state = _read_data_packet(card, SD_DATA_TOKEN_CMD_17_18_24, &(data[i * blocksize]),
+                                   blocksize);
+        if (*state != SD_RW_OK) {
+            DEBUG("sdcard_spi_read_stream: _read_data_packet: [FAILED]\n");
+            break;
+        }
+        reads++;
+    }
+
+    _unselect_card_spi(card);
+    card->stream_next += reads;
+
+    if (*state != SD_RW_OK) {
+        sdcard_spi_stream_stop(card);
+    }
+    return reads;
+}
+
+sd_rw_response_t sdcard_spi_stream_stop(sdcard_spi_t *card)
+{
+    sd_rw_response_t res = SD_RW_OK;
+
+    if (card->stream == SD_STREAM_NONE) {
+        return SD_RW_OK;
+    }
+
+    _select_card_spi(card);
+
+    if (card->stream == SD_STREAM_WRITE) {
+        if (_wait_for_not_busy(card, SD_WAIT_FOR_NOT_BUSY_CNT)) {
+            spi_transfer_byte(card->params.spi_dev, GPIO_UNDEF, true,
+                              SD_DATA_TOKEN_CMD_25_STOP);
+            _send_dummy_byte(card); //sd card needs dummy byte before we can wait for not-busy state
+        }
+        if (!_wait_for_not_busy(card, SD_WAIT_FOR_NOT_BUSY_CNT)) {
+            DEBUG("sdcard_spi_stream_stop: _wait_for_not_busy: [FAILED]\n");
+            res = SD_RW_TIMEOUT;
+        }
+    }
+    else {
+        char r1 = sdcard_spi_send_cmd(card, SD_CMD_12, 0, 1);
+
+        if (!R1_VALID(r1) || R1_ERROR(r1)) {
+            DEBUG("sdcard_spi_stream_stop: send CMD12: [RX_TX_ERROR]\n");
+            res = SD_RW_RX_TX_ERROR;
+        }
+    }
+
+    _unselect_card_spi(card);
+    card->stream = SD_STREAM_NONE;
+    return res;
+}
+
 sd_rw_response_t _read_cid(sdcard_spi_t *card)
 {
     char cid_raw_data[SD_SIZE_OF_CID_AND_CSD_REG];
@@ -843,7 +1020,7 @@ sd_rw_response_t _read_cid(sdcard_spi_t *card)
 
     DEBUG("_read_cid: _read_blocks: nbl=%d state=%d\n", nbl, state);
     DEBUG("_read_cid: cid_raw_data: ");
-    for (int i = 0; i < sizeof(cid_raw_data); i++) {
+    for (unsigned i = 0; i < sizeof(cid_raw_data); i++) {
         DEBUG("0x%02X ", cid_raw_data[i]);
     }
     DEBUG("\n");
@@ -879,7 +1056,7 @@ sd_rw_response_t _read_csd(sdcard_spi_t *card)
 
     DEBUG("_read_csd: _read_blocks: read_resu=%d state=%d\n", read_resu, state);
     DEBUG("_read_csd: raw data: ");
-    for (int i = 0; i < sizeof(c); i++) {
+    for (unsigned i = 0; i < sizeof(c); i++) {
         DEBUG("0x%02X ", c[i]);
     }
     DEBUG("\n");
@@ -961,6 +1138,7 @@ sd_rw_response_t _read_csd(sdcard_spi_t *card)
 }
 
 sd_rw_response_t sdcard_spi_read_sds(sdcard_spi_t *card, sd_status_t *sd_status){
+    sdcard_spi_stream_stop(card);
     _select_card_spi(card);
     char sds_raw_data[SD_SIZE_OF_SD_STATUS];
     char r1_resu = sdcard_spi_send_cmd(card, SD_CMD_55, SD_CMD_NO_ARG, 0);
@@ -974,7 +1152,7 @@ sd_rw_response_t sdcard_spi_read_sds(sdcard_spi_t *card, sd_status_t *sd_status)
 
             DEBUG("sdcard_spi_read_sds: _read_blocks: nbl=%d state=%d\n", nbl, state);
             DEBUG("sdcard_spi_read_sds: sds_raw_data: ");
-            for (int i = 0; i < sizeof(sds_raw_data); i++) {
+            for (unsigned i = 0; i < sizeof(sds_raw_data); i++) {
                 DEBUG("0x%02X ", sds_raw_data[i]);
             }
             DEBUG("\n");
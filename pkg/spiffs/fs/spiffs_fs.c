@@ -276,6 +276,22 @@ static ssize_t _write(vfs_file_t *filp, const void *src, size_t nbytes)
     return spiffs_err_to_errno(SPIFFS_write(&fs_desc->fs, filp->private_data.value, src, nbytes));
 }
 
+static int _fsync(vfs_file_t *filp)
+{
+    spiffs_desc_t *fs_desc = filp->mp->private_data;
+#if SPIFFS_HAL_CALLBACK_EXTRA == 1
+    mtd_dev_t *dev = fs_desc->dev;
+#else
+    mtd_dev_t *dev = SPIFFS_MTD_DEV;
+#endif
+    int res = spiffs_err_to_errno(SPIFFS_fflush(&fs_desc->fs, filp->private_data.value));
+
+    if (res < 0) {
+        return res;
+    }
+    return mtd_flush(dev);
+}
+
 static ssize_t _read(vfs_file_t *filp, void *dest, size_t nbytes)
 {
     spiffs_desc_t *fs_desc = filp->mp->private_data;
@@ -474,6 +490,7 @@ static const vfs_file_ops_t spiffs_file_ops = {
     .write = _write,
     .lseek = _lseek,
     .fstat = _fstat,
+    .fsync = _fsync,
 };
 
 static const vfs_dir_ops_t spiffs_dir_ops = {
@@ -19,6 +19,7 @@
  */
 
 #include <errno.h>
+#include <stdbool.h>
 
 #include "thread.h"
 #include "can/device.h"
@@ -37,6 +38,10 @@
 #define CAN_DEVICE_MSG_QUEUE_SIZE 64
 #endif
 
+#ifndef CAN_DEVICE_TX_BATCH_SIZE
+#define CAN_DEVICE_TX_BATCH_SIZE 8
+#endif
+
 #ifdef MODULE_CAN_PM
 #define CAN_DEVICE_PM_DEFAULT_RX_TIMEOUT (10 * US_PER_SEC)
 #define CAN_DEVICE_PM_DEFAULT_TX_TIMEOUT (2 * US_PER_SEC)
@@ -54,6 +59,7 @@ static void _can_event(candev_t *dev, candev_event_t event, void *arg)
     msg_t msg;
     struct can_frame *frame;
     can_pkt_t *pkt;
+    candev_rx_batch_t *batch;
     candev_dev_t *candev_dev = dev->isr_arg;
 
     DEBUG("_can_event: dev=%p, params=%p\n", (void*)dev, (void*)candev_dev);
@@ -96,6 +102,15 @@ static void _can_event(candev_t *dev, candev_event_t event, void *arg)
         frame = (struct can_frame *) arg;
         can_dll_dispatch_rx_frame(frame, candev_dev->pid);
         break;
+    case CANDEV_EVENT_RX_BATCH:
+        DEBUG("_can_event: CANDEV_EVENT_RX_BATCH\n");
+#ifdef MODULE_CAN_PM
+        pm_reset(candev_dev, candev_dev->rx_inactivity_timeout);
+#endif
+        /* received frames in arg */
+        batch = (candev_rx_batch_t *) arg;
+        can_dll_dispatch_rx_frames(batch->frames, batch->numof, candev_dev->pid);
+        break;
     case CANDEV_EVENT_RX_ERROR:
         DEBUG("_can_event: CANDEV_EVENT_RX_ERROR\n");
         break;
@@ -197,6 +212,31 @@ static void wake_up(candev_dev_t *candev_dev)
 #endif
 }
 
+/* Sends pkt together with the frames queued right behind it in one driver
+ * call. Returns true if a message of another type was dequeued, it is left in
+ * msg to be handled next. */
+static bool send_batch(candev_t *dev, can_pkt_t *pkt, msg_t *msg)
+{
+    const struct can_frame *frames[CAN_DEVICE_TX_BATCH_SIZE];
+    size_t numof = 0;
+    bool pending = false;
+
+    frames[numof++] = &pkt->frame;
+    while ((numof < CAN_DEVICE_TX_BATCH_SIZE) && (msg_try_receive(msg) == 1)) {
+        if (msg->type != CAN_MSG_SEND_FRAME) {
+            pending = true;
+            break;
+        }
+        pkt = (can_pkt_t *) msg->content.ptr;
+        frames[numof++] = &pkt->frame;
+    }
+
+    DEBUG("can device: sending %u frames\n", (unsigned)numof);
+    dev->driver->send_batch(dev, frames, numof);
+
+    return pending;
+}
+
 static void *_can_device_thread(void *args)
 {
     candev_dev_t *candev_dev = (candev_dev_t *) args;
@@ -227,6 +267,7 @@ static void *_can_device_thread(void *args)
     can_pkt_t *pkt;
     can_opt_t *opt;
     msg_t msg, reply, msg_queue[CAN_DEVICE_MSG_QUEUE_SIZE];
+    bool pending = false;
 
     /* setup the device layers message queue */
     msg_init_queue(msg_queue, CAN_DEVICE_MSG_QUEUE_SIZE);
@@ -240,7 +281,10 @@ static void *_can_device_thread(void *args)
     power_up(candev_dev);
 
     while (1) {
-        msg_receive(&msg);
+        if (!pending) {
+            msg_receive(&msg);
+        }
+        pending = false;
         switch (msg.type) {
         case CAN_MSG_EVENT:
             DEBUG("can device: CAN_MSG_EVENT received\n");
@@ -259,7 +303,12 @@ static void *_can_device_thread(void *args)
             wake_up(candev_dev);
             /* read incoming pkt */
             pkt = (can_pkt_t *) msg.content.ptr;
-            dev->driver->send(dev, &pkt->frame);
+            if (dev->driver->send_batch) {
+                pending = send_batch(dev, pkt, &msg);
+            }
+            else {
+                dev->driver->send(dev, &pkt->frame);
+            }
             break;
         case CAN_MSG_SET:
             DEBUG("can device: CAN_MSG_SET received\n");
@@ -333,6 +333,22 @@ int can_dll_dispatch_rx_frame(struct can_frame *frame, kernel_pid_t pid)
     return can_router_dispatch_rx_indic(pkt);
 }
 
+int can_dll_dispatch_rx_frames(struct can_frame *frames, size_t numof, kernel_pid_t pid)
+{
+    int ifnum = _get_ifnum(pid);
+    int res = 0;
+
+    DEBUG("can_dll_dispatch_rx_frames: ifnum=%d, numof=%u\n", ifnum, (unsigned)numof);
+
+    for (size_t i = 0; i < numof; i++) {
+        if (can_router_dispatch_rx_indic(can_pkt_alloc_rx(ifnum, &frames[i])) < 0) {
+            res = -ENOMEM;
+        }
+    }
+
+    return res;
+}
+
 int can_dll_dispatch_tx_conf(can_pkt_t *pkt)
 {
     DEBUG("can_dll_dispatch_tx_conf: pkt=0x%p\n", (void*)pkt);
@@ -103,6 +103,8 @@ static mutex_t lock = MUTEX_INIT;
 static void _rx_timeout(void *arg);
 static int _isotp_send_fc(struct isotp *isotp, int ae, uint8_t status);
 static int _isotp_tx_send(struct isotp *isotp, struct can_frame *frame);
+static void _isotp_tx_pump(struct isotp *isotp);
+static void _isotp_fill_dataframe(struct isotp *isotp, struct can_frame *frame, int ae);
 
 static int _send_msg(msg_t *msg, can_reg_entry_t *entry)
 {
@@ -121,6 +123,72 @@ static int _send_msg(msg_t *msg, can_reg_entry_t *entry)
 #endif
 }
 
+static int _isotp_rx_alloc(struct isotp *isotp, size_t len)
+{
+    size_t space = 0;
+
+    if (isotp->rx_iov) {
+        for (unsigned i = 0; i < isotp->rx_iovcnt; i++) {
+            space += isotp->rx_iov[i].iov_len;
+        }
+        if (len > space) {
+            return -ENOMEM;
+        }
+        isotp->rx_len = len;
+    }
+    else {
+        isotp->rx.snip = gnrc_pktbuf_add(NULL, NULL, len, GNRC_NETTYPE_UNDEF);
+        if (!isotp->rx.snip) {
+            return -ENOMEM;
+        }
+    }
+    isotp->rx.idx = 0;
+
+    return 0;
+}
+
+static void _isotp_rx_release(struct isotp *isotp)
+{
+    if (isotp->rx.snip) {
+        gnrc_pktbuf_release(isotp->rx.snip);
+        isotp->rx.snip = NULL;
+    }
+}
+
+static size_t _isotp_rx_size(struct isotp *isotp)
+{
+    return (isotp->rx_iov) ? isotp->rx_len : isotp->rx.snip->size;
+}
+
+/* appends at most the missing part of the message */
+static void _isotp_rx_copy(struct isotp *isotp, const uint8_t *data, size_t len)
+{
+    size_t off = isotp->rx.idx;
+
+    len = MIN(len, _isotp_rx_size(isotp) - isotp->rx.idx);
+    if (!isotp->rx_iov) {
+        memcpy((uint8_t *)isotp->rx.snip->data + off, data, len);
+        isotp->rx.idx += len;
+        return;
+    }
+
+    for (unsigned i = 0; (i < isotp->rx_iovcnt) && (len > 0); i++) {
+        const struct iovec *iov = &isotp->rx_iov[i];
+        size_t num_bytes;
+
+        if (off >= iov->iov_len) {
+            off -= iov->iov_len;
+            continue;
+        }
+        num_bytes = MIN(len, iov->iov_len - off);
+        memcpy((uint8_t *)iov->iov_base + off, data, num_bytes);
+        data += num_bytes;
+        len -= num_bytes;
+        isotp->rx.idx += num_bytes;
+        off = 0;
+    }
+}
+
 static int _isotp_dispatch_rx(struct isotp *isotp)
 {
     msg_t msg;
@@ -128,18 +196,24 @@ static int _isotp_dispatch_rx(struct isotp *isotp)
     can_rx_data_t *data;
 
     msg.type = CAN_MSG_RX_INDICATION;
-    data = can_pkt_alloc_rx_data(isotp->rx.snip,
-                                 isotp->rx.snip->size + sizeof(*isotp->rx.snip),
-                                 isotp->arg);
+    if (isotp->rx_iov) {
+        data = can_pkt_alloc_rx_data(NULL, isotp->rx_len, isotp->arg);
+    }
+    else {
+        data = can_pkt_alloc_rx_data(isotp->rx.snip,
+                                     isotp->rx.snip->size + sizeof(*isotp->rx.snip),
+                                     isotp->arg);
+    }
 
     if (!data) {
+        _isotp_rx_release(isotp);
         return -ENOMEM;
     }
 
     msg.content.ptr = data;
     if (_send_msg(&msg, &isotp->entry) < 1) {
         DEBUG("_isotp_dispatch_rx: msg lost, freeing rx buf\n");
-        gnrc_pktbuf_release(((gnrc_pktsnip_t *)data->data.iov_base));
+        _isotp_rx_release(isotp);
         can_pkt_free_rx_data(data);
         ret = -EOVERFLOW;
     }
@@ -241,6 +315,12 @@ static int _isotp_rcv_fc(struct isotp *isotp, struct can_frame *frame, int ae)
         isotp->tx_wft = 0;
         isotp->tx.bs = 0;
         isotp->tx.state = ISOTP_SENDING_NEXT_CF;
+        if (isotp->opt.flags & CAN_ISOTP_HIGH_THROUGHPUT) {
+            /* STmin only separates the CFs, the first one can go right away */
+            isotp->tx_last = xtimer_now_usec() - isotp->tx_gap;
+            _isotp_tx_pump(isotp);
+            break;
+        }
         xtimer_set(&isotp->tx_timer, isotp->tx_gap);
         break;
 
@@ -276,16 +356,11 @@ static int _isotp_rcv_sf(struct isotp *isotp, struct can_frame *frame, int ae)
         return 1;
     }
 
-    gnrc_pktsnip_t *snip = gnrc_pktbuf_add(NULL, NULL, len, GNRC_NETTYPE_UNDEF);
-    if (!snip) {
+    _isotp_rx_release(isotp);
+    if (_isotp_rx_alloc(isotp, len) < 0) {
         return 1;
     }
-    isotp->rx.snip = snip;
-
-    isotp->rx.idx = 0;
-    for (size_t i = SF_PCI_SZ + ae; i < isotp->rx.snip->size + ae + SF_PCI_SZ; i++) {
-        ((uint8_t *)isotp->rx.snip->data)[isotp->rx.idx++] = frame->data[i];
-    }
+    _isotp_rx_copy(isotp, &frame->data[SF_PCI_SZ + ae], len);
 
     return _isotp_dispatch_rx(isotp);
 }
@@ -299,7 +374,7 @@ static int _isotp_rcv_ff(struct isotp *isotp, struct can_frame *frame, int ae)
 
     if (isotp->rx.snip) {
         DEBUG("_isotp_rcv_ff: freeing previous rx buf\n");
-        gnrc_pktbuf_release(isotp->rx.snip);
+        _isotp_rx_release(isotp);
     }
 
     if (len > MAX_MSG_LENGTH) {
@@ -309,27 +384,18 @@ static int _isotp_rcv_ff(struct isotp *isotp, struct can_frame *frame, int ae)
         return 1;
     }
 
-    gnrc_pktsnip_t *snip = gnrc_pktbuf_add(NULL, NULL, len, GNRC_NETTYPE_UNDEF);
-    if (!snip) {
+    if (_isotp_rx_alloc(isotp, len) < 0) {
         if (!(isotp->opt.flags & CAN_ISOTP_LISTEN_MODE)) {
             _isotp_send_fc(isotp, ae, ISOTP_FC_OVFLW);
         }
         return 1;
     }
-    isotp->rx.snip = snip;
-
-    isotp->rx.idx = 0;
-    for (int i = ae + FF_PCI_SZ; i < frame->can_dlc; i++) {
-        ((uint8_t *)isotp->rx.snip->data)[isotp->rx.idx++] = frame->data[i];
+    if (frame->can_dlc > ae + FF_PCI_SZ) {
+        _isotp_rx_copy(isotp, &frame->data[ae + FF_PCI_SZ],
+                       frame->can_dlc - (ae + FF_PCI_SZ));
     }
 
-#if ENABLE_DEBUG
-    DEBUG("_isotp_rcv_ff: rx.buf=");
-    for (unsigned i = 0; i < isotp->rx.idx; i++) {
-        DEBUG("%02hhx", ((uint8_t *)isotp->rx.snip->data)[i]);
-    }
-    DEBUG("\n");
-#endif
+    DEBUG("_isotp_rcv_ff: len=%d, rx.idx=%u\n", len, isotp->rx.idx);
 
     isotp->rx.sn = 1;
 
@@ -357,29 +423,20 @@ static int _isotp_rcv_cf(struct isotp *isotp, struct can_frame *frame, int ae)
     if ((frame->data[ae] & 0x0F) != isotp->rx.sn) {
         DEBUG("_isotp_rcv_cf: wrong seq number %d, expected %d\n", frame->data[ae] & 0x0F, isotp->rx.sn);
         isotp->rx.state = ISOTP_IDLE;
-        gnrc_pktbuf_release(isotp->rx.snip);
-        isotp->rx.snip = NULL;
+        _isotp_rx_release(isotp);
         return 1;
     }
     isotp->rx.sn++;
     isotp->rx.sn %= 16;
 
-    for (int i = ae + N_PCI_SZ; i < frame->can_dlc; i++) {
-        ((uint8_t *)isotp->rx.snip->data)[isotp->rx.idx++] = frame->data[i];
-        if (isotp->rx.idx >= isotp->rx.snip->size) {
-            break;
-        }
+    if (frame->can_dlc > ae + N_PCI_SZ) {
+        _isotp_rx_copy(isotp, &frame->data[ae + N_PCI_SZ],
+                       frame->can_dlc - (ae + N_PCI_SZ));
     }
 
-#if ENABLE_DEBUG
-    DEBUG("_isotp_rcv_cf: rx.buf=");
-    for (unsigned i = 0; i < isotp->rx.idx; i++) {
-        DEBUG("%02hhx", ((uint8_t *)isotp->rx.snip->data)[i]);
-    }
-    DEBUG("\n");
-#endif
+    DEBUG("_isotp_rcv_cf: rx.idx=%u\n", isotp->rx.idx);
 
-    if (isotp->rx.idx >= isotp->rx.snip->size) {
+    if (isotp->rx.idx >= _isotp_rx_size(isotp)) {
         isotp->rx.state = ISOTP_IDLE;
         return _isotp_dispatch_rx(isotp);
     }
@@ -528,6 +585,104 @@ static void _isotp_fill_dataframe(struct isotp *isotp, struct can_frame *frame,
 
 }
 
+static void _isotp_tx_abort_inflight(struct isotp *isotp)
+{
+    while (isotp->tx_inflight) {
+        raw_can_abort(isotp->entry.ifnum, isotp->tx_handles[isotp->tx_head]);
+        isotp->tx_head = (isotp->tx_head + 1) % CAN_ISOTP_TX_WINDOW;
+        isotp->tx_inflight--;
+    }
+    isotp->tx.tx_handle = 0;
+}
+
+static void _isotp_tx_pump(struct isotp *isotp)
+{
+    int ae = (isotp->opt.flags & CAN_ISOTP_EXTEND_ADDR) ? 1 : 0;
+    struct can_frame frame;
+
+    while ((isotp->tx.idx < isotp->tx.snip->size) &&
+           (isotp->tx_inflight < CAN_ISOTP_TX_WINDOW) &&
+           (!isotp->txfc.bs || (isotp->tx.bs < isotp->txfc.bs))) {
+        int handle;
+
+        if (isotp->tx_gap) {
+            uint32_t elapsed = xtimer_now_usec() - isotp->tx_last;
+
+            if (elapsed < isotp->tx_gap) {
+                /* the timer now paces instead of supervising the frames in
+                 * flight, they are checked again on their confirmation */
+                isotp->tx.state = ISOTP_SENDING_NEXT_CF;
+                xtimer_set(&isotp->tx_timer, isotp->tx_gap - elapsed);
+                return;
+            }
+        }
+
+        _isotp_fill_dataframe(isotp, &frame, ae);
+        frame.data[ae] = N_PCI_CF | isotp->tx.sn++;
+        isotp->tx.sn %= 16;
+        isotp->tx.bs++;
+
+        handle = raw_can_send(isotp->entry.ifnum, &frame, isotp_pid);
+        DEBUG("_isotp_tx_pump: CF sent handle=%d, inflight=%u\n", handle,
+              isotp->tx_inflight);
+        if (handle < 0) {
+            xtimer_remove(&isotp->tx_timer);
+            _isotp_tx_abort_inflight(isotp);
+            isotp->tx.state = ISOTP_IDLE;
+            _isotp_dispatch_tx(isotp, handle);
+            return;
+        }
+        isotp->tx_last = xtimer_now_usec();
+        isotp->tx_handles[(isotp->tx_head + isotp->tx_inflight) % CAN_ISOTP_TX_WINDOW] = handle;
+        isotp->tx_inflight++;
+    }
+
+    isotp->tx.state = ISOTP_SENDING_CF;
+    xtimer_set(&isotp->tx_timer, CAN_ISOTP_TIMEOUT_N_As);
+}
+
+/* returns the position of handle in tx_handles, -1 if it is not in flight */
+static int _isotp_tx_inflight_find(struct isotp *isotp, int handle)
+{
+    for (unsigned i = 0; i < isotp->tx_inflight; i++) {
+        unsigned pos = (isotp->tx_head + i) % CAN_ISOTP_TX_WINDOW;
+
+        if (isotp->tx_handles[pos] == handle) {
+            return pos;
+        }
+    }
+    return -1;
+}
+
+static void _isotp_tx_pump_conf(struct isotp *isotp, unsigned pos)
+{
+    xtimer_remove(&isotp->tx_timer);
+    /* frames may be confirmed in any order, the oldest frame takes the slot
+     * of the confirmed one */
+    isotp->tx_handles[pos] = isotp->tx_handles[isotp->tx_head];
+    isotp->tx_head = (isotp->tx_head + 1) % CAN_ISOTP_TX_WINDOW;
+    isotp->tx_inflight--;
+
+    DEBUG("_isotp_tx_pump_conf: inflight=%u\n", isotp->tx_inflight);
+
+    if (!isotp->tx_inflight) {
+        if (isotp->tx.idx >= isotp->tx.snip->size) {
+            /* Finished */
+            isotp->tx.state = ISOTP_IDLE;
+            _isotp_dispatch_tx(isotp, 0);
+            return;
+        }
+        if (isotp->txfc.bs && (isotp->tx.bs >= isotp->txfc.bs)) {
+            /* wait for FC */
+            isotp->tx.state = ISOTP_WAIT_FC;
+            xtimer_set(&isotp->tx_timer, CAN_ISOTP_TIMEOUT_N_Bs);
+            return;
+        }
+    }
+
+    _isotp_tx_pump(isotp);
+}
+
 static void _isotp_tx_timeout_task(struct isotp *isotp)
 {
     int ae = (isotp->opt.flags & CAN_ISOTP_EXTEND_ADDR) ? 1 : 0;
@@ -544,6 +699,10 @@ static void _isotp_tx_timeout_task(struct isotp *isotp)
 
     case ISOTP_SENDING_NEXT_CF:
         DEBUG("_isotp_tx_timeout_task: sending next CF\n");
+        if (isotp->opt.flags & CAN_ISOTP_HIGH_THROUGHPUT) {
+            _isotp_tx_pump(isotp);
+            break;
+        }
         _isotp_fill_dataframe(isotp, &frame, ae);
         frame.data[ae] = N_PCI_CF | isotp->tx.sn++;
         isotp->tx.sn %= 16;
@@ -558,7 +717,12 @@ static void _isotp_tx_timeout_task(struct isotp *isotp)
     case ISOTP_SENDING_SF:
         DEBUG("_isotp_tx_timeout_task: timeout on DLL\n");
         isotp->tx.state = ISOTP_IDLE;
-        raw_can_abort(isotp->entry.ifnum, isotp->tx.tx_handle);
+        if (isotp->tx_inflight) {
+            _isotp_tx_abort_inflight(isotp);
+        }
+        else {
+            raw_can_abort(isotp->entry.ifnum, isotp->tx.tx_handle);
+        }
         _isotp_dispatch_tx(isotp, ETIMEDOUT);
         break;
     }
@@ -611,8 +775,7 @@ static void _isotp_rx_timeout_task(struct isotp *isotp)
         raw_can_abort(isotp->entry.ifnum, isotp->rx.tx_handle);
     case ISOTP_WAIT_CF:
         DEBUG("_isotp_rx_timeout_task: free rx buf\n");
-        gnrc_pktbuf_release(isotp->rx.snip);
-        isotp->rx.snip = NULL;
+        _isotp_rx_release(isotp);
         isotp->rx.state = ISOTP_IDLE;
         /* TODO dispatch rx error ? */
         break;
@@ -704,7 +867,16 @@ static void *_isotp_thread(void *args)
             DEBUG("_isotp_thread: CAN_MSG_TX_CONFIRMATION, handle=%d\n", (int)msg.content.value);
             mutex_lock(&lock);
             LL_FOREACH(isotp_list, isotp) {
-                if (isotp->tx.tx_handle == (int)msg.content.value) {
+                int pos;
+
+                /* any of the frames in flight may be confirmed */
+                if (isotp->tx_inflight &&
+                    ((pos = _isotp_tx_inflight_find(isotp, (int)msg.content.value)) >= 0)) {
+                    mutex_unlock(&lock);
+                    _isotp_tx_pump_conf(isotp, pos);
+                    break;
+                }
+                else if (isotp->tx.tx_handle == (int)msg.content.value) {
                     mutex_unlock(&lock);
                     _isotp_tx_tx_conf(isotp);
                     break;
@@ -782,6 +954,8 @@ int isotp_send(struct isotp *isotp, const void *buf, int len, int flags)
     isotp->tx.idx = 0;
 
     isotp->tx_wft = 0;
+    isotp->tx_head = 0;
+    isotp->tx_inflight = 0;
 
     msg_t msg;
     msg.type = CAN_MSG_SEND_FRAME;
@@ -814,6 +988,10 @@ int isotp_bind(struct isotp *isotp, can_reg_entry_t *entry, void *arg)
 
     memset(&isotp->rx, 0, sizeof(struct tpcon));
     memset(&isotp->tx, 0, sizeof(struct tpcon));
+    isotp->tx_head = 0;
+    isotp->tx_inflight = 0;
+    isotp->rx_iov = NULL;
+    isotp->rx_iovcnt = 0;
 
     isotp->rxfc.bs = CAN_ISOTP_BS;
     isotp->rxfc.stmin = CAN_ISOTP_STMIN;
@@ -853,10 +1031,24 @@ int isotp_bind(struct isotp *isotp, can_reg_entry_t *entry, void *arg)
     return 0;
 }
 
+void isotp_set_rx_iov(struct isotp *isotp, const struct iovec *iov, unsigned count)
+{
+    assert(isotp != NULL);
+    assert((iov != NULL) || (count == 0));
+
+    DEBUG("isotp_set_rx_iov: isotp=%p, count=%u\n", (void *)isotp, count);
+
+    isotp->rx_iov = (count) ? iov : NULL;
+    isotp->rx_iovcnt = count;
+}
+
 void isotp_free_rx(can_rx_data_t *rx)
 {
     DEBUG("isotp_free_rx: rx=%p\n", (void *)rx);
-    gnrc_pktbuf_release(rx->data.iov_base);
+    /* data received into the buffers of the upper layer is not in the pktbuf */
+    if (rx->data.iov_base) {
+        gnrc_pktbuf_release(rx->data.iov_base);
+    }
     can_pkt_free_rx_data(rx);
 }
 
@@ -29,6 +29,7 @@
 #include "can/device.h"
 #include "utlist.h"
 #include "mutex.h"
+#include "irq.h"
 #include "assert.h"
 
 #ifdef MODULE_CAN_MBOX
@@ -51,33 +52,70 @@ typedef struct filter_el {
     canid_t mask;            /**< Mask of the element */
     void *data;              /**< Private data */
     gnrc_pktsnip_t *snip;    /**< Pointer to the allocated snip */
+    struct filter_el *retired; /**< Next removed element waiting to be freed */
 } filter_el_t;
 
+#if (CAN_ROUTER_BUCKETS_NUMOF & (CAN_ROUTER_BUCKETS_NUMOF - 1))
+#error "CAN_ROUTER_BUCKETS_NUMOF must be a power of 2"
+#endif
+
 /**
- * This table contains @p CAN_ROUTER_APP_MAX lists of CAN IDs per interface
+ * Filters of an interface
+ *
+ * Filters are only changed with @p lock held. The dispatch walks them without
+ * the lock, so changes of the lists are published with release stores and
+ * read with acquire loads, and elements removed while a dispatch is running
+ * are only freed once no dispatch is left.
  */
-static can_reg_entry_t *table[CAN_DLL_NUMOF];
+typedef struct {
+    can_reg_entry_t *exact[CAN_ROUTER_BUCKETS_NUMOF]; /**< single CAN ID filters,
+                                                           hashed by CAN ID */
+    can_reg_entry_t *masked;    /**< filters with a mask */
+    filter_el_t *retired;       /**< removed elements to free */
+    unsigned readers;           /**< number of running dispatches */
+    mutex_t lock;               /**< lock for changing the filters */
+} filter_table_t;
 
-
-static mutex_t lock = MUTEX_INIT;
+/**
+ * This table contains the filters per interface
+ */
+static filter_table_t table[CAN_DLL_NUMOF];
 
 static filter_el_t *_alloc_filter_el(canid_t can_id, canid_t mask, void *data);
 static void _free_filter_el(filter_el_t *el);
 static void _insert_to_list(can_reg_entry_t **list, filter_el_t *el);
 static filter_el_t *_find_filter_el(can_reg_entry_t *list, can_reg_entry_t *entry, canid_t can_id, canid_t mask, void *data);
-static int _filter_is_used(unsigned int ifnum, canid_t can_id, canid_t mask);
+static int _filter_is_used(can_reg_entry_t *list, canid_t can_id, canid_t mask);
+
+static inline can_reg_entry_t **_get_list(unsigned int ifnum, canid_t can_id, canid_t mask)
+{
+    if (mask == CAN_ROUTER_FULL_MASK) {
+        /* the low bits differ the most between IDs of the same bus */
+        return &table[ifnum].exact[(can_id ^ (can_id >> 11)) &
+                                   (CAN_ROUTER_BUCKETS_NUMOF - 1)];
+    }
+    return &table[ifnum].masked;
+}
 
 #if ENABLE_DEBUG
+static void _print_list(can_reg_entry_t *list)
+{
+    can_reg_entry_t *entry;
+    LL_FOREACH(list, entry) {
+        filter_el_t *el = container_of(entry, filter_el_t, entry);
+        DEBUG("App pid=%" PRIkernel_pid ", el=%p, can_id=0x%" PRIx32 ", mask=0x%" PRIx32 ", data=%p\n",
+              el->entry.target.pid, (void*)el, el->can_id, el->mask, el->data);
+    }
+}
+
 static void _print_filters(void)
 {
     for (int i = 0; i < (int)CAN_DLL_NUMOF; i++) {
         DEBUG("--- Ifnum: %d ---\n", i);
-        can_reg_entry_t *entry;
-        LL_FOREACH(table[i], entry) {
-            filter_el_t *el = container_of(entry, filter_el_t, entry);
-            DEBUG("App pid=%" PRIkernel_pid ", el=%p, can_id=0x%" PRIx32 ", mask=0x%" PRIx32 ", data=%p\n",
-                  el->entry.target.pid, (void*)el, el->can_id, el->mask, el->data);
+        for (unsigned j = 0; j < CAN_ROUTER_BUCKETS_NUMOF; j++) {
+            _print_list(table[i].exact[j]);
         }
+        _print_list(table[i].masked);
     }
 }
 
@@ -101,6 +139,7 @@ static filter_el_t *_alloc_filter_el(canid_t can_id, canid_t mask, void *data)
     el->data = data;
     el->entry.next = NULL;
     el->snip = snip;
+    el->retired = NULL;
     DEBUG("_alloc_canid_el: el allocated with can_id=0x%" PRIx32 ", mask=0x%" PRIx32
           ", data=%p\n", can_id, mask, data);
     return el;
@@ -114,40 +153,61 @@ static void _free_filter_el(filter_el_t *el)
     gnrc_pktbuf_release(el->snip);
 }
 
+/* free the element, or leave it to the last running dispatch */
+static void _retire_filter_el(filter_table_t *t, filter_el_t *el)
+{
+    unsigned state = irq_disable();
+
+    if (t->readers > 0) {
+        el->retired = t->retired;
+        t->retired = el;
+        el = NULL;
+    }
+    irq_restore(state);
+
+    if (el) {
+        _free_filter_el(el);
+    }
+}
+
+/* Make a change of a list visible to the dispatch, which walks the lists
+ * without the lock: the release store orders all writes to the element before
+ * the store of the pointer to it, _next() pairs with it */
+static inline void _publish(can_reg_entry_t **ptr, can_reg_entry_t *entry)
+{
+    __atomic_store_n(ptr, entry, __ATOMIC_RELEASE);
+}
+
+static inline can_reg_entry_t *_next(can_reg_entry_t *const *ptr)
+{
+    return __atomic_load_n(ptr, __ATOMIC_ACQUIRE);
+}
+
 /* Insert to the list in a sorted way
  * Lower CAN IDs are inserted first */
 static void _insert_to_list(can_reg_entry_t **list, filter_el_t *el)
 {
-    can_reg_entry_t *next_entry = *list;
-    filter_el_t *next_el = container_of(next_entry, filter_el_t, entry);
+    can_reg_entry_t **prev = list;
 
     DEBUG("_insert_to_list: list=%p, el=%p\n", (void *)list, (void *)el);
 
-    if (!(*list) || (next_el->can_id > el->can_id)) {
-        LL_PREPEND(*list, &el->entry);
-        DEBUG("_insert_to_list: inserting first el, list=%p\n", (void *)list);
+    while (*prev && (container_of(*prev, filter_el_t, entry)->can_id < el->can_id)) {
+        prev = &(*prev)->next;
     }
-    else {
-        do {
-            if (el->can_id <= next_el->can_id) {
-                DEBUG("_insert_to_list: found next_el can_id:0x%" PRIx32
-                      "\n", next_el->can_id);
-                LL_PREPEND_ELEM(*list, next_entry, &el->entry);
-                return;
-            }
-            else if (next_el->entry.next == NULL) {
-                DEBUG("_insert_to_list: insert at the end\n");
-                LL_APPEND(next_entry, &el->entry);
-                return;
-            }
-            else {
-                next_entry = next_entry->next;
-                next_el = container_of(next_entry, filter_el_t, entry);
-                DEBUG("_insert_to_list: going to next el: %p\n", (void*) next_el);
-            }
-        } while (next_el);
+    el->entry.next = *prev;
+    _publish(prev, &el->entry);
+}
+
+/* Remove from the list, the element itself stays intact for running
+ * dispatches */
+static void _delete_from_list(can_reg_entry_t **list, filter_el_t *el)
+{
+    can_reg_entry_t **prev = list;
 
+    while (*prev != &el->entry) {
+        prev = &(*prev)->next;
     }
+    _publish(prev, el->entry.next);
 }
 
 #ifdef MODULE_CAN_MBOX
@@ -177,9 +237,9 @@ static filter_el_t *_find_filter_el(can_reg_entry_t *list, can_reg_entry_t *entr
     return NULL;
 }
 
-static int _filter_is_used(unsigned int ifnum, canid_t can_id, canid_t mask)
+static int _filter_is_used(can_reg_entry_t *list, canid_t can_id, canid_t mask)
 {
-    filter_el_t *el = container_of(table[ifnum], filter_el_t, entry);
+    filter_el_t *el = container_of(list, filter_el_t, entry);
     if (!el) {
         DEBUG("_filter_is_used: empty list\n");
         return 0;
@@ -202,6 +262,7 @@ static int _filter_is_used(unsigned int ifnum, canid_t can_id, canid_t mask)
 int can_router_register(can_reg_entry_t *entry, canid_t can_id, canid_t mask, void *param)
 {
     filter_el_t *filter;
+    can_reg_entry_t **list;
     int ret;
 
 #if ENABLE_DEBUG
@@ -214,12 +275,13 @@ int can_router_register(can_reg_entry_t *entry, canid_t can_id, canid_t mask, vo
     }
 #endif
 
-    mutex_lock(&lock);
-    ret = _filter_is_used(entry->ifnum, can_id, mask);
+    list = _get_list(entry->ifnum, can_id, mask);
+    mutex_lock(&table[entry->ifnum].lock);
+    ret = _filter_is_used(*list, can_id, mask);
 
     filter = _alloc_filter_el(can_id, mask, param);
     if (!filter) {
-        mutex_unlock(&lock);
+        mutex_unlock(&table[entry->ifnum].lock);
         return -ENOMEM;
     }
 
@@ -238,8 +300,8 @@ int can_router_register(can_reg_entry_t *entry, canid_t can_id, canid_t mask, vo
     filter->entry.target.pid = entry->target.pid;
 #endif
     filter->entry.ifnum = entry->ifnum;
-    _insert_to_list(&table[entry->ifnum], filter);
-    mutex_unlock(&lock);
+    _insert_to_list(list, filter);
+    mutex_unlock(&table[entry->ifnum].lock);
 
     PRINT_FILTERS();
 
@@ -251,6 +313,7 @@ int can_router_unregister(can_reg_entry_t *entry, canid_t can_id,
                           canid_t mask, void *param)
 {
     filter_el_t *el;
+    can_reg_entry_t **list;
     int ret;
 
 #if ENABLE_DEBUG
@@ -263,16 +326,17 @@ int can_router_unregister(can_reg_entry_t *entry, canid_t can_id,
     }
 #endif
 
-    mutex_lock(&lock);
-    el = _find_filter_el(table[entry->ifnum], entry, can_id, mask, param);
+    list = _get_list(entry->ifnum, can_id, mask);
+    mutex_lock(&table[entry->ifnum].lock);
+    el = _find_filter_el(*list, entry, can_id, mask, param);
     if (!el) {
-        mutex_unlock(&lock);
+        mutex_unlock(&table[entry->ifnum].lock);
         return -EINVAL;
     }
-    LL_DELETE(table[entry->ifnum], &el->entry);
-    _free_filter_el(el);
-    ret = _filter_is_used(entry->ifnum, can_id, mask);
-    mutex_unlock(&lock);
+    _delete_from_list(list, el);
+    _retire_filter_el(&table[entry->ifnum], el);
+    ret = _filter_is_used(*list, can_id, mask);
+    mutex_unlock(&table[entry->ifnum].lock);
 
     PRINT_FILTERS();
 
@@ -296,27 +360,14 @@ static int _send_msg(msg_t *msg, can_reg_entry_t *entry)
 #endif
 }
 
-/* send received pkt to all interested users */
-int can_router_dispatch_rx_indic(can_pkt_t *pkt)
+static int _dispatch_list(can_pkt_t *pkt, can_reg_entry_t *const *list)
 {
-    if (!pkt) {
-        DEBUG("can_router_dispatch_rx_indic: invalid pkt\n");
-        return -EINVAL;
-    }
-
-    int res = 0;
     msg_t msg;
     msg.type = CAN_MSG_RX_INDICATION;
-#if ENABLE_DEBUG
-    int msg_cnt = 0;
-#endif
-    DEBUG("can_router_dispatch_rx_indic: pkt=%p, ifnum=%d, can_id=%" PRIx32 "\n",
-          (void *)pkt, pkt->entry.ifnum, pkt->frame.can_id);
-
-    mutex_lock(&lock);
     can_reg_entry_t *entry;
     filter_el_t *el;
-    LL_FOREACH(table[pkt->entry.ifnum], entry) {
+
+    for (entry = _next(list); entry; entry = _next(&entry->next)) {
         el = container_of(entry, filter_el_t, entry);
         if ((pkt->frame.can_id & el->mask) == el->can_id) {
             DEBUG("can_router_dispatch_rx_indic: found el=%p, data=%p\n",
@@ -325,23 +376,61 @@ int can_router_dispatch_rx_indic(can_pkt_t *pkt)
                   PRIkernel_pid "\n", entry->target.pid);
             atomic_fetch_add(&pkt->ref_count, 1);
             msg.content.ptr = can_pkt_alloc_rx_data(&pkt->frame, sizeof(pkt->frame), el->data);
-#if ENABLE_DEBUG
-            msg_cnt++;
-#endif
             if (!msg.content.ptr || (_send_msg(&msg, entry) <= 0)) {
                 can_pkt_free_rx_data(msg.content.ptr);
                 atomic_fetch_sub(&pkt->ref_count, 1);
                 DEBUG("can_router_dispatch_rx_indic: failed to send msg to "
                       "pid=%" PRIkernel_pid "\n", entry->target.pid);
-                res = -EBUSY;
-                break;
+                return -EBUSY;
             }
         }
+        else if ((el->mask == CAN_ROUTER_FULL_MASK) && (el->can_id > pkt->frame.can_id)) {
+            /* single CAN ID filters are sorted */
+            break;
+        }
     }
-    mutex_unlock(&lock);
-#if ENABLE_DEBUG
-    DEBUG("can_router_dispatch_rx: msg send to %d threads\n", msg_cnt);
-#endif
+
+    return 0;
+}
+
+/* send received pkt to all interested users */
+int can_router_dispatch_rx_indic(can_pkt_t *pkt)
+{
+    if (!pkt) {
+        DEBUG("can_router_dispatch_rx_indic: invalid pkt\n");
+        return -EINVAL;
+    }
+
+    int res;
+    filter_table_t *t = &table[pkt->entry.ifnum];
+    filter_el_t *retired = NULL;
+    unsigned state;
+
+    DEBUG("can_router_dispatch_rx_indic: pkt=%p, ifnum=%d, can_id=%" PRIx32 "\n",
+          (void *)pkt, pkt->entry.ifnum, pkt->frame.can_id);
+
+    state = irq_disable();
+    t->readers++;
+    irq_restore(state);
+
+    res = _dispatch_list(pkt, _get_list(pkt->entry.ifnum, pkt->frame.can_id,
+                                        CAN_ROUTER_FULL_MASK));
+    if (res == 0) {
+        res = _dispatch_list(pkt, &t->masked);
+    }
+
+    state = irq_disable();
+    if (--t->readers == 0) {
+        retired = t->retired;
+        t->retired = NULL;
+    }
+    irq_restore(state);
+    while (retired) {
+        filter_el_t *next = retired->retired;
+        _free_filter_el(retired);
+        retired = next;
+    }
+
     if (atomic_load(&pkt->ref_count) == 0) {
         can_pkt_free(pkt);
     }
@@ -45,7 +45,9 @@ static const cipher_interface_t aes_interface = {
     AES_KEY_SIZE,
     aes_init,
     aes_encrypt,
-    aes_decrypt
+    aes_decrypt,
+    aes_encrypt_blocks,
+    aes_decrypt_blocks
 };
 const cipher_id_t CIPHER_AES_128 = &aes_interface;
 
@@ -933,22 +935,12 @@ static int aes_set_decrypt_key(const unsigned char *userKey, const int bits,
 
 #ifndef AES_ASM
 /*
- * Encrypt a single block
+ * Encrypt a single block with an expanded key
  * in and out can overlap
  */
-int aes_encrypt(const cipher_context_t *context, const uint8_t *plainBlock,
-                uint8_t *cipherBlock)
+static void _encrypt_block(const AES_KEY *key, const uint8_t *plainBlock,
+                           uint8_t *cipherBlock)
 {
-    //setup AES_KEY
-    int res;
-    AES_KEY aeskey;
-    const AES_KEY *key = &aeskey;
-    res = aes_set_encrypt_key((unsigned char *)context->context,
-                                   AES_KEY_SIZE * 8, &aeskey);
-    if (res < 0) {
-        return res;
-    }
-
     const u32 *rk;
     u32 s0, s1, s2, s3, t0, t1, t2, t3;
 #ifndef FULL_UNROLL
@@ -1188,27 +1180,63 @@ int aes_encrypt(const cipher_context_t *context, const uint8_t *plainBlock,
         (Te4[(t2) & 0xff]       & 0x000000ff) ^
         rk[3];
     PUTU32(cipherBlock + 12, s3);
-    return 1;
 }
 
 /*
- * Decrypt a single block
+ * Encrypt a single block
  * in and out can overlap
  */
-int aes_decrypt(const cipher_context_t *context, const uint8_t *cipherBlock,
-                uint8_t *plainBlock)
+int aes_encrypt(const cipher_context_t *context, const uint8_t *plainBlock,
+                uint8_t *cipherBlock)
+{
+    return aes_encrypt_blocks(context, plainBlock, cipherBlock, 1);
+}
+
+/* T-table implementation of aes_encrypt_blocks() */
+static int _encrypt_blocks(const cipher_context_t *context, const uint8_t *plain,
+                           uint8_t *cipher, size_t numof)
 {
     //setup AES_KEY
     int res;
     AES_KEY aeskey;
-    const AES_KEY *key = &aeskey;
-    res = aes_set_decrypt_key((unsigned char *)context->context,
+    res = aes_set_encrypt_key((unsigned char *)context->context,
                               AES_KEY_SIZE * 8, &aeskey);
-
     if (res < 0) {
         return res;
     }
 
+    for (size_t i = 0; i < numof; i++) {
+        _encrypt_block(&aeskey, plain, cipher);
+        plain += AES_BLOCK_SIZE;
+        cipher += AES_BLOCK_SIZE;
+    }
+    return 1;
+}
+
+/*
+ * Encrypt consecutive blocks, the key is only expanded once
+ * in and out can overlap
+ */
+int aes_encrypt_blocks(const cipher_context_t *context, const uint8_t *plain,
+                       uint8_t *cipher, size_t numof)
+{
+#ifdef MODULE_CRYPTO_AES_NI
+    if (aes_ni_available()) {
+        aes_ni_encrypt_blocks(context->context, plain, cipher, numof);
+        return 1;
+    }
+#endif
+
+    return _encrypt_blocks(context, plain, cipher, numof);
+}
+
+/*
+ * Decrypt a single block with an expanded key
+ * in and out can overlap
+ */
+static void _decrypt_block(const AES_KEY *key, const uint8_t *cipherBlock,
+                           uint8_t *plainBlock)
+{
     const u32 *rk;
     u32 s0, s1, s2, s3, t0, t1, t2, t3;
 #ifndef FULL_UNROLL
@@ -1448,7 +1476,82 @@ int aes_decrypt(const cipher_context_t *context, const uint8_t *cipherBlock,
         (Td4[(t0) & 0xff]       & 0x000000ff) ^
         rk[3];
     PUTU32(plainBlock + 12, s3);
+}
+
+/*
+ * Decrypt a single block
+ * in and out can overlap
+ */
+int aes_decrypt(const cipher_context_t *context, const uint8_t *cipherBlock,
+                uint8_t *plainBlock)
+{
+    return aes_decrypt_blocks(context, cipherBlock, plainBlock, 1);
+}
+
+/* T-table implementation of aes_decrypt_blocks() */
+static int _decrypt_blocks(const cipher_context_t *context, const uint8_t *cipher,
+                           uint8_t *plain, size_t numof)
+{
+    //setup AES_KEY
+    int res;
+    AES_KEY aeskey;
+    res = aes_set_decrypt_key((unsigned char *)context->context,
+                              AES_KEY_SIZE * 8, &aeskey);
+    if (res < 0) {
+        return res;
+    }
+
+    for (size_t i = 0; i < numof; i++) {
+        _decrypt_block(&aeskey, cipher, plain);
+        cipher += AES_BLOCK_SIZE;
+        plain += AES_BLOCK_SIZE;
+    }
     return 1;
 }
 
+/*
+ * Decrypt consecutive blocks, the key is only expanded once
+ * in and out can overlap
+ */
+int aes_decrypt_blocks(const cipher_context_t *context, const uint8_t *cipher,
+                       uint8_t *plain, size_t numof)
+{
+#ifdef MODULE_CRYPTO_AES_NI
+    if (aes_ni_available()) {
+        aes_ni_decrypt_blocks(context->context, cipher, plain, numof);
+        return 1;
+    }
+#endif
+
+    return _decrypt_blocks(context, cipher, plain, numof);
+}
+
+#ifdef MODULE_CRYPTO_AES_NI
+static int _encrypt(const cipher_context_t *context, const uint8_t *plainBlock,
+                    uint8_t *cipherBlock)
+{
+    return _encrypt_blocks(context, plainBlock, cipherBlock, 1);
+}
+
+static int _decrypt(const cipher_context_t *context, const uint8_t *cipherBlock,
+                    uint8_t *plainBlock)
+{
+    return _decrypt_blocks(context, cipherBlock, plainBlock, 1);
+}
+
+/**
+ * Interface to the T-table implementation, even if AES-NI is available
+ */
+static const cipher_interface_t aes_ttable_interface = {
+    AES_BLOCK_SIZE,
+    AES_KEY_SIZE,
+    aes_init,
+    _encrypt,
+    _decrypt,
+    _encrypt_blocks,
+    _decrypt_blocks
+};
+const cipher_id_t CIPHER_AES_128_TTABLE = &aes_ttable_interface;
+#endif /* MODULE_CRYPTO_AES_NI */
+
 #endif /* AES_ASM */
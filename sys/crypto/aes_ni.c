@@ -0,0 +1,208 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_crypto
+ * @{
+ *
+ * @file
+ * @brief       AES-128 using the AES-NI instructions of x86 hosts
+ *
+ * The functions are compiled for AES-NI regardless of the global compiler
+ * flags, so they must only be called if aes_ni_available() returned true.
+ *
+ * @}
+ */
+
+#ifdef MODULE_CRYPTO_AES_NI
+
+#include <cpuid.h>
+#include <wmmintrin.h>
+
+#include "crypto/aes.h"
+
+/* the stack of a native thread is not guaranteed to be aligned to 16 bytes */
+#define AES_NI_FUNC     __attribute__((target("aes,sse2"), force_align_arg_pointer))
+#define AES_NI_INLINE   __attribute__((target("aes,sse2"), always_inline)) static inline
+
+#define ROUNDS          (10U)
+/* number of blocks in flight, hides the latency of the AES instructions */
+#define INTERLEAVE      (4U)
+
+#define EXPAND(k, i, rcon) \
+    k[i] = _expand(k[i - 1], _mm_aeskeygenassist_si128(k[i - 1], rcon))
+
+static int _available = -1;
+
+AES_NI_INLINE __m128i _expand(__m128i key, __m128i gen)
+{
+    gen = _mm_shuffle_epi32(gen, 0xff);
+    key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+    key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+    key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+    return _mm_xor_si128(key, gen);
+}
+
+AES_NI_INLINE void _set_encrypt_key(const uint8_t *key, __m128i *k)
+{
+    k[0] = _mm_loadu_si128((const __m128i *)key);
+    EXPAND(k, 1, 0x01);
+    EXPAND(k, 2, 0x02);
+    EXPAND(k, 3, 0x04);
+    EXPAND(k, 4, 0x08);
+    EXPAND(k, 5, 0x10);
+    EXPAND(k, 6, 0x20);
+    EXPAND(k, 7, 0x40);
+    EXPAND(k, 8, 0x80);
+    EXPAND(k, 9, 0x1b);
+    EXPAND(k, 10, 0x36);
+}
+
+int aes_ni_available(void)
+{
+    if (_available < 0) {
+        unsigned eax, ebx, ecx, edx;
+
+        _available = (__get_cpuid(1, &eax, &ebx, &ecx, &edx) &&
+                      (ecx & bit_AES)) ? 1 : 0;
+    }
+    return _available;
+}
+
+AES_NI_FUNC void aes_ni_encrypt_blocks(const uint8_t *key, const uint8_t *plain,
+                                       uint8_t *cipher, size_t numof)
+{
+    __m128i k[ROUNDS + 1];
+
+    _set_encrypt_key(key, k);
+    for (; numof >= INTERLEAVE; numof -= INTERLEAVE) {
+        __m128i b[INTERLEAVE];
+
+        for (unsigned i = 0; i < INTERLEAVE; i++) {
+            b[i] = _mm_xor_si128(_mm_loadu_si128((const __m128i *)plain + i), k[0]);
+        }
+        for (unsigned r = 1; r < ROUNDS; r++) {
+            for (unsigned i = 0; i < INTERLEAVE; i++) {
+                b[i] = _mm_aesenc_si128(b[i], k[r]);
+            }
+        }
+        for (unsigned i = 0; i < INTERLEAVE; i++) {
+            _mm_storeu_si128((__m128i *)cipher + i,
+                             _mm_aesenclast_si128(b[i], k[ROUNDS]));
+        }
+        plain += INTERLEAVE * AES_BLOCK_SIZE;
+        cipher += INTERLEAVE * AES_BLOCK_SIZE;
+    }
+    for (; numof > 0; numof--) {
+        __m128i b = _mm_xor_si128(_mm_loadu_si128((const __m128i *)plain), k[0]);
+
+        for (unsigned r = 1; r < ROUNDS; r++) {
+            b = _mm_aesenc_si128(b, k[r]);
+        }
+        _mm_storeu_si128((__m128i *)cipher, _mm_aesenclast_si128(b, k[ROUNDS]));
+        plain += AES_BLOCK_SIZE;
+        cipher += AES_BLOCK_SIZE;
+    }
+}
+
+AES_NI_FUNC void aes_ni_decrypt_blocks(const uint8_t *key, const uint8_t *cipher,
+                                       uint8_t *plain, size_t numof)
+{
+    __m128i k[ROUNDS + 1], dk[ROUNDS + 1];
+
+    /* the decryption key schedule is the reversed encryption key schedule,
+     * with InvMixColumns applied to the inner round keys */
+    _set_encrypt_key(key, k);
+    dk[0] = k[ROUNDS];
+    for (unsigned r = 1; r < ROUNDS; r++) {
+        dk[r] = _mm_aesimc_si128(k[ROUNDS - r]);
+    }
+    dk[ROUNDS] = k[0];
+
+    for (; numof >= INTERLEAVE; numof -= INTERLEAVE) {
+        __m128i b[INTERLEAVE];
+
+        for (unsigned i = 0; i < INTERLEAVE; i++) {
+            b[i] = _mm_xor_si128(_mm_loadu_si128((const __m128i *)cipher + i), dk[0]);
+        }
+        for (unsigned r = 1; r < ROUNDS; r++) {
+            for (unsigned i = 0; i < INTERLEAVE; i++) {
+                b[i] = _mm_aesdec_si128(b[i], dk[r]);
+            }
+        }
+        for (unsigned i = 0; i < INTERLEAVE; i++) {
+            _mm_storeu_si128((__m128i *)plain + i,
+                             _mm_aesdeclast_si128(b[i], dk[ROUNDS]));
+        }
+        cipher += INTERLEAVE * AES_BLOCK_SIZE;
+        plain += INTERLEAVE * AES_BLOCK_SIZE;
+    }
+    for (; numof > 0; numof--) {
+        __m128i b = _mm_xor_si128(_mm_loadu_si128((const __m128i *)cipher), dk[0]);
+
+        for (unsigned r = 1; r < ROUNDS; r++) {
+            b = _mm_aesdec_si128(b, dk[r]);
+        }
+        _mm_storeu_si128((__m128i *)plain, _mm_aesdeclast_si128(b, dk[ROUNDS]));
+        cipher += AES_BLOCK_SIZE;
+        plain += AES_BLOCK_SIZE;
+    }
+}
+
+static int _init(cipher_context_t *context, const uint8_t *key,
+                 uint8_t keySize)
+{
+    if (!aes_ni_available()) {
+        return CIPHER_ERR_BAD_CONTEXT_SIZE;
+    }
+    return aes_init(context, key, keySize);
+}
+
+static int _encrypt_blocks(const cipher_context_t *context,
+                           const uint8_t *plain, uint8_t *cipher, size_t numof)
+{
+    aes_ni_encrypt_blocks(context->context, plain, cipher, numof);
+    return 1;
+}
+
+static int _decrypt_blocks(const cipher_context_t *context,
+                           const uint8_t *cipher, uint8_t *plain, size_t numof)
+{
+    aes_ni_decrypt_blocks(context->context, cipher, plain, numof);
+    return 1;
+}
+
+static int _encrypt(const cipher_context_t *context, const uint8_t *plainBlock,
+                    uint8_t *cipherBlock)
+{
+    return _encrypt_blocks(context, plainBlock, cipherBlock, 1);
+}
+
+static int _decrypt(const cipher_context_t *context, const uint8_t *cipherBlock,
+                    uint8_t *plainBlock)
+{
+    return _decrypt_blocks(context, cipherBlock, plainBlock, 1);
+}
+
+/**
+ * Interface to the AES-NI implementation
+ */
+static const cipher_interface_t aes_ni_interface = {
+    AES_BLOCK_SIZE,
+    AES_KEY_SIZE,
+    _init,
+    _encrypt,
+    _decrypt,
+    _encrypt_blocks,
+    _decrypt_blocks
+};
+const cipher_id_t CIPHER_AES_128_NI = &aes_ni_interface;
+
+#else
+typedef int dont_be_pedantic;
+#endif /* MODULE_CRYPTO_AES_NI */
@@ -0,0 +1,189 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_crypto
+ * @{
+ *
+ * @file
+ * @brief       ChaCha20-Poly1305 AEAD
+ *
+ * @}
+ */
+
+#include <string.h>
+
+#include "crypto/chacha20poly1305.h"
+#include "crypto/helper.h"
+
+#define CHACHA_BLOCK_SIZE   (64U)
+
+static const uint8_t _zero[16];
+
+static void _put_le64(uint8_t *buf, uint64_t val)
+{
+    for (unsigned i = 0; i < 8; i++) {
+        buf[i] = val & 0xff;
+        val >>= 8;
+    }
+}
+
+/* pads the data authenticated so far to a multiple of 16 bytes */
+static void _pad16(chacha20poly1305_ctx_t *ctx, uint64_t len)
+{
+    if (len % 16) {
+        poly1305_update(&ctx->poly, _zero, 16 - (len % 16));
+    }
+}
+
+static void _start_text(chacha20poly1305_ctx_t *ctx)
+{
+    if (!ctx->text) {
+        _pad16(ctx, ctx->aad_len);
+        ctx->text = true;
+    }
+}
+
+static void _update(chacha20poly1305_ctx_t *ctx, const uint8_t *input,
+                    size_t len, uint8_t *output, bool encrypt)
+{
+    _start_text(ctx);
+    ctx->text_len += len;
+    /* the tag is always computed over the ciphertext, hash it before it is
+     * possibly overwritten by the plaintext */
+    if (!encrypt) {
+        poly1305_update(&ctx->poly, input, len);
+    }
+    while (len > 0) {
+        size_t chunk = CHACHA_BLOCK_SIZE - ctx->pos;
+
+        if (chunk == 0) {
+            chacha_keystream_bytes(&ctx->chacha, ctx->stream);
+            ctx->pos = 0;
+            chunk = CHACHA_BLOCK_SIZE;
+        }
+        if (chunk > len) {
+            chunk = len;
+        }
+        crypto_xor(output, input, &ctx->stream[ctx->pos], chunk);
+        if (encrypt) {
+            poly1305_update(&ctx->poly, output, chunk);
+        }
+        ctx->pos += chunk;
+        input += chunk;
+        output += chunk;
+        len -= chunk;
+    }
+}
+
+static void _compute_tag(chacha20poly1305_ctx_t *ctx,
+                         uint8_t tag[CHACHA20POLY1305_TAG_BYTES])
+{
+    uint8_t lengths[16];
+
+    _start_text(ctx);
+    _pad16(ctx, ctx->text_len);
+    _put_le64(&lengths[0], ctx->aad_len);
+    _put_le64(&lengths[8], ctx->text_len);
+    poly1305_update(&ctx->poly, lengths, sizeof(lengths));
+    poly1305_finish(&ctx->poly, tag);
+    memset(ctx, 0, sizeof(chacha20poly1305_ctx_t));
+}
+
+void chacha20poly1305_init(chacha20poly1305_ctx_t *ctx,
+                           const uint8_t key[CHACHA20POLY1305_KEY_BYTES],
+                           const uint8_t nonce[CHACHA20POLY1305_NONCE_BYTES])
+{
+    uint8_t poly_key[CHACHA_BLOCK_SIZE];
+
+    memset(ctx, 0, sizeof(chacha20poly1305_ctx_t));
+    chacha_init(&ctx->chacha, 20, key, CHACHA20POLY1305_KEY_BYTES, _zero);
+    /* RFC 8439 uses a 32 bit block counter followed by a 96 bit nonce */
+    ctx->chacha.state[12] = 0;
+    memcpy(&ctx->chacha.state[13], nonce, CHACHA20POLY1305_NONCE_BYTES);
+
+    /* the first block is the one-time Poly1305 key, the text starts with
+     * block 1 */
+    chacha_keystream_bytes(&ctx->chacha, poly_key);
+    poly1305_init(&ctx->poly, poly_key);
+    memset(poly_key, 0, sizeof(poly_key));
+    ctx->pos = CHACHA_BLOCK_SIZE;
+}
+
+void chacha20poly1305_update_aad(chacha20poly1305_ctx_t *ctx,
+                                 const uint8_t *aad, size_t aad_len)
+{
+    ctx->aad_len += aad_len;
+    poly1305_update(&ctx->poly, aad, aad_len);
+}
+
+void chacha20poly1305_encrypt_update(chacha20poly1305_ctx_t *ctx,
+                                     const uint8_t *input, size_t len,
+                                     uint8_t *output)
+{
+    _update(ctx, input, len, output, true);
+}
+
+void chacha20poly1305_decrypt_update(chacha20poly1305_ctx_t *ctx,
+                                     const uint8_t *input, size_t len,
+                                     uint8_t *output)
+{
+    _update(ctx, input, len, output, false);
+}
+
+void chacha20poly1305_finish(chacha20poly1305_ctx_t *ctx,
+                             uint8_t tag[CHACHA20POLY1305_TAG_BYTES])
+{
+    _compute_tag(ctx, tag);
+}
+
+bool chacha20poly1305_verify(chacha20poly1305_ctx_t *ctx,
+                             const uint8_t tag[CHACHA20POLY1305_TAG_BYTES])
+{
+    uint8_t expected[CHACHA20POLY1305_TAG_BYTES], diff = 0;
+
+    _compute_tag(ctx, expected);
+    /* compare in constant time */
+    for (unsigned i = 0; i < CHACHA20POLY1305_TAG_BYTES; i++) {
+        diff |= expected[i] ^ tag[i];
+    }
+    return (diff == 0);
+}
+
+void chacha20poly1305_encrypt(uint8_t *cipher, const uint8_t *msg,
+                              size_t msglen, const uint8_t *aad, size_t aadlen,
+                              const uint8_t *key, const uint8_t *nonce)
+{
+    chacha20poly1305_ctx_t ctx;
+
+    chacha20poly1305_init(&ctx, key, nonce);
+    chacha20poly1305_update_aad(&ctx, aad, aadlen);
+    chacha20poly1305_encrypt_update(&ctx, msg, msglen, cipher);
+    chacha20poly1305_finish(&ctx, cipher + msglen);
+}
+
+int chacha20poly1305_decrypt(const uint8_t *cipher, size_t cipherlen,
+                             uint8_t *msg, size_t *msglen,
+                             const uint8_t *aad, size_t aadlen,
+                             const uint8_t *key, const uint8_t *nonce)
+{
+    chacha20poly1305_ctx_t ctx;
+
+    if (cipherlen < CHACHA20POLY1305_TAG_BYTES) {
+        return 0;
+    }
+    *msglen = cipherlen - CHACHA20POLY1305_TAG_BYTES;
+    chacha20poly1305_init(&ctx, key, nonce);
+    chacha20poly1305_update_aad(&ctx, aad, aadlen);
+    chacha20poly1305_decrypt_update(&ctx, cipher, *msglen, msg);
+    if (!chacha20poly1305_verify(&ctx, cipher + *msglen)) {
+        memset(msg, 0, *msglen);
+        return 0;
+    }
+    return 1;
+}
@@ -7,6 +7,8 @@
  * directory for more details.
  */
 
+#include <string.h>
+
 #include "crypto/helper.h"
 
 void crypto_block_inc_ctr(uint8_t block[16], int L)
@@ -19,6 +21,39 @@ void crypto_block_inc_ctr(uint8_t block[16], int L)
     }
 }
 
+void crypto_block_fill_ctr(uint8_t *blocks, uint8_t ctr[16], int L,
+                           size_t numof)
+{
+    for (size_t i = 0; i < numof; ++i, blocks += 16) {
+        memcpy(blocks, ctr, 16);
+        crypto_block_inc_ctr(ctr, L);
+    }
+}
+
+void crypto_xor(uint8_t *out, const uint8_t *a, const uint8_t *b, size_t len)
+{
+    /* words can only be used if all buffers are equally misaligned */
+    if ((((uintptr_t)out ^ (uintptr_t)a) | ((uintptr_t)out ^ (uintptr_t)b)) &
+        (sizeof(uint32_t) - 1)) {
+        for (; len > 0; --len) {
+            *out++ = *a++ ^ *b++;
+        }
+        return;
+    }
+    for (; (len > 0) && ((uintptr_t)out & (sizeof(uint32_t) - 1)); --len) {
+        *out++ = *a++ ^ *b++;
+    }
+    for (; len >= sizeof(uint32_t); len -= sizeof(uint32_t)) {
+        *(uint32_t *)out = *(const uint32_t *)a ^ *(const uint32_t *)b;
+        out += sizeof(uint32_t);
+        a += sizeof(uint32_t);
+        b += sizeof(uint32_t);
+    }
+    for (; len > 0; --len) {
+        *out++ = *a++ ^ *b++;
+    }
+}
+
 int crypto_equals(uint8_t *a, uint8_t *b, size_t len)
 {
     uint8_t diff = 0;
@@ -20,14 +20,15 @@
 
 
 #include <string.h>
+#include "crypto/helper.h"
 #include "crypto/modes/cbc.h"
 
 int cipher_encrypt_cbc(cipher_t* cipher, uint8_t iv[16],
                        const uint8_t* input, size_t length, uint8_t* output)
 {
     size_t offset = 0;
-    uint8_t block_size, input_block[CIPHER_MAX_BLOCK_SIZE] = {0},
-            *output_block_last;
+    uint8_t block_size;
+    const uint8_t *output_block_last;
 
     block_size = cipher_get_block_size(cipher);
     if (length % block_size != 0) {
@@ -36,17 +37,16 @@ int cipher_encrypt_cbc(cipher_t* cipher, uint8_t iv[16],
 
     output_block_last = iv;
     do {
-        /* CBC-Mode: XOR plaintext with ciphertext of (n-1)-th block */
-        memcpy(input_block, input + offset, block_size);
-        for (int i = 0; i < block_size; ++i) {
-            input_block[i] ^= output_block_last[i];
-        }
+        uint8_t *output_block = output + offset;
 
-        if (cipher_encrypt(cipher, input_block, output + offset) != 1) {
+        /* CBC-Mode: XOR plaintext with ciphertext of (n-1)-th block and
+         * encrypt the result in place */
+        crypto_xor(output_block, input + offset, output_block_last, block_size);
+        if (cipher_encrypt(cipher, output_block, output_block) != 1) {
             return CIPHER_ERR_ENC_FAILED;
         }
 
-        output_block_last = output + offset;
+        output_block_last = output_block;
         offset += block_size;
     } while (offset < length);
 
@@ -58,32 +58,46 @@ int cipher_decrypt_cbc(cipher_t* cipher, uint8_t iv[16],
                        const uint8_t* input, size_t length, uint8_t* output)
 {
     size_t offset = 0;
-    const uint8_t *input_block, *input_block_last;
-    uint8_t block_size;
-
+    uint8_t block_size, input_block_last[CIPHER_MAX_BLOCK_SIZE];
+    uint32_t plain[CIPHER_BATCH_BLOCKS * CIPHER_MAX_BLOCK_SIZE / sizeof(uint32_t)];
+    uint8_t *plain_blocks = (uint8_t *)plain;
 
     block_size = cipher_get_block_size(cipher);
     if (length % block_size != 0) {
         return CIPHER_ERR_INVALID_LENGTH;
     }
 
-    input_block_last = iv;
-    do {
-        input_block = input + offset;
-        uint8_t *output_block = output + offset;
+    memcpy(input_block_last, iv, block_size);
+    while (offset < length) {
+        size_t numof = (length - offset) / block_size;
+
+        if (numof > CIPHER_BATCH_BLOCKS) {
+            numof = CIPHER_BATCH_BLOCKS;
+        }
 
-        if (cipher_decrypt(cipher, input_block, output_block) != 1) {
+        /* decryption is independent of the previous block, so several
+         * blocks are decrypted with one cipher call */
+        if (cipher_decrypt_blocks(cipher, input + offset, plain_blocks,
+                                  numof) != 1) {
             return CIPHER_ERR_DEC_FAILED;
         }
 
-        /* CBC-Mode: XOR plaintext with ciphertext of (n-1)-th block */
-        for (uint8_t i = 0; i < block_size; ++i) {
-            output_block[i] ^= input_block_last[i];
+        /* CBC-Mode: XOR plaintext with ciphertext of (n-1)-th block. The
+         * blocks are written backwards, so the ciphertext is still there if
+         * output == input */
+        crypto_xor(plain_blocks, plain_blocks, input_block_last, block_size);
+        memcpy(input_block_last, input + offset + (numof - 1) * block_size,
+               block_size);
+        for (size_t i = numof - 1; i > 0; --i) {
+            size_t block = offset + i * block_size;
+
+            crypto_xor(output + block, plain_blocks + i * block_size,
+                       input + block - block_size, block_size);
         }
+        memcpy(output + offset, plain_blocks, block_size);
 
-        input_block_last = input_block;
-        offset += block_size;
-    } while (offset < length);
+        offset += numof * block_size;
+    }
 
     return offset;
 }
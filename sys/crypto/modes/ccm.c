@@ -37,7 +37,8 @@ static inline int min(int a, int b)
 int ccm_compute_cbc_mac(cipher_t* cipher, uint8_t iv[16],
                         uint8_t* input, size_t length, uint8_t* mac)
 {
-    uint8_t offset, block_size, mac_enc[16] = {0};
+    uint8_t block_size;
+    size_t offset;
 
     block_size = cipher_get_block_size(cipher);
     memmove(mac, iv, 16);
@@ -47,15 +48,12 @@ int ccm_compute_cbc_mac(cipher_t* cipher, uint8_t iv[16],
                                    block_size : length - offset;
 
         /* CBC-Mode: XOR plaintext with ciphertext of (n-1)-th block */
-        for (int i = 0; i < block_size_input; ++i) {
-            mac[i] ^= input[offset + i];
-        }
+        crypto_xor(mac, mac, input + offset, block_size_input);
 
-        if (cipher_encrypt(cipher, mac, mac_enc) != 1) {
+        if (cipher_encrypt(cipher, mac, mac) != 1) {
             return CIPHER_ERR_ENC_FAILED;
         }
 
-        memcpy(mac, mac_enc, block_size);
         offset += block_size_input;
     } while (offset < length);
 
@@ -83,7 +81,7 @@ int ccm_create_mac_iv(cipher_t* cipher, uint8_t auth_data_len, uint8_t M,
     memcpy(&X1[1], nonce, min(nonce_len, 15 - L));
 
     /* write plaintext_len to B[15..16-L] */
-    for (uint8_t i = 15; i > 16 - L; --i) {
+    for (uint8_t i = 15; i >= 16 - L; --i) {
         X1[i] = plaintext_len & 0xff;
         plaintext_len >>= 8;
     }
@@ -200,7 +198,8 @@ int cipher_decrypt_ccm(cipher_t* cipher, uint8_t* auth_data,
     uint32_t length_max;
     uint8_t nonce_counter[16] = {0}, mac_iv[16] = {0}, mac[16] = {0},
                                 mac_recv[16] = {0}, stream_block[16] = {0}, zero_block[16] = {0},
-                                        plain_len, block_size;
+                                        block_size;
+    size_t plain_len;
 
     if (mac_length % 2 != 0  || mac_length < 4 || mac_length > 16) {
         return CCM_ERR_INVALID_MAC_LENGTH;
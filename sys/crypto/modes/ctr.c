@@ -26,24 +26,37 @@ int cipher_encrypt_ctr(cipher_t* cipher, uint8_t nonce_counter[16],
                        uint8_t* output)
 {
     size_t offset = 0;
-    uint8_t stream_block[16] = {0}, block_size;
+    /* words, so the keystream can be XORed word-wise */
+    uint32_t stream[CIPHER_BATCH_BLOCKS * 16 / sizeof(uint32_t)];
+    uint8_t *stream_blocks = (uint8_t *)stream, block_size;
 
     block_size = cipher_get_block_size(cipher);
     do {
-        uint8_t block_size_input;
+        size_t numof = (length - offset + block_size - 1) / block_size;
+        size_t stream_len;
 
-        if (cipher_encrypt(cipher, nonce_counter, stream_block) != 1) {
-            return CIPHER_ERR_ENC_FAILED;
+        if (numof > CIPHER_BATCH_BLOCKS) {
+            numof = CIPHER_BATCH_BLOCKS;
+        }
+        else if (numof == 0) {
+            /* empty input still consumes one counter block */
+            numof = 1;
         }
 
-        block_size_input = (length - offset > block_size) ?
-                           block_size : length - offset;
-        for (uint8_t i = 0; i < block_size_input; ++i) {
-            output[offset + i] = stream_block[i] ^ input[offset + i];
+        /* compute the keystream of several blocks with one cipher call */
+        crypto_block_fill_ctr(stream_blocks, nonce_counter,
+                              block_size - nonce_len, numof);
+        if (cipher_encrypt_blocks(cipher, stream_blocks, stream_blocks,
+                                  numof) != 1) {
+            return CIPHER_ERR_ENC_FAILED;
         }
 
-        offset += block_size_input;
-        crypto_block_inc_ctr(nonce_counter, block_size - nonce_len);
+        stream_len = numof * block_size;
+        if (stream_len > length - offset) {
+            stream_len = length - offset;
+        }
+        crypto_xor(output + offset, input + offset, stream_blocks, stream_len);
+        offset += stream_len;
     } while (offset < length);
 
     return offset;
@@ -0,0 +1,485 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+* @ingroup     sys_crypto_modes
+* @{
+*
+* @file
+* @brief       Crypto mode - Galois/counter mode
+*
+* @}
+*/
+
+#include <assert.h>
+#include <string.h>
+
+#include "crypto/helper.h"
+#include "crypto/modes/gcm.h"
+
+#ifdef MODULE_CRYPTO_AES_NI
+#include <cpuid.h>
+#include <wmmintrin.h>
+#include <tmmintrin.h>
+#endif
+
+/* GCM increments only the last 32 bit of the counter block */
+#define COUNTER_LEN     (4)
+
+static const uint8_t _zero[GCM_BLOCK_SIZE];
+
+/* reduction of the 4 bits shifted out of the table multiplication */
+static const uint64_t _last4[16] = {
+    0x0000, 0x1c20, 0x3840, 0x2460, 0x7080, 0x6ca0, 0x48c0, 0x54e0,
+    0xe100, 0xfd20, 0xd940, 0xc560, 0x9180, 0x8da0, 0xa9c0, 0xb5e0
+};
+
+static uint64_t _get_be64(const uint8_t *buf)
+{
+    uint64_t res = 0;
+
+    for (unsigned i = 0; i < 8; i++) {
+        res = (res << 8) | buf[i];
+    }
+    return res;
+}
+
+static void _put_be64(uint8_t *buf, uint64_t val)
+{
+    for (int i = 7; i >= 0; i--) {
+        buf[i] = val & 0xff;
+        val >>= 8;
+    }
+}
+
+static void _gen_table(gcm_ctx_t *ctx)
+{
+    uint64_t vh = _get_be64(ctx->h), vl = _get_be64(&ctx->h[8]);
+
+    /* entries for single bits, the bit order of GCM is reflected */
+    ctx->hl[0] = ctx->hh[0] = 0;
+    ctx->hl[8] = vl;
+    ctx->hh[8] = vh;
+    for (unsigned i = 4; i > 0; i >>= 1) {
+        uint64_t t = (vl & 1) * 0xe1000000U;
+
+        vl = (vh << 63) | (vl >> 1);
+        vh = (vh >> 1) ^ (t << 32);
+        ctx->hl[i] = vl;
+        ctx->hh[i] = vh;
+    }
+    /* all other entries are sums of those */
+    for (unsigned i = 2; i <= 8; i *= 2) {
+        for (unsigned j = 1; j < i; j++) {
+            ctx->hh[i + j] = ctx->hh[i] ^ ctx->hh[j];
+            ctx->hl[i + j] = ctx->hl[i] ^ ctx->hl[j];
+        }
+    }
+}
+
+/* x = x * H, 4 bits at a time */
+static void _mult(const gcm_ctx_t *ctx, uint8_t x[GCM_BLOCK_SIZE])
+{
+    uint64_t zh, zl;
+    uint8_t idx = x[15] & 0xf;
+
+    zh = ctx->hh[idx];
+    zl = ctx->hl[idx];
+    for (int i = 15; i >= 0; i--) {
+        uint8_t lo = x[i] & 0xf, hi = x[i] >> 4, rem;
+
+        if (i != 15) {
+            rem = zl & 0xf;
+            zl = (zh << 60) | (zl >> 4);
+            zh = (zh >> 4) ^ (_last4[rem] << 48);
+            zh ^= ctx->hh[lo];
+            zl ^= ctx->hl[lo];
+        }
+        rem = zl & 0xf;
+        zl = (zh << 60) | (zl >> 4);
+        zh = (zh >> 4) ^ (_last4[rem] << 48);
+        zh ^= ctx->hh[hi];
+        zl ^= ctx->hl[hi];
+    }
+    _put_be64(x, zh);
+    _put_be64(&x[8], zl);
+}
+
+#ifdef MODULE_CRYPTO_AES_NI
+/* the stack of a native thread is not guaranteed to be aligned to 16 bytes */
+#define PCLMUL_FUNC     __attribute__((target("pclmul,ssse3,sse2"), force_align_arg_pointer))
+
+static int _pclmul = -1;
+
+static int _pclmul_available(void)
+{
+    if (_pclmul < 0) {
+        unsigned eax, ebx, ecx, edx;
+
+        _pclmul = (__get_cpuid(1, &eax, &ebx, &ecx, &edx) &&
+                   (ecx & bit_PCLMUL) && (ecx & bit_SSSE3)) ? 1 : 0;
+    }
+    return _pclmul;
+}
+
+/* carry-less multiplication and reduction as in Intel's white paper
+ * "Carry-Less Multiplication Instruction and its Usage for Computing the GCM
+ * Mode", on byte-reversed operands */
+PCLMUL_FUNC static void _ghash_pclmul(uint8_t x[GCM_BLOCK_SIZE],
+                                      const uint8_t h[GCM_BLOCK_SIZE],
+                                      const uint8_t *blocks, size_t numof)
+{
+    const __m128i bswap = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11,
+                                       12, 13, 14, 15);
+    __m128i a = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)x), bswap);
+    __m128i b = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)h), bswap);
+
+    for (; numof > 0; numof--, blocks += GCM_BLOCK_SIZE) {
+        __m128i t2, t3, t4, t5, t6, t7, t8, t9;
+
+        a = _mm_xor_si128(a, _mm_shuffle_epi8(
+                              _mm_loadu_si128((const __m128i *)blocks), bswap));
+        /* 256 bit product */
+        t3 = _mm_clmulepi64_si128(a, b, 0x00);
+        t4 = _mm_clmulepi64_si128(a, b, 0x10);
+        t5 = _mm_clmulepi64_si128(a, b, 0x01);
+        t6 = _mm_clmulepi64_si128(a, b, 0x11);
+        t4 = _mm_xor_si128(t4, t5);
+        t5 = _mm_slli_si128(t4, 8);
+        t4 = _mm_srli_si128(t4, 8);
+        t3 = _mm_xor_si128(t3, t5);
+        t6 = _mm_xor_si128(t6, t4);
+        /* shift left by one to account for the reflected bit order */
+        t7 = _mm_srli_epi32(t3, 31);
+        t8 = _mm_srli_epi32(t6, 31);
+        t3 = _mm_slli_epi32(t3, 1);
+        t6 = _mm_slli_epi32(t6, 1);
+        t9 = _mm_srli_si128(t7, 12);
+        t8 = _mm_slli_si128(t8, 4);
+        t7 = _mm_slli_si128(t7, 4);
+        t3 = _mm_or_si128(t3, t7);
+        t6 = _mm_or_si128(t6, t8);
+        t6 = _mm_or_si128(t6, t9);
+        /* reduction modulo x^128 + x^7 + x^2 + x + 1 */
+        t7 = _mm_slli_epi32(t3, 31);
+        t8 = _mm_slli_epi32(t3, 30);
+        t9 = _mm_slli_epi32(t3, 25);
+        t7 = _mm_xor_si128(t7, t8);
+        t7 = _mm_xor_si128(t7, t9);
+        t8 = _mm_srli_si128(t7, 4);
+        t7 = _mm_slli_si128(t7, 12);
+        t3 = _mm_xor_si128(t3, t7);
+        t2 = _mm_srli_epi32(t3, 1);
+        t4 = _mm_srli_epi32(t3, 2);
+        t5 = _mm_srli_epi32(t3, 7);
+        t2 = _mm_xor_si128(t2, t4);
+        t2 = _mm_xor_si128(t2, t5);
+        t2 = _mm_xor_si128(t2, t8);
+        t3 = _mm_xor_si128(t3, t2);
+        a = _mm_xor_si128(t6, t3);
+    }
+    _mm_storeu_si128((__m128i *)x, _mm_shuffle_epi8(a, bswap));
+}
+#endif
+
+/* feeds whole blocks into GHASH */
+static void _ghash(gcm_ctx_t *ctx, const uint8_t *blocks, size_t numof)
+{
+#ifdef MODULE_CRYPTO_AES_NI
+    if (_pclmul_available()) {
+        _ghash_pclmul(ctx->x, ctx->h, blocks, numof);
+        return;
+    }
+#endif
+    for (; numof > 0; numof--, blocks += GCM_BLOCK_SIZE) {
+        crypto_xor(ctx->x, ctx->x, blocks, GCM_BLOCK_SIZE);
+        _mult(ctx, ctx->x);
+    }
+}
+
+/* feeds data of arbitrary length into GHASH, a partial block is completed
+ * with zeros by _ghash_pad() */
+static void _ghash_bytes(gcm_ctx_t *ctx, const uint8_t *data, size_t len)
+{
+    while (len > 0) {
+        if ((ctx->pos == 0) && (len >= GCM_BLOCK_SIZE)) {
+            size_t numof = len / GCM_BLOCK_SIZE;
+
+            _ghash(ctx, data, numof);
+            data += numof * GCM_BLOCK_SIZE;
+            len -= numof * GCM_BLOCK_SIZE;
+            continue;
+        }
+        ctx->x[ctx->pos++] ^= *(data++);
+        len--;
+        if (ctx->pos == GCM_BLOCK_SIZE) {
+            _ghash(ctx, _zero, 1);
+            ctx->pos = 0;
+        }
+    }
+}
+
+static void _ghash_pad(gcm_ctx_t *ctx)
+{
+    if (ctx->pos != 0) {
+        _ghash(ctx, _zero, 1);
+        ctx->pos = 0;
+    }
+}
+
+static void _start_text(gcm_ctx_t *ctx)
+{
+    if (!ctx->text) {
+        _ghash_pad(ctx);
+        ctx->text = true;
+    }
+}
+
+/* processes the keystream of the current block, at most up to its end */
+static void _update_bytes(gcm_ctx_t *ctx, const uint8_t *input, size_t len,
+                          uint8_t *output, bool encrypt)
+{
+    for (size_t i = 0; i < len; i++) {
+        uint8_t in = input[i], out = in ^ ctx->stream[ctx->pos];
+
+        output[i] = out;
+        ctx->x[ctx->pos++] ^= encrypt ? out : in;
+    }
+    if (ctx->pos == GCM_BLOCK_SIZE) {
+        _ghash(ctx, _zero, 1);
+        ctx->pos = 0;
+    }
+}
+
+static int _update(gcm_ctx_t *ctx, const uint8_t *input, size_t len,
+                   uint8_t *output, bool encrypt)
+{
+    size_t offset = 0;
+    /* words, so the keystream can be XORed word-wise */
+    uint32_t stream[CIPHER_BATCH_BLOCKS * GCM_BLOCK_SIZE / sizeof(uint32_t)];
+    uint8_t *stream_blocks = (uint8_t *)stream;
+
+    _start_text(ctx);
+    ctx->text_len += len;
+
+    /* use up the keystream of a partially processed block */
+    if (ctx->pos != 0) {
+        offset = GCM_BLOCK_SIZE - ctx->pos;
+        if (offset > len) {
+            offset = len;
+        }
+        _update_bytes(ctx, input, offset, output, encrypt);
+    }
+
+    /* whole blocks, the keystream of several blocks is computed at once */
+    while ((len - offset) >= GCM_BLOCK_SIZE) {
+        size_t numof = (len - offset) / GCM_BLOCK_SIZE;
+
+        if (numof > CIPHER_BATCH_BLOCKS) {
+            numof = CIPHER_BATCH_BLOCKS;
+        }
+        crypto_block_fill_ctr(stream_blocks, ctx->counter, COUNTER_LEN, numof);
+        if (cipher_encrypt_blocks(ctx->cipher, stream_blocks, stream_blocks,
+                                  numof) != 1) {
+            return CIPHER_ERR_ENC_FAILED;
+        }
+        /* GHASH always runs over the ciphertext, hash it before it is
+         * possibly overwritten by the plaintext */
+        if (!encrypt) {
+            _ghash(ctx, input + offset, numof);
+        }
+        crypto_xor(output + offset, input + offset, stream_blocks,
+                   numof * GCM_BLOCK_SIZE);
+        if (encrypt) {
+            _ghash(ctx, output + offset, numof);
+        }
+        offset += numof * GCM_BLOCK_SIZE;
+    }
+
+    /* the start of the next block, its keystream is kept for the next call */
+    if (offset < len) {
+        crypto_block_fill_ctr(ctx->stream, ctx->counter, COUNTER_LEN, 1);
+        if (cipher_encrypt(ctx->cipher, ctx->stream, ctx->stream) != 1) {
+            return CIPHER_ERR_ENC_FAILED;
+        }
+        _update_bytes(ctx, input + offset, len - offset, output + offset,
+                      encrypt);
+    }
+
+    return len;
+}
+
+static int _compute_tag(gcm_ctx_t *ctx, uint8_t tag[GCM_BLOCK_SIZE])
+{
+    uint8_t len_block[GCM_BLOCK_SIZE];
+
+    _start_text(ctx);
+    _ghash_pad(ctx);
+    _put_be64(len_block, ctx->aad_len * 8);
+    _put_be64(&len_block[8], ctx->text_len * 8);
+    _ghash(ctx, len_block, 1);
+
+    if (cipher_encrypt(ctx->cipher, ctx->j0, tag) != 1) {
+        return CIPHER_ERR_ENC_FAILED;
+    }
+    crypto_xor(tag, tag, ctx->x, GCM_BLOCK_SIZE);
+    return 0;
+}
+
+int gcm_init(gcm_ctx_t *ctx, const cipher_t *cipher, const uint8_t *iv,
+             size_t iv_len)
+{
+    assert(cipher_get_block_size(cipher) == GCM_BLOCK_SIZE);
+
+    if (iv_len == 0) {
+        return GCM_ERR_INVALID_IV_LENGTH;
+    }
+    memset(ctx, 0, sizeof(gcm_ctx_t));
+    ctx->cipher = cipher;
+
+    /* hash subkey H = E(K, 0^128) */
+    if (cipher_encrypt(cipher, _zero, ctx->h) != 1) {
+        return CIPHER_ERR_ENC_FAILED;
+    }
+    _gen_table(ctx);
+
+    if (iv_len == 12) {
+        memcpy(ctx->j0, iv, iv_len);
+        ctx->j0[15] = 1;
+    }
+    else {
+        uint8_t len_block[GCM_BLOCK_SIZE] = { 0 };
+
+        /* J0 = GHASH(IV || 0^s || [len(IV)]_128) */
+        _ghash_bytes(ctx, iv, iv_len);
+        _ghash_pad(ctx);
+        _put_be64(&len_block[8], (uint64_t)iv_len * 8);
+        _ghash(ctx, len_block, 1);
+        memcpy(ctx->j0, ctx->x, GCM_BLOCK_SIZE);
+        memset(ctx->x, 0, GCM_BLOCK_SIZE);
+    }
+    memcpy(ctx->counter, ctx->j0, GCM_BLOCK_SIZE);
+    crypto_block_inc_ctr(ctx->counter, COUNTER_LEN);
+
+    return 0;
+}
+
+void gcm_update_aad(gcm_ctx_t *ctx, const uint8_t *aad, size_t aad_len)
+{
+    assert(!ctx->text);
+
+    ctx->aad_len += aad_len;
+    _ghash_bytes(ctx, aad, aad_len);
+}
+
+int gcm_encrypt_update(gcm_ctx_t *ctx, const uint8_t *input, size_t input_len,
+                       uint8_t *output)
+{
+    return _update(ctx, input, input_len, output, true);
+}
+
+int gcm_decrypt_update(gcm_ctx_t *ctx, const uint8_t *input, size_t input_len,
+                       uint8_t *output)
+{
+    return _update(ctx, input, input_len, output, false);
+}
+
+int gcm_finish(gcm_ctx_t *ctx, uint8_t *tag, size_t tag_len)
+{
+    uint8_t full_tag[GCM_BLOCK_SIZE];
+    int res;
+
+    if ((tag_len < GCM_TAG_LEN_MIN) || (tag_len > GCM_BLOCK_SIZE)) {
+        return GCM_ERR_INVALID_TAG_LENGTH;
+    }
+    res = _compute_tag(ctx, full_tag);
+    if (res < 0) {
+        return res;
+    }
+    memcpy(tag, full_tag, tag_len);
+    return 0;
+}
+
+int gcm_verify(gcm_ctx_t *ctx, const uint8_t *tag, size_t tag_len)
+{
+    uint8_t full_tag[GCM_BLOCK_SIZE], diff = 0;
+    int res;
+
+    if ((tag_len < GCM_TAG_LEN_MIN) || (tag_len > GCM_BLOCK_SIZE)) {
+        return GCM_ERR_INVALID_TAG_LENGTH;
+    }
+    res = _compute_tag(ctx, full_tag);
+    if (res < 0) {
+        return res;
+    }
+    /* compare in constant time */
+    for (size_t i = 0; i < tag_len; i++) {
+        diff |= full_tag[i] ^ tag[i];
+    }
+    return (diff == 0) ? 0 : GCM_ERR_INVALID_TAG;
+}
+
+int cipher_encrypt_gcm(const cipher_t* cipher, const uint8_t* auth_data,
+                       size_t auth_data_len, uint8_t tag_len,
+                       const uint8_t* iv, size_t iv_len,
+                       const uint8_t* input, size_t input_len, uint8_t* output)
+{
+    gcm_ctx_t ctx;
+    int res;
+
+    if ((tag_len < GCM_TAG_LEN_MIN) || (tag_len > GCM_BLOCK_SIZE)) {
+        return GCM_ERR_INVALID_TAG_LENGTH;
+    }
+    res = gcm_init(&ctx, cipher, iv, iv_len);
+    if (res < 0) {
+        return res;
+    }
+    gcm_update_aad(&ctx, auth_data, auth_data_len);
+    res = gcm_encrypt_update(&ctx, input, input_len, output);
+    if (res < 0) {
+        return res;
+    }
+    res = gcm_finish(&ctx, output + input_len, tag_len);
+    if (res < 0) {
+        return res;
+    }
+    return input_len + tag_len;
+}
+
+int cipher_decrypt_gcm(const cipher_t* cipher, const uint8_t* auth_data,
+                       size_t auth_data_len, uint8_t tag_len,
+                       const uint8_t* iv, size_t iv_len,
+                       const uint8_t* input, size_t input_len, uint8_t* output)
+{
+    gcm_ctx_t ctx;
+    size_t plain_len;
+    int res;
+
+    if ((tag_len < GCM_TAG_LEN_MIN) || (tag_len > GCM_BLOCK_SIZE)) {
+        return GCM_ERR_INVALID_TAG_LENGTH;
+    }
+    if (input_len < tag_len) {
+        return GCM_ERR_INVALID_DATA_LENGTH;
+    }
+    plain_len = input_len - tag_len;
+    res = gcm_init(&ctx, cipher, iv, iv_len);
+    if (res < 0) {
+        return res;
+    }
+    gcm_update_aad(&ctx, auth_data, auth_data_len);
+    res = gcm_decrypt_update(&ctx, input, plain_len, output);
+    if (res < 0) {
+        return res;
+    }
+    res = gcm_verify(&ctx, input + plain_len, tag_len);
+    if (res < 0) {
+        memset(output, 0, plain_len);
+        return res;
+    }
+    return plain_len;
+}
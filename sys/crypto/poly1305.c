@@ -0,0 +1,239 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_crypto
+ * @{
+ *
+ * @file
+ * @brief       Poly1305 one-time authenticator
+ *
+ * The arithmetic modulo 2^130 - 5 uses five 26 bit limbs, so all products fit
+ * into 64 bit also on 32 bit platforms.
+ *
+ * @}
+ */
+
+#include <string.h>
+
+#include "crypto/poly1305.h"
+
+#define LIMB_MASK   (0x3ffffffU)
+
+static uint32_t _get_le32(const uint8_t *buf)
+{
+    return (uint32_t)buf[0] | ((uint32_t)buf[1] << 8) |
+           ((uint32_t)buf[2] << 16) | ((uint32_t)buf[3] << 24);
+}
+
+static void _put_le32(uint8_t *buf, uint32_t val)
+{
+    buf[0] = val;
+    buf[1] = val >> 8;
+    buf[2] = val >> 16;
+    buf[3] = val >> 24;
+}
+
+/* hibit is the 2^128 bit of the blocks, which is only missing for a padded
+ * final block */
+static void _blocks(poly1305_ctx_t *ctx, const uint8_t *data, size_t len,
+                    uint32_t hibit)
+{
+    const uint32_t r0 = ctx->r[0], r1 = ctx->r[1], r2 = ctx->r[2],
+                   r3 = ctx->r[3], r4 = ctx->r[4];
+    const uint32_t s1 = r1 * 5, s2 = r2 * 5, s3 = r3 * 5, s4 = r4 * 5;
+    uint32_t h0 = ctx->h[0], h1 = ctx->h[1], h2 = ctx->h[2],
+             h3 = ctx->h[3], h4 = ctx->h[4];
+
+    for (; len >= 16; len -= 16, data += 16) {
+        uint64_t d0, d1, d2, d3, d4;
+        uint32_t c;
+
+        /* h += m */
+        h0 += _get_le32(&data[0]) & LIMB_MASK;
+        h1 += (_get_le32(&data[3]) >> 2) & LIMB_MASK;
+        h2 += (_get_le32(&data[6]) >> 4) & LIMB_MASK;
+        h3 += (_get_le32(&data[9]) >> 6) & LIMB_MASK;
+        h4 += (_get_le32(&data[12]) >> 8) | hibit;
+
+        /* h *= r, the limbs above 2^130 wrap around multiplied by 5 */
+        d0 = ((uint64_t)h0 * r0) + ((uint64_t)h1 * s4) + ((uint64_t)h2 * s3) +
+             ((uint64_t)h3 * s2) + ((uint64_t)h4 * s1);
+        d1 = ((uint64_t)h0 * r1) + ((uint64_t)h1 * r0) + ((uint64_t)h2 * s4) +
+             ((uint64_t)h3 * s3) + ((uint64_t)h4 * s2);
+        d2 = ((uint64_t)h0 * r2) + ((uint64_t)h1 * r1) + ((uint64_t)h2 * r0) +
+             ((uint64_t)h3 * s4) + ((uint64_t)h4 * s3);
+        d3 = ((uint64_t)h0 * r3) + ((uint64_t)h1 * r2) + ((uint64_t)h2 * r1) +
+             ((uint64_t)h3 * r0) + ((uint64_t)h4 * s4);
+        d4 = ((uint64_t)h0 * r4) + ((uint64_t)h1 * r3) + ((uint64_t)h2 * r2) +
+             ((uint64_t)h3 * r1) + ((uint64_t)h4 * r0);
+
+        /* partial carry propagation */
+        c = (uint32_t)(d0 >> 26);
+        h0 = (uint32_t)d0 & LIMB_MASK;
+        d1 += c;
+        c = (uint32_t)(d1 >> 26);
+        h1 = (uint32_t)d1 & LIMB_MASK;
+        d2 += c;
+        c = (uint32_t)(d2 >> 26);
+        h2 = (uint32_t)d2 & LIMB_MASK;
+        d3 += c;
+        c = (uint32_t)(d3 >> 26);
+        h3 = (uint32_t)d3 & LIMB_MASK;
+        d4 += c;
+        c = (uint32_t)(d4 >> 26);
+        h4 = (uint32_t)d4 & LIMB_MASK;
+        h0 += c * 5;
+        c = h0 >> 26;
+        h0 &= LIMB_MASK;
+        h1 += c;
+    }
+
+    ctx->h[0] = h0;
+    ctx->h[1] = h1;
+    ctx->h[2] = h2;
+    ctx->h[3] = h3;
+    ctx->h[4] = h4;
+}
+
+void poly1305_init(poly1305_ctx_t *ctx, const uint8_t key[POLY1305_KEY_SIZE])
+{
+    memset(ctx, 0, sizeof(poly1305_ctx_t));
+    /* r &= 0xffffffc0ffffffc0ffffffc0fffffff */
+    ctx->r[0] = _get_le32(&key[0]) & 0x3ffffff;
+    ctx->r[1] = (_get_le32(&key[3]) >> 2) & 0x3ffff03;
+    ctx->r[2] = (_get_le32(&key[6]) >> 4) & 0x3ffc0ff;
+    ctx->r[3] = (_get_le32(&key[9]) >> 6) & 0x3f03fff;
+    ctx->r[4] = (_get_le32(&key[12]) >> 8) & 0x00fffff;
+    for (unsigned i = 0; i < 4; i++) {
+        ctx->pad[i] = _get_le32(&key[16 + (4 * i)]);
+    }
+}
+
+void poly1305_update(poly1305_ctx_t *ctx, const uint8_t *data, size_t len)
+{
+    if (ctx->leftover > 0) {
+        size_t want = sizeof(ctx->buf) - ctx->leftover;
+
+        if (want > len) {
+            want = len;
+        }
+        memcpy(&ctx->buf[ctx->leftover], data, want);
+        ctx->leftover += want;
+        data += want;
+        len -= want;
+        if (ctx->leftover < sizeof(ctx->buf)) {
+            return;
+        }
+        _blocks(ctx, ctx->buf, sizeof(ctx->buf), 1UL << 24);
+        ctx->leftover = 0;
+    }
+    if (len >= 16) {
+        size_t full = len & ~((size_t)15);
+
+        _blocks(ctx, data, full, 1UL << 24);
+        data += full;
+        len -= full;
+    }
+    memcpy(ctx->buf, data, len);
+    ctx->leftover = len;
+}
+
+void poly1305_finish(poly1305_ctx_t *ctx, uint8_t tag[POLY1305_TAG_SIZE])
+{
+    uint32_t h0, h1, h2, h3, h4, g0, g1, g2, g3, g4, c, mask;
+    uint64_t f;
+
+    /* the final partial block is terminated by a 1 byte instead of the
+     * 2^128 bit */
+    if (ctx->leftover > 0) {
+        ctx->buf[ctx->leftover] = 1;
+        memset(&ctx->buf[ctx->leftover + 1], 0,
+               sizeof(ctx->buf) - ctx->leftover - 1);
+        _blocks(ctx, ctx->buf, sizeof(ctx->buf), 0);
+    }
+
+    /* full carry propagation */
+    h0 = ctx->h[0];
+    h1 = ctx->h[1];
+    h2 = ctx->h[2];
+    h3 = ctx->h[3];
+    h4 = ctx->h[4];
+    c = h1 >> 26;
+    h1 &= LIMB_MASK;
+    h2 += c;
+    c = h2 >> 26;
+    h2 &= LIMB_MASK;
+    h3 += c;
+    c = h3 >> 26;
+    h3 &= LIMB_MASK;
+    h4 += c;
+    c = h4 >> 26;
+    h4 &= LIMB_MASK;
+    h0 += c * 5;
+    c = h0 >> 26;
+    h0 &= LIMB_MASK;
+    h1 += c;
+
+    /* g = h + -p = h - (2^130 - 5) */
+    g0 = h0 + 5;
+    c = g0 >> 26;
+    g0 &= LIMB_MASK;
+    g1 = h1 + c;
+    c = g1 >> 26;
+    g1 &= LIMB_MASK;
+    g2 = h2 + c;
+    c = g2 >> 26;
+    g2 &= LIMB_MASK;
+    g3 = h3 + c;
+    c = g3 >> 26;
+    g3 &= LIMB_MASK;
+    g4 = h4 + c - (1UL << 26);
+
+    /* select h if h < p, else g, in constant time */
+    mask = (g4 >> 31) - 1;
+    g0 &= mask;
+    g1 &= mask;
+    g2 &= mask;
+    g3 &= mask;
+    g4 &= mask;
+    mask = ~mask;
+    h0 = (h0 & mask) | g0;
+    h1 = (h1 & mask) | g1;
+    h2 = (h2 & mask) | g2;
+    h3 = (h3 & mask) | g3;
+    h4 = (h4 & mask) | g4;
+
+    /* h = h % 2^128 */
+    h0 = h0 | (h1 << 26);
+    h1 = (h1 >> 6) | (h2 << 20);
+    h2 = (h2 >> 12) | (h3 << 14);
+    h3 = (h3 >> 18) | (h4 << 8);
+
+    /* tag = (h + s) % 2^128 */
+    f = (uint64_t)h0 + ctx->pad[0];
+    _put_le32(&tag[0], f);
+    f = (uint64_t)h1 + ctx->pad[1] + (f >> 32);
+    _put_le32(&tag[4], f);
+    f = (uint64_t)h2 + ctx->pad[2] + (f >> 32);
+    _put_le32(&tag[8], f);
+    f = (uint64_t)h3 + ctx->pad[3] + (f >> 32);
+    _put_le32(&tag[12], f);
+
+    memset(ctx, 0, sizeof(poly1305_ctx_t));
+}
+
+void poly1305_auth(uint8_t tag[POLY1305_TAG_SIZE], const uint8_t *data,
+                   size_t len, const uint8_t key[POLY1305_KEY_SIZE])
+{
+    poly1305_ctx_t ctx;
+
+    poly1305_init(&ctx, key);
+    poly1305_update(&ctx, data, len);
+    poly1305_finish(&ctx, tag);
+}
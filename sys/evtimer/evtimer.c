@@ -141,6 +141,38 @@ void evtimer_add(evtimer_t *evtimer, evtimer_event_t *event)
     }
 }
 
+uint32_t evtimer_add_coalesced(evtimer_t *evtimer, evtimer_event_t *event,
+                               uint32_t slack)
+{
+    uint32_t delta_sum = 0, delay = 0;
+    unsigned state = irq_disable();
+
+    _update_head_offset(evtimer);
+    /* find the first event that expires no earlier than this one */
+    for (evtimer_event_t *list = evtimer->events; list; list = list->next) {
+        delta_sum += list->offset;
+        if (delta_sum >= event->offset) {
+            if ((delta_sum - event->offset) <= slack) {
+                delay = delta_sum - event->offset;
+                event->offset = delta_sum;
+            }
+            break;
+        }
+    }
+    DEBUG("evtimer_add_coalesced(): adding event with offset %" PRIu32
+          " (deferred by %" PRIu32 ")\n", event->offset, delay);
+    evtimer_add_event_to_list(evtimer, event);
+    if (evtimer->events == event) {
+        _set_timer(&evtimer->timer, event->offset);
+    }
+    irq_restore(state);
+    if (sched_context_switch_request) {
+        thread_yield_higher();
+    }
+
+    return delay;
+}
+
 void evtimer_del(evtimer_t *evtimer, evtimer_event_t *event)
 {
     unsigned state = irq_disable();
@@ -153,6 +185,24 @@ void evtimer_del(evtimer_t *evtimer, evtimer_event_t *event)
     irq_restore(state);
 }
 
+uint32_t evtimer_remaining(evtimer_t *evtimer, const evtimer_event_t *event)
+{
+    uint32_t offset = 0;
+    unsigned state = irq_disable();
+
+    _update_head_offset(evtimer);
+    for (evtimer_event_t *list = evtimer->events; list; list = list->next) {
+        offset += list->offset;
+        if (list == event) {
+            irq_restore(state);
+            return offset;
+        }
+    }
+    irq_restore(state);
+
+    return UINT32_MAX;
+}
+
 static evtimer_event_t *_get_next(evtimer_t *evtimer)
 {
     evtimer_event_t *event = evtimer->events;
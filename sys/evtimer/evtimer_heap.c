@@ -0,0 +1,291 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_evtimer
+ * @{
+ *
+ * @file
+ * @brief       event timer implementation based on a pairing heap
+ *
+ * Events are ordered by their absolute deadline in a pairing heap, kept as a
+ * tree of first children and next siblings. The first child of an event points
+ * back to its parent, all other children to their previous sibling, so an
+ * event can be cut out of the heap without searching for it.
+ *
+ * @}
+ */
+
+#include <stdbool.h>
+
+#include "div.h"
+#include "irq.h"
+#include "xtimer.h"
+
+#include "evtimer.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+static evtimer_event_t *_meld(evtimer_event_t *a, evtimer_event_t *b)
+{
+    if (b->deadline < a->deadline) {
+        evtimer_event_t *tmp = a;
+
+        a = b;
+        b = tmp;
+    }
+    /* b becomes the first child of a */
+    b->prev = a;
+    b->next = a->child;
+    if (a->child) {
+        a->child->prev = b;
+    }
+    a->child = b;
+
+    return a;
+}
+
+/* two-pass pairing of a list of siblings into a single heap */
+static evtimer_event_t *_merge_pairs(evtimer_event_t *first)
+{
+    evtimer_event_t *pairs = NULL, *heap = NULL;
+
+    /* meld pairs from left to right, pushing them onto a stack */
+    while (first) {
+        evtimer_event_t *a = first, *b = first->next;
+
+        if (b) {
+            first = b->next;
+            b->next = b->prev = NULL;
+            a->next = a->prev = NULL;
+            a = _meld(a, b);
+        }
+        else {
+            first = NULL;
+            a->prev = NULL;
+        }
+        a->next = pairs;
+        pairs = a;
+    }
+    /* meld the pairs from right to left */
+    while (pairs) {
+        evtimer_event_t *a = pairs;
+
+        pairs = a->next;
+        a->next = NULL;
+        heap = (heap) ? _meld(heap, a) : a;
+    }
+
+    return heap;
+}
+
+/* every queued event but the root has a prev pointer, so an event that was
+ * never added must have a zero-initialized prev */
+static bool _queued(const evtimer_t *evtimer, const evtimer_event_t *event)
+{
+    return (event == evtimer->events) || (event->prev != NULL);
+}
+
+static void _remove(evtimer_t *evtimer, evtimer_event_t *event)
+{
+    evtimer_event_t *children = event->child;
+
+    if (event == evtimer->events) {
+        evtimer->events = NULL;
+    }
+    else {
+        /* cut the event and its children out of the heap */
+        if (event->prev->child == event) {
+            event->prev->child = event->next;
+        }
+        else {
+            event->prev->next = event->next;
+        }
+        if (event->next) {
+            event->next->prev = event->prev;
+        }
+    }
+    event->next = event->prev = event->child = NULL;
+
+    if (children) {
+        children = _merge_pairs(children);
+        evtimer->events = (evtimer->events) ? _meld(evtimer->events, children)
+                                            : children;
+    }
+}
+
+static void _insert(evtimer_t *evtimer, evtimer_event_t *event)
+{
+    event->next = event->prev = event->child = NULL;
+    evtimer->events = (evtimer->events) ? _meld(evtimer->events, event) : event;
+}
+
+/* next event in pre-order, skipping the children of event if skip is set */
+static evtimer_event_t *_heap_next(evtimer_event_t *event, bool skip)
+{
+    if (!skip && event->child) {
+        return event->child;
+    }
+    while (event) {
+        if (event->next) {
+            return event->next;
+        }
+        /* walk back over the previous siblings to the parent */
+        while (event->prev && (event->prev->child != event)) {
+            event = event->prev;
+        }
+        event = event->prev;
+    }
+    return NULL;
+}
+
+static void _update_timer(evtimer_t *evtimer)
+{
+    if (evtimer->events) {
+        uint64_t now = xtimer_now_usec64();
+        uint64_t deadline = evtimer->events->deadline;
+        uint64_t offset = (deadline > now) ? (deadline - now) : 0;
+        /* _xtimer_set64() takes ticks, not microseconds */
+        uint64_t ticks = _xtimer_ticks_from_usec64(offset);
+
+        DEBUG("evtimer: now=%" PRIu32 " setting xtimer to %" PRIu32 ":%" PRIu32 "\n",
+              (uint32_t)now, (uint32_t)(offset >> 32), (uint32_t)offset);
+        _xtimer_set64(&evtimer->timer, ticks, ticks >> 32);
+    }
+    else {
+        xtimer_remove(&evtimer->timer);
+    }
+}
+
+static void _add(evtimer_t *evtimer, evtimer_event_t *event, uint32_t slack,
+                 uint32_t *delay)
+{
+    event->deadline = xtimer_now_usec64() + ((uint64_t)event->offset * US_PER_MS);
+
+    if (slack > 0) {
+        uint64_t limit = event->deadline + ((uint64_t)slack * US_PER_MS);
+        evtimer_event_t *match = NULL;
+
+        /* find the earliest event between the deadline and the limit, skipping
+         * all subtrees that start after the limit */
+        for (evtimer_event_t *cur = evtimer->events; cur; ) {
+            if (cur->deadline > limit) {
+                cur = _heap_next(cur, true);
+                continue;
+            }
+            if ((cur->deadline >= event->deadline) &&
+                ((match == NULL) || (cur->deadline < match->deadline))) {
+                match = cur;
+            }
+            cur = _heap_next(cur, false);
+        }
+        if (match) {
+            *delay = (uint32_t)(match->deadline - event->deadline) / US_PER_MS;
+            event->deadline = match->deadline;
+        }
+    }
+
+    DEBUG("evtimer_add(): adding event with offset %" PRIu32 "\n", event->offset);
+    _insert(evtimer, event);
+    if (evtimer->events == event) {
+        _update_timer(evtimer);
+    }
+}
+
+void evtimer_add(evtimer_t *evtimer, evtimer_event_t *event)
+{
+    unsigned state = irq_disable();
+
+    _add(evtimer, event, 0, NULL);
+    irq_restore(state);
+    if (sched_context_switch_request) {
+        thread_yield_higher();
+    }
+}
+
+uint32_t evtimer_add_coalesced(evtimer_t *evtimer, evtimer_event_t *event,
+                               uint32_t slack)
+{
+    uint32_t delay = 0;
+    unsigned state = irq_disable();
+
+    _add(evtimer, event, slack, &delay);
+    irq_restore(state);
+    if (sched_context_switch_request) {
+        thread_yield_higher();
+    }
+
+    return delay;
+}
+
+void evtimer_del(evtimer_t *evtimer, evtimer_event_t *event)
+{
+    unsigned state = irq_disable();
+
+    DEBUG("evtimer_del(): removing event with offset %" PRIu32 "\n", event->offset);
+
+    if (_queued(evtimer, event)) {
+        bool head = (event == evtimer->events);
+
+        _remove(evtimer, event);
+        if (head) {
+            _update_timer(evtimer);
+        }
+    }
+    irq_restore(state);
+}
+
+uint32_t evtimer_remaining(evtimer_t *evtimer, const evtimer_event_t *event)
+{
+    uint64_t now;
+    uint32_t res = UINT32_MAX;
+    unsigned state = irq_disable();
+
+    if (_queued(evtimer, event)) {
+        now = xtimer_now_usec64();
+        res = (event->deadline > now) ? div_u64_by_125((event->deadline - now) >> 3) : 0;
+    }
+    irq_restore(state);
+
+    return res;
+}
+
+static void _evtimer_handler(void *arg)
+{
+    DEBUG("_evtimer_handler()\n");
+
+    evtimer_t *evtimer = (evtimer_t *)arg;
+    uint64_t now = xtimer_now_usec64();
+    evtimer_event_t *event;
+
+    /* handle all events that are due, including those added by a handler */
+    while ((event = evtimer->events) && (event->deadline <= now)) {
+        _remove(evtimer, event);
+        evtimer->callback(event);
+    }
+
+    _update_timer(evtimer);
+}
+
+void evtimer_init(evtimer_t *evtimer, evtimer_callback_t handler)
+{
+    evtimer->callback = handler;
+    evtimer->timer.callback = _evtimer_handler;
+    evtimer->timer.arg = (void *)evtimer;
+    evtimer->events = NULL;
+}
+
+void evtimer_print(const evtimer_t *evtimer)
+{
+    for (evtimer_event_t *event = evtimer->events; event;
+         event = _heap_next(event, false)) {
+        printf("ev deadline=%" PRIu32 ":%" PRIu32 "\n",
+               (uint32_t)(event->deadline >> 32), (uint32_t)event->deadline);
+    }
+}
@@ -50,6 +50,11 @@
 
 #include "hashes/sha256.h"
 
+#ifdef MODULE_HASHES_SHA_NI
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+
 #ifdef __BIG_ENDIAN__
 /* Copy a vector of big-endian uint32_t into a vector of bytes */
 #define be32enc_vect memcpy
@@ -160,6 +165,152 @@ static void sha256_transform(uint32_t *state, const unsigned char block[64])
     }
 }
 
+/*
+ * SHA256 block compression function for several independent states at once.
+ * The rounds of all lanes are interleaved, so the CPU can work on several
+ * independent dependency chains.  The message schedule is computed on the fly
+ * in a window of 16 words.
+ */
+static void sha256_transform_lanes(sha256_context_t *ctx,
+                                   const unsigned char *const block[],
+                                   unsigned lanes)
+{
+    uint32_t W[SHA256_MULTI_LANES][16];
+    uint32_t S[SHA256_MULTI_LANES][8];
+
+    for (unsigned l = 0; l < lanes; l++) {
+        be32dec_vect(W[l], block[l], 64);
+        memcpy(S[l], ctx[l].state, 32);
+    }
+
+    for (int i = 0; i < 64; ++i) {
+        for (unsigned l = 0; l < lanes; l++) {
+            uint32_t *w = W[l], *st = S[l];
+
+            if (i >= 16) {
+                w[i & 15] += s1(w[(i - 2) & 15]) + w[(i - 7) & 15] +
+                             s0(w[(i - 15) & 15]);
+            }
+
+            uint32_t e = st[(68 - i) % 8], f = st[(69 - i) % 8];
+            uint32_t g = st[(70 - i) % 8], h = st[(71 - i) % 8];
+            uint32_t t0 = h + S1(e) + Ch(e, f, g) + w[i & 15] + K[i];
+
+            uint32_t a = st[(64 - i) % 8], b = st[(65 - i) % 8];
+            uint32_t c = st[(66 - i) % 8], d = st[(67 - i) % 8];
+            uint32_t t1 = S0(a) + Maj(a, b, c);
+
+            st[(67 - i) % 8] = d + t0;
+            st[(71 - i) % 8] = t0 + t1;
+        }
+    }
+
+    for (unsigned l = 0; l < lanes; l++) {
+        for (int i = 0; i < 8; i++) {
+            ctx[l].state[i] += S[l][i];
+        }
+    }
+}
+
+#ifdef MODULE_HASHES_SHA_NI
+/* the stack of a native thread is not guaranteed to be aligned to 16 bytes */
+#define SHA_NI_FUNC     __attribute__((target("sha,sse4.1,ssse3"), force_align_arg_pointer))
+#define SHA_NI_INLINE   __attribute__((target("sha,sse4.1,ssse3"), always_inline)) static inline
+
+static int _sha_ni = -1;
+
+static int sha_ni_available(void)
+{
+    if (_sha_ni < 0) {
+        unsigned eax, ebx, ecx, edx;
+
+        _sha_ni = (__get_cpuid(1, &eax, &ebx, &ecx, &edx) &&
+                   (ecx & bit_SSE4_1) && (ecx & bit_SSSE3) &&
+                   __get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx) &&
+                   (ebx & bit_SHA)) ? 1 : 0;
+    }
+    return _sha_ni;
+}
+
+/*
+ * Four rounds.  Besides, the message schedule is advanced: msg[g % 4] holds
+ * the words of the current rounds, the words of the next rounds are finished
+ * and the words four rounds ahead are started.
+ */
+SHA_NI_INLINE void sha_ni_rounds(__m128i *state0, __m128i *state1,
+                                 __m128i msg[4], unsigned g)
+{
+    __m128i cur = msg[g % 4];
+    __m128i tmp = _mm_add_epi32(cur, _mm_loadu_si128((const __m128i *)&K[4 * g]));
+
+    *state1 = _mm_sha256rnds2_epu32(*state1, *state0, tmp);
+    if ((g >= 3) && (g <= 14)) {
+        __m128i *next = &msg[(g + 1) % 4];
+
+        *next = _mm_add_epi32(*next, _mm_alignr_epi8(cur, msg[(g + 3) % 4], 4));
+        *next = _mm_sha256msg2_epu32(*next, cur);
+    }
+    tmp = _mm_shuffle_epi32(tmp, 0x0e);
+    *state0 = _mm_sha256rnds2_epu32(*state0, *state1, tmp);
+    if ((g >= 1) && (g <= 12)) {
+        msg[(g + 3) % 4] = _mm_sha256msg1_epu32(msg[(g + 3) % 4], cur);
+    }
+}
+
+/*
+ * SHA256 block compression function using the SHA extensions of x86 CPUs,
+ * for several consecutive blocks.
+ */
+SHA_NI_FUNC static void sha_ni_transform(uint32_t *state,
+                                         const unsigned char *block,
+                                         size_t numof)
+{
+    const __m128i bswap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL,
+                                         0x0405060700010203ULL);
+    __m128i tmp, state0, state1;
+
+    /* the instructions expect the state as ABEF and CDGH */
+    tmp = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *)&state[0]), 0xb1);
+    state1 = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *)&state[4]), 0x1b);
+    state0 = _mm_alignr_epi8(tmp, state1, 8);
+    state1 = _mm_blend_epi16(state1, tmp, 0xf0);
+
+    for (; numof > 0; numof--, block += 64) {
+        __m128i abef = state0, cdgh = state1, msg[4];
+
+        for (unsigned i = 0; i < 4; i++) {
+            msg[i] = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)block + i),
+                                      bswap);
+        }
+        for (unsigned g = 0; g < 16; g++) {
+            sha_ni_rounds(&state0, &state1, msg, g);
+        }
+        state0 = _mm_add_epi32(state0, abef);
+        state1 = _mm_add_epi32(state1, cdgh);
+    }
+
+    tmp = _mm_shuffle_epi32(state0, 0x1b);
+    state1 = _mm_shuffle_epi32(state1, 0xb1);
+    _mm_storeu_si128((__m128i *)&state[0], _mm_blend_epi16(tmp, state1, 0xf0));
+    _mm_storeu_si128((__m128i *)&state[4], _mm_alignr_epi8(state1, tmp, 8));
+}
+#endif /* MODULE_HASHES_SHA_NI */
+
+/* Transforms consecutive blocks */
+static void sha256_transform_blocks(uint32_t *state, const unsigned char *block,
+                                    size_t numof)
+{
+#ifdef MODULE_HASHES_SHA_NI
+    if (sha_ni_available()) {
+        sha_ni_transform(state, block, numof);
+        return;
+    }
+#endif
+    for (; numof > 0; numof--, block += 64) {
+        sha256_transform(state, block);
+    }
+}
+
 static unsigned char PAD[64] = {
     0x80, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
     0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
@@ -204,12 +355,9 @@ void sha256_init(sha256_context_t *ctx)
     ctx->state[7] = 0x5BE0CD19;
 }
 
-/* Add bytes into the hash */
-void sha256_update(sha256_context_t *ctx, const void *data, size_t len)
+/* Adds the length of data to the number of bits processed so far */
+static void sha256_count(sha256_context_t *ctx, size_t len)
 {
-    /* Number of bytes left in the buffer from previous updates */
-    uint32_t r = (ctx->count[1] >> 3) & 0x3f;
-
     /* Convert the length into a number of bits */
     uint32_t bitlen1 = ((uint32_t) len) << 3;
     uint32_t bitlen0 = ((uint32_t) len) >> 29;
@@ -220,6 +368,17 @@ void sha256_update(sha256_context_t *ctx, const void *data, size_t len)
     }
 
     ctx->count[0] += bitlen0;
+}
+
+/* Add bytes into the hash */
+void sha256_update(sha256_context_t *ctx, const void *data, size_t len)
+{
+    /* Number of bytes left in the buffer from previous updates */
+    uint32_t r = (ctx->count[1] >> 3) & 0x3f;
+
+    const unsigned char *src = data;
+
+    sha256_count(ctx, len);
 
     /* Handle the case where we don't need to perform any transforms */
     if (len < 64 - r) {
@@ -227,21 +386,19 @@ void sha256_update(sha256_context_t *ctx, const void *data, size_t len)
         return;
     }
 
-    /* Finish the current block */
-    const unsigned char *src = data;
-
-    memcpy(&ctx->buf[r], src, 64 - r);
-    sha256_transform(ctx->state, ctx->buf);
-    src += 64 - r;
-    len -= 64 - r;
-
-    /* Perform complete blocks */
-    while (len >= 64) {
-        sha256_transform(ctx->state, src);
-        src += 64;
-        len -= 64;
+    /* Finish the current block, if there is one */
+    if (r > 0) {
+        memcpy(&ctx->buf[r], src, 64 - r);
+        sha256_transform_blocks(ctx->state, ctx->buf, 1);
+        src += 64 - r;
+        len -= 64 - r;
     }
 
+    /* Perform complete blocks directly from the input */
+    sha256_transform_blocks(ctx->state, src, len / 64);
+    src += len & ~((size_t)63);
+    len &= 63;
+
     /* Copy left over data into buffer */
     memcpy(ctx->buf, src, len);
 }
@@ -278,6 +435,51 @@ void *sha256(const void *data, size_t len, void *digest)
     return digest;
 }
 
+void sha256_multi(const void *const data[], const size_t len[],
+                  void *const digest[], size_t numof)
+{
+    for (size_t first = 0; first < numof; first += SHA256_MULTI_LANES) {
+        sha256_context_t ctx[SHA256_MULTI_LANES];
+        const unsigned char *src[SHA256_MULTI_LANES];
+        unsigned lanes = SHA256_MULTI_LANES;
+        size_t blocks = SIZE_MAX;
+
+        if (numof - first < lanes) {
+            lanes = numof - first;
+        }
+        for (unsigned l = 0; l < lanes; l++) {
+            sha256_init(&ctx[l]);
+            src[l] = data[first + l];
+            if (len[first + l] / 64 < blocks) {
+                blocks = len[first + l] / 64;
+            }
+        }
+
+        /* the complete blocks all messages have are hashed side by side */
+#ifdef MODULE_HASHES_SHA_NI
+        if (sha_ni_available()) {
+            for (unsigned l = 0; l < lanes; l++) {
+                sha_ni_transform(ctx[l].state, src[l], blocks);
+                src[l] += blocks * 64;
+            }
+        }
+        else
+#endif
+        for (size_t b = 0; b < blocks; b++) {
+            sha256_transform_lanes(ctx, src, lanes);
+            for (unsigned l = 0; l < lanes; l++) {
+                src[l] += 64;
+            }
+        }
+
+        /* the rest of every message is hashed on its own */
+        for (unsigned l = 0; l < lanes; l++) {
+            sha256_count(&ctx[l], blocks * 64);
+            sha256_update(&ctx[l], src[l], len[first + l] - (blocks * 64));
+            sha256_final(&ctx[l], digest[first + l]);
+        }
+    }
+}
 
 void hmac_sha256_init(hmac_context_t *ctx, const void *key, size_t key_length)
 {
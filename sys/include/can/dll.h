@@ -62,6 +62,21 @@ int can_dll_register_candev(candev_dev_t *candev);
  */
 int can_dll_dispatch_rx_frame(struct can_frame *frame, kernel_pid_t pid);
 
+/**
+ * @brief Dispatch several received frames
+ *
+ * Same as can_dll_dispatch_rx_frame() for @p numof frames received at once
+ * from the device identified by its @p pid
+ *
+ * @param[in] frames the received frames
+ * @param[in] numof  the number of frames in @p frames
+ * @param[in] pid    the pid of the receiver device
+ *
+ * @return 0 on success
+ * @return -ENOMEM if at least one frame could not be dispatched
+ */
+int can_dll_dispatch_rx_frames(struct can_frame *frames, size_t numof, kernel_pid_t pid);
+
 /**
  * @brief Dispatch a tx confirmation
  *
@@ -31,6 +31,12 @@ extern "C" {
 #include "xtimer.h"
 #include "net/gnrc/pktbuf.h"
 
+#ifndef CAN_ISOTP_TX_WINDOW
+/**
+ * @brief Max number of consecutive frames in flight in high throughput mode
+ */
+#define CAN_ISOTP_TX_WINDOW (8U)
+#endif
 
 /**
  * @brief The isotp_fc_options struct
@@ -95,6 +101,14 @@ struct isotp {
     can_reg_entry_t entry;         /**< entry containing ifnum and upper layer msg system */
     uint32_t tx_gap;               /**< transmit gap from fc (in us) */
     uint8_t tx_wft;                /**< transmit wait counter */
+    uint8_t tx_head;               /**< first entry in @p tx_handles */
+    uint8_t tx_inflight;           /**< number of frames sent but not confirmed */
+    uint32_t tx_last;              /**< time the last CF was sent (in us) */
+    int tx_handles[CAN_ISOTP_TX_WINDOW]; /**< handles of the frames in flight, in
+                                              no particular order */
+    const struct iovec *rx_iov;    /**< receive buffers, NULL to use the pktbuf */
+    unsigned rx_iovcnt;            /**< number of buffers in @p rx_iov */
+    size_t rx_len;                 /**< length of the message received in @p rx_iov */
     void *arg;                     /**< upper layer private arg */
 };
 
@@ -108,6 +122,9 @@ struct isotp {
 #define CAN_ISOTP_TX_PADDING    0x0004     /**< enable CAN frame padding tx path */
 #define CAN_ISOTP_HALF_DUPLEX   0x0040     /**< half duplex error state handling */
 #define CAN_ISOTP_RX_EXT_ADDR   0x0200     /**< different rx extended addressing */
+#define CAN_ISOTP_HIGH_THROUGHPUT 0x1000   /**< keep up to @ref CAN_ISOTP_TX_WINDOW
+                                                CFs in flight, STmin is measured
+                                                between the CFs being sent */
 
 #define CAN_ISOTP_TX_FLAGS_MASK 0xFFFF0000 /**< tx flags mask */
 #define CAN_ISOTP_TX_DONT_WAIT  0x00010000 /**< do not send a tx confirmation msg */
@@ -178,6 +195,23 @@ int isotp_bind(struct isotp *isotp, can_reg_entry_t *entry, void *arg);
  */
 int isotp_release(struct isotp *isotp);
 
+/**
+ * @brief Set the buffers an isotp channel receives into
+ *
+ * Received messages are written directly to @p iov instead of being allocated
+ * in the pktbuf. The RX indication then carries a NULL @p data.iov_base and
+ * the length of the message in @p data.iov_len. The buffers are reused for the
+ * next message, so they must be read before the next first frame is received.
+ * Messages longer than the buffers are rejected with an overflow flow control.
+ *
+ * Must be called on a bound channel while no message is received.
+ *
+ * @param isotp           the channel
+ * @param iov             the buffers, NULL to go back to the pktbuf
+ * @param count           number of buffers in @p iov
+ */
+void isotp_set_rx_iov(struct isotp *isotp, const struct iovec *iov, unsigned count);
+
 /**
  * @brief Free a received buffer
  *
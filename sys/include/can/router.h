@@ -29,6 +29,21 @@ extern "C" {
 #include "can/can.h"
 #include "can/pkt.h"
 
+/**
+ * @brief Number of hash buckets per interface for filters of a single CAN ID
+ *
+ * Filters with @ref CAN_ROUTER_FULL_MASK are looked up by CAN ID, all other
+ * filters are checked for each received frame. Must be a power of 2.
+ */
+#ifndef CAN_ROUTER_BUCKETS_NUMOF
+#define CAN_ROUTER_BUCKETS_NUMOF    (16)
+#endif
+
+/**
+ * @brief Mask of a filter that matches a single CAN ID
+ */
+#define CAN_ROUTER_FULL_MASK        (0xFFFFFFFFU)
+
 /**
  * @brief Register a user @p entry to receive a frame @p can_id
  *
@@ -0,0 +1,161 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_checksum_crc CRC-32, CRC-32C and CRC-16 (table driven)
+ * @ingroup     sys_checksum
+ *
+ * @brief       Table driven CRC engine for reflected CRCs of up to 32 bit
+ * @details     The engine processes eight bytes per step using eight lookup
+ *              tables ("slice-by-8"). Each set of tables takes 8 KiB of ROM.
+ *              Defining CHECKSUM_CRC_SLICES to 1 falls back to the classic
+ *              byte-wise algorithm with a single 1 KiB table.
+ *
+ *              Ready-to-use variants are provided for
+ *              - CRC-32 (IEEE 802.3, zlib, PNG): crc32_calc()
+ *              - CRC-32C (Castagnoli, iSCSI, SCTP, ext4): crc32c_calc()
+ *              - CRC-16/KERMIT (IEEE 802.15.4 FCS): crc16_kermit_calc()
+ *
+ *              On native x86 hosts CRC-32C uses the SSE4.2 `crc32`
+ *              instruction if the CPU supports it.
+ *
+ *              All `*_update()` functions take the CRC of the preceding data,
+ *              so a message may be processed in chunks:
+ *
+ * @code
+ *  uint32_t crc = crc32_calc(part1, len1);
+ *  crc = crc32_update(crc, part2, len2);
+ * @endcode
+ *
+ *              Other reflected polynomials can be used with tables generated
+ *              by crc_table_init() and the raw engine crc_update().
+ *
+ * @{
+ * @file
+ */
+
+#ifndef CHECKSUM_CRC_H
+#define CHECKSUM_CRC_H
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Number of lookup tables per polynomial, either 8 or 1
+ */
+#ifndef CHECKSUM_CRC_SLICES
+#define CHECKSUM_CRC_SLICES     (8)
+#endif
+
+/**
+ * @brief   Lookup tables of a reflected polynomial
+ */
+typedef struct {
+    uint32_t t[CHECKSUM_CRC_SLICES][256];   /**< table n maps a byte to its
+                                             *   CRC followed by n zero bytes */
+} crc_table_t;
+
+/**
+ * @brief           Generate the lookup tables of a reflected polynomial
+ *
+ * @param[out] table    The tables to fill
+ * @param[in]  poly     The bit-reversed generator polynomial, e.g.
+ *                      0xedb88320 for CRC-32
+ */
+void crc_table_init(crc_table_t *table, uint32_t poly);
+
+/**
+ * @brief           Feed data into a CRC register
+ *
+ * This is the raw engine: neither the initial value nor the final XOR of an
+ * algorithm are applied.
+ *
+ * @param[in]  table    Lookup tables generated by crc_table_init()
+ * @param[in]  crc      The current value of the CRC register
+ * @param[in]  buf      Start of the memory area to checksum
+ * @param[in]  len      Number of bytes to checksum
+ *
+ * @return          The new value of the CRC register
+ */
+uint32_t crc_update(const crc_table_t *table, uint32_t crc,
+                    const uint8_t *buf, size_t len);
+
+/**
+ * @brief           Update CRC-32
+ *
+ * @param[in]  crc  The CRC-32 of the preceding data, 0 to start a new one
+ * @param[in]  buf  Start of the memory area to checksum
+ * @param[in]  len  Number of bytes to checksum
+ *
+ * @return          CRC-32 of the preceding data followed by @p buf
+ */
+uint32_t crc32_update(uint32_t crc, const uint8_t *buf, size_t len);
+
+/**
+ * @brief           Calculate CRC-32
+ *
+ * @param[in]  buf  Start of the memory area to checksum
+ * @param[in]  len  Number of bytes to checksum
+ *
+ * @return          CRC-32 of the specified memory area
+ */
+uint32_t crc32_calc(const uint8_t *buf, size_t len);
+
+/**
+ * @brief           Update CRC-32C
+ *
+ * @param[in]  crc  The CRC-32C of the preceding data, 0 to start a new one
+ * @param[in]  buf  Start of the memory area to checksum
+ * @param[in]  len  Number of bytes to checksum
+ *
+ * @return          CRC-32C of the preceding data followed by @p buf
+ */
+uint32_t crc32c_update(uint32_t crc, const uint8_t *buf, size_t len);
+
+/**
+ * @brief           Calculate CRC-32C
+ *
+ * @param[in]  buf  Start of the memory area to checksum
+ * @param[in]  len  Number of bytes to checksum
+ *
+ * @return          CRC-32C of the specified memory area
+ */
+uint32_t crc32c_calc(const uint8_t *buf, size_t len);
+
+/**
+ * @brief           Update CRC-16/KERMIT
+ *
+ * @param[in]  crc  The CRC of the preceding data, 0 to start a new one
+ * @param[in]  buf  Start of the memory area to checksum
+ * @param[in]  len  Number of bytes to checksum
+ *
+ * @return          CRC-16/KERMIT of the preceding data followed by @p buf
+ */
+uint16_t crc16_kermit_update(uint16_t crc, const uint8_t *buf, size_t len);
+
+/**
+ * @brief           Calculate CRC-16/KERMIT
+ *
+ * @param[in]  buf  Start of the memory area to checksum
+ * @param[in]  len  Number of bytes to checksum
+ *
+ * @return          CRC-16/KERMIT of the specified memory area
+ */
+uint16_t crc16_kermit_calc(const uint8_t *buf, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CHECKSUM_CRC_H */
+
+/** @} */
@@ -123,6 +123,97 @@ int aes_encrypt(const cipher_context_t *context, const uint8_t *plain_block,
 int aes_decrypt(const cipher_context_t *context, const uint8_t *cipher_block,
                 uint8_t *plain_block);
 
+/**
+ * @brief   encrypts consecutive plaintext blocks and saves the result in
+ *          cipher. The key schedule is only set up once for all blocks.
+ *
+ * @param       context       the cipher_context_t-struct to use for this
+ *                            encryption
+ * @param       plain         a pointer to @p numof plaintext blocks
+ * @param       cipher        a pointer to the place where the @p numof
+ *                            ciphertext blocks will be stored
+ * @param       numof         the number of blocks
+ *
+ * @return  1 or result of aes_set_encrypt_key if it failed
+ */
+int aes_encrypt_blocks(const cipher_context_t *context, const uint8_t *plain,
+                       uint8_t *cipher, size_t numof);
+
+/**
+ * @brief   decrypts consecutive ciphertext blocks and saves the result in
+ *          plain. The key schedule is only set up once for all blocks.
+ *
+ * @param       context       the cipher_context_t-struct to use for this
+ *                            decryption
+ * @param       cipher        a pointer to @p numof ciphertext blocks
+ * @param       plain         a pointer to the place where the @p numof
+ *                            plaintext blocks will be stored
+ * @param       numof         the number of blocks
+ *
+ * @return  1 or negative value if cipher key cannot be expanded into
+ *          decryption key schedule
+ */
+int aes_decrypt_blocks(const cipher_context_t *context, const uint8_t *cipher,
+                       uint8_t *plain, size_t numof);
+
+#if defined(MODULE_CRYPTO_AES_NI) || defined(DOXYGEN)
+/**
+ * @brief   checks if the host CPU supports the AES-NI instructions
+ *
+ * The AES functions above use the AES-NI backend automatically if it is
+ * available, so this is only needed to call the backend directly.
+ *
+ * @return  1 if the AES-NI instructions are available, 0 otherwise
+ */
+int aes_ni_available(void);
+
+/**
+ * @brief   encrypts consecutive blocks with AES-128 using AES-NI
+ *
+ * @pre aes_ni_available() returned 1
+ *
+ * @param       key           the AES_KEY_SIZE bytes long key
+ * @param       plain         a pointer to @p numof plaintext blocks
+ * @param       cipher        a pointer to the place where the @p numof
+ *                            ciphertext blocks will be stored, may be
+ *                            @p plain
+ * @param       numof         the number of blocks
+ */
+void aes_ni_encrypt_blocks(const uint8_t *key, const uint8_t *plain,
+                           uint8_t *cipher, size_t numof);
+
+/**
+ * @brief   decrypts consecutive blocks with AES-128 using AES-NI
+ *
+ * @pre aes_ni_available() returned 1
+ *
+ * @param       key           the AES_KEY_SIZE bytes long key
+ * @param       cipher        a pointer to @p numof ciphertext blocks
+ * @param       plain         a pointer to the place where the @p numof
+ *                            plaintext blocks will be stored, may be
+ *                            @p cipher
+ * @param       numof         the number of blocks
+ */
+void aes_ni_decrypt_blocks(const uint8_t *key, const uint8_t *cipher,
+                           uint8_t *plain, size_t numof);
+
+/**
+ * @brief   AES-128 using only the T-table implementation
+ *
+ * @ref CIPHER_AES_128 selects the implementation at runtime, this and
+ * @ref CIPHER_AES_128_NI allow to compare them.
+ */
+extern const cipher_id_t CIPHER_AES_128_TTABLE;
+
+/**
+ * @brief   AES-128 using only the AES-NI implementation
+ *
+ * cipher_init() returns CIPHER_ERR_BAD_CONTEXT_SIZE if the host CPU does not
+ * support AES-NI.
+ */
+extern const cipher_id_t CIPHER_AES_128_NI;
+#endif
+
 #ifdef __cplusplus
 }
 #endif
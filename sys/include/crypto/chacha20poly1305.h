@@ -0,0 +1,180 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_crypto
+ * @{
+ *
+ * @file
+ * @brief       ChaCha20-Poly1305 AEAD as specified in RFC 8439
+ *
+ * Besides the single-shot functions chacha20poly1305_encrypt() and
+ * chacha20poly1305_decrypt() there is an incremental API, which takes the data
+ * in chunks of arbitrary length:
+ *
+ * @code
+ *  chacha20poly1305_ctx_t ctx;
+ *
+ *  chacha20poly1305_init(&ctx, key, nonce);
+ *  chacha20poly1305_update_aad(&ctx, header, sizeof(header));
+ *  while (more_data) {
+ *      chacha20poly1305_encrypt_update(&ctx, chunk, chunk_len, out);
+ *  }
+ *  chacha20poly1305_finish(&ctx, tag);
+ * @endcode
+ *
+ * @warning A nonce must never be used twice with the same key. A message must
+ *          not be longer than 256 GiB.
+ */
+
+#ifndef CRYPTO_CHACHA20POLY1305_H
+#define CRYPTO_CHACHA20POLY1305_H
+
+#include <stdbool.h>
+
+#include "crypto/chacha.h"
+#include "crypto/poly1305.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CHACHA20POLY1305_KEY_BYTES      (32U)   /**< Key length in bytes */
+#define CHACHA20POLY1305_NONCE_BYTES    (12U)   /**< Nonce length in bytes */
+#define CHACHA20POLY1305_TAG_BYTES      (16U)   /**< Tag length in bytes */
+
+/**
+ * @brief   Context of an incremental ChaCha20-Poly1305 operation
+ */
+typedef struct {
+    /** @cond INTERNAL */
+    chacha_ctx chacha;
+    poly1305_ctx_t poly;
+    uint8_t stream[64];     /* keystream of the current block */
+    uint64_t aad_len;
+    uint64_t text_len;
+    uint8_t pos;            /* position in the current keystream block */
+    bool text;              /* the text has started */
+    /** @endcond */
+} chacha20poly1305_ctx_t;
+
+/**
+ * @brief   Starts an incremental ChaCha20-Poly1305 operation
+ *
+ * @param[out] ctx      The context to initialize
+ * @param[in]  key      The key
+ * @param[in]  nonce    The nonce
+ */
+void chacha20poly1305_init(chacha20poly1305_ctx_t *ctx,
+                           const uint8_t key[CHACHA20POLY1305_KEY_BYTES],
+                           const uint8_t nonce[CHACHA20POLY1305_NONCE_BYTES]);
+
+/**
+ * @brief   Adds additional data to authenticate
+ *
+ * May be called several times, but only before the first call of
+ * chacha20poly1305_encrypt_update() or chacha20poly1305_decrypt_update().
+ *
+ * @param[in,out] ctx       The context
+ * @param[in]     aad       Additional data to authenticate
+ * @param[in]     aad_len   Length of @p aad in bytes
+ */
+void chacha20poly1305_update_aad(chacha20poly1305_ctx_t *ctx,
+                                 const uint8_t *aad, size_t aad_len);
+
+/**
+ * @brief   Encrypts the next chunk of data
+ *
+ * @param[in,out] ctx       The context
+ * @param[in]     input     The plaintext
+ * @param[in]     len       Length of @p input in bytes
+ * @param[out]    output    The ciphertext, may be the same as @p input
+ */
+void chacha20poly1305_encrypt_update(chacha20poly1305_ctx_t *ctx,
+                                     const uint8_t *input, size_t len,
+                                     uint8_t *output);
+
+/**
+ * @brief   Decrypts the next chunk of data
+ *
+ * @warning The decrypted data is not authenticated before
+ *          chacha20poly1305_verify() succeeded.
+ *
+ * @param[in,out] ctx       The context
+ * @param[in]     input     The ciphertext
+ * @param[in]     len       Length of @p input in bytes
+ * @param[out]    output    The plaintext, may be the same as @p input
+ */
+void chacha20poly1305_decrypt_update(chacha20poly1305_ctx_t *ctx,
+                                     const uint8_t *input, size_t len,
+                                     uint8_t *output);
+
+/**
+ * @brief   Finishes an encryption and computes the tag
+ *
+ * @param[in,out] ctx       The context, it is cleared afterwards
+ * @param[out]    tag       The tag
+ */
+void chacha20poly1305_finish(chacha20poly1305_ctx_t *ctx,
+                             uint8_t tag[CHACHA20POLY1305_TAG_BYTES]);
+
+/**
+ * @brief   Finishes a decryption and verifies the tag
+ *
+ * @param[in,out] ctx       The context, it is cleared afterwards
+ * @param[in]     tag       The received tag
+ *
+ * @return  true if the tag is valid
+ */
+bool chacha20poly1305_verify(chacha20poly1305_ctx_t *ctx,
+                             const uint8_t tag[CHACHA20POLY1305_TAG_BYTES]);
+
+/**
+ * @brief   Encrypts and authenticates a message
+ *
+ * @param[out] cipher   The ciphertext followed by the tag, of size
+ *                      @p msglen + CHACHA20POLY1305_TAG_BYTES
+ * @param[in]  msg      The plaintext
+ * @param[in]  msglen   Length of @p msg in bytes
+ * @param[in]  aad      Additional data to authenticate
+ * @param[in]  aadlen   Length of @p aad in bytes
+ * @param[in]  key      The key
+ * @param[in]  nonce    The nonce
+ */
+void chacha20poly1305_encrypt(uint8_t *cipher, const uint8_t *msg,
+                              size_t msglen, const uint8_t *aad, size_t aadlen,
+                              const uint8_t *key, const uint8_t *nonce);
+
+/**
+ * @brief   Verifies and decrypts a message
+ *
+ * The plaintext is cleared if the tag is invalid.
+ *
+ * @param[in]  cipher       The ciphertext followed by the tag
+ * @param[in]  cipherlen    Length of @p cipher in bytes, including the tag
+ * @param[out] msg          The plaintext, of size
+ *                          @p cipherlen - CHACHA20POLY1305_TAG_BYTES
+ * @param[out] msglen       Length of the plaintext
+ * @param[in]  aad          Additional data to authenticate
+ * @param[in]  aadlen       Length of @p aad in bytes
+ * @param[in]  key          The key
+ * @param[in]  nonce        The nonce
+ *
+ * @return  1 if the message is authentic, 0 otherwise
+ */
+int chacha20poly1305_decrypt(const uint8_t *cipher, size_t cipherlen,
+                             uint8_t *msg, size_t *msglen,
+                             const uint8_t *aad, size_t aadlen,
+                             const uint8_t *key, const uint8_t *nonce);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CRYPTO_CHACHA20POLY1305_H */
+/** @} */
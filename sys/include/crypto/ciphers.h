@@ -22,6 +22,7 @@
 #ifndef CRYPTO_CIPHERS_H
 #define CRYPTO_CIPHERS_H
 
+#include <stddef.h>
 #include <stdint.h>
 
 #ifdef __cplusplus
@@ -40,6 +41,16 @@ extern "C" {
 #define CIPHERS_MAX_KEY_SIZE 20
 #define CIPHER_MAX_BLOCK_SIZE 16
 
+/**
+ * @brief   Number of blocks the cipher modes pass to the cipher with one call
+ *
+ * The modes keep this many blocks on the stack, e.g. the keystream of
+ * @ref cipher_encrypt_ctr().
+ */
+#ifndef CIPHER_BATCH_BLOCKS
+#define CIPHER_BATCH_BLOCKS 4
+#endif
+
 
 /**
  * Context sizes needed for the different ciphers.
@@ -96,6 +107,14 @@ typedef struct cipher_interface_st {
     /** the decrypt function */
     int (*decrypt)(const cipher_context_t* ctx, const uint8_t* cipher_block,
                    uint8_t* plain_block);
+
+    /** the multi-block encrypt function, NULL if the cipher has none */
+    int (*encrypt_blocks)(const cipher_context_t* ctx, const uint8_t* plain,
+                          uint8_t* cipher, size_t numof);
+
+    /** the multi-block decrypt function, NULL if the cipher has none */
+    int (*decrypt_blocks)(const cipher_context_t* ctx, const uint8_t* cipher,
+                          uint8_t* plain, size_t numof);
 } cipher_interface_t;
 
 
@@ -156,6 +175,41 @@ int cipher_encrypt(const cipher_t* cipher, const uint8_t* input, uint8_t* output
 int cipher_decrypt(const cipher_t* cipher, const uint8_t* input, uint8_t* output);
 
 
+/**
+ * @brief Encrypt several consecutive blocks of BLOCK_SIZE length
+ *
+ * Uses the multi-block function of the cipher if it has one, so e.g. the key
+ * schedule is only set up once for all blocks.
+ *
+ * @param cipher     Already initialized cipher struct
+ * @param input      pointer to input data to encrypt, of size
+ *                   numof * BLOCK_SIZE
+ * @param output     pointer to allocated memory for encrypted data, of size
+ *                   numof * BLOCK_SIZE. May be the same as @p input.
+ * @param numof      number of blocks
+ *
+ * @return  1 on success, a negative value if the encryption failed
+ */
+int cipher_encrypt_blocks(const cipher_t* cipher, const uint8_t* input,
+                          uint8_t* output, size_t numof);
+
+
+/**
+ * @brief Decrypt several consecutive blocks of BLOCK_SIZE length
+ *
+ * @param cipher     Already initialized cipher struct
+ * @param input      pointer to input data to decrypt, of size
+ *                   numof * BLOCK_SIZE
+ * @param output     pointer to allocated memory for decrypted data, of size
+ *                   numof * BLOCK_SIZE. May be the same as @p input.
+ * @param numof      number of blocks
+ *
+ * @return  1 on success, a negative value if the decryption failed
+ */
+int cipher_decrypt_blocks(const cipher_t* cipher, const uint8_t* input,
+                          uint8_t* output, size_t numof);
+
+
 /**
  * @brief Get block size of cipher
  * *
@@ -38,6 +38,30 @@ extern "C" {
 void crypto_block_inc_ctr(uint8_t block[16], int L);
 
 
+/**
+ * @brief Writes consecutive counter blocks, e.g. as input for the keystream
+ *        of counter mode, and increments the counter by their number.
+ *
+ * @param blocks    buffer for @p numof blocks of 16 octets
+ * @param ctr       encoded counter block, see crypto_block_inc_ctr()
+ * @param L         length of counter
+ * @param numof     number of blocks to write
+ */
+void crypto_block_fill_ctr(uint8_t *blocks, uint8_t ctr[16], int L,
+                           size_t numof);
+
+
+/**
+ * @brief XORs two buffers. Works on whole words if the buffers allow it.
+ *
+ * @param out       result, may be the same as @p a or @p b
+ * @param a         first operand
+ * @param b         second operand
+ * @param len       length of all three buffers
+ */
+void crypto_xor(uint8_t *out, const uint8_t *a, const uint8_t *b, size_t len);
+
+
 /**
  * @brief   Compares two blocks of same size in deterministic time.
  *
@@ -0,0 +1,209 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_crypto
+ * @{
+ *
+ * @file        gcm.h
+ * @brief       Galois/counter mode of operation for block ciphers
+ *
+ * Besides the single-shot functions cipher_encrypt_gcm() and
+ * cipher_decrypt_gcm() there is an incremental API, which takes the data in
+ * chunks of arbitrary length:
+ *
+ * @code
+ *  gcm_ctx_t gcm;
+ *
+ *  gcm_init(&gcm, &cipher, iv, sizeof(iv));
+ *  gcm_update_aad(&gcm, header, sizeof(header));
+ *  while (more_data) {
+ *      gcm_encrypt_update(&gcm, chunk, chunk_len, out);
+ *  }
+ *  gcm_finish(&gcm, tag, sizeof(tag));
+ * @endcode
+ *
+ * GHASH uses a 4-bit multiplication table of the hash subkey. On x86 hosts
+ * with the crypto_aes_ni module it uses the PCLMULQDQ instruction, if the
+ * CPU supports it.
+ */
+
+#ifndef CRYPTO_MODES_GCM_H
+#define CRYPTO_MODES_GCM_H
+
+#include <stdbool.h>
+
+#include "crypto/ciphers.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define GCM_ERR_INVALID_IV_LENGTH -2
+#define GCM_ERR_INVALID_TAG -3
+#define GCM_ERR_INVALID_DATA_LENGTH -4
+#define GCM_ERR_INVALID_TAG_LENGTH -5
+
+/**
+ * @brief   Block size of GCM, GCM is only defined for 128 bit block ciphers
+ */
+#define GCM_BLOCK_SIZE      (16U)
+
+/**
+ * @brief   Minimum length of the authentication tag
+ */
+#define GCM_TAG_LEN_MIN     (4U)
+
+/**
+ * @brief   Context of an incremental GCM operation
+ */
+typedef struct {
+    /** @cond INTERNAL */
+    const cipher_t *cipher;
+    uint64_t hl[16];                /* multiplication table of the hash */
+    uint64_t hh[16];                /* subkey, low and high halves */
+    uint8_t h[GCM_BLOCK_SIZE];      /* hash subkey */
+    uint8_t x[GCM_BLOCK_SIZE];      /* GHASH state */
+    uint8_t j0[GCM_BLOCK_SIZE];     /* pre-counter block */
+    uint8_t counter[GCM_BLOCK_SIZE];
+    uint8_t stream[GCM_BLOCK_SIZE]; /* keystream of the current block */
+    uint64_t aad_len;
+    uint64_t text_len;
+    uint8_t pos;                    /* position in the current block */
+    bool text;                      /* the text has started */
+    /** @endcond */
+} gcm_ctx_t;
+
+/**
+ * @brief Starts an incremental GCM operation
+ *
+ * @param ctx           GCM context
+ * @param cipher        Already initialized cipher struct with a block size
+ *                      of 16. Must stay valid until the operation finished.
+ * @param iv            Initialization vector, 12 octets are recommended
+ * @param iv_len        Length of the initialization vector, must not be 0
+ *
+ * @return  0 on success or an error code
+ */
+int gcm_init(gcm_ctx_t *ctx, const cipher_t *cipher, const uint8_t *iv,
+             size_t iv_len);
+
+/**
+ * @brief Adds additional data to authenticate
+ *
+ * May be called several times, but only before the first call of
+ * gcm_encrypt_update() or gcm_decrypt_update().
+ *
+ * @param ctx           GCM context
+ * @param aad           Additional data to authenticate
+ * @param aad_len       Length of the additional data
+ */
+void gcm_update_aad(gcm_ctx_t *ctx, const uint8_t *aad, size_t aad_len);
+
+/**
+ * @brief Encrypts the next chunk of data
+ *
+ * @param ctx           GCM context
+ * @param input         pointer to input data to encrypt
+ * @param input_len     length of the input data
+ * @param output        pointer to allocated memory for encrypted data. It has
+ *                      to be of size input_len. May be the same as @p input.
+ *
+ * @return  length of encrypted data or error code
+ */
+int gcm_encrypt_update(gcm_ctx_t *ctx, const uint8_t *input, size_t input_len,
+                       uint8_t *output);
+
+/**
+ * @brief Decrypts the next chunk of data
+ *
+ * @warning The decrypted data is not authenticated before gcm_verify()
+ *          succeeded.
+ *
+ * @param ctx           GCM context
+ * @param input         pointer to input data to decrypt
+ * @param input_len     length of the input data
+ * @param output        pointer to allocated memory for decrypted data. It has
+ *                      to be of size input_len. May be the same as @p input.
+ *
+ * @return  length of decrypted data or error code
+ */
+int gcm_decrypt_update(gcm_ctx_t *ctx, const uint8_t *input, size_t input_len,
+                       uint8_t *output);
+
+/**
+ * @brief Finishes an encryption and computes the authentication tag
+ *
+ * @param ctx           GCM context
+ * @param tag           pointer to allocated memory for the tag
+ * @param tag_len       length of the tag (between 4 and 16)
+ *
+ * @return  0 on success or an error code
+ */
+int gcm_finish(gcm_ctx_t *ctx, uint8_t *tag, size_t tag_len);
+
+/**
+ * @brief Finishes a decryption and verifies the authentication tag
+ *
+ * @param ctx           GCM context
+ * @param tag           the received tag
+ * @param tag_len       length of the tag (between 4 and 16)
+ *
+ * @return  0 if the tag is valid or an error code
+ */
+int gcm_verify(gcm_ctx_t *ctx, const uint8_t *tag, size_t tag_len);
+
+/**
+ * @brief Encrypt and authenticate data of arbitrary length in GCM mode.
+ *
+ * @param cipher           Already initialized cipher struct
+ * @param auth_data        Additional data to authenticate
+ * @param auth_data_len    Length of additional data
+ * @param tag_len          length of the appended tag (between 4 and 16)
+ * @param iv               Initialization vector
+ * @param iv_len           Length of the initialization vector
+ * @param input            pointer to input data to encrypt
+ * @param input_len        length of the input data
+ * @param output           pointer to allocated memory for encrypted data. It
+ *                         has to be of size input_len + tag_len.
+ * @return                 length of encrypted data or error code
+ */
+int cipher_encrypt_gcm(const cipher_t* cipher, const uint8_t* auth_data,
+                       size_t auth_data_len, uint8_t tag_len,
+                       const uint8_t* iv, size_t iv_len,
+                       const uint8_t* input, size_t input_len, uint8_t* output);
+
+/**
+ * @brief Decrypt and verify data of arbitrary length in GCM mode.
+ *
+ * The output is cleared if the tag is invalid.
+ *
+ * @param cipher           Already initialized cipher struct
+ * @param auth_data        Additional data to authenticate
+ * @param auth_data_len    Length of additional data
+ * @param tag_len          length of the appended tag (between 4 and 16)
+ * @param iv               Initialization vector
+ * @param iv_len           Length of the initialization vector
+ * @param input            pointer to input data to decrypt, followed by the
+ *                         tag
+ * @param input_len        length of the input data including the tag
+ * @param output           pointer to allocated memory for decrypted data. It
+ *                         has to be of size input_len - tag_len.
+ * @return                 length of decrypted data or error code
+ */
+int cipher_decrypt_gcm(const cipher_t* cipher, const uint8_t* auth_data,
+                       size_t auth_data_len, uint8_t tag_len,
+                       const uint8_t* iv, size_t iv_len,
+                       const uint8_t* input, size_t input_len, uint8_t* output);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CRYPTO_MODES_GCM_H */
+/** @} */
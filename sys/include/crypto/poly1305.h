@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_crypto
+ * @{
+ *
+ * @file
+ * @brief       Poly1305 one-time authenticator as specified in RFC 8439
+ *
+ * @warning A key must only be used for a single message.
+ */
+
+#ifndef CRYPTO_POLY1305_H
+#define CRYPTO_POLY1305_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Length of a Poly1305 key in bytes
+ */
+#define POLY1305_KEY_SIZE   (32U)
+
+/**
+ * @brief   Length of a Poly1305 tag in bytes
+ */
+#define POLY1305_TAG_SIZE   (16U)
+
+/**
+ * @brief   Context of an incremental Poly1305 computation
+ */
+typedef struct {
+    /** @cond INTERNAL */
+    uint32_t r[5];      /* clamped r in 26 bit limbs */
+    uint32_t h[5];      /* accumulator in 26 bit limbs */
+    uint32_t pad[4];    /* s */
+    uint8_t buf[16];    /* partial block */
+    uint8_t leftover;   /* number of bytes in buf */
+    /** @endcond */
+} poly1305_ctx_t;
+
+/**
+ * @brief   Initializes a Poly1305 context
+ *
+ * @param[out] ctx  The context to initialize
+ * @param[in]  key  The one-time key
+ */
+void poly1305_init(poly1305_ctx_t *ctx, const uint8_t key[POLY1305_KEY_SIZE]);
+
+/**
+ * @brief   Adds data to the authenticated message
+ *
+ * @param[in,out] ctx   The Poly1305 context
+ * @param[in]     data  The data
+ * @param[in]     len   Length of @p data in bytes
+ */
+void poly1305_update(poly1305_ctx_t *ctx, const uint8_t *data, size_t len);
+
+/**
+ * @brief   Computes the tag of the message
+ *
+ * The context is cleared afterwards.
+ *
+ * @param[in,out] ctx   The Poly1305 context
+ * @param[out]    tag   The tag
+ */
+void poly1305_finish(poly1305_ctx_t *ctx, uint8_t tag[POLY1305_TAG_SIZE]);
+
+/**
+ * @brief   Computes the tag of a message
+ *
+ * @param[out] tag  The tag
+ * @param[in]  data The message
+ * @param[in]  len  Length of @p data in bytes
+ * @param[in]  key  The one-time key
+ */
+void poly1305_auth(uint8_t tag[POLY1305_TAG_SIZE], const uint8_t *data,
+                   size_t len, const uint8_t key[POLY1305_KEY_SIZE]);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CRYPTO_POLY1305_H */
+/** @} */
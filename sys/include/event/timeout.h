@@ -74,6 +74,16 @@ void event_timeout_init(event_timeout_t *event_timeout, event_queue_t *queue, ev
  */
 void event_timeout_set(event_timeout_t *event_timeout, uint32_t timeout);
 
+/**
+ * @brief   Clear a timeout
+ *
+ * This will stop the timer of @p event_timeout. An event that was already
+ * posted to the queue is not removed, use event_cancel() for that.
+ *
+ * @param[in]   event_timeout   event_timeout context object to use
+ */
+void event_timeout_clear(event_timeout_t *event_timeout);
+
 #ifdef __cplusplus
 }
 #endif
@@ -31,6 +31,14 @@
  *   example.
  * - uses @ref sys_xtimer "xtimer" as backend
  *
+ * By default, events are kept in a list sorted by their offset to the previous
+ * event, so adding and removing an event walks the list. With the
+ * `evtimer_heap` module, events are kept in a pairing heap ordered by their
+ * absolute deadline instead: adding an event takes constant time, removing one
+ * amortized logarithmic time, and @ref evtimer_remaining() does not need to
+ * search the queue. This suits event timers with many events at the cost of
+ * three more fields per event.
+ *
  * @{
  *
  * @file
@@ -55,8 +63,17 @@ extern "C" {
  * @brief   Generic event
  */
 typedef struct evtimer_event {
-    struct evtimer_event *next; /**< the next event in the queue */
-    uint32_t offset;            /**< offset in milliseconds from previous event */
+    struct evtimer_event *next; /**< the next event in the queue
+                                     (the next sibling with `evtimer_heap`) */
+#if defined(MODULE_EVTIMER_HEAP) || defined(DOXYGEN)
+    struct evtimer_event *child;    /**< first child in the heap */
+    struct evtimer_event *prev;     /**< previous sibling, or parent of the
+                                         first child */
+    uint64_t deadline;              /**< absolute deadline in microseconds */
+#endif
+    uint32_t offset;            /**< offset in milliseconds from previous event
+                                     (from the time it was added with
+                                     `evtimer_heap`) */
 } evtimer_event_t;
 
 /**
@@ -71,7 +88,8 @@ typedef struct {
     xtimer_t timer;                 /**< Timer */
     evtimer_callback_t callback;    /**< Handler function for this evtimer's
                                          event type */
-    evtimer_event_t *events;        /**< Event queue */
+    evtimer_event_t *events;        /**< Event queue (root of the heap with
+                                         `evtimer_heap`) */
 } evtimer_t;
 
 /**
@@ -90,14 +108,54 @@ void evtimer_init(evtimer_t *evtimer, evtimer_callback_t handler);
  */
 void evtimer_add(evtimer_t *evtimer, evtimer_event_t *event);
 
+/**
+ * @brief   Adds event to an event timer, deferring it to expire together with
+ *          an already queued event
+ *
+ * If an event is queued to expire at most @p slack milliseconds after @p event,
+ * @p event is deferred to expire at the same time, so both are handled with a
+ * single timer interrupt.
+ *
+ * @note    Without `evtimer_heap`, this walks the list up to the position
+ *          @p event is inserted at with interrupts disabled, like
+ *          evtimer_add(), so it takes linear time in the number of events
+ *          expiring before @p event.
+ *
+ * @param[in] evtimer       An event timer
+ * @param[in] event         An event
+ * @param[in] slack         Maximum deferral in milliseconds
+ *
+ * @return  Milliseconds @p event was deferred by
+ */
+uint32_t evtimer_add_coalesced(evtimer_t *evtimer, evtimer_event_t *event,
+                               uint32_t slack);
+
 /**
  * @brief   Removes an event from an event timer
  *
+ * Does nothing if @p event is not in the queue of @p evtimer.
+ *
+ * @note    With `evtimer_heap`, an event that was never added must be
+ *          zero-initialized, as in a static variable or after `memset()`,
+ *          because its evtimer_event_t::prev field tells whether it is queued.
+ *          Events are reset when they expire or are removed.
+ *
  * @param[in] evtimer       An event timer
  * @param[in] event         An event
  */
 void evtimer_del(evtimer_t *evtimer, evtimer_event_t *event);
 
+/**
+ * @brief   Gets the time until an event expires
+ *
+ * @param[in] evtimer       An event timer
+ * @param[in] event         An event
+ *
+ * @return  Milliseconds until @p event expires
+ * @return  UINT32_MAX, if @p event is not queued in @p evtimer
+ */
+uint32_t evtimer_remaining(evtimer_t *evtimer, const evtimer_event_t *event);
+
 /**
  * @brief   Print overview of current state of an event timer
  *
@@ -59,6 +59,13 @@ extern "C" {
  */
 #define SHA256_INTERNAL_BLOCK_SIZE (64)
 
+/**
+ * @brief Number of messages sha256_multi() hashes side by side
+ */
+#ifndef SHA256_MULTI_LANES
+#define SHA256_MULTI_LANES (4U)
+#endif
+
 /**
  * @brief Context for ciper operations based on sha256
  */
@@ -128,6 +135,22 @@ void sha256_final(sha256_context_t *ctx, void *digest);
  */
 void *sha256(const void *data, size_t len, void *digest);
 
+/**
+ * @brief Computes the hashes of several independent messages
+ *
+ * The complete blocks of up to SHA256_MULTI_LANES messages are hashed in one
+ * interleaved loop, which is faster than hashing the messages one by one.
+ * Messages of similar length benefit most.
+ *
+ * @param[in] data    pointers to the messages
+ * @param[in] len     lengths of the messages
+ * @param[out] digest pointers to arrays for the results, length of each must
+ *                    be SHA256_DIGEST_LENGTH
+ * @param[in] numof   number of messages
+ */
+void sha256_multi(const void *const data[], const size_t len[],
+                  void *const digest[], size_t numof);
+
 /**
  * @brief hmac_sha256_init HMAC SHA-256 calculation. Initiate calculation of a HMAC
  * @param[in] ctx hmac_context_t handle to use
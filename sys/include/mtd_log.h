@@ -0,0 +1,230 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_mtd_log Append-only record log on MTD
+ * @ingroup     sys
+ * @brief       Log-structured store for time-stamped records on a MTD
+ *
+ * Stores a sequence of records, e.g. sensor samples, in a range of sectors of
+ * a @ref drivers_mtd "MTD" without a file system. Records are appended at a
+ * write pointer kept in RAM, so an append costs one header and one payload
+ * program and never reads or erases more than the next sector.
+ *
+ * The sectors are used as a ring. Every sector starts with a header holding
+ * a sequence number and the number of times the sector was erased. When the
+ * last free sector is used up, the sector with the oldest records is erased
+ * and reused, so all sectors of the log wear evenly.
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~ {.c}
+ * static mtd_log_sector_t sectors[16];
+ * static mtd_log_t log = {
+ *     .mtd = MTD_0,
+ *     .first_sector = 0,
+ *     .sector_numof = 16,
+ *     .sectors = sectors,
+ * };
+ *
+ * mtd_log_mount(&log);
+ * mtd_log_append(&log, xtimer_now_usec() / US_PER_SEC, &sample,
+ *                sizeof(sample));
+ *
+ * mtd_log_iter_t iter;
+ * mtd_log_iter_seek(&log, &iter, start_time);
+ * while (mtd_log_iter_next(&log, &iter, &sample, sizeof(sample), &time) >= 0) {
+ *     [...]
+ * }
+ * ~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * Each record is framed by its length, its time stamp and a CRC-32 over both
+ * and the payload. Records never span sectors. The time stamps are chosen by
+ * the application and must not decrease. The time stamp of the first record
+ * of every sector is kept in RAM as a sparse index, so mtd_log_iter_seek()
+ * only scans a single sector.
+ *
+ * mtd_log_mount() recovers the write pointer after a reset or power loss by
+ * scanning the newest sector. A record that was torn by a power loss fails
+ * its CRC and is skipped by the iterator, the records before it are kept.
+ *
+ * The MTD must allow programming the remaining erased bytes of a page that
+ * was already partially programmed, as NOR flash does.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Append-only record log definitions
+ */
+
+#ifndef MTD_LOG_H
+#define MTD_LOG_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "mtd.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Magic number of a sector header ("MLOG")
+ */
+#define MTD_LOG_MAGIC           (0x474f4c4dUL)
+
+/**
+ * @brief   Time stamp of a sector without records
+ */
+#define MTD_LOG_TIME_NONE       (UINT32_MAX)
+
+/**
+ * @brief   Size of the sector header in bytes
+ */
+#define MTD_LOG_SECTOR_HDR_SIZE (16U)
+
+/**
+ * @brief   Size of the record header in bytes
+ */
+#define MTD_LOG_RECORD_HDR_SIZE (12U)
+
+/**
+ * @brief   Records are aligned to this number of bytes
+ */
+#define MTD_LOG_ALIGN           (4U)
+
+/**
+ * @brief   State of a sector in RAM
+ */
+typedef struct {
+    uint32_t seq;                   /**< sequence number of the sector */
+    uint32_t erase_count;           /**< number of erases of the sector */
+    uint32_t first_time;            /**< time stamp of the first record */
+    uint8_t state;                  /**< free, used or dirty */
+} mtd_log_sector_t;
+
+/**
+ * @brief   Append-only record log
+ *
+ * @ref mtd, @ref first_sector, @ref sector_numof and @ref sectors must be set
+ * before calling mtd_log_mount(), the remaining members are internal.
+ */
+typedef struct {
+    mtd_dev_t *mtd;                 /**< the underlying MTD */
+    uint32_t first_sector;          /**< first sector of the log on @ref mtd */
+    uint32_t sector_numof;          /**< number of sectors, at least 2 */
+    mtd_log_sector_t *sectors;      /**< @ref sector_numof sector states */
+    uint32_t head;                  /**< sector appended to */
+    uint32_t offset;                /**< write pointer in @ref head */
+    uint32_t head_seq;              /**< sequence number of @ref head */
+    uint32_t tail_seq;              /**< sequence number of the oldest sector */
+    uint8_t empty;                  /**< the log has no sector in use */
+} mtd_log_t;
+
+/**
+ * @brief   Position of a reader in the log
+ */
+typedef struct {
+    uint32_t seq;                   /**< sequence number of the sector */
+    uint32_t offset;                /**< position in the sector */
+} mtd_log_iter_t;
+
+/**
+ * @brief   Mounts the log, recovering the write pointer
+ *
+ * Initializes the MTD. Sectors that don't belong to the log are erased before
+ * they are used, as an erase interrupted by a power loss may look complete.
+ *
+ * @param[in,out] log   The log
+ *
+ * @return  0 on success
+ * @return  -EINVAL if the log has less than two sectors or does not fit the
+ *          MTD
+ * @return  < 0 on MTD errors
+ */
+int mtd_log_mount(mtd_log_t *log);
+
+/**
+ * @brief   Erases all records of a mounted log
+ *
+ * @param[in,out] log   The log
+ *
+ * @return  0 on success
+ * @return  < 0 on MTD errors
+ */
+int mtd_log_format(mtd_log_t *log);
+
+/**
+ * @brief   Appends a record
+ *
+ * If the record doesn't fit the current sector, the next sector is started,
+ * which erases the oldest sector if the log is full.
+ *
+ * @param[in,out] log   The log
+ * @param[in] time      Time stamp of the record, not less than the time
+ *                      stamp of the previous record
+ * @param[in] data      The payload
+ * @param[in] len       Length of @p data
+ *
+ * @return  0 on success
+ * @return  -EOVERFLOW if the record doesn't fit into a sector
+ * @return  < 0 on MTD errors
+ */
+int mtd_log_append(mtd_log_t *log, uint32_t time, const void *data,
+                   size_t len);
+
+/**
+ * @brief   Positions an iterator at the oldest record
+ *
+ * @param[in] log       The log
+ * @param[out] iter     The iterator
+ */
+void mtd_log_iter_init(const mtd_log_t *log, mtd_log_iter_t *iter);
+
+/**
+ * @brief   Positions an iterator at the first record with a time stamp not
+ *          less than @p time
+ *
+ * @param[in] log       The log
+ * @param[out] iter     The iterator
+ * @param[in] time      The time stamp to seek
+ *
+ * @return  0 on success
+ * @return  -ENOENT if all records are older than @p time
+ * @return  < 0 on MTD errors
+ */
+int mtd_log_iter_seek(const mtd_log_t *log, mtd_log_iter_t *iter,
+                      uint32_t time);
+
+/**
+ * @brief   Reads the record at an iterator and advances it
+ *
+ * Records with a bad CRC are skipped. If the sector of the iterator was
+ * erased to make room for new records, the iterator continues at the oldest
+ * record.
+ *
+ * @param[in] log       The log
+ * @param[in,out] iter  The iterator
+ * @param[out] buf      Buffer for the payload
+ * @param[in] size      Size of @p buf
+ * @param[out] time     Time stamp of the record, may be NULL
+ *
+ * @return  length of the payload
+ * @return  -ENOENT if there are no more records
+ * @return  -ENOBUFS if the payload is larger than @p size, the iterator is
+ *          not advanced
+ * @return  < 0 on MTD errors
+ */
+int mtd_log_iter_next(const mtd_log_t *log, mtd_log_iter_t *iter, void *buf,
+                      size_t size, uint32_t *time);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MTD_LOG_H */
+/** @} */
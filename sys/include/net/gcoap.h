@@ -21,9 +21,11 @@
  * response requires from one to three well-defined steps, depending on
  * inclusion of a payload.
  *
- * gcoap allocates a RIOT message processing thread, so a single instance can
- * serve multiple applications. This approach also means gcoap uses a single UDP
- * port, which supports RFC 6282 compression. Internally, gcoap depends on the
+ * gcoap allocates a RIOT event processing thread, so a single instance can
+ * serve multiple applications. The thread sleeps until its sock reports an
+ * incoming message or a response times out, so it never polls. This approach
+ * also means gcoap uses a single UDP port, which supports RFC 6282
+ * compression. Internally, gcoap depends on the
  * nanocoap package for base level structs and functionality.
  *
  * gcoap also supports the Observe extension (RFC 7641) for a server. gcoap
@@ -174,7 +176,7 @@
  *
  * ### Waiting for a response ###
  *
- * We take advantage of RIOT's asynchronous messaging by using an xtimer to wait
+ * We take advantage of RIOT's event queues by using an event timeout to wait
  * for a response, so the gcoap thread does not block while waiting. The user is
  * notified via the same callback, whether the message is received or the wait
  * times out. We track the response with an entry in the
@@ -212,6 +214,7 @@
 
 #include <stdint.h>
 #include <stdatomic.h>
+#include "event/timeout.h"
 #include "net/sock/udp.h"
 #include "mutex.h"
 #include "nanocoap.h"
@@ -223,6 +226,9 @@ extern "C" {
 
 /**
  * @brief  Size for module message queue
+ *
+ * @deprecated  gcoap's thread waits on an event queue and has no message
+ *              queue anymore. Will be removed after the 2018.01 release.
  */
 #define GCOAP_MSG_QUEUE_SIZE    (4)
 
@@ -304,6 +310,10 @@ extern "C" {
 
 /**
  * @brief   Time in usec that the event loop waits for an incoming CoAP message
+ *
+ * @deprecated  gcoap's thread is woken up by its sock and does not poll
+ *              anymore, so this is not used. Will be removed after the 2018.01
+ *              release.
  */
 #ifndef GCOAP_RECV_TIMEOUT
 #define GCOAP_RECV_TIMEOUT      (1 * US_PER_SEC)
@@ -320,6 +330,9 @@ extern "C" {
 
 /**
  * @brief   Identifies waiting timed out for a response to a sent message
+ *
+ * @deprecated  Response timeouts are handled as events and not sent as
+ *              messages anymore. Will be removed after the 2018.01 release.
  */
 #define GCOAP_MSG_TYPE_TIMEOUT  (0x1501)
 
@@ -327,7 +340,8 @@ extern "C" {
  * @brief   Identifies a request to interrupt listening for an incoming message
  *          on a sock
  *
- * Allows the event loop to process IPC messages.
+ * @deprecated  gcoap's thread does not block in the sock anymore, so it needs
+ *              not be interrupted. Will be removed after the 2018.01 release.
  */
 #define GCOAP_MSG_TYPE_INTR     (0x1502)
 
@@ -432,8 +446,8 @@ typedef struct {
     uint8_t hdr_buf[GCOAP_HEADER_MAXLEN];
                                         /**< Stores a copy of the request header */
     gcoap_resp_handler_t resp_handler;  /**< Callback for the response */
-    xtimer_t response_timer;            /**< Limits wait for response */
-    msg_t timeout_msg;                  /**< For response timer */
+    event_t timeout_ev;                 /**< Posted on response timeout */
+    event_timeout_t response_timer;     /**< Limits wait for response */
 } gcoap_request_memo_t;
 
 /**
@@ -41,6 +41,9 @@
 #ifdef MODULE_GNRC_MAC
 #include "net/csma_sender.h"
 #endif
+#ifdef MODULE_NETSTATS_NEIGHBOR
+#include "net/netstats.h"
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -161,6 +164,27 @@ typedef struct gnrc_netdev {
 #endif
 
 #endif /* MODULE_GNRC_MAC */
+
+#if defined(MODULE_NETSTATS_NEIGHBOR) || defined(DOXYGEN)
+    /**
+     * @brief Link statistics of the neighbors this device transmitted to
+     *
+     * Can be retrieved with @ref NETOPT_STATS and @ref NETSTATS_NEIGHBOR
+     * as context, which copies all @ref NETSTATS_NB_SIZE entries into a
+     * buffer of the caller.
+     */
+    netstats_nb_t nb_stats[NETSTATS_NB_SIZE];
+
+    /**
+     * @brief Neighbor the currently ongoing transmission is addressed to
+     */
+    netstats_nb_t *nb_pending;
+
+    /**
+     * @brief Age counter for @ref gnrc_netdev_t::nb_stats
+     */
+    uint16_t nb_age;
+#endif
 } gnrc_netdev_t;
 
 #ifdef MODULE_GNRC_MAC
@@ -35,6 +35,18 @@
 extern "C" {
 #endif
 
+/**
+ * @brief   Number of hash buckets for the demultiplexing contexts of the
+ *          @ref GNRC_NETTYPE_IPV6 and @ref GNRC_NETTYPE_UDP types
+ *
+ * Entries of these types are looked up by their demultiplexing context (next
+ * header numbers or ports) in a hash table, so a lookup does not need to walk
+ * all registered entries of the type. Must be a power of 2.
+ */
+#ifndef GNRC_NETREG_HASH_SIZE
+#define GNRC_NETREG_HASH_SIZE       (16U)
+#endif
+
 #if defined(MODULE_GNRC_NETAPI_MBOX) || defined(MODULE_GNRC_NETAPI_CALLBACKS) || \
     defined(DOXYGEN)
 /**
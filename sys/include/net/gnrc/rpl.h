@@ -46,7 +46,9 @@
  * CFLAGS
  * ------
  *
- * - Exclude Prefix Information Options from DIOs
+ * - Exclude Prefix Information Options from DIOs. Nodes of a non-storing
+ *   mode DODAG learn the global addresses of their parents from these options
+ *   and send no DAOs without them.
  *   ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ {.mk}
  *   CFLAGS += -DGNRC_RPL_WITHOUT_PIO
  *   ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
@@ -193,12 +195,25 @@ extern "C" {
 /**
  * @brief   Number of implemented Objective Functions
  */
-#define GNRC_RPL_IMPLEMENTED_OFS_NUMOF (1)
+#define GNRC_RPL_IMPLEMENTED_OFS_NUMOF (2)
 
 /**
  * @brief   Default Objective Code Point (OF0)
+ *
+ * Set to 1 to use MRHOF with ETX as link metric. Link metrics are taken from
+ * the link layer if the `netstats_neighbor` module is used.
  */
+#ifndef GNRC_RPL_DEFAULT_OCP
 #define GNRC_RPL_DEFAULT_OCP (0)
+#endif
+
+/**
+ * @brief   Link metric type of ETX measured by the link layer
+ * @see <a href="https://tools.ietf.org/html/rfc6551#section-6.1">
+ *          RFC 6551, section 6.1
+ *      </a>
+ */
+#define GNRC_RPL_LINK_METRIC_ETX (7)
 
 /**
  * @brief   Default Instance ID
@@ -334,6 +349,9 @@ static inline bool GNRC_RPL_COUNTER_GREATER_THAN(uint8_t A, uint8_t B)
 #ifndef GNRC_RPL_REGULAR_DAO_INTERVAL
 #define GNRC_RPL_REGULAR_DAO_INTERVAL (60)
 #endif
+/**
+ * @brief   Seconds to wait for further DAO triggers before sending a DAO
+ */
 #ifndef GNRC_RPL_DEFAULT_DAO_DELAY
 #define GNRC_RPL_DEFAULT_DAO_DELAY (1)
 #endif
@@ -415,6 +433,13 @@ static inline bool GNRC_RPL_COUNTER_GREATER_THAN(uint8_t A, uint8_t B)
  */
 #define GNRC_RPL_LIFETIME_UPDATE_STEP (2)
 
+/**
+ * @brief Interval in seconds of the control-plane overhead statistics
+ */
+#ifndef GNRC_RPL_NETSTATS_INTERVAL
+#define GNRC_RPL_NETSTATS_INTERVAL (60)
+#endif
+
 /**
  *  @brief Rank part of the DODAG
  *  @see <a href="https://tools.ietf.org/html/rfc6550#section-3.5.1">
@@ -562,7 +587,10 @@ void gnrc_rpl_recv_DAO_ACK(gnrc_rpl_dao_ack_t *dao_ack, kernel_pid_t iface, ipv6
                            ipv6_addr_t *dst, uint16_t len);
 
 /**
- * @brief   Delay the DAO sending interval
+ * @brief   Schedule a DAO after @ref GNRC_RPL_DEFAULT_DAO_DELAY
+ *
+ * Triggers that arrive while a DAO is already scheduled are merged into that
+ * DAO, so at most one DAO is sent per delay interval.
  *
  * @param[in] dodag     The DODAG of the DAO
  */
@@ -575,6 +603,53 @@ void gnrc_rpl_delay_dao(gnrc_rpl_dodag_t *dodag);
  */
 void gnrc_rpl_long_delay_dao(gnrc_rpl_dodag_t *dodag);
 
+/**
+ * @brief   Send a DAO and retransmit it until it is acknowledged
+ *
+ * Up to @ref GNRC_RPL_DAO_PIPELINE_SIZE DAOs are outstanding at the same time,
+ * each retransmitted after @ref GNRC_RPL_DEFAULT_WAIT_FOR_DAO_ACK seconds
+ * for at most @ref GNRC_RPL_DAO_SEND_RETRIES times.
+ *
+ * @param[in] dodag         The DODAG of the DAO
+ * @param[in] destination   Destination of the DAO, NULL for the preferred parent
+ * @param[in] lifetime      Path lifetime, 0 for a no-path DAO
+ */
+void gnrc_rpl_track_dao(gnrc_rpl_dodag_t *dodag, ipv6_addr_t *destination, uint8_t lifetime);
+
+/**
+ * @brief   Handle the DAO-ACK of an outstanding DAO
+ *
+ * Also completes older DAOs with the same destination, as their routes are
+ * superseded by the acknowledged one.
+ *
+ * @param[in] dodag     The DODAG of the DAO
+ * @param[in] seq       DAO sequence number of the DAO-ACK
+ */
+void gnrc_rpl_ack_dao(gnrc_rpl_dodag_t *dodag, uint8_t seq);
+
+/**
+ * @brief   Handle a DAO-ACK that rejects an outstanding DAO
+ *
+ * The DAO is not retransmitted. In storing mode, a node whose preferred
+ * parent rejected the DAO selects another parent, if it has one, and sends a
+ * DAO to it. Otherwise the next DAO is sent after
+ * @ref GNRC_RPL_REGULAR_DAO_INTERVAL.
+ *
+ * @param[in] dodag     The DODAG of the DAO
+ * @param[in] seq       DAO sequence number of the DAO-ACK
+ */
+void gnrc_rpl_reject_dao(gnrc_rpl_dodag_t *dodag, uint8_t seq);
+
+/**
+ * @brief   Advance the DAO timers of a DODAG by @ref GNRC_RPL_LIFETIME_UPDATE_STEP
+ *
+ * Sends the scheduled DAO when its delay is over and retransmits outstanding
+ * DAOs whose DAO-ACK timed out. Called periodically by the RPL thread.
+ *
+ * @param[in] dodag     The DODAG of the DAOs
+ */
+void gnrc_rpl_dao_update(gnrc_rpl_dodag_t *dodag);
+
 /**
  * @brief Create a new RPL instance and RPL DODAG.
  *
@@ -23,6 +23,8 @@
 #ifndef NET_GNRC_RPL_SRH_H
 #define NET_GNRC_RPL_SRH_H
 
+#include <stddef.h>
+
 #include "net/ipv6/hdr.h"
 #include "net/ipv6/addr.h"
 
@@ -66,6 +68,105 @@ typedef struct __attribute__((packed)) {
  */
 int gnrc_rpl_srh_process(ipv6_hdr_t *ipv6, gnrc_rpl_srh_t *rh);
 
+/**
+ * @name    Source route tree configuration
+ *
+ * The root of a non-storing mode DODAG keeps the parent of every node in a
+ * tree of parent pointers, indexed by a hash table over the nodes' addresses.
+ * Routes of recently used destinations are cached and only invalidated if a
+ * node on the path changes its parent.
+ * @{
+ */
+/**
+ * @brief   Maximum number of nodes in the source route tree
+ *
+ * Every node costs 26 bytes of RAM: the address, the parent and hash chain
+ * indexes, the index of its cached route, and a hash bucket.
+ */
+#ifndef GNRC_RPL_SRH_TREE_SIZE
+#define GNRC_RPL_SRH_TREE_SIZE          (32)
+#endif
+
+/**
+ * @brief   Maximum number of hops of a source route
+ */
+#ifndef GNRC_RPL_SRH_TREE_MAX_HOPS
+#define GNRC_RPL_SRH_TREE_MAX_HOPS      (16)
+#endif
+
+/**
+ * @brief   Number of cached source routes
+ *
+ * Every cached route costs 2 * @ref GNRC_RPL_SRH_TREE_MAX_HOPS + 4 bytes of
+ * RAM.
+ */
+#ifndef GNRC_RPL_SRH_TREE_CACHE_SIZE
+#define GNRC_RPL_SRH_TREE_CACHE_SIZE    (8)
+#endif
+/** @} */
+
+/**
+ * @brief   Initializes (and clears) the source route tree.
+ *
+ * @param[in] root  Address of the DODAG root, i.e. this node.
+ */
+void gnrc_rpl_srh_tree_init(const ipv6_addr_t *root);
+
+/**
+ * @brief   Sets the DODAG parent of a node, as announced in a DAO.
+ *
+ * Cached routes that include @p target are invalidated if its parent changed.
+ *
+ * @pre gnrc_rpl_srh_tree_init() was called.
+ *
+ * @param[in] target    Address of the node.
+ * @param[in] parent    Address of the DODAG parent of @p target.
+ *
+ * @return  0 on success.
+ * @return  -EINVAL, if @p target is the root or equals @p parent.
+ * @return  -ENOMEM, if the tree is full.
+ */
+int gnrc_rpl_srh_tree_update(const ipv6_addr_t *target, const ipv6_addr_t *parent);
+
+/**
+ * @brief   Removes a node from the source route tree (e.g. on a No-Path DAO).
+ *
+ * Children of the node stay in the tree but are unreachable until they
+ * announce a new parent.
+ *
+ * @param[in] target    Address of the node.
+ *
+ * @return  0 on success.
+ * @return  -ENOENT, if @p target is not in the tree.
+ */
+int gnrc_rpl_srh_tree_remove(const ipv6_addr_t *target);
+
+/**
+ * @brief   Builds the source route to a node.
+ *
+ * The first hop of the route is written to @p next_hop and has to be used as
+ * the destination of the IPv6 header. The remaining hops (including @p dst)
+ * are written into a RPL source routing header with the common prefix of all
+ * hops elided. gnrc_rpl_srh_t::nh has to be set by the caller.
+ *
+ * May be called before gnrc_rpl_srh_tree_init(), i.e. on nodes that are no
+ * non-storing mode root, the tree is empty then.
+ *
+ * @param[in] dst       Destination of the route.
+ * @param[out] next_hop First hop of the route.
+ * @param[out] srh      Buffer for the source routing header. If NULL, only
+ *                      the size of the header is returned.
+ * @param[in] srh_len   Size of @p srh in bytes.
+ *
+ * @return  Size of the source routing header in bytes.
+ * @return  0, if @p dst is a child of the root and no header is needed.
+ * @return  -ENOENT, if @p dst is not in the tree.
+ * @return  -EHOSTUNREACH, if the path to @p dst is broken or too long.
+ * @return  -ENOBUFS, if @p srh_len is too small.
+ */
+int gnrc_rpl_srh_tree_build(const ipv6_addr_t *dst, ipv6_addr_t *next_hop,
+                            gnrc_rpl_srh_t *srh, size_t srh_len);
+
 #ifdef __cplusplus
 }
 #endif
@@ -221,17 +221,39 @@ struct gnrc_rpl_parent {
     gnrc_rpl_parent_t *next;        /**< pointer to the next parent */
     uint8_t state;                  /**< 0 for unsued, 1 for used */
     ipv6_addr_t addr;               /**< link-local IPv6 address of this parent */
+    ipv6_addr_t global_addr;        /**< global address of this parent, as
+                                         announced in its DIOs, unspecified
+                                         if unknown */
     uint8_t dtsn;                   /**< last seen dtsn of this parent */
     uint16_t rank;                  /**< rank of the parent */
     gnrc_rpl_dodag_t *dodag;        /**< DODAG the parent belongs to */
     uint32_t lifetime;              /**< lifetime of this parent in seconds */
-    double  link_metric;            /**< metric of the link */
-    uint8_t link_metric_type;       /**< type of the metric */
+    uint16_t link_metric;           /**< metric of the link, 0 if unknown */
+    uint8_t link_metric_type;       /**< type of the metric
+                                         (see @ref GNRC_RPL_LINK_METRIC_ETX) */
 };
 /**
  * @endcond
  */
 
+/**
+ * @brief   Number of DAOs that can be outstanding at the same time
+ */
+#ifndef GNRC_RPL_DAO_PIPELINE_SIZE
+#define GNRC_RPL_DAO_PIPELINE_SIZE      (2)
+#endif
+
+/**
+ * @brief DAO that waits for its DAO-ACK
+ */
+typedef struct {
+    ipv6_addr_t dst;    /**< destination of the DAO */
+    uint8_t seq;        /**< DAO sequence number of the last transmission */
+    uint8_t lifetime;   /**< path lifetime, 0 for a no-path DAO */
+    uint8_t retries;    /**< number of retransmissions so far */
+    uint8_t timeout;    /**< seconds until a retransmission, 0 if unused */
+} gnrc_rpl_dao_pending_t;
+
 /**
  * @brief Objective function representation
  */
@@ -284,8 +306,7 @@ struct gnrc_rpl_dodag {
     uint16_t my_rank;               /**< rank/position in the DODAG */
     uint8_t node_status;            /**< leaf, normal, or root node */
     uint8_t dao_seq;                /**< dao sequence number */
-    uint8_t dao_counter;            /**< amount of retried DAOs */
-    bool dao_ack_received;          /**< flag to check for DAO-ACK */
+    gnrc_rpl_dao_pending_t dao_pending[GNRC_RPL_DAO_PIPELINE_SIZE]; /**< unacknowledged DAOs */
     uint8_t dio_opts;               /**< options in the next DIO
                                          (see @ref GNRC_RPL_REQ_DIO_OPTS "DIO Options") */
     uint8_t dao_time;               /**< time to schedule a DAO in seconds */
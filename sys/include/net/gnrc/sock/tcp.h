@@ -0,0 +1,64 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_sock_tcp   GNRC-specific extensions of the TCP sock
+ * @ingroup     net_gnrc_sock
+ * @brief       Functions of @ref net_sock_tcp that only GNRC provides
+ *
+ * A listening queue of sock_tcp_listen() can have at most
+ * @ref SOCK_TCP_QUEUE_MBOX_SIZE socks, as every sock reports its established
+ * connection to the mbox of the queue. A longer queue is rejected with
+ * `-ENOMEM`. Define @ref SOCK_TCP_QUEUE_MBOX_SIZE, e.g. in the `CFLAGS` of
+ * the application, for longer queues.
+ *
+ * TCP socks do not support @ref net_sock_async, so the POSIX poll() and
+ * select() of the `posix_select` module reject stream sockets with
+ * `EOPNOTSUPP`.
+ *
+ * @{
+ *
+ * @file
+ * @brief   GNRC-specific TCP sock definitions
+ */
+#ifndef NET_GNRC_SOCK_TCP_H
+#define NET_GNRC_SOCK_TCP_H
+
+#include <sys/types.h>
+
+#include "net/gnrc/pkt.h"
+#include "net/sock/tcp.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Writes a packet snip to an established TCP stream without copying
+ *          it
+ *
+ * Segments reference @p payload until they are acknowledged, if it fits into
+ * one segment.
+ *
+ * @pre `(sock != NULL) && (payload != NULL) && (payload->next == NULL)`
+ *
+ * @param[in] sock      A TCP sock object.
+ * @param[in] payload   The data to write. The reference of the caller is
+ *                      always released.
+ *
+ * @return  The number of bytes written on success.
+ * @return  The errors of sock_tcp_write().
+ */
+ssize_t gnrc_sock_tcp_write_pkt(sock_tcp_t *sock, gnrc_pktsnip_t *payload);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GNRC_SOCK_TCP_H */
+/** @} */
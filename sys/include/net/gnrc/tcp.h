@@ -23,6 +23,8 @@
 #define NET_GNRC_TCP_H
 
 #include <stdint.h>
+#include "mbox.h"
+#include "net/gnrc/netapi.h"
 #include "net/gnrc/pkt.h"
 #include "net/gnrc/tcp/tcb.h"
 
@@ -112,6 +114,47 @@ int gnrc_tcp_open_active(gnrc_tcp_tcb_t *tcb,  const uint8_t address_family,
 int gnrc_tcp_open_passive(gnrc_tcp_tcb_t *tcb,  const uint8_t address_family,
                           const uint8_t *local_addr, const uint16_t local_port);
 
+/**
+ * @brief Message type posted to the listen mbox of gnrc_tcp_listen() when a
+ *        connection was established. msg_t::content::ptr points to the TCB.
+ */
+#define GNRC_TCP_MSG_TYPE_ESTABLISHED   (GNRC_NETAPI_MSG_TYPE_ACK + 107)
+
+/**
+ * @brief Opens a connection passively without waiting for an incomming
+ *        request.
+ *
+ * @pre gnrc_tcp_tcb_init() must have been successfully called.
+ * @pre @p tcb must not be NULL.
+ * @pre @p local_port must not be zero.
+ *
+ * Several TCBs may listen on the same @p local_port, each of them accepts one
+ * incoming connection. The established connection can be used with the
+ * other functions of this API from any thread.
+ *
+ * @param[in,out] tcb              TCB holding the connection information.
+ * @param[in]     address_family   Address family of @p local_addr.
+ *                                 If local_addr == NULL, address_family is ignored.
+ * @param[in]     local_addr       If not NULL the connection is bound to @p local_addr.
+ *                                 If NULL a connection request to all local ip
+ *                                 addresses is valid.
+ * @param[in]     local_port       Port number to listen on.
+ * @param[in]     mbox             If not NULL, a message of type
+ *                                 @ref GNRC_TCP_MSG_TYPE_ESTABLISHED is put
+ *                                 into @p mbox without blocking, once the
+ *                                 connection was established.
+ *
+ * @returns   Zero on success.
+ *            -EAFNOSUPPORT if local_addr != NULL and @p address_family is not supported.
+ *            -EINVAL if @p address_family is not the same the address_family used in TCB.
+ *            -EISCONN if TCB is already in use.
+ *            -ENOMEM if the receive buffer for the TCB could not be allocated.
+ *            Hint: Increase "GNRC_TCP_RCV_BUFFERS".
+ */
+int gnrc_tcp_listen(gnrc_tcp_tcb_t *tcb, const uint8_t address_family,
+                    const uint8_t *local_addr, const uint16_t local_port,
+                    mbox_t *mbox);
+
 /**
  * @brief Transmit data to connected peer.
  *
@@ -132,11 +175,43 @@ int gnrc_tcp_open_passive(gnrc_tcp_tcb_t *tcb,  const uint8_t address_family,
  *            -ENOTCONN if connection is not established.
  *            -ECONNRESET if connection was resetted by the peer.
  *            -ECONNABORTED if the connection was aborted.
+ *            -ENOMEM if the segment could not be built.
  *            -ETIMEDOUT if @p user_timeout_duration_us expired.
  */
 ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
                       const uint32_t user_timeout_duration_us);
 
+/**
+ * @brief Transmit a packet snip to connected peer without copying it.
+ *
+ * @pre gnrc_tcp_tcb_init() must have been successfully called.
+ * @pre @p tcb must not be NULL.
+ * @pre @p payload must not be NULL and must be a single snip.
+ *
+ * If @p payload fits into the next segment, it is referenced by the segment
+ * and its retransmissions. Otherwise its data is sent segment-wise like with
+ * gnrc_tcp_send().
+ *
+ * @note Blocks until @p payload was transmitted or an error occured.
+ *
+ * @param[in,out] tcb                        TCB holding the connection information.
+ * @param[in]     payload                    Data to transmit. The function
+ *                                           always releases the callers
+ *                                           reference to @p payload.
+ * @param[in]     user_timeout_duration_us   If not zero and there was not data transmitted
+ *                                           the function returns after user_timeout_duration_us.
+ *                                           If zero, no timeout will be triggered.
+ *
+ * @returns   The number of successfully transmitted bytes.
+ *            -ENOTCONN if connection is not established.
+ *            -ECONNRESET if connection was resetted by the peer.
+ *            -ECONNABORTED if the connection was aborted.
+ *            -ENOMEM if the segment could not be built.
+ *            -ETIMEDOUT if @p user_timeout_duration_us expired.
+ */
+ssize_t gnrc_tcp_send_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *payload,
+                          const uint32_t user_timeout_duration_us);
+
 /**
  * @brief Receive Data from the peer.
  *
@@ -25,7 +25,7 @@
 #include <stdint.h>
 #include "kernel_types.h"
 #include "ringbuffer.h"
-#include "xtimer.h"
+#include "evtimer.h"
 #include "mutex.h"
 #include "msg.h"
 #include "mbox.h"
@@ -45,6 +45,18 @@ extern "C" {
  */
 #define GNRC_TCP_TCB_MBOX_SIZE (8U)
 
+/**
+ * @brief Timer of GNRC TCP.
+ *
+ * The timers of all TCBs and blocked user calls are events of one event
+ * timer, so any number of connections needs a single xtimer.
+ */
+typedef struct {
+    evtimer_event_t event;   /**< Event timer base class */
+    msg_t msg;               /**< Message, sent on expiration */
+    mbox_t *mbox;            /**< Mbox to put @ref msg in, NULL for the TCP thread */
+} gnrc_tcp_timer_t;
+
 /**
  * @brief Transmission control block of GNRC TCP.
  */
@@ -73,8 +85,7 @@ typedef struct _transmission_control_block {
     int32_t srtt;          /**< Smoothed round trip time */
     int32_t rto;           /**< Retransmission timeout duration */
     uint8_t retries;       /**< Number of retransmissions */
-    xtimer_t tim_tout;     /**< Timer struct for timeouts */
-    msg_t msg_tout;        /**< Message, sent on timeouts */
+    gnrc_tcp_timer_t tim_tout;        /**< Retransmission and timewait timer */
     gnrc_pktsnip_t *pkt_retransmit;   /**< Pointer to packet in "retransmit queue" */
     msg_t mbox_raw[GNRC_TCP_TCB_MBOX_SIZE];   /**< Msg queue for mbox */
     mbox_t mbox;             /**< TCB mbox for synchronization */
@@ -82,6 +93,8 @@ typedef struct _transmission_control_block {
     ringbuffer_t rcv_buf;    /**< Receive buffer data structure */
     mutex_t fsm_lock;        /**< Mutex for FSM access synchronization */
     mutex_t function_lock;   /**< Mutex for function call synchronization */
+    mbox_t *listen_mbox;     /**< Notified about passively opened connections, see
+                              *   gnrc_tcp_listen() */
     struct _transmission_control_block *next;   /**< Pointer next TCB */
 } gnrc_tcp_tcb_t;
 
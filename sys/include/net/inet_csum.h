@@ -27,6 +27,45 @@
 extern "C" {
 #endif
 
+/**
+ * @brief   Adds two unnormalized Internet Checksums
+ *
+ * @param[in] a     An unnormalized Internet Checksum.
+ * @param[in] b     Another unnormalized Internet Checksum.
+ *
+ * @return  The 1's complement sum of @p a and @p b.
+ */
+static inline uint16_t inet_csum_add(uint16_t a, uint16_t b)
+{
+    uint32_t sum = (uint32_t)a + b;
+
+    return (uint16_t)((sum & 0xffff) + (sum >> 16));
+}
+
+/**
+ * @brief   Updates an unnormalized Internet Checksum for a changed 16-bit
+ *          word of its checksum domain
+ *
+ * @see <a href="https://tools.ietf.org/html/rfc1624">
+ *          RFC 1624
+ *      </a>
+ *
+ * @details Can be used to update a checksum without recalculating it over the
+ *          whole domain, e.g. for a cached pseudo-header sum and a new length.
+ *
+ * @param[in] sum       The unnormalized Internet Checksum.
+ * @param[in] old_word  The old value of the word in host byte order.
+ * @param[in] new_word  The new value of the word in host byte order.
+ *
+ * @return  The updated unnormalized Internet Checksum.
+ */
+static inline uint16_t inet_csum_update(uint16_t sum, uint16_t old_word,
+                                        uint16_t new_word)
+{
+    /* HC' = HC + ~m + m' (RFC 1624, eqn. 2 for the unnormalized sum) */
+    return inet_csum_add(inet_csum_add(sum, (uint16_t)~old_word), new_word);
+}
+
 /**
  * @brief   Calculates the unnormalized Internet Checksum of @p buf, where the
  *          buffer provides a slice of the full checksum domain, calculated in order.
@@ -38,6 +77,8 @@ extern "C" {
  * @details The Internet Checksum is not normalized (i. e. its 1's complement
  *          was not taken of the result) to use it for further calculation.
  *          This function handles padding an odd number of bytes across the full domain.
+ *          @p buf does not need to be aligned, the sum is calculated over
+ *          32-bit words regardless.
  *
  * @param[in] sum       An initial value for the checksum.
  * @param[in] buf       A buffer.
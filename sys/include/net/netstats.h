@@ -34,6 +34,7 @@ extern "C" {
 #define NETSTATS_LAYER2     (0x01)
 #define NETSTATS_IPV6       (0x02)
 #define NETSTATS_RPL        (0x03)
+#define NETSTATS_NEIGHBOR   (0x04)
 #define NETSTATS_ALL        (0xFF)
 /** @} */
 
@@ -53,6 +54,60 @@ typedef struct {
     uint32_t rx_bytes;          /**< received bytes */
 } netstats_t;
 
+/**
+ * @name    Neighbor statistics configuration
+ * @{
+ */
+/**
+ * @brief   Number of neighbors a link layer keeps statistics for
+ */
+#ifndef NETSTATS_NB_SIZE
+#define NETSTATS_NB_SIZE            (8)
+#endif
+
+/**
+ * @brief   Fixed point divisor of @ref netstats_nb_t::etx
+ *
+ * An ETX of 1.0 is represented as NETSTATS_NB_ETX_DIVISOR.
+ */
+#define NETSTATS_NB_ETX_DIVISOR     (128U)
+
+/**
+ * @brief   ETX assumed for a neighbor that was not transmitted to yet
+ */
+#ifndef NETSTATS_NB_ETX_INIT
+#define NETSTATS_NB_ETX_INIT        (2U * NETSTATS_NB_ETX_DIVISOR)
+#endif
+
+/**
+ * @brief   ETX sample used if a transmission was not acknowledged
+ */
+#ifndef NETSTATS_NB_ETX_NOACK_PENALTY
+#define NETSTATS_NB_ETX_NOACK_PENALTY   (12U * NETSTATS_NB_ETX_DIVISOR)
+#endif
+
+/**
+ * @brief   Weight (in 1/8) of the old ETX value in the moving average
+ */
+#ifndef NETSTATS_NB_ETX_ALPHA
+#define NETSTATS_NB_ETX_ALPHA       (7U)
+#endif
+/** @} */
+
+/**
+ * @brief       Link statistics of a single neighbor
+ */
+typedef struct {
+    uint8_t l2_addr[8];         /**< link layer address of the neighbor */
+    uint8_t l2_addr_len;        /**< length of netstats_nb_t::l2_addr,
+                                     0 if the entry is unused */
+    uint16_t etx;               /**< expected transmission count, scaled by
+                                     @ref NETSTATS_NB_ETX_DIVISOR */
+    uint16_t tx_count;          /**< frames sent to the neighbor */
+    uint16_t tx_failed;         /**< frames that were not acknowledged */
+    uint16_t last_use;          /**< age stamp used to replace stale entries */
+} netstats_nb_t;
+
 #ifdef __cplusplus
 }
 #endif
@@ -67,6 +67,16 @@ typedef struct {
     uint32_t dao_ack_tx_ucast_bytes;    /**< unicast dao_ack sent in bytes */
     uint32_t dao_ack_tx_mcast_count;    /**< multicast dao_ack sent in packets */
     uint32_t dao_ack_tx_mcast_bytes;    /**< multicast dao_ack sent in bytes*/
+    /* DAO reliability */
+    uint32_t dao_retransmissions;       /**< dao retransmitted for a missing dao_ack */
+    uint32_t dao_ack_timeouts;          /**< dao given up on after all retransmissions */
+    uint32_t dao_merged;                /**< dao triggers merged into a scheduled dao */
+    uint32_t dao_rejected;              /**< dao rejected by a dao_ack status >= 128 */
+    /* control-plane overhead of the last interval */
+    uint32_t interval_rx_count;         /**< control messages received in packets */
+    uint32_t interval_rx_bytes;         /**< control messages received in bytes */
+    uint32_t interval_tx_count;         /**< control messages sent in packets */
+    uint32_t interval_tx_bytes;         /**< control messages sent in bytes */
 } netstats_rpl_t;
 
 #ifdef __cplusplus
@@ -0,0 +1,94 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_sock_async  Asynchronous sock notifications
+ * @ingroup     net_sock
+ *
+ * @brief   Notifies users of a sock about incoming data without blocking in
+ *          a receive call.
+ *
+ * A callback registered with a sock is called every time data was queued for
+ * the sock. The callback is called in the context of the network stack, so it
+ * must not block and should only signal another thread, which then calls the
+ * (non-blocking) receive function of the sock. After data was sent, the
+ * callback is called in the context of the sending thread.
+ *
+ * @{
+ *
+ * @file
+ * @brief   Asynchronous sock notification definitions
+ */
+#ifndef NET_SOCK_ASYNC_H
+#define NET_SOCK_ASYNC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* the sock types are only forward declared, as the sock implementations
+ * include this header with their type definitions */
+struct sock_ip;
+struct sock_udp;
+
+/**
+ * @brief   Flags for the events reported to an asynchronous sock callback
+ */
+typedef enum {
+    SOCK_ASYNC_MSG_RECV = 0x0010,   /**< data was queued for receiving */
+    SOCK_ASYNC_MSG_SENT = 0x0020,   /**< data was handed to the stack for sending */
+} sock_async_flags_t;
+
+/**
+ * @brief   Event callback for @ref sock_ip_t
+ *
+ * @param[in] sock  The sock the event happened on
+ * @param[in] flags The event flags
+ * @param[in] arg   Argument given to @ref sock_ip_set_cb()
+ */
+typedef void (*sock_ip_cb_t)(struct sock_ip *sock, sock_async_flags_t flags,
+                             void *arg);
+
+/**
+ * @brief   Event callback for @ref sock_udp_t
+ *
+ * @param[in] sock  The sock the event happened on
+ * @param[in] flags The event flags
+ * @param[in] arg   Argument given to @ref sock_udp_set_cb()
+ */
+typedef void (*sock_udp_cb_t)(struct sock_udp *sock, sock_async_flags_t flags,
+                              void *arg);
+
+/**
+ * @brief   Sets the event callback of a raw IPv4/IPv6 sock
+ *
+ * @pre `(sock != NULL)`
+ *
+ * @param[in] sock  A raw IPv4/IPv6 sock object
+ * @param[in] cb    An event callback. May be NULL to unset the callback.
+ * @param[in] arg   Argument for @p cb
+ */
+void sock_ip_set_cb(struct sock_ip *sock, sock_ip_cb_t cb, void *arg);
+
+/**
+ * @brief   Sets the event callback of a UDP sock
+ *
+ * @pre `(sock != NULL)`
+ *
+ * @param[in] sock  A UDP sock object
+ * @param[in] cb    An event callback. May be NULL to unset the callback.
+ * @param[in] arg   Argument for @p cb
+ */
+void sock_udp_set_cb(struct sock_udp *sock, sock_udp_cb_t cb, void *arg);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_SOCK_ASYNC_H */
+/** @} */
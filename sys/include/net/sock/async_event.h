@@ -0,0 +1,150 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_sock_async_event    Event-driven sock
+ * @ingroup     net_sock
+ *
+ * @brief   Binds a sock to an @ref sys_event "event queue"
+ *
+ * Instead of blocking in a receive call, a sock bound to an event queue posts
+ * an event to that queue every time a packet arrived or a packet was sent. The
+ * thread owning the queue then calls the handler of the sock, which receives
+ * the queued packets without blocking. This way one thread can serve any
+ * number of socks without using timeouts:
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~ {.c}
+ * static void _handler(sock_udp_t *sock, sock_async_flags_t type, void *arg)
+ * {
+ *     if (type & SOCK_ASYNC_MSG_RECV) {
+ *         ssize_t res;
+ *
+ *         while ((res = sock_udp_recv(sock, buf, sizeof(buf), 0, NULL)) != -EAGAIN) {
+ *             ...
+ *         }
+ *     }
+ * }
+ *
+ * [...]
+ * event_queue_init(&queue);
+ * sock_udp_create(&sock, &local, NULL, 0);
+ * sock_udp_event_init(&sock, &queue, _handler, NULL);
+ * event_loop(&queue);
+ * ~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * Events that occur while the event of a sock is still queued are merged into
+ * that event, so a handler for @ref SOCK_ASYNC_MSG_RECV must receive until the
+ * sock reports `-EAGAIN`.
+ *
+ * @{
+ *
+ * @file
+ * @brief   Event-driven sock definitions
+ */
+#ifndef NET_SOCK_ASYNC_EVENT_H
+#define NET_SOCK_ASYNC_EVENT_H
+
+#include "event.h"
+#include "net/sock/async.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Event of a sock
+ */
+typedef struct {
+    event_t super;                  /**< event structure that gets extended */
+    union {
+        sock_ip_cb_t ip;            /**< handler for a raw IP sock */
+        sock_udp_cb_t udp;          /**< handler for a UDP sock */
+    } cb;                           /**< handler of the sock */
+    void *cb_arg;                   /**< argument for the handler */
+    void *sock;                     /**< the sock the event belongs to */
+    event_queue_t *queue;           /**< the queue the event is posted to */
+    unsigned type;                  /**< pending @ref sock_async_flags_t */
+} sock_event_t;
+
+/**
+ * @brief   Asynchronous context of a sock, stored in the sock object
+ */
+typedef struct {
+    sock_event_t event;             /**< the event of the sock */
+} sock_async_ctx_t;
+
+/**
+ * @brief   Gets the asynchronous context of a raw IPv4/IPv6 sock
+ *
+ * @note    Provided by the stack implementing @ref net_sock_ip
+ *
+ * @param[in] sock  A raw IPv4/IPv6 sock object
+ *
+ * @return  The asynchronous context of @p sock
+ */
+sock_async_ctx_t *sock_ip_get_async_ctx(struct sock_ip *sock);
+
+/**
+ * @brief   Gets the asynchronous context of a UDP sock
+ *
+ * @note    Provided by the stack implementing @ref net_sock_udp
+ *
+ * @param[in] sock  A UDP sock object
+ *
+ * @return  The asynchronous context of @p sock
+ */
+sock_async_ctx_t *sock_udp_get_async_ctx(struct sock_udp *sock);
+
+/**
+ * @brief   Makes a raw IPv4/IPv6 sock post its events to an event queue
+ *
+ * @pre `(sock != NULL) && (ev_queue != NULL) && (handler != NULL)`
+ *
+ * @param[in] sock          A raw IPv4/IPv6 sock object. Must already be
+ *                          created.
+ * @param[in] ev_queue      The queue the events of @p sock are posted to
+ * @param[in] handler       Called in the thread of @p ev_queue for the events
+ *                          of @p sock
+ * @param[in] handler_arg   Argument for @p handler
+ */
+void sock_ip_event_init(struct sock_ip *sock, event_queue_t *ev_queue,
+                        sock_ip_cb_t handler, void *handler_arg);
+
+/**
+ * @brief   Makes a UDP sock post its events to an event queue
+ *
+ * @pre `(sock != NULL) && (ev_queue != NULL) && (handler != NULL)`
+ *
+ * @param[in] sock          A UDP sock object. Must already be created.
+ * @param[in] ev_queue      The queue the events of @p sock are posted to
+ * @param[in] handler       Called in the thread of @p ev_queue for the events
+ *                          of @p sock
+ * @param[in] handler_arg   Argument for @p handler
+ */
+void sock_udp_event_init(struct sock_udp *sock, event_queue_t *ev_queue,
+                         sock_udp_cb_t handler, void *handler_arg);
+
+/**
+ * @brief   Stops a sock from posting events
+ *
+ * Removes a still queued event of the sock from its queue. Must be called in
+ * the thread of the queue, after the sock was closed.
+ *
+ * @pre The sock was bound to a queue with @ref sock_ip_event_init() or
+ *      @ref sock_udp_event_init()
+ *
+ * @param[in] ctx   The asynchronous context of the sock
+ */
+void sock_event_close(sock_async_ctx_t *ctx);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_SOCK_ASYNC_EVENT_H */
+/** @} */
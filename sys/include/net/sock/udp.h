@@ -435,6 +435,65 @@ ssize_t sock_udp_recv(sock_udp_t *sock, void *data, size_t max_len,
 ssize_t sock_udp_send(sock_udp_t *sock, const void *data, size_t len,
                       const sock_udp_ep_t *remote);
 
+/**
+ * @brief   A datagram for the batch functions
+ */
+typedef struct {
+    void *data;                 /**< buffer for or payload of the datagram */
+    size_t len;                 /**< size of sock_udp_msg_t::data, set to
+                                 *   the received length by
+                                 *   sock_udp_recv_batch() */
+    sock_udp_ep_t remote;       /**< remote end point of a received datagram,
+                                 *   not used for sending */
+} sock_udp_msg_t;
+
+/**
+ * @brief   Receives multiple UDP messages in one call
+ *
+ * Waits for the first message like sock_udp_recv() and then receives all
+ * messages already queued for @p sock, up to @p numof.
+ *
+ * @pre `(sock != NULL) && (msgs != NULL) && (numof > 0)`
+ *
+ * @param[in] sock      A UDP sock object.
+ * @param[in,out] msgs  Buffers for the received messages. sock_udp_msg_t::len
+ *                      is set to the length of the received message.
+ * @param[in] numof     Number of elements in @p msgs.
+ * @param[in] timeout   Timeout for the first message in microseconds, see
+ *                      sock_udp_recv().
+ *
+ * @note    A message that can not be received into its buffer is dropped and
+ *          ends the batch, if it is not the first one.
+ *
+ * @return  The number of messages received on success.
+ * @return  Any error of sock_udp_recv() for the first message.
+ */
+ssize_t sock_udp_recv_batch(sock_udp_t *sock, sock_udp_msg_t *msgs,
+                            size_t numof, uint32_t timeout);
+
+/**
+ * @brief   Sends multiple UDP messages to the same remote end point
+ *
+ * Equivalent to calling sock_udp_send() for every message, but a stack may
+ * determine the end points, the source address and the implicit binding of
+ * @p sock only once for all messages (GNRC does).
+ *
+ * @pre `((sock != NULL || remote != NULL)) && (msgs != NULL) && (numof > 0)`
+ *
+ * @param[in] sock      A UDP sock object. May be `NULL`, see sock_udp_send().
+ * @param[in] msgs      Payloads of the messages. sock_udp_msg_t::remote is
+ *                      ignored.
+ * @param[in] numof     Number of elements in @p msgs.
+ * @param[in] remote    Remote end point for all messages, see
+ *                      sock_udp_send().
+ *
+ * @return  The number of messages sent on success. Sending stops at the first
+ *          message that could not be sent.
+ * @return  Any error of sock_udp_send() for the first message.
+ */
+ssize_t sock_udp_send_batch(sock_udp_t *sock, const sock_udp_msg_t *msgs,
+                            size_t numof, const sock_udp_ep_t *remote);
+
 #include "sock_types.h"
 
 #ifdef __cplusplus
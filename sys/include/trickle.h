@@ -14,6 +14,11 @@
  * @ingroup sys
  * @brief   Implementation of a generic Trickle Algorithm (RFC 6206)
  *
+ * All trickle timers share a single @ref sys_evtimer "evtimer" queue. An
+ * interval that ends at most @ref TRICKLE_TIMER_SLACK milliseconds before the
+ * interval of another trickle timer is extended to end together with it, so
+ * both are handled with a single timer interrupt.
+ *
  * @see https://tools.ietf.org/html/rfc6206
  *
  * @{
@@ -32,9 +37,18 @@
  extern "C" {
 #endif
 
+#include "evtimer_msg.h"
 #include "xtimer.h"
 #include "thread.h"
 
+/**
+ * @brief   Maximum time in milliseconds an interval is extended by to end
+ *          together with the interval of another trickle timer
+ */
+#ifndef TRICKLE_TIMER_SLACK
+#define TRICKLE_TIMER_SLACK     (16U)
+#endif
+
 /**
  * @brief Trickle callback function with arguments
  */
@@ -57,10 +71,9 @@ typedef struct {
     kernel_pid_t pid;               /**< pid of trickles target thread */
     trickle_callback_t callback;    /**< callback function and parameter that
                                          trickle calls after each interval */
-    msg_t msg;                      /**< the msg_t to use for intervals */
-    uint64_t msg_time;              /**< interval in ms */
-    xtimer_t msg_timer;             /**< xtimer to send a msg_t to the target
+    evtimer_msg_event_t msg_event;  /**< event to send a msg_t to the target
                                          thread for a new interval */
+    uint64_t msg_time;              /**< time of the next msg_t in ms */
 } trickle_t;
 
 /**
@@ -0,0 +1,212 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_vfs_async Asynchronous VFS
+ * @ingroup     sys_vfs
+ * @brief       Offloads VFS reads, writes and fsyncs to an I/O worker thread
+ *
+ * vfs_read(), vfs_write() and vfs_fsync() block the calling thread until the
+ * storage device is done, e.g. while flash pages are programmed. With this
+ * module a thread submits the request to a dedicated worker thread instead
+ * and continues right away. The completion is signaled either by posting an
+ * @ref sys_event "event" or by setting @ref THREAD_FLAG_VFS_ASYNC on the
+ * submitting thread:
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~ {.c}
+ * static vfs_async_req_t req;
+ *
+ * vfs_async_req_init(&req, NULL, NULL);
+ * vfs_async_write(&req, fd, record, sizeof(record));
+ * [...]
+ * if (vfs_async_wait(&req) < 0) {
+ *     puts("logging failed");
+ * }
+ * ~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * Requests are executed in the order they were submitted, so the requests
+ * for one file descriptor never overtake each other. Writes to the same file
+ * descriptor that are queued back-to-back are merged into one vfs_write() of
+ * up to @ref VFS_ASYNC_MERGE_SIZE bytes, which saves the per-call overhead of
+ * the file system for small records.
+ *
+ * The request object and its buffer must stay valid until the request
+ * completed.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Asynchronous VFS definitions
+ */
+
+#ifndef VFS_ASYNC_H
+#define VFS_ASYNC_H
+
+#include <sys/types.h>
+
+#include "event.h"
+#include "thread.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Stack size of the I/O worker thread
+ */
+#ifndef VFS_ASYNC_STACK_SIZE
+#define VFS_ASYNC_STACK_SIZE    (THREAD_STACKSIZE_DEFAULT)
+#endif
+
+/**
+ * @brief   Priority of the I/O worker thread
+ *
+ * Below the main thread by default, so storage devices that poll their busy
+ * state don't delay the submitting threads.
+ */
+#ifndef VFS_ASYNC_PRIO
+#define VFS_ASYNC_PRIO          (THREAD_PRIORITY_MAIN + 1)
+#endif
+
+/**
+ * @brief   Maximum number of bytes of merged writes
+ *
+ * Writes of this size or larger are never merged.
+ */
+#ifndef VFS_ASYNC_MERGE_SIZE
+#define VFS_ASYNC_MERGE_SIZE    (256U)
+#endif
+
+/**
+ * @brief   Maximum number of writes merged into one
+ */
+#ifndef VFS_ASYNC_MERGE_NUMOF
+#define VFS_ASYNC_MERGE_NUMOF   (8U)
+#endif
+
+#ifndef THREAD_FLAG_VFS_ASYNC
+/**
+ * @brief   Thread flag set on the submitting thread when a request completed
+ *          that has no completion event
+ */
+#define THREAD_FLAG_VFS_ASYNC   (0x1 << 13)
+#endif
+
+/**
+ * @brief   Operation of a request
+ */
+typedef enum {
+    VFS_ASYNC_READ,                 /**< vfs_read() */
+    VFS_ASYNC_WRITE,                /**< vfs_write() */
+    VFS_ASYNC_FSYNC,                /**< vfs_fsync() */
+} vfs_async_op_t;
+
+/**
+ * @brief   Request to the I/O worker thread
+ */
+typedef struct {
+    event_t super;                  /**< queue entry of the worker thread */
+    vfs_async_op_t op;              /**< the operation */
+    int fd;                         /**< the file descriptor */
+    void *buf;                      /**< buffer to read into or write from */
+    size_t count;                   /**< size of @p buf */
+    volatile ssize_t res;           /**< result of the operation */
+    volatile int done;              /**< the request completed */
+    thread_t *thread;               /**< thread to notify if @p event is NULL */
+    event_queue_t *queue;           /**< queue to post @p event to */
+    event_t *event;                 /**< completion event, may be NULL */
+} vfs_async_req_t;
+
+/**
+ * @brief   Starts the I/O worker thread
+ *
+ * @return  PID of the worker thread
+ * @return  -EEXIST if the worker thread is already running
+ */
+kernel_pid_t vfs_async_init(void);
+
+/**
+ * @brief   Initializes a request
+ *
+ * @param[out] req      The request to initialize
+ * @param[in] queue     Queue to post @p event to on completion. If NULL the
+ *                      submitting thread gets @ref THREAD_FLAG_VFS_ASYNC set
+ *                      instead.
+ * @param[in] event     Posted to @p queue on completion, must not be queued
+ *                      at that time
+ */
+void vfs_async_req_init(vfs_async_req_t *req, event_queue_t *queue,
+                        event_t *event);
+
+/**
+ * @brief   Submits a vfs_read()
+ *
+ * @pre @p req is initialized and not pending
+ *
+ * @param[in] req       The request
+ * @param[in] fd        fd number obtained from vfs_open
+ * @param[out] dest     destination buffer to hold the file contents
+ * @param[in] count     maximum number of bytes to read
+ */
+void vfs_async_read(vfs_async_req_t *req, int fd, void *dest, size_t count);
+
+/**
+ * @brief   Submits a vfs_write()
+ *
+ * @pre @p req is initialized and not pending
+ *
+ * @param[in] req       The request
+ * @param[in] fd        fd number obtained from vfs_open
+ * @param[in] src       pointer to source buffer
+ * @param[in] count     maximum number of bytes to write
+ */
+void vfs_async_write(vfs_async_req_t *req, int fd, const void *src,
+                     size_t count);
+
+/**
+ * @brief   Submits a vfs_fsync()
+ *
+ * Completes after all requests for @p fd submitted before.
+ *
+ * @pre @p req is initialized and not pending
+ *
+ * @param[in] req       The request
+ * @param[in] fd        fd number obtained from vfs_open
+ */
+void vfs_async_fsync(vfs_async_req_t *req, int fd);
+
+/**
+ * @brief   Checks if a request completed
+ *
+ * @param[in] req       The request
+ *
+ * @return  1 if the request completed, 0 if it is still pending
+ */
+static inline int vfs_async_done(const vfs_async_req_t *req)
+{
+    return req->done;
+}
+
+/**
+ * @brief   Waits until a request completed
+ *
+ * Must be called by the submitting thread for requests without completion
+ * event.
+ *
+ * @param[in] req       The request
+ *
+ * @return  The result of the vfs function
+ */
+ssize_t vfs_async_wait(vfs_async_req_t *req);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* VFS_ASYNC_H */
+/** @} */
@@ -0,0 +1,517 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_mtd_log
+ * @{
+ *
+ * @file
+ * @brief       Append-only record log implementation
+ *
+ * The length of a record is stored together with its complement. Programming
+ * only clears bits, so a header torn by a power loss either still reads as
+ * erased or has a length that doesn't match its complement. In the latter
+ * case the rest of the sector is ignored and appends continue in the next
+ * sector.
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include "checksum/crc.h"
+#include "mtd_log.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+enum {
+    SECTOR_DIRTY = 0,               /**< must be erased before use */
+    SECTOR_FREE,                    /**< erased since mount */
+    SECTOR_USED,                    /**< holds a header and records */
+};
+
+enum {
+    RECORD_VALID,
+    RECORD_END,                     /**< no further records in the sector */
+};
+
+typedef struct {
+    uint32_t magic;
+    uint32_t seq;
+    uint32_t erase_count;
+    uint32_t crc;
+} _sector_hdr_t;
+
+typedef struct {
+    uint16_t len;
+    uint16_t len_inv;
+    uint32_t time;
+    uint32_t crc;
+} _record_hdr_t;
+
+static inline uint32_t _sector_size(const mtd_log_t *log)
+{
+    return log->mtd->pages_per_sector * log->mtd->page_size;
+}
+
+static inline uint32_t _addr(const mtd_log_t *log, uint32_t idx,
+                             uint32_t offset)
+{
+    return (log->first_sector + idx) * _sector_size(log) + offset;
+}
+
+static inline uint32_t _record_size(size_t len)
+{
+    return (MTD_LOG_RECORD_HDR_SIZE + len + MTD_LOG_ALIGN - 1) &
+           ~(MTD_LOG_ALIGN - 1);
+}
+
+static uint32_t _record_crc(const _record_hdr_t *hdr)
+{
+    return crc32_calc((const uint8_t *)hdr, offsetof(_record_hdr_t, crc));
+}
+
+/* index of the sector with sequence number seq */
+static uint32_t _idx(const mtd_log_t *log, uint32_t seq)
+{
+    uint32_t back = (log->head_seq - seq) % log->sector_numof;
+
+    return (log->head + log->sector_numof - back) % log->sector_numof;
+}
+
+static int _in_log(const mtd_log_t *log, uint32_t seq)
+{
+    return !log->empty &&
+           (seq - log->tail_seq <= log->head_seq - log->tail_seq);
+}
+
+/* mtd_write() must not cross page boundaries */
+static int _write(const mtd_log_t *log, const void *data, uint32_t addr,
+                  uint32_t len)
+{
+    const uint8_t *pos = data;
+    uint32_t page_size = log->mtd->page_size;
+
+    while (len) {
+        uint32_t chunk = page_size - (addr % page_size);
+
+        if (chunk > len) {
+            chunk = len;
+        }
+        int res = mtd_write(log->mtd, pos, addr, chunk);
+        if (res < 0) {
+            return res;
+        }
+        pos += chunk;
+        addr += chunk;
+        len -= chunk;
+    }
+    return 0;
+}
+
+static int _read_record(const mtd_log_t *log, uint32_t idx, uint32_t offset,
+                        uint32_t limit, _record_hdr_t *hdr)
+{
+    static const _record_hdr_t erased = {
+        UINT16_MAX, UINT16_MAX, UINT32_MAX, UINT32_MAX
+    };
+
+    if (offset + MTD_LOG_RECORD_HDR_SIZE > limit) {
+        return RECORD_END;
+    }
+    int res = mtd_read(log->mtd, hdr, _addr(log, idx, offset), sizeof(*hdr));
+    if (res < 0) {
+        return res;
+    }
+    if (!memcmp(hdr, &erased, sizeof(*hdr))) {
+        return RECORD_END;
+    }
+    if (((hdr->len ^ hdr->len_inv) != UINT16_MAX) ||
+        (offset + _record_size(hdr->len) > _sector_size(log))) {
+        DEBUG("mtd_log: torn header in sector %u at %u\n", (unsigned)idx,
+              (unsigned)offset);
+        return RECORD_END;
+    }
+    return RECORD_VALID;
+}
+
+static int _erase(mtd_log_t *log, uint32_t idx)
+{
+    int res = mtd_erase(log->mtd, _addr(log, idx, 0), _sector_size(log));
+
+    if (res < 0) {
+        return res;
+    }
+    log->sectors[idx].erase_count++;
+    log->sectors[idx].state = SECTOR_FREE;
+    return 0;
+}
+
+/* starts the sector following the head, erasing the tail if needed */
+static int _next_sector(mtd_log_t *log)
+{
+    uint32_t idx = 0;
+    mtd_log_sector_t *sector;
+    int res;
+
+    if (!log->empty) {
+        idx = (log->head + 1) % log->sector_numof;
+    }
+    else {
+        /* start with the least worn sector */
+        for (uint32_t i = 1; i < log->sector_numof; i++) {
+            if (log->sectors[i].erase_count < log->sectors[idx].erase_count) {
+                idx = i;
+            }
+        }
+    }
+    sector = &log->sectors[idx];
+
+    if (sector->state == SECTOR_USED) {
+        /* the log is full, drop its oldest sector */
+        log->tail_seq++;
+    }
+    if (sector->state != SECTOR_FREE) {
+        if ((res = _erase(log, idx)) < 0) {
+            return res;
+        }
+    }
+
+    _sector_hdr_t hdr = {
+        .magic = MTD_LOG_MAGIC,
+        .seq = log->head_seq + 1,
+        .erase_count = sector->erase_count,
+    };
+    hdr.crc = crc32_calc((const uint8_t *)&hdr, offsetof(_sector_hdr_t, crc));
+    if ((res = _write(log, &hdr, _addr(log, idx, 0), sizeof(hdr))) < 0) {
+        return res;
+    }
+
+    DEBUG("mtd_log: sector %u seq %u, %u erases\n", (unsigned)idx,
+          (unsigned)hdr.seq, (unsigned)hdr.erase_count);
+    sector->seq = hdr.seq;
+    sector->first_time = MTD_LOG_TIME_NONE;
+    sector->state = SECTOR_USED;
+    if (log->empty) {
+        log->tail_seq = hdr.seq;
+        log->empty = 0;
+    }
+    log->head = idx;
+    log->head_seq = hdr.seq;
+    log->offset = MTD_LOG_SECTOR_HDR_SIZE;
+    return 0;
+}
+
+/* scans a sector for the end of its records */
+static int _scan(mtd_log_t *log, uint32_t idx, uint32_t *end)
+{
+    _record_hdr_t hdr;
+    uint32_t offset = MTD_LOG_SECTOR_HDR_SIZE;
+    int res;
+
+    while ((res = _read_record(log, idx, offset, _sector_size(log), &hdr)) ==
+           RECORD_VALID) {
+        if (offset == MTD_LOG_SECTOR_HDR_SIZE) {
+            log->sectors[idx].first_time = hdr.time;
+        }
+        offset += _record_size(hdr.len);
+    }
+    if (res < 0) {
+        return res;
+    }
+    /* anything but erased flash at the end closes the sector */
+    if ((offset + MTD_LOG_RECORD_HDR_SIZE <= _sector_size(log)) &&
+        (hdr.len != UINT16_MAX || hdr.len_inv != UINT16_MAX ||
+         hdr.time != UINT32_MAX || hdr.crc != UINT32_MAX)) {
+        offset = _sector_size(log);
+    }
+    *end = offset;
+    return 0;
+}
+
+int mtd_log_mount(mtd_log_t *log)
+{
+    uint32_t max_erase_count = 0;
+    int res;
+
+    if ((log->sector_numof < 2) ||
+        (log->first_sector + log->sector_numof > log->mtd->sector_count)) {
+        return -EINVAL;
+    }
+    if ((res = mtd_init(log->mtd)) < 0) {
+        return res;
+    }
+
+    log->empty = 1;
+    log->head_seq = UINT32_MAX;
+    for (uint32_t i = 0; i < log->sector_numof; i++) {
+        mtd_log_sector_t *sector = &log->sectors[i];
+        _sector_hdr_t hdr;
+
+        res = mtd_read(log->mtd, &hdr, _addr(log, i, 0), sizeof(hdr));
+        if (res < 0) {
+            return res;
+        }
+        sector->first_time = MTD_LOG_TIME_NONE;
+        if ((hdr.magic != MTD_LOG_MAGIC) ||
+            (hdr.crc != crc32_calc((const uint8_t *)&hdr,
+                                   offsetof(_sector_hdr_t, crc)))) {
+            /* may be erased only partially, never trust it */
+            sector->state = SECTOR_DIRTY;
+            sector->erase_count = 0;
+            continue;
+        }
+        sector->state = SECTOR_USED;
+        sector->seq = hdr.seq;
+        sector->erase_count = hdr.erase_count;
+        if (hdr.erase_count > max_erase_count) {
+            max_erase_count = hdr.erase_count;
+        }
+        if (log->empty || (int32_t)(hdr.seq - log->head_seq) > 0) {
+            log->head = i;
+            log->head_seq = hdr.seq;
+            log->empty = 0;
+        }
+    }
+
+    if (!log->empty) {
+        /* the used sectors precede the head with consecutive numbers, any
+         * other used sector is stale */
+        uint32_t len = 1;
+
+        while ((len < log->sector_numof) &&
+               (log->sectors[_idx(log, log->head_seq - len)].state ==
+                SECTOR_USED) &&
+               (log->sectors[_idx(log, log->head_seq - len)].seq ==
+                log->head_seq - len)) {
+            len++;
+        }
+        log->tail_seq = log->head_seq - len + 1;
+        for (uint32_t i = 0; i < log->sector_numof; i++) {
+            if ((log->sectors[i].state == SECTOR_USED) &&
+                !_in_log(log, log->sectors[i].seq)) {
+                log->sectors[i].state = SECTOR_DIRTY;
+            }
+        }
+    }
+
+    for (uint32_t i = 0; i < log->sector_numof; i++) {
+        mtd_log_sector_t *sector = &log->sectors[i];
+
+        if (sector->state != SECTOR_USED) {
+            /* the number of erases is lost, estimate it */
+            sector->erase_count = max_erase_count;
+        }
+        else if (i == log->head) {
+            if ((res = _scan(log, i, &log->offset)) < 0) {
+                return res;
+            }
+        }
+        else {
+            _record_hdr_t hdr;
+
+            res = _read_record(log, i, MTD_LOG_SECTOR_HDR_SIZE,
+                               _sector_size(log), &hdr);
+            if (res < 0) {
+                return res;
+            }
+            if (res == RECORD_VALID) {
+                sector->first_time = hdr.time;
+            }
+        }
+    }
+
+    DEBUG("mtd_log: mounted, %s, head %u at %u\n",
+          log->empty ? "empty" : "in use", (unsigned)log->head,
+          (unsigned)log->offset);
+    return 0;
+}
+
+int mtd_log_format(mtd_log_t *log)
+{
+    for (uint32_t i = 0; i < log->sector_numof; i++) {
+        if (log->sectors[i].state != SECTOR_FREE) {
+            int res = _erase(log, i);
+            if (res < 0) {
+                return res;
+            }
+        }
+        log->sectors[i].first_time = MTD_LOG_TIME_NONE;
+    }
+    /* sequence numbers continue, so old iterators are detected */
+    log->empty = 1;
+    return 0;
+}
+
+int mtd_log_append(mtd_log_t *log, uint32_t time, const void *data,
+                   size_t len)
+{
+    uint32_t size = _record_size(len);
+    int res;
+
+    if ((len >= UINT16_MAX) ||
+        (MTD_LOG_SECTOR_HDR_SIZE + size > _sector_size(log))) {
+        return -EOVERFLOW;
+    }
+    if (log->empty || (log->offset + size > _sector_size(log))) {
+        if ((res = _next_sector(log)) < 0) {
+            return res;
+        }
+    }
+
+    _record_hdr_t hdr = {
+        .len = len,
+        .len_inv = ~len,
+        .time = time,
+    };
+    hdr.crc = crc32_update(_record_crc(&hdr), data, len);
+
+    uint32_t addr = _addr(log, log->head, log->offset);
+    if ((res = _write(log, &hdr, addr, sizeof(hdr))) < 0) {
+        return res;
+    }
+    if ((res = _write(log, data, addr + sizeof(hdr), len)) < 0) {
+        return res;
+    }
+    log->offset += size;
+    if (log->sectors[log->head].first_time == MTD_LOG_TIME_NONE) {
+        log->sectors[log->head].first_time = time;
+    }
+    return 0;
+}
+
+void mtd_log_iter_init(const mtd_log_t *log, mtd_log_iter_t *iter)
+{
+    iter->seq = log->tail_seq;
+    iter->offset = MTD_LOG_SECTOR_HDR_SIZE;
+}
+
+/* moves the iterator to the next record header, without checking its CRC */
+static int _peek(const mtd_log_t *log, mtd_log_iter_t *iter,
+                 _record_hdr_t *hdr)
+{
+    if (log->empty) {
+        return -ENOENT;
+    }
+    while (1) {
+        if (!_in_log(log, iter->seq)) {
+            /* the sector was reused while reading */
+            mtd_log_iter_init(log, iter);
+        }
+
+        uint32_t limit = _sector_size(log);
+        if (iter->seq == log->head_seq) {
+            limit = log->offset;
+        }
+        int res = _read_record(log, _idx(log, iter->seq), iter->offset, limit,
+                               hdr);
+        if (res < 0) {
+            return res;
+        }
+        if (res == RECORD_VALID) {
+            return 0;
+        }
+        if (iter->seq == log->head_seq) {
+            return -ENOENT;
+        }
+        iter->seq++;
+        iter->offset = MTD_LOG_SECTOR_HDR_SIZE;
+    }
+}
+
+/* computes the CRC of a payload that doesn't fit the buffer of the caller */
+static int _check_crc(const mtd_log_t *log, const mtd_log_iter_t *iter,
+                      const _record_hdr_t *hdr)
+{
+    uint8_t chunk[32];
+    uint32_t addr = _addr(log, _idx(log, iter->seq),
+                          iter->offset + MTD_LOG_RECORD_HDR_SIZE);
+    uint32_t crc = _record_crc(hdr);
+
+    for (uint32_t left = hdr->len; left;) {
+        uint32_t len = (left > sizeof(chunk)) ? sizeof(chunk) : left;
+        int res = mtd_read(log->mtd, chunk, addr, len);
+        if (res < 0) {
+            return res;
+        }
+        crc = crc32_update(crc, chunk, len);
+        addr += len;
+        left -= len;
+    }
+    return (crc == hdr->crc);
+}
+
+int mtd_log_iter_seek(const mtd_log_t *log, mtd_log_iter_t *iter,
+                      uint32_t time)
+{
+    _record_hdr_t hdr;
+    int res;
+
+    mtd_log_iter_init(log, iter);
+    if (log->empty) {
+        return -ENOENT;
+    }
+    /* start in the newest sector beginning at or before time */
+    for (uint32_t seq = log->head_seq; seq != log->tail_seq; seq--) {
+        uint32_t first_time = log->sectors[_idx(log, seq)].first_time;
+
+        if ((first_time != MTD_LOG_TIME_NONE) && (first_time <= time)) {
+            iter->seq = seq;
+            break;
+        }
+    }
+    while ((res = _peek(log, iter, &hdr)) == 0) {
+        if (hdr.time >= time) {
+            return 0;
+        }
+        iter->offset += _record_size(hdr.len);
+    }
+    return res;
+}
+
+int mtd_log_iter_next(const mtd_log_t *log, mtd_log_iter_t *iter, void *buf,
+                      size_t size, uint32_t *time)
+{
+    _record_hdr_t hdr;
+    int res;
+
+    while ((res = _peek(log, iter, &hdr)) == 0) {
+        int valid;
+
+        if (hdr.len > size) {
+            valid = _check_crc(log, iter, &hdr);
+            if (valid > 0) {
+                return -ENOBUFS;
+            }
+        }
+        else {
+            valid = mtd_read(log->mtd, buf,
+                             _addr(log, _idx(log, iter->seq),
+                                   iter->offset + MTD_LOG_RECORD_HDR_SIZE),
+                             hdr.len);
+            if (valid >= 0) {
+                valid = (crc32_update(_record_crc(&hdr), buf, hdr.len) ==
+                         hdr.crc);
+            }
+        }
+        if (valid < 0) {
+            return valid;
+        }
+        iter->offset += _record_size(hdr.len);
+        if (valid) {
+            if (time) {
+                *time = hdr.time;
+            }
+            return hdr.len;
+        }
+        DEBUG("mtd_log: skipped record with bad CRC\n");
+    }
+    return res;
+}
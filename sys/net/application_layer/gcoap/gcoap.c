@@ -13,13 +13,16 @@
  * @file
  * @brief       GNRC's implementation of CoAP protocol
  *
- * Runs a thread (_pid) to manage request/response messaging.
+ * Runs a thread (_pid) with an event loop to manage request/response
+ * messaging.
  *
  * @author      Ken Bannister <kb2ma@runbox.com>
  */
 
 #include <errno.h>
+#include "kernel_defines.h"
 #include "net/gcoap.h"
+#include "net/sock/async_event.h"
 #include "random.h"
 #include "thread.h"
 
@@ -28,13 +31,16 @@
 
 /* Internal functions */
 static void *_event_loop(void *arg);
+static void _on_sock_evt(sock_udp_t *sock, sock_async_flags_t type, void *arg);
 static void _listen(sock_udp_t *sock);
+static void _handle_msg(sock_udp_t *sock, uint8_t *buf, size_t len,
+                        sock_udp_ep_t *remote);
 static ssize_t _well_known_core_handler(coap_pkt_t* pdu, uint8_t *buf, size_t len);
 static ssize_t _write_options(coap_pkt_t *pdu, uint8_t *buf, size_t len);
 static size_t _handle_req(coap_pkt_t *pdu, uint8_t *buf, size_t len,
                                                          sock_udp_ep_t *remote);
 static ssize_t _finish_pdu(coap_pkt_t *pdu, uint8_t *buf, size_t len);
-static void _expire_request(gcoap_request_memo_t *memo);
+static void _on_resp_timeout(event_t *event);
 static void _find_req_memo(gcoap_request_memo_t **memo_ptr, coap_pkt_t *pdu,
                                                             uint8_t *buf, size_t len);
 static void _find_resource(coap_pkt_t *pdu, coap_resource_t **resource_ptr,
@@ -63,15 +69,15 @@ static gcoap_state_t _coap_state = {
 static kernel_pid_t _pid = KERNEL_PID_UNDEF;
 static char _msg_stack[GCOAP_STACK_SIZE];
 static sock_udp_t _sock;
+static event_queue_t _queue;
 
 
-/* Event/Message loop for gcoap _pid thread. */
+/* Event loop for gcoap _pid thread. */
 static void *_event_loop(void *arg)
 {
-    msg_t msg_rcvd, msg_queue[GCOAP_MSG_QUEUE_SIZE];
     (void)arg;
 
-    msg_init_queue(msg_queue, GCOAP_MSG_QUEUE_SIZE);
+    event_queue_init(&_queue);
 
     sock_udp_ep_t local;
     memset(&local, 0, sizeof(sock_udp_ep_t));
@@ -85,50 +91,54 @@ static void *_event_loop(void *arg)
         return 0;
     }
 
-    while(1) {
-        res = msg_try_receive(&msg_rcvd);
+    /* incoming messages and response timeouts are both handled as events */
+    sock_udp_event_init(&_sock, &_queue, _on_sock_evt, NULL);
+    event_loop(&_queue);
 
-        if (res > 0) {
-            switch (msg_rcvd.type) {
-                case GCOAP_MSG_TYPE_TIMEOUT:
-                    _expire_request((gcoap_request_memo_t *)msg_rcvd.content.ptr);
-                    break;
-                case GCOAP_MSG_TYPE_INTR:
-                    /* next _listen() timeout will account for open requests */
-                    break;
-                default:
-                    break;
-            }
-        }
+    return 0;
+}
 
-        _listen(&_sock);
-    }
+/* Handles the events of the sock in the gcoap thread. */
+static void _on_sock_evt(sock_udp_t *sock, sock_async_flags_t type, void *arg)
+{
+    (void)arg;
 
-    return 0;
+    if (type & SOCK_ASYNC_MSG_RECV) {
+        _listen(sock);
+    }
 }
 
-/* Listen for an incoming CoAP message. */
+/* Handles all CoAP messages queued at the sock, without blocking. */
 static void _listen(sock_udp_t *sock)
 {
-    coap_pkt_t pdu;
     uint8_t buf[GCOAP_PDU_BUF_SIZE];
     sock_udp_ep_t remote;
-    gcoap_request_memo_t *memo = NULL;
-    uint8_t open_reqs = gcoap_op_state();
 
-    ssize_t res = sock_udp_recv(sock, buf, sizeof(buf),
-                                open_reqs > 0 ? GCOAP_RECV_TIMEOUT : SOCK_NO_TIMEOUT,
-                                &remote);
-    if (res <= 0) {
-#if ENABLE_DEBUG
-        if (res < 0 && res != -ETIMEDOUT) {
-            DEBUG("gcoap: udp recv failure: %d\n", res);
+    while (1) {
+        ssize_t res = sock_udp_recv(sock, buf, sizeof(buf), 0, &remote);
+
+        if (res > 0) {
+            _handle_msg(sock, buf, res, &remote);
         }
+        else if ((res < 0) && (res != -ENOBUFS) && (res != -EPROTO)) {
+#if ENABLE_DEBUG
+            if (res != -EAGAIN) {
+                DEBUG("gcoap: udp recv failure: %d\n", (int)res);
+            }
 #endif
-        return;
+            /* sock is empty */
+            return;
+        }
     }
+}
 
-    res = coap_parse(&pdu, buf, res);
+/* Handles a single incoming CoAP message. */
+static void _handle_msg(sock_udp_t *sock, uint8_t *buf, size_t len,
+                        sock_udp_ep_t *remote)
+{
+    coap_pkt_t pdu;
+    gcoap_request_memo_t *memo = NULL;
+    ssize_t res = coap_parse(&pdu, buf, len);
     if (res < 0) {
         DEBUG("gcoap: parse failure: %d\n", res);
         /* If a response, can't clear memo, but it will timeout later. */
@@ -143,9 +153,9 @@ static void _listen(sock_udp_t *sock)
     } else if (coap_get_code_class(&pdu) == COAP_CLASS_REQ) {
         if (coap_get_type(&pdu) == COAP_TYPE_NON
                 || coap_get_type(&pdu) == COAP_TYPE_CON) {
-            size_t pdu_len = _handle_req(&pdu, buf, sizeof(buf), &remote);
+            size_t pdu_len = _handle_req(&pdu, buf, GCOAP_PDU_BUF_SIZE, remote);
             if (pdu_len > 0) {
-                sock_udp_send(sock, buf, pdu_len, &remote);
+                sock_udp_send(sock, buf, pdu_len, remote);
             }
         }
         else {
@@ -156,11 +166,13 @@ static void _listen(sock_udp_t *sock)
 
     /* incoming response */
     else {
-        _find_req_memo(&memo, &pdu, buf, sizeof(buf));
+        _find_req_memo(&memo, &pdu, buf, GCOAP_PDU_BUF_SIZE);
         if (memo) {
-            xtimer_remove(&memo->response_timer);
+            event_timeout_clear(&memo->response_timer);
+            /* the timeout might have expired while the response was queued */
+            event_cancel(&_queue, &memo->timeout_ev);
             memo->state = GCOAP_MEMO_RESP;
-            memo->resp_handler(memo->state, &pdu, &remote);
+            memo->resp_handler(memo->state, &pdu, remote);
             memo->state = GCOAP_MEMO_UNUSED;
         }
     }
@@ -369,12 +381,14 @@ static void _find_req_memo(gcoap_request_memo_t **memo_ptr, coap_pkt_t *src_pdu,
     }
 }
 
-/* Calls handler callback on receipt of a timeout message. */
-static void _expire_request(gcoap_request_memo_t *memo)
+/* Calls handler callback on expiry of the response timeout. */
+static void _on_resp_timeout(event_t *event)
 {
+    gcoap_request_memo_t *memo = container_of(event, gcoap_request_memo_t,
+                                              timeout_ev);
     coap_pkt_t req;
 
-    DEBUG("coap: received timeout message\n");
+    DEBUG("coap: response timed out\n");
     if (memo->state == GCOAP_MEMO_WAIT) {
         memo->state = GCOAP_MEMO_TIMEOUT;
         /* Pass response to handler */
@@ -698,21 +712,10 @@ size_t gcoap_req_send2(const uint8_t *buf, size_t len,
         size_t res = sock_udp_send(&_sock, buf, len, remote);
 
         if (res && (GCOAP_NON_TIMEOUT > 0)) {
-            /* interrupt sock listening (to set a listen timeout) */
-            msg_t mbox_msg;
-            mbox_msg.type          = GCOAP_MSG_TYPE_INTR;
-            mbox_msg.content.value = 0;
-            if (mbox_try_put(&_sock.reg.mbox, &mbox_msg)) {
-                /* start response wait timer */
-                memo->timeout_msg.type        = GCOAP_MSG_TYPE_TIMEOUT;
-                memo->timeout_msg.content.ptr = (char *)memo;
-                xtimer_set_msg(&memo->response_timer, GCOAP_NON_TIMEOUT,
-                                                      &memo->timeout_msg, _pid);
-            }
-            else {
-                memo->state = GCOAP_MEMO_UNUSED;
-                DEBUG("gcoap: can't wake up mbox; no timeout for msg\n");
-            }
+            /* start response wait timer */
+            memo->timeout_ev.handler = _on_resp_timeout;
+            event_timeout_init(&memo->response_timer, &_queue, &memo->timeout_ev);
+            event_timeout_set(&memo->response_timer, GCOAP_NON_TIMEOUT);
         }
         else if (!res) {
             memo->state = GCOAP_MEMO_UNUSED;
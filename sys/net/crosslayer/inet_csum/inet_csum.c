@@ -13,16 +13,82 @@
  */
 
 #include <inttypes.h>
+#include <stdbool.h>
 #include <stdio.h>
+#include <string.h>
+
+#include "byteorder.h"
 #include "od.h"
 #include "net/inet_csum.h"
 
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
 
+/**
+ * @brief   Sums up @p len bytes of @p buf as 32-bit words in host byte order
+ *
+ * As the 1's complement sum is independent of the byte order (see RFC 1071,
+ * section 2(B)), the words can be summed up as they are read from memory and
+ * only the folded result needs to be converted. All bytes keep their position
+ * relative to a 4-byte aligned address, so the result needs to be swapped if
+ * @p buf starts at an odd address.
+ *
+ * @return  The unfolded sum
+ */
+static uint64_t _sum_words(const uint8_t *buf, size_t len)
+{
+    const uint32_t *words;
+    uint64_t acc = 0;
+    uint32_t tmp = 0;
+    unsigned head = (4U - ((uintptr_t)buf & 3U)) & 3U;
+
+    /* bring buf to a word boundary, so the loop below never loads
+     * unaligned words */
+    if (head > 0) {
+        if (head > len) {
+            head = len;
+        }
+        memcpy(((uint8_t *)&tmp) + ((uintptr_t)buf & 3U), buf, head);
+        acc = tmp;
+        buf += head;
+        len -= head;
+    }
+    words = (const uint32_t *)buf;
+    /* a 64-bit accumulator can not overflow for any 16-bit length, so the
+     * carries are only folded back in at the end */
+    while (len >= 32) {
+        acc += (uint64_t)words[0] + words[1] + words[2] + words[3];
+        acc += (uint64_t)words[4] + words[5] + words[6] + words[7];
+        words += 8;
+        len -= 32;
+    }
+    while (len >= 4) {
+        acc += *(words++);
+        len -= 4;
+    }
+    if (len > 0) {
+        tmp = 0;
+        memcpy(&tmp, words, len);
+        acc += tmp;
+    }
+    return acc;
+}
+
+static inline uint16_t _fold(uint64_t acc)
+{
+    acc = (acc & 0xffffffff) + (acc >> 32);
+    acc = (acc & 0xffffffff) + (acc >> 32);
+    acc = (acc & 0xffff) + (acc >> 16);
+    acc = (acc & 0xffff) + (acc >> 16);
+    return (uint16_t)acc;
+}
+
 uint16_t inet_csum_slice(uint16_t sum, const uint8_t *buf, uint16_t len, size_t accum_len)
 {
-    uint32_t csum = sum;
+    uint16_t csum;
+    /* the sum of buf in host byte order is swapped by an odd start address and
+     * by an odd position in the checksum domain */
+    bool swap = ((uintptr_t)buf ^ accum_len) & 1;
 
     DEBUG("inet_sum: sum = 0x%04" PRIx16 ", len = %" PRIu16, sum, len);
 #if ENABLE_DEBUG
@@ -34,30 +100,20 @@ uint16_t inet_csum_slice(uint16_t sum, const uint8_t *buf, uint16_t len, size_t
 #endif
 #endif
 
-    if (len == 0)
-        return csum;
-
-    if (accum_len & 1) {      /* if accumulated length is odd */
-        csum += *buf;         /* add first byte as bottom half of 16-byte word */
-        buf++;
-        len--;
-        accum_len++;
-    }
-
-    for (int i = 0; i < (len >> 1); buf += 2, i++) {
-        csum += (uint16_t)(*buf << 8) + *(buf + 1); /* group bytes by 16-byte words */
-                                                    /* and add them */
+    if (len == 0) {
+        return sum;
     }
 
-    if ((accum_len + len) & 1)          /* if accumulated length is odd */
-        csum += (uint16_t)(*buf << 8);  /* add last byte as top half of 16-byte word */
-
-    while (csum >> 16) {
-        uint16_t carry = csum >> 16;
-        csum = (csum & 0xffff) + carry;
+    csum = _fold(_sum_words(buf, len));
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    swap = !swap;
+#endif
+    if (swap) {
+        csum = byteorder_swaps(csum);
     }
+    csum = inet_csum_add(sum, csum);
 
-    DEBUG("inet_sum: new sum = 0x%04" PRIx32 "\n", csum);
+    DEBUG("inet_sum: new sum = 0x%04" PRIx16 "\n", csum);
 
     return csum;
 }
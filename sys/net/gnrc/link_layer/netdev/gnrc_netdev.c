@@ -19,6 +19,7 @@
  */
 
 #include <errno.h>
+#include <string.h>
 
 #include "msg.h"
 #include "thread.h"
@@ -40,6 +41,10 @@
 #define NETDEV_NETAPI_MSG_QUEUE_SIZE 8
 
 static void _pass_on_packet(gnrc_pktsnip_t *pkt);
+#ifdef MODULE_NETSTATS_NEIGHBOR
+static void _nb_record_dst(gnrc_netdev_t *gnrc_netdev, gnrc_pktsnip_t *pkt);
+static void _nb_tx_done(gnrc_netdev_t *gnrc_netdev, bool success);
+#endif
 
 /**
  * @brief   Function called by the device driver on device events
@@ -73,12 +78,27 @@ static void _event_cb(netdev_t *dev, netdev_event_t event)
 
                     break;
                 }
-#ifdef MODULE_NETSTATS_L2
+#if defined(MODULE_NETSTATS_L2) || defined(MODULE_NETSTATS_NEIGHBOR)
             case NETDEV_EVENT_TX_MEDIUM_BUSY:
+#ifdef MODULE_NETSTATS_L2
                 dev->stats.tx_failed++;
+#endif
+#ifdef MODULE_NETSTATS_NEIGHBOR
+                _nb_tx_done(gnrc_netdev, false);
+#endif
                 break;
             case NETDEV_EVENT_TX_COMPLETE:
+#ifdef MODULE_NETSTATS_L2
                 dev->stats.tx_success++;
+#endif
+#ifdef MODULE_NETSTATS_NEIGHBOR
+                _nb_tx_done(gnrc_netdev, true);
+#endif
+                break;
+#endif
+#ifdef MODULE_NETSTATS_NEIGHBOR
+            case NETDEV_EVENT_TX_NOACK:
+                _nb_tx_done(gnrc_netdev, false);
                 break;
 #endif
             default:
@@ -97,6 +117,111 @@ static void _pass_on_packet(gnrc_pktsnip_t *pkt)
     }
 }
 
+#ifdef MODULE_NETSTATS_NEIGHBOR
+/**
+ * @brief   Remember the neighbor a packet is sent to, so the outcome of the
+ *          transmission can be accounted to it
+ */
+static void _nb_record_dst(gnrc_netdev_t *gnrc_netdev, gnrc_pktsnip_t *pkt)
+{
+    gnrc_netif_hdr_t *hdr;
+    netstats_nb_t *nb = NULL, *oldest = NULL;
+    uint8_t *dst;
+
+    gnrc_netdev->nb_pending = NULL;
+
+    if ((pkt == NULL) || (pkt->type != GNRC_NETTYPE_NETIF)) {
+        return;
+    }
+    hdr = pkt->data;
+    if ((hdr->flags & (GNRC_NETIF_HDR_FLAGS_BROADCAST | GNRC_NETIF_HDR_FLAGS_MULTICAST)) ||
+        (hdr->dst_l2addr_len == 0) ||
+        (hdr->dst_l2addr_len > sizeof(nb->l2_addr))) {
+        return;
+    }
+    dst = gnrc_netif_hdr_get_dst_addr(hdr);
+    for (unsigned i = 0; i < NETSTATS_NB_SIZE; i++) {
+        netstats_nb_t *entry = &gnrc_netdev->nb_stats[i];
+
+        if ((entry->l2_addr_len == hdr->dst_l2addr_len) &&
+            (memcmp(entry->l2_addr, dst, entry->l2_addr_len) == 0)) {
+            nb = entry;
+            break;
+        }
+        /* prefer unused entries, otherwise replace the least recently used */
+        if ((oldest == NULL) || (entry->l2_addr_len == 0) ||
+            ((oldest->l2_addr_len != 0) &&
+             ((uint16_t)(gnrc_netdev->nb_age - entry->last_use) >
+              (uint16_t)(gnrc_netdev->nb_age - oldest->last_use)))) {
+            oldest = entry;
+        }
+    }
+    if (nb == NULL) {
+        nb = oldest;
+        memset(nb, 0, sizeof(netstats_nb_t));
+        memcpy(nb->l2_addr, dst, hdr->dst_l2addr_len);
+        nb->l2_addr_len = hdr->dst_l2addr_len;
+        nb->etx = NETSTATS_NB_ETX_INIT;
+    }
+    nb->last_use = gnrc_netdev->nb_age++;
+    gnrc_netdev->nb_pending = nb;
+}
+
+/**
+ * @brief   Update the ETX of the neighbor the last transmission was sent to
+ */
+static void _nb_tx_done(gnrc_netdev_t *gnrc_netdev, bool success)
+{
+    netstats_nb_t *nb = gnrc_netdev->nb_pending;
+    netdev_t *dev = gnrc_netdev->dev;
+    unsigned sample;
+
+    if (nb == NULL) {
+        return;
+    }
+    gnrc_netdev->nb_pending = NULL;
+    nb->tx_count++;
+    if (success) {
+        uint8_t retries = 0;
+
+        if (dev->driver->get(dev, NETOPT_TX_RETRIES_NEEDED, &retries,
+                             sizeof(retries)) < 0) {
+            retries = 0;
+        }
+        sample = (retries + 1U) * NETSTATS_NB_ETX_DIVISOR;
+    }
+    else {
+        nb->tx_failed++;
+        sample = NETSTATS_NB_ETX_NOACK_PENALTY;
+    }
+    /* exponentially weighted moving average */
+    nb->etx = (uint16_t)(((nb->etx * NETSTATS_NB_ETX_ALPHA) +
+                          (sample * (8U - NETSTATS_NB_ETX_ALPHA))) / 8U);
+    DEBUG("gnrc_netdev: ETX to neighbor updated to %u/%u\n", nb->etx,
+          NETSTATS_NB_ETX_DIVISOR);
+}
+#endif
+
+static int _get(gnrc_netdev_t *gnrc_netdev, gnrc_netapi_opt_t *opt)
+{
+    netdev_t *dev = gnrc_netdev->dev;
+
+#ifdef MODULE_NETSTATS_NEIGHBOR
+    if ((opt->opt == NETOPT_STATS) && (opt->context == NETSTATS_NEIGHBOR)) {
+        /* copied in the device thread, so the caller gets a consistent
+         * snapshot while transmissions keep updating the table */
+        if (opt->data_len < sizeof(gnrc_netdev->nb_stats)) {
+            return -EOVERFLOW;
+        }
+        memcpy(opt->data, gnrc_netdev->nb_stats, sizeof(gnrc_netdev->nb_stats));
+        return sizeof(gnrc_netdev->nb_stats);
+    }
+#else
+    (void)gnrc_netdev;
+#endif
+    return dev->driver->get(dev, opt->opt, opt->data, opt->data_len);
+}
+
 /**
  * @brief   Startup code and event loop of the gnrc_netdev layer
  *
@@ -143,6 +268,9 @@ static void *_gnrc_netdev_thread(void *args)
             case GNRC_NETAPI_MSG_TYPE_SND:
                 DEBUG("gnrc_netdev: GNRC_NETAPI_MSG_TYPE_SND received\n");
                 gnrc_pktsnip_t *pkt = msg.content.ptr;
+#ifdef MODULE_NETSTATS_NEIGHBOR
+                _nb_record_dst(gnrc_netdev, pkt);
+#endif
                 gnrc_netdev->send(gnrc_netdev, pkt);
                 break;
             case GNRC_NETAPI_MSG_TYPE_SET:
@@ -164,7 +292,7 @@ static void *_gnrc_netdev_thread(void *args)
                 DEBUG("gnrc_netdev: GNRC_NETAPI_MSG_TYPE_GET received. opt=%s\n",
                         netopt2str(opt->opt));
                 /* get option from device driver */
-                res = dev->driver->get(dev, opt->opt, opt->data, opt->data_len);
+                res = _get(gnrc_netdev, opt);
                 DEBUG("gnrc_netdev: response of netdev->get: %i\n", res);
                 /* send reply to calling thread */
                 reply.type = GNRC_NETAPI_MSG_TYPE_ACK;
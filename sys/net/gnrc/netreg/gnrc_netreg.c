@@ -27,17 +27,71 @@
 
 #define _INVALID_TYPE(type) (((type) < GNRC_NETTYPE_UNDEF) || ((type) >= GNRC_NETTYPE_NUMOF))
 
+#if (GNRC_NETREG_HASH_SIZE & (GNRC_NETREG_HASH_SIZE - 1))
+#error "GNRC_NETREG_HASH_SIZE must be a power of 2"
+#endif
+
 /* The registry as lookup table by gnrc_nettype_t */
 static gnrc_netreg_entry_t *netreg[GNRC_NETTYPE_NUMOF];
 
+/* The types with many different demultiplexing contexts are hashed by it */
+#ifdef MODULE_GNRC_IPV6
+static gnrc_netreg_entry_t *_ipv6[GNRC_NETREG_HASH_SIZE];
+#endif
+#ifdef MODULE_GNRC_UDP
+static gnrc_netreg_entry_t *_udp[GNRC_NETREG_HASH_SIZE];
+#endif
+#ifdef TEST_SUITES
+static gnrc_netreg_entry_t *_test[GNRC_NETREG_HASH_SIZE];
+#endif
+
+static inline unsigned _hash(uint32_t demux_ctx)
+{
+    /* fold the upper half in, so GNRC_NETREG_DEMUX_CTX_ALL gets its own bucket */
+    return (demux_ctx ^ (demux_ctx >> 16)) & (GNRC_NETREG_HASH_SIZE - 1);
+}
+
+/* returns the head of the list an entry with demux_ctx is stored in */
+static gnrc_netreg_entry_t **_list(gnrc_nettype_t type, uint32_t demux_ctx)
+{
+    switch (type) {
+#ifdef MODULE_GNRC_IPV6
+        case GNRC_NETTYPE_IPV6:
+            return &_ipv6[_hash(demux_ctx)];
+#endif
+#ifdef MODULE_GNRC_UDP
+        case GNRC_NETTYPE_UDP:
+            return &_udp[_hash(demux_ctx)];
+#endif
+#ifdef TEST_SUITES
+        case GNRC_NETTYPE_TEST:
+            return &_test[_hash(demux_ctx)];
+#endif
+        default:
+            (void)demux_ctx;
+            return &netreg[type];
+    }
+}
+
 void gnrc_netreg_init(void)
 {
     /* set all pointers in registry to NULL */
     memset(netreg, 0, GNRC_NETTYPE_NUMOF * sizeof(gnrc_netreg_entry_t *));
+#ifdef MODULE_GNRC_IPV6
+    memset(_ipv6, 0, sizeof(_ipv6));
+#endif
+#ifdef MODULE_GNRC_UDP
+    memset(_udp, 0, sizeof(_udp));
+#endif
+#ifdef TEST_SUITES
+    memset(_test, 0, sizeof(_test));
+#endif
 }
 
 int gnrc_netreg_register(gnrc_nettype_t type, gnrc_netreg_entry_t *entry)
 {
+    gnrc_netreg_entry_t **list;
+
 #if defined(MODULE_GNRC_NETAPI_MBOX) || defined(MODULE_GNRC_NETAPI_CALLBACKS)
 #ifdef DEVELHELP
     /* only threads with a message queue are allowed to register at gnrc */
@@ -53,29 +107,34 @@ int gnrc_netreg_register(gnrc_nettype_t type, gnrc_netreg_entry_t *entry)
         return -EINVAL;
     }
 
-    LL_PREPEND(netreg[type], entry);
+    list = _list(type, entry->demux_ctx);
+    LL_PREPEND(*list, entry);
 
     return 0;
 }
 
 void gnrc_netreg_unregister(gnrc_nettype_t type, gnrc_netreg_entry_t *entry)
 {
+    gnrc_netreg_entry_t **list;
+
     if (_INVALID_TYPE(type)) {
         return;
     }
 
-    LL_DELETE(netreg[type], entry);
+    list = _list(type, entry->demux_ctx);
+    LL_DELETE(*list, entry);
 }
 
 gnrc_netreg_entry_t *gnrc_netreg_lookup(gnrc_nettype_t type, uint32_t demux_ctx)
 {
-    gnrc_netreg_entry_t *res;
+    gnrc_netreg_entry_t *res, **list;
 
     if (_INVALID_TYPE(type)) {
         return NULL;
     }
 
-    LL_SEARCH_SCALAR(netreg[type], res, demux_ctx, demux_ctx);
+    list = _list(type, demux_ctx);
+    LL_SEARCH_SCALAR(*list, res, demux_ctx, demux_ctx);
 
     return res;
 }
@@ -89,7 +148,7 @@ int gnrc_netreg_num(gnrc_nettype_t type, uint32_t demux_ctx)
         return 0;
     }
 
-    entry = netreg[type];
+    entry = *_list(type, demux_ctx);
 
     while (entry != NULL) {
         if (entry->demux_ctx == demux_ctx) {
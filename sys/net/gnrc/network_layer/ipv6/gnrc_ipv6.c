@@ -37,6 +37,9 @@
 #include "net/gnrc/ipv6/netif.h"
 #include "net/gnrc/ipv6/whitelist.h"
 #include "net/gnrc/ipv6/blacklist.h"
+#ifdef MODULE_GNRC_RPL_SRH
+#include "net/gnrc/rpl/srh.h"
+#endif
 
 #include "net/gnrc/ipv6.h"
 
@@ -681,6 +684,104 @@ static inline kernel_pid_t _next_hop_l2addr(uint8_t *l2addr, uint8_t *l2addr_len
 }
 #endif   /* MODULE_GNRC_IPV6_NIB */
 
+#ifdef MODULE_GNRC_RPL_SRH
+/**
+ * @brief   Tunnels a forwarded packet to its destination, if this node is a
+ *          non-storing mode root and the destination is deeper in its DODAG
+ *
+ * Routers must not insert a routing header into packets they forward
+ * (RFC 6554, section 4 and RFC 8200, section 4), so the packet is wrapped into
+ * a new IPv6 header (IPv6-in-IPv6), which gets the routing header in
+ * _insert_srh(). The destination decapsulates the packet again.
+ *
+ * @return  1 if the packet was encapsulated, @p pkt and @p ipv6 then point
+ *          to the new header (@p pkt only if it pointed to the old one)
+ * @return  0 if the packet needs no routing header
+ * @return  < 0 on error
+ */
+static int _encapsulate_srh(gnrc_pktsnip_t **pkt, gnrc_pktsnip_t **ipv6)
+{
+    ipv6_hdr_t *hdr = (*ipv6)->data;
+    gnrc_pktsnip_t *outer;
+    ipv6_addr_t next_hop;
+
+    if (gnrc_rpl_srh_tree_build(&hdr->dst, &next_hop, NULL, 0) <= 0) {
+        return 0;
+    }
+    /* source is set to our own address when the header is filled in */
+    outer = gnrc_ipv6_hdr_build(*ipv6, NULL, &hdr->dst);
+    if (outer == NULL) {
+        DEBUG("ipv6: unable to allocate header for encapsulation\n");
+        return -ENOBUFS;
+    }
+    if (*pkt == *ipv6) {
+        *pkt = outer;
+    }
+    else {
+        (*pkt)->next = outer;
+    }
+    *ipv6 = outer;
+    DEBUG("ipv6: encapsulated forwarded packet for source routing\n");
+
+    return 1;
+}
+
+/**
+ * @brief   Inserts a RPL source routing header into a packet this node
+ *          originates, if this node is a non-storing mode root and the
+ *          destination is deeper in its DODAG
+ *
+ * The destination of the IPv6 header is replaced by the first hop of the
+ * route. The header is filled in before if @p prep_hdr is set, as the upper
+ * layer checksum covers the final destination.
+ *
+ * @return  0 if the packet can be sent (with or without a routing header)
+ * @return  < 0 on error
+ */
+static int _insert_srh(kernel_pid_t iface, gnrc_pktsnip_t *ipv6,
+                       bool *prep_hdr)
+{
+    ipv6_hdr_t *hdr = ipv6->data;
+    gnrc_pktsnip_t *rh;
+    gnrc_rpl_srh_t *srh;
+    ipv6_addr_t next_hop;
+    int res;
+
+    /* not in a DODAG we are root of, or a child of the root */
+    if ((res = gnrc_rpl_srh_tree_build(&hdr->dst, &next_hop, NULL, 0)) <= 0) {
+        return 0;
+    }
+    if (*prep_hdr) {
+        if ((res = _fill_ipv6_hdr(iface, ipv6, ipv6->next)) < 0) {
+            return res;
+        }
+        *prep_hdr = false;
+    }
+    rh = gnrc_pktbuf_add(ipv6->next, NULL, res, GNRC_NETTYPE_IPV6_EXT);
+    if (rh == NULL) {
+        DEBUG("ipv6: unable to allocate source routing header\n");
+        return -ENOBUFS;
+    }
+    srh = rh->data;
+    if (gnrc_rpl_srh_tree_build(&hdr->dst, &next_hop, srh, rh->size) != res) {
+        /* route changed in between */
+        DEBUG("ipv6: source route changed, dropping packet\n");
+        rh->next = NULL;
+        gnrc_pktbuf_release(rh);
+        return -EAGAIN;
+    }
+    srh->nh = hdr->nh;
+    hdr->nh = PROTNUM_IPV6_EXT_RH;
+    hdr->len = byteorder_htons(byteorder_ntohs(hdr->len) + res);
+    hdr->dst = next_hop;
+    ipv6->next = rh;
+    DEBUG("ipv6: inserted source routing header, next hop %s\n",
+          ipv6_addr_to_str(addr_str, &next_hop, sizeof(addr_str)));
+
+    return 0;
+}
+#endif
+
 static void _send(gnrc_pktsnip_t *pkt, bool prep_hdr)
 {
     kernel_pid_t iface = KERNEL_PID_UNDEF;
@@ -771,6 +872,27 @@ static void _send(gnrc_pktsnip_t *pkt, bool prep_hdr)
         }
     }
     else {
+#ifdef MODULE_GNRC_RPL_SRH
+        if (!prep_hdr) {
+            /* forwarded packet */
+            int res = _encapsulate_srh(&pkt, &ipv6);
+
+            if (res < 0) {
+                gnrc_pktbuf_release(pkt);
+                return;
+            }
+            else if (res > 0) {
+                /* the new header still needs to be filled in */
+                hdr = ipv6->data;
+                payload = ipv6->next;
+                prep_hdr = true;
+            }
+        }
+        if (_insert_srh(iface, ipv6, &prep_hdr) < 0) {
+            gnrc_pktbuf_release(pkt);
+            return;
+        }
+#endif
 #ifndef MODULE_GNRC_IPV6_NIB
         uint8_t l2addr_len = GNRC_IPV6_NC_L2_ADDR_MAX;
         uint8_t l2addr[l2addr_len];
@@ -823,21 +823,46 @@ static inline bool _node_unreachable(_nib_onl_entry_t *node)
     }
 }
 
+static evtimer_msg_event_t *_evtimer_get(const void *ctx, uint16_t type)
+{
+    switch (type) {
+        case GNRC_IPV6_NIB_SND_UC_NS:
+        case GNRC_IPV6_NIB_SND_MC_NS:
+        case GNRC_IPV6_NIB_REACH_TIMEOUT:
+        case GNRC_IPV6_NIB_DELAY_TIMEOUT:
+            return &((_nib_onl_entry_t *)ctx)->nud_timeout;
+        case GNRC_IPV6_NIB_SND_NA:
+            return &((_nib_onl_entry_t *)ctx)->snd_na;
+#if GNRC_IPV6_NIB_CONF_6LR
+        case GNRC_IPV6_NIB_ADDR_REG_TIMEOUT:
+            return &((_nib_onl_entry_t *)ctx)->addr_reg_timeout;
+#endif
+        case GNRC_IPV6_NIB_PFX_TIMEOUT:
+            return &((_nib_offl_entry_t *)ctx)->pfx_timeout;
+#if GNRC_IPV6_NIB_CONF_ARSM
+        case GNRC_IPV6_NIB_RECALC_REACH_TIME:
+            return &((_nib_iface_t *)ctx)->recalc_reach_time;
+#endif
+#if GNRC_IPV6_NIB_CONF_MULTIHOP_P6C
+        case GNRC_IPV6_NIB_ABR_TIMEOUT:
+            return &((_nib_abr_entry_t *)ctx)->timeout;
+#endif
+        default:
+            return NULL;
+    }
+}
+
 uint32_t _evtimer_lookup(const void *ctx, uint16_t type)
 {
-    evtimer_msg_event_t *event = (evtimer_msg_event_t *)_nib_evtimer.events;
-    uint32_t offset = 0;
+    evtimer_msg_event_t *event = _evtimer_get(ctx, type);
 
     DEBUG("nib: lookup ctx = %p, type = %04x\n", (void *)ctx, type);
-    while (event != NULL) {
-        offset += event->event.offset;
-        if ((event->msg.type == type) &&
-            ((ctx == NULL) || (event->msg.content.ptr == ctx))) {
-            return offset;
-        }
-        event = (evtimer_msg_event_t *)event->event.next;
+    /* the event of a context may be queued with another type */
+    if ((event == NULL) || (event->msg.type != type) ||
+        (event->msg.content.ptr != ctx)) {
+        return UINT32_MAX;
     }
-    return UINT32_MAX;
+    return evtimer_remaining((evtimer_t *)&_nib_evtimer, &event->event);
 }
 
 /** @} */
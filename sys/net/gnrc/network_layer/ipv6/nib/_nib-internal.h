@@ -822,7 +822,12 @@ void _nib_iface_recalc_reach_time(_nib_iface_t *iface);
 /**
  * @brief   Looks up if an event is queued in the event timer
  *
- * @param[in] ctx   Context of the event. May be NULL for any event context.
+ * The event is found from its context and type without searching the event
+ * queue.
+ *
+ * @pre `ctx != NULL`
+ *
+ * @param[in] ctx   Context of the event.
  * @param[in] type  [Type of the event](@ref net_gnrc_ipv6_nib_msg).
  *
  * @return  Milliseconds to the event, if event in queue.
@@ -71,13 +71,9 @@ static inline bool _is_rtr(const gnrc_ipv6_netif_t *netif)
 
 void gnrc_ipv6_nib_init(void)
 {
-    evtimer_event_t *tmp;
-
     mutex_lock(&_nib_mutex);
-    for (evtimer_event_t *ptr = _nib_evtimer.events;
-         (ptr != NULL) && (tmp = (ptr->next), 1);
-         ptr = tmp) {
-        evtimer_del((evtimer_t *)(&_nib_evtimer), ptr);
+    while (_nib_evtimer.events != NULL) {
+        evtimer_del((evtimer_t *)(&_nib_evtimer), _nib_evtimer.events);
     }
     _nib_init();
     mutex_unlock(&_nib_mutex);
@@ -25,6 +25,9 @@
 #include "net/gnrc/rpl/p2p.h"
 #include "net/gnrc/rpl/p2p_dodag.h"
 #endif
+#ifdef MODULE_NETSTATS_RPL
+#include "gnrc_rpl_internal/netstats.h"
+#endif
 
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
@@ -45,6 +48,8 @@ gnrc_rpl_parent_t gnrc_rpl_parents[GNRC_RPL_PARENTS_NUMOF];
 
 #ifdef MODULE_NETSTATS_RPL
 netstats_rpl_t gnrc_rpl_netstats;
+static uint32_t _netstats_last[4];
+static uint16_t _netstats_time;
 #endif
 
 static void _update_lifetime(void);
@@ -278,12 +283,7 @@ void _update_lifetime(void)
                 }
             }
 
-            if (inst->dodag.dao_time > GNRC_RPL_LIFETIME_UPDATE_STEP) {
-                inst->dodag.dao_time -= GNRC_RPL_LIFETIME_UPDATE_STEP;
-            }
-            else {
-                _dao_handle_send(&inst->dodag);
-            }
+            gnrc_rpl_dao_update(&inst->dodag);
         }
     }
 
@@ -291,40 +291,220 @@ void _update_lifetime(void)
     gnrc_rpl_p2p_update();
 #endif
 
+#ifdef MODULE_NETSTATS_RPL
+    _netstats_time += GNRC_RPL_LIFETIME_UPDATE_STEP;
+    if (_netstats_time >= GNRC_RPL_NETSTATS_INTERVAL) {
+        _netstats_time = 0;
+        gnrc_rpl_netstats_interval(&gnrc_rpl_netstats, _netstats_last);
+    }
+#endif
+
     xtimer_set_msg(&_lt_timer, _lt_time, &_lt_msg, gnrc_rpl_pid);
 }
 
 void gnrc_rpl_delay_dao(gnrc_rpl_dodag_t *dodag)
 {
+    /* merge into the DAO that is already scheduled */
+    if (dodag->dao_time <= GNRC_RPL_DEFAULT_DAO_DELAY) {
+#ifdef MODULE_NETSTATS_RPL
+        gnrc_rpl_netstats.dao_merged++;
+#endif
+        return;
+    }
     dodag->dao_time = GNRC_RPL_DEFAULT_DAO_DELAY;
-    dodag->dao_counter = 0;
-    dodag->dao_ack_received = false;
 }
 
 void gnrc_rpl_long_delay_dao(gnrc_rpl_dodag_t *dodag)
 {
     dodag->dao_time = GNRC_RPL_REGULAR_DAO_INTERVAL;
-    dodag->dao_counter = 0;
-    dodag->dao_ack_received = false;
 }
 
-void _dao_handle_send(gnrc_rpl_dodag_t *dodag)
+static bool _dao_send(gnrc_rpl_dodag_t *dodag, ipv6_addr_t *dst, uint8_t lifetime,
+                      uint8_t *seq)
 {
-#ifdef MODULE_GNRC_RPL_P2P
-    if (dodag->instance->mop == GNRC_RPL_P2P_MOP) {
+    *seq = dodag->dao_seq;
+    gnrc_rpl_send_DAO(dodag->instance, dst, lifetime);
+    /* the sequence number is only consumed by a DAO that was sent */
+    return (*seq != dodag->dao_seq);
+}
+
+/* a newer DAO to the same destination, or a new preferred parent, makes
+ * retransmitting this DAO pointless */
+static bool _dao_superseded(gnrc_rpl_dodag_t *dodag, gnrc_rpl_dao_pending_t *dao)
+{
+    if ((dao->lifetime > 0) &&
+        ((dodag->parents == NULL) || !ipv6_addr_equal(&dodag->parents->addr, &dao->dst))) {
+        return true;
+    }
+    for (unsigned i = 0; i < GNRC_RPL_DAO_PIPELINE_SIZE; i++) {
+        gnrc_rpl_dao_pending_t *other = &dodag->dao_pending[i];
+
+        if ((other->timeout != 0) && ipv6_addr_equal(&other->dst, &dao->dst) &&
+            GNRC_RPL_COUNTER_GREATER_THAN(other->seq, dao->seq)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void _dao_handle_pending(gnrc_rpl_dodag_t *dodag)
+{
+    for (unsigned i = 0; i < GNRC_RPL_DAO_PIPELINE_SIZE; i++) {
+        gnrc_rpl_dao_pending_t *dao = &dodag->dao_pending[i];
+
+        if (dao->timeout == 0) {
+            continue;
+        }
+        if (dao->timeout > GNRC_RPL_LIFETIME_UPDATE_STEP) {
+            dao->timeout -= GNRC_RPL_LIFETIME_UPDATE_STEP;
+            continue;
+        }
+        dao->timeout = 0;
+        if (_dao_superseded(dodag, dao)) {
+            continue;
+        }
+        if (dao->retries >= GNRC_RPL_DAO_SEND_RETRIES) {
+            DEBUG("RPL: no DAO-ACK for DAO (%d)\n", dao->seq);
+#ifdef MODULE_NETSTATS_RPL
+            gnrc_rpl_netstats.dao_ack_timeouts++;
+#endif
+            continue;
+        }
+        if (_dao_send(dodag, &dao->dst, dao->lifetime, &dao->seq)) {
+            dao->retries++;
+            dao->timeout = GNRC_RPL_DEFAULT_WAIT_FOR_DAO_ACK;
+#ifdef MODULE_NETSTATS_RPL
+            gnrc_rpl_netstats.dao_retransmissions++;
+#endif
+        }
+    }
+}
+
+void gnrc_rpl_track_dao(gnrc_rpl_dodag_t *dodag, ipv6_addr_t *destination, uint8_t lifetime)
+{
+    gnrc_rpl_dao_pending_t *dao = NULL;
+    uint8_t seq;
+
+    if (destination == NULL) {
+        if (dodag->parents == NULL) {
+            DEBUG("RPL: dodag has no preferred parent\n");
+            return;
+        }
+        destination = &dodag->parents->addr;
+    }
+
+    if (!_dao_send(dodag, destination, lifetime, &seq)) {
+        return;
+    }
+
+    /* take a free slot, or replace the oldest outstanding DAO */
+    for (unsigned i = 0; i < GNRC_RPL_DAO_PIPELINE_SIZE; i++) {
+        gnrc_rpl_dao_pending_t *cur = &dodag->dao_pending[i];
+
+        if (cur->timeout == 0) {
+            dao = cur;
+            break;
+        }
+        if ((dao == NULL) || GNRC_RPL_COUNTER_GREATER_THAN(dao->seq, cur->seq)) {
+            dao = cur;
+        }
+    }
+
+    dao->dst = *destination;
+    dao->seq = seq;
+    dao->lifetime = lifetime;
+    dao->retries = 0;
+    dao->timeout = GNRC_RPL_DEFAULT_WAIT_FOR_DAO_ACK;
+}
+
+/* completes the outstanding DAO with sequence number seq and the older ones
+ * with the same destination, returns false if there is no such DAO */
+static bool _dao_complete(gnrc_rpl_dodag_t *dodag, uint8_t seq, ipv6_addr_t *dst)
+{
+    gnrc_rpl_dao_pending_t *done = NULL;
+
+    for (unsigned i = 0; i < GNRC_RPL_DAO_PIPELINE_SIZE; i++) {
+        if ((dodag->dao_pending[i].timeout != 0) && (dodag->dao_pending[i].seq == seq)) {
+            done = &dodag->dao_pending[i];
+            break;
+        }
+    }
+
+    if (done == NULL) {
+        DEBUG("RPL: DAO-ACK (%d) for no outstanding DAO\n", seq);
+        return false;
+    }
+
+    *dst = done->dst;
+    for (unsigned i = 0; i < GNRC_RPL_DAO_PIPELINE_SIZE; i++) {
+        gnrc_rpl_dao_pending_t *dao = &dodag->dao_pending[i];
+
+        if ((dao->timeout != 0) && ipv6_addr_equal(&dao->dst, dst) &&
+            ((dao == done) || GNRC_RPL_COUNTER_GREATER_THAN(seq, dao->seq))) {
+            dao->timeout = 0;
+        }
+    }
+    return true;
+}
+
+void gnrc_rpl_ack_dao(gnrc_rpl_dodag_t *dodag, uint8_t seq)
+{
+    ipv6_addr_t dst;
+
+    _dao_complete(dodag, seq, &dst);
+}
+
+void gnrc_rpl_reject_dao(gnrc_rpl_dodag_t *dodag, uint8_t seq)
+{
+    ipv6_addr_t dst;
+
+    if (!_dao_complete(dodag, seq, &dst)) {
         return;
     }
+#ifdef MODULE_NETSTATS_RPL
+    gnrc_rpl_netstats.dao_rejected++;
 #endif
-    if ((dodag->dao_ack_received == false) && (dodag->dao_counter < GNRC_RPL_DAO_SEND_RETRIES)) {
-        dodag->dao_counter++;
-        gnrc_rpl_send_DAO(dodag->instance, NULL, dodag->default_lifetime);
-        dodag->dao_time = GNRC_RPL_DEFAULT_WAIT_FOR_DAO_ACK;
+    /* the preferred parent has no room for our routes in storing mode, try
+     * another one (RFC 6550, section 6.5.1) */
+    if (((dodag->instance->mop == GNRC_RPL_MOP_STORING_MODE_NO_MC) ||
+         (dodag->instance->mop == GNRC_RPL_MOP_STORING_MODE_MC)) &&
+        (dodag->parents != NULL) && (dodag->parents->next != NULL) &&
+        ipv6_addr_equal(&dodag->parents->addr, &dst)) {
+        DEBUG("RPL: DAO rejected by preferred parent, selecting another one\n");
+        gnrc_rpl_parent_remove(dodag->parents);
+        gnrc_rpl_parent_update(dodag, NULL);
+        if (dodag->parents != NULL) {
+            gnrc_rpl_delay_dao(dodag);
+            return;
+        }
+    }
+    /* no other parent, or the root rejected the DAO in non-storing mode */
+    gnrc_rpl_long_delay_dao(dodag);
+}
+
+void gnrc_rpl_dao_update(gnrc_rpl_dodag_t *dodag)
+{
+    _dao_handle_pending(dodag);
+
+    if (dodag->dao_time > GNRC_RPL_LIFETIME_UPDATE_STEP) {
+        dodag->dao_time -= GNRC_RPL_LIFETIME_UPDATE_STEP;
     }
-    else if (dodag->dao_ack_received == false) {
-        gnrc_rpl_long_delay_dao(dodag);
+    else {
+        _dao_handle_send(dodag);
     }
 }
 
+static void _dao_handle_send(gnrc_rpl_dodag_t *dodag)
+{
+#ifdef MODULE_GNRC_RPL_P2P
+    if (dodag->instance->mop == GNRC_RPL_P2P_MOP) {
+        return;
+    }
+#endif
+    gnrc_rpl_track_dao(dodag, NULL, dodag->default_lifetime);
+    gnrc_rpl_long_delay_dao(dodag);
+}
+
 uint8_t gnrc_rpl_gen_instance_id(bool local)
 {
     mutex_lock(&_inst_id_mutex);
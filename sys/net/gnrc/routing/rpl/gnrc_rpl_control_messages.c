@@ -32,10 +32,15 @@
 #include "gnrc_rpl_internal/validation.h"
 #endif
 
+#ifdef MODULE_GNRC_RPL_SRH
+#include "net/gnrc/rpl/srh.h"
+#endif
+
 #ifdef MODULE_GNRC_RPL_P2P
 #include "net/gnrc/rpl/p2p_structs.h"
 #include "net/gnrc/rpl/p2p_dodag.h"
 #include "net/gnrc/rpl/p2p.h"
+#include "utlist.h"
 #endif
 
 #define ENABLE_DEBUG    (0)
@@ -52,6 +57,7 @@ static char addr_str[IPV6_ADDR_MAX_STR_LEN];
 #define GNRC_RPL_SHIFTED_MOP_MASK           (0x7)
 #define GNRC_RPL_PRF_MASK                   (0x7)
 #define GNRC_RPL_PREFIX_AUTO_ADDRESS_BIT    (1 << 6)
+#define GNRC_RPL_PREFIX_ROUTER_ADDRESS_BIT  (1 << 5)
 
 void gnrc_rpl_send(gnrc_pktsnip_t *pkt, kernel_pid_t iface, ipv6_addr_t *src, ipv6_addr_t *dst,
                    ipv6_addr_t *dodag_id)
@@ -141,15 +147,16 @@ gnrc_pktsnip_t *_dio_prefix_info_build(gnrc_pktsnip_t *pkt, gnrc_rpl_dodag_t *do
     prefix_info = opt_snip->data;
     prefix_info->type = GNRC_RPL_OPT_PREFIX_INFO;
     prefix_info->length = GNRC_RPL_OPT_PREFIX_INFO_LEN;
-    /* auto-address configuration */
-    prefix_info->LAR_flags = GNRC_RPL_PREFIX_AUTO_ADDRESS_BIT;
+    /* auto-address configuration, the prefix field holds our full address
+     * (needed by children in non-storing mode for the transit option) */
+    prefix_info->LAR_flags = GNRC_RPL_PREFIX_AUTO_ADDRESS_BIT |
+                             GNRC_RPL_PREFIX_ROUTER_ADDRESS_BIT;
     prefix_info->valid_lifetime = dodag->netif_addr->valid;
     prefix_info->pref_lifetime = dodag->netif_addr->preferred;
     prefix_info->prefix_len = dodag->netif_addr->prefix_len;
     prefix_info->reserved = 0;
 
-    memset(&prefix_info->prefix, 0, sizeof(prefix_info->prefix));
-    ipv6_addr_init_prefix(&prefix_info->prefix, &dodag->dodag_id, dodag->netif_addr->prefix_len);
+    memcpy(&prefix_info->prefix, &dodag->netif_addr->addr, sizeof(prefix_info->prefix));
     return opt_snip;
 }
 #endif
@@ -371,6 +378,19 @@ bool _parse_options(int msg_type, gnrc_rpl_instance_t *inst, gnrc_rpl_opt_t *opt
                 dodag->dio_opts |= GNRC_RPL_REQ_DIO_OPT_PREFIX_INFO;
 #endif
                 gnrc_rpl_opt_prefix_info_t *pi = (gnrc_rpl_opt_prefix_info_t *) opt;
+                /* remember the global address of the sender, as the prefix
+                 * is overwritten below */
+                if (pi->LAR_flags & GNRC_RPL_PREFIX_ROUTER_ADDRESS_BIT) {
+                    gnrc_rpl_parent_t *parent;
+
+                    LL_FOREACH(dodag->parents, parent) {
+                        if (ipv6_addr_equal(&parent->addr, src)) {
+                            memcpy(&parent->global_addr, &pi->prefix,
+                                   sizeof(ipv6_addr_t));
+                            break;
+                        }
+                    }
+                }
                 /* check for the auto address-configuration flag */
                 if ((gnrc_netapi_get(dodag->iface, NETOPT_IPV6_IID, 0, &iid, sizeof(eui64_t)) < 0)
                      && !(pi->LAR_flags & GNRC_RPL_PREFIX_AUTO_ADDRESS_BIT)) {
@@ -393,6 +413,13 @@ bool _parse_options(int msg_type, gnrc_rpl_instance_t *inst, gnrc_rpl_opt_t *opt
                     first_target = target;
                 }
 
+                /* in non-storing mode the DAO comes from the target itself,
+                 * not from a neighbor, routes are kept in the source route
+                 * tree instead */
+                if (inst->mop == GNRC_RPL_MOP_NON_STORING_MODE) {
+                    break;
+                }
+
                 uint32_t fib_dst_flags = 0;
 
                 if (target->prefix_length <= IPV6_ADDR_BIT_LEN) {
@@ -420,20 +447,47 @@ bool _parse_options(int msg_type, gnrc_rpl_instance_t *inst, gnrc_rpl_opt_t *opt
                           "a preceding RPL TARGET DAO option\n");
                     break;
                 }
+#ifdef MODULE_GNRC_RPL_SRH
+                ipv6_addr_t parent_addr;
+                bool srh_update = false;
+                if ((inst->mop == GNRC_RPL_MOP_NON_STORING_MODE) &&
+                    (dodag->node_status == GNRC_RPL_ROOT_NODE) &&
+                    (transit->length >= (GNRC_RPL_OPT_TRANSIT_INFO_LEN + sizeof(ipv6_addr_t)))) {
+                    /* options are not aligned in the packet */
+                    memcpy(&parent_addr, transit + 1, sizeof(parent_addr));
+                    srh_update = true;
+                }
+#endif
 
                 do {
-                    DEBUG("RPL: updating fib entry %s/%d\n",
-                          ipv6_addr_to_str(addr_str, &(first_target->target), sizeof(addr_str)),
-                          first_target->prefix_length);
-
-                    fib_update_entry(&gnrc_ipv6_fib_table,
-                                     first_target->target.u8,
-                                     sizeof(ipv6_addr_t), src->u8,
-                                     sizeof(ipv6_addr_t),
-                                     ((transit->e_flags & GNRC_RPL_OPT_TRANSIT_E_FLAG) ?
-                                      0x0 : FIB_FLAG_RPL_ROUTE),
-                                     (transit->path_lifetime *
-                                      dodag->lifetime_unit * MS_PER_SEC));
+                    if (inst->mop != GNRC_RPL_MOP_NON_STORING_MODE) {
+                        DEBUG("RPL: updating fib entry %s/%d\n",
+                              ipv6_addr_to_str(addr_str, &(first_target->target),
+                                               sizeof(addr_str)),
+                              first_target->prefix_length);
+
+                        fib_update_entry(&gnrc_ipv6_fib_table,
+                                         first_target->target.u8,
+                                         sizeof(ipv6_addr_t), src->u8,
+                                         sizeof(ipv6_addr_t),
+                                         ((transit->e_flags & GNRC_RPL_OPT_TRANSIT_E_FLAG) ?
+                                          0x0 : FIB_FLAG_RPL_ROUTE),
+                                         (transit->path_lifetime *
+                                          dodag->lifetime_unit * MS_PER_SEC));
+                    }
+#ifdef MODULE_GNRC_RPL_SRH
+                    if (srh_update) {
+                        ipv6_addr_t target_addr;
+
+                        memcpy(&target_addr, &first_target->target, sizeof(target_addr));
+                        if (transit->path_lifetime == 0) {
+                            gnrc_rpl_srh_tree_remove(&target_addr);
+                        }
+                        else {
+                            gnrc_rpl_srh_tree_update(&target_addr, &parent_addr);
+                        }
+                    }
+#endif
                     first_target = (gnrc_rpl_opt_target_t *) (((uint8_t *) (first_target)) +
                                    sizeof(gnrc_rpl_opt_t) + first_target->length);
                 }
@@ -675,12 +729,13 @@ gnrc_pktsnip_t *_dao_target_build(gnrc_pktsnip_t *pkt, ipv6_addr_t *addr, uint8_
     return opt_snip;
 }
 
-gnrc_pktsnip_t *_dao_transit_build(gnrc_pktsnip_t *pkt, uint8_t lifetime, bool external)
+gnrc_pktsnip_t *_dao_transit_build(gnrc_pktsnip_t *pkt, uint8_t lifetime, bool external,
+                                   ipv6_addr_t *parent)
 {
     gnrc_rpl_opt_transit_t *transit;
     gnrc_pktsnip_t *opt_snip;
-    if ((opt_snip = gnrc_pktbuf_add(pkt, NULL, sizeof(gnrc_rpl_opt_transit_t),
-                               GNRC_NETTYPE_UNDEF)) == NULL) {
+    size_t size = sizeof(gnrc_rpl_opt_transit_t) + ((parent) ? sizeof(ipv6_addr_t) : 0);
+    if ((opt_snip = gnrc_pktbuf_add(pkt, NULL, size, GNRC_NETTYPE_UNDEF)) == NULL) {
         DEBUG("RPL: Send DAO - no space left in packet buffer\n");
         gnrc_pktbuf_release(pkt);
         return NULL;
@@ -693,6 +748,11 @@ gnrc_pktsnip_t *_dao_transit_build(gnrc_pktsnip_t *pkt, uint8_t lifetime, bool e
     transit->path_control = 0;
     transit->path_sequence = 0;
     transit->path_lifetime = lifetime;
+    if (parent) {
+        /* non-storing mode: announce the DODAG parent to the root */
+        transit->length += sizeof(ipv6_addr_t);
+        memcpy(transit + 1, parent, sizeof(ipv6_addr_t));
+    }
     return opt_snip;
 }
 
@@ -729,6 +789,23 @@ void gnrc_rpl_send_DAO(gnrc_rpl_instance_t *inst, ipv6_addr_t *destination, uint
     gnrc_pktsnip_t *pkt = NULL, **ptr = NULL,  *tmp = NULL, *tr_int = NULL;
     gnrc_rpl_dao_t *dao;
     bool ext_processed = false, int_processed = false;
+    ipv6_addr_t *parent = NULL;
+
+    if (inst->mop == GNRC_RPL_MOP_NON_STORING_MODE) {
+        if (dodag->parents == NULL) {
+            DEBUG("RPL: dodag has no preferred parent\n");
+            return;
+        }
+        /* DAOs are sent to the root and carry the global address of the
+         * preferred parent, as announced in the prefix information option of
+         * its DIOs */
+        if (ipv6_addr_is_unspecified(&dodag->parents->global_addr)) {
+            DEBUG("RPL: global address of the preferred parent unknown\n");
+            return;
+        }
+        parent = &dodag->parents->global_addr;
+        destination = &dodag->dodag_id;
+    }
 
     /* find my address */
     ipv6_addr_t *me = NULL;
@@ -748,7 +825,7 @@ void gnrc_rpl_send_DAO(gnrc_rpl_instance_t *inst, ipv6_addr_t *destination, uint
                 ptr = &tmp;
                 if (!ext_processed) {
                     DEBUG("RPL: Send DAO - building external transit\n");
-                    if ((tmp = _dao_transit_build(NULL, lifetime, true)) == NULL) {
+                    if ((tmp = _dao_transit_build(NULL, lifetime, true, parent)) == NULL) {
                         DEBUG("RPL: Send DAO - no space left in packet buffer\n");
                         mutex_unlock(&(gnrc_ipv6_fib_table.mtx_access));
                         return;
@@ -760,7 +837,7 @@ void gnrc_rpl_send_DAO(gnrc_rpl_instance_t *inst, ipv6_addr_t *destination, uint
                 ptr = &pkt;
                 if (!int_processed) {
                     DEBUG("RPL: Send DAO - building internal transit\n");
-                    if ((tr_int = pkt = _dao_transit_build(NULL, lifetime, false)) == NULL) {
+                    if ((tr_int = pkt = _dao_transit_build(NULL, lifetime, false, parent)) == NULL) {
                         DEBUG("RPL: Send DAO - no space left in packet buffer\n");
                         mutex_unlock(&(gnrc_ipv6_fib_table.mtx_access));
                         return;
@@ -850,7 +927,7 @@ void gnrc_rpl_send_DAO(gnrc_rpl_instance_t *inst, ipv6_addr_t *destination, uint
 
     gnrc_rpl_send(pkt, dodag->iface, NULL, destination, &dodag->dodag_id);
 
-    GNRC_RPL_COUNTER_INCREMENT(dodag->dao_seq);
+    dodag->dao_seq = GNRC_RPL_COUNTER_INCREMENT(dodag->dao_seq);
 }
 
 void gnrc_rpl_send_DAO_ACK(gnrc_rpl_instance_t *inst, ipv6_addr_t *destination, uint8_t seq)
@@ -1006,14 +1083,15 @@ void gnrc_rpl_recv_DAO_ACK(gnrc_rpl_dao_ack_t *dao_ack, kernel_pid_t iface, ipv6
         }
     }
 
-    if ((dao_ack->status != 0) && (dao_ack->dao_sequence != dodag->dao_seq)) {
-        DEBUG("RPL: DAO-ACK sequence (%d) does not match expected sequence (%d)\n",
-                dao_ack->dao_sequence, dodag->dao_seq);
+    /* status values of 128 and above reject the DAO */
+    if (dao_ack->status >= 128) {
+        DEBUG("RPL: DAO-ACK (%d) rejected with status %d\n", dao_ack->dao_sequence,
+              dao_ack->status);
+        gnrc_rpl_reject_dao(dodag, dao_ack->dao_sequence);
         return;
     }
 
-    dodag->dao_ack_received = true;
-    gnrc_rpl_long_delay_dao(dodag);
+    gnrc_rpl_ack_dao(dodag, dao_ack->dao_sequence);
 }
 
 /**
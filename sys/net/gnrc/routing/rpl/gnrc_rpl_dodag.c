@@ -24,6 +24,15 @@
 #include "utlist.h"
 
 #include "net/gnrc/rpl.h"
+#ifdef MODULE_NETSTATS_NEIGHBOR
+#include "net/ethernet.h"
+#include "net/gnrc/netapi.h"
+#include "net/ieee802154.h"
+#include "net/netstats.h"
+#endif
+#ifdef MODULE_GNRC_RPL_SRH
+#include "net/gnrc/rpl/srh.h"
+#endif
 #ifdef MODULE_GNRC_RPL_P2P
 #include "net/gnrc/rpl/p2p.h"
 #include "net/gnrc/rpl/p2p_dodag.h"
@@ -150,8 +159,7 @@ bool gnrc_rpl_dodag_init(gnrc_rpl_instance_t *instance, ipv6_addr_t *dodag_id, k
     dodag->node_status = GNRC_RPL_NORMAL_NODE;
     dodag->dao_seq = GNRC_RPL_COUNTER_INIT;
     dodag->dtsn = 0;
-    dodag->dao_ack_received = false;
-    dodag->dao_counter = 0;
+    memset(dodag->dao_pending, 0, sizeof(dodag->dao_pending));
     dodag->instance = instance;
     dodag->iface = iface;
     dodag->netif_addr = netif_addr;
@@ -290,6 +298,47 @@ void gnrc_rpl_parent_update(gnrc_rpl_dodag_t *dodag, gnrc_rpl_parent_t *parent)
     }
 }
 
+#ifdef MODULE_NETSTATS_NEIGHBOR
+/**
+ * @brief   Update the link metrics of all parents from the link layer's
+ *          neighbor statistics
+ *
+ * @param[in] dodag     Pointer to the DODAG
+ */
+static void _gnrc_rpl_update_link_metrics(gnrc_rpl_dodag_t *dodag)
+{
+    /* a copy, the table is updated by the interface's thread */
+    static netstats_nb_t nb_stats[NETSTATS_NB_SIZE];
+    gnrc_rpl_parent_t *elt;
+
+    if (gnrc_netapi_get(dodag->iface, NETOPT_STATS, NETSTATS_NEIGHBOR, nb_stats,
+                        sizeof(nb_stats)) < 0) {
+        return;
+    }
+
+    for (unsigned i = 0; i < NETSTATS_NB_SIZE; i++) {
+        netstats_nb_t *nb = &nb_stats[i];
+        eui64_t iid;
+
+        if ((nb->l2_addr_len == 0) || (nb->tx_count == 0)) {
+            continue;
+        }
+        if (nb->l2_addr_len == ETHERNET_ADDR_LEN) {
+            ethernet_get_iid(&iid, nb->l2_addr);
+        }
+        else if (ieee802154_get_iid(&iid, nb->l2_addr, nb->l2_addr_len) == NULL) {
+            continue;
+        }
+        LL_FOREACH(dodag->parents, elt) {
+            if (memcmp(&elt->addr.u8[8], iid.uint8, sizeof(iid)) == 0) {
+                elt->link_metric = nb->etx;
+                elt->link_metric_type = GNRC_RPL_LINK_METRIC_ETX;
+            }
+        }
+    }
+}
+#endif
+
 /**
  * @brief   Find the parent with the lowest rank and update the DODAG's preferred parent
  *
@@ -309,10 +358,23 @@ static gnrc_rpl_parent_t *_gnrc_rpl_find_preferred_parent(gnrc_rpl_dodag_t *doda
         return NULL;
     }
 
+#ifdef MODULE_NETSTATS_NEIGHBOR
+    _gnrc_rpl_update_link_metrics(dodag);
+#endif
+
     LL_SORT(dodag->parents, dodag->instance->of->parent_cmp);
     new_best = dodag->parents;
 
-    if (new_best->rank == GNRC_RPL_INFINITE_RANK) {
+    /* let the objective function decide if a switch is worth it (hysteresis) */
+    if ((new_best != old_best) &&
+        (dodag->instance->of->which_parent(old_best, new_best) == old_best)) {
+        LL_DELETE(dodag->parents, old_best);
+        LL_PREPEND(dodag->parents, old_best);
+        new_best = old_best;
+    }
+
+    if ((new_best->rank == GNRC_RPL_INFINITE_RANK) ||
+        (dodag->instance->of->calc_rank(new_best, 0) == GNRC_RPL_INFINITE_RANK)) {
         return NULL;
     }
 
@@ -320,7 +382,7 @@ static gnrc_rpl_parent_t *_gnrc_rpl_find_preferred_parent(gnrc_rpl_dodag_t *doda
         /* no-path DAOs only for the storing mode */
         if ((dodag->instance->mop == GNRC_RPL_MOP_STORING_MODE_NO_MC) ||
             (dodag->instance->mop == GNRC_RPL_MOP_STORING_MODE_MC)) {
-            gnrc_rpl_send_DAO(dodag->instance, &old_best->addr, 0);
+            gnrc_rpl_track_dao(dodag, &old_best->addr, 0);
             gnrc_rpl_delay_dao(dodag);
         }
 
@@ -413,6 +475,12 @@ gnrc_rpl_instance_t *gnrc_rpl_root_instance_init(uint8_t instance_id, ipv6_addr_
     dodag = &inst->dodag;
     dodag->instance = inst;
 
+#ifdef MODULE_GNRC_RPL_SRH
+    if (mop == GNRC_RPL_MOP_NON_STORING_MODE) {
+        gnrc_rpl_srh_tree_init(dodag_id);
+    }
+#endif
+
     return inst;
 }
 
@@ -183,6 +183,45 @@ static inline void gnrc_rpl_netstats_tx_DAO_ACK(netstats_rpl_t *netstats, size_t
     }
 }
 
+/**
+ * @brief   Close a statistics interval
+ *
+ * Sets the control-plane overhead of the interval that ends now from the
+ * totals and the totals at the end of the previous interval.
+ *
+ * @param[in]       netstats    Pointer to netstats_rpl_t
+ * @param[in,out]   last        Totals (rx/tx count, rx/tx bytes) at the end of
+ *                              the previous interval, updated to the current ones
+ */
+static inline void gnrc_rpl_netstats_interval(netstats_rpl_t *netstats, uint32_t last[4])
+{
+    uint32_t rx_count = netstats->dio_rx_ucast_count + netstats->dio_rx_mcast_count +
+                        netstats->dis_rx_ucast_count + netstats->dis_rx_mcast_count +
+                        netstats->dao_rx_ucast_count + netstats->dao_rx_mcast_count +
+                        netstats->dao_ack_rx_ucast_count + netstats->dao_ack_rx_mcast_count;
+    uint32_t tx_count = netstats->dio_tx_ucast_count + netstats->dio_tx_mcast_count +
+                        netstats->dis_tx_ucast_count + netstats->dis_tx_mcast_count +
+                        netstats->dao_tx_ucast_count + netstats->dao_tx_mcast_count +
+                        netstats->dao_ack_tx_ucast_count + netstats->dao_ack_tx_mcast_count;
+    uint32_t rx_bytes = netstats->dio_rx_ucast_bytes + netstats->dio_rx_mcast_bytes +
+                        netstats->dis_rx_ucast_bytes + netstats->dis_rx_mcast_bytes +
+                        netstats->dao_rx_ucast_bytes + netstats->dao_rx_mcast_bytes +
+                        netstats->dao_ack_rx_ucast_bytes + netstats->dao_ack_rx_mcast_bytes;
+    uint32_t tx_bytes = netstats->dio_tx_ucast_bytes + netstats->dio_tx_mcast_bytes +
+                        netstats->dis_tx_ucast_bytes + netstats->dis_tx_mcast_bytes +
+                        netstats->dao_tx_ucast_bytes + netstats->dao_tx_mcast_bytes +
+                        netstats->dao_ack_tx_ucast_bytes + netstats->dao_ack_tx_mcast_bytes;
+
+    netstats->interval_rx_count = rx_count - last[0];
+    netstats->interval_tx_count = tx_count - last[1];
+    netstats->interval_rx_bytes = rx_bytes - last[2];
+    netstats->interval_tx_bytes = tx_bytes - last[3];
+    last[0] = rx_count;
+    last[1] = tx_count;
+    last[2] = rx_bytes;
+    last[3] = tx_bytes;
+}
+
 #ifdef __cplusplus
 }
 #endif
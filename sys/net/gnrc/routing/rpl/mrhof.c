@@ -0,0 +1,137 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc_rpl
+ * @{
+ * @file
+ * @brief       Minimum Rank with Hysteresis Objective Function.
+ *
+ * Implementation of MRHOF using ETX as link metric. The rank increase of a
+ * link is its ETX scaled by the minimum hop rank increase, so a perfect link
+ * accounts for exactly one hop.
+ *
+ * @}
+ */
+
+#include "mrhof.h"
+#include "net/gnrc/rpl.h"
+#include "net/gnrc/rpl/structs.h"
+
+static uint16_t calc_rank(gnrc_rpl_parent_t *, uint16_t);
+static gnrc_rpl_parent_t *which_parent(gnrc_rpl_parent_t *, gnrc_rpl_parent_t *);
+static int parent_cmp(gnrc_rpl_parent_t *, gnrc_rpl_parent_t *);
+static gnrc_rpl_dodag_t *which_dodag(gnrc_rpl_dodag_t *, gnrc_rpl_dodag_t *);
+static void reset(gnrc_rpl_dodag_t *);
+
+static gnrc_rpl_of_t gnrc_rpl_mrhof = {
+    GNRC_RPL_MRHOF_OCP,
+    calc_rank,
+    which_parent,
+    parent_cmp,
+    which_dodag,
+    reset,
+    NULL,
+    NULL,
+    NULL
+};
+
+gnrc_rpl_of_t *gnrc_rpl_get_of_mrhof(void)
+{
+    return &gnrc_rpl_mrhof;
+}
+
+void reset(gnrc_rpl_dodag_t *dodag)
+{
+    /* Nothing to do in MRHOF */
+    (void) dodag;
+}
+
+static uint16_t _link_metric(gnrc_rpl_parent_t *parent)
+{
+    return (parent->link_metric == 0) ? GNRC_RPL_MRHOF_DEFAULT_ETX : parent->link_metric;
+}
+
+static uint16_t _min_hop_rank_inc(gnrc_rpl_parent_t *parent)
+{
+    if ((parent != NULL) && (parent->dodag != NULL) && (parent->dodag->instance != NULL)) {
+        return parent->dodag->instance->min_hop_rank_inc;
+    }
+    return GNRC_RPL_DEFAULT_MIN_HOP_RANK_INCREASE;
+}
+
+/* path cost through a parent, i.e. the rank we would get by selecting it */
+static uint32_t _path_cost(gnrc_rpl_parent_t *parent)
+{
+    uint16_t metric = _link_metric(parent);
+
+    if ((parent->rank == GNRC_RPL_INFINITE_RANK) ||
+        (metric > GNRC_RPL_MRHOF_MAX_LINK_METRIC)) {
+        return GNRC_RPL_INFINITE_RANK;
+    }
+
+    uint32_t cost = parent->rank +
+                    ((uint32_t)metric * _min_hop_rank_inc(parent)) /
+                    GNRC_RPL_MRHOF_ETX_DIVISOR;
+
+    return (cost > GNRC_RPL_INFINITE_RANK) ? GNRC_RPL_INFINITE_RANK : cost;
+}
+
+uint16_t calc_rank(gnrc_rpl_parent_t *parent, uint16_t base_rank)
+{
+    uint16_t add = _min_hop_rank_inc(parent);
+
+    if (base_rank == 0) {
+        if (parent == NULL) {
+            return GNRC_RPL_INFINITE_RANK;
+        }
+        return (uint16_t)_path_cost(parent);
+    }
+
+    if (((uint32_t)base_rank + add) >= GNRC_RPL_INFINITE_RANK) {
+        return GNRC_RPL_INFINITE_RANK;
+    }
+
+    return base_rank + add;
+}
+
+/* Keep the first parent unless the second one is better by more than
+ * PARENT_SWITCH_THRESHOLD to avoid parent churn */
+gnrc_rpl_parent_t *which_parent(gnrc_rpl_parent_t *p1, gnrc_rpl_parent_t *p2)
+{
+    uint32_t cost1 = _path_cost(p1);
+    uint32_t cost2 = _path_cost(p2);
+    uint32_t threshold = ((uint32_t)GNRC_RPL_MRHOF_PARENT_SWITCH_THRESHOLD *
+                          _min_hop_rank_inc(p1)) / GNRC_RPL_MRHOF_ETX_DIVISOR;
+
+    if ((cost1 == GNRC_RPL_INFINITE_RANK) || ((cost2 + threshold) < cost1)) {
+        return p2;
+    }
+    return p1;
+}
+
+int parent_cmp(gnrc_rpl_parent_t *parent1, gnrc_rpl_parent_t *parent2)
+{
+    uint32_t cost1 = _path_cost(parent1);
+    uint32_t cost2 = _path_cost(parent2);
+
+    if (cost1 < cost2) {
+        return -1;
+    }
+    else if (cost1 > cost2) {
+        return 1;
+    }
+    return 0;
+}
+
+/* Not used yet */
+gnrc_rpl_dodag_t *which_dodag(gnrc_rpl_dodag_t *d1, gnrc_rpl_dodag_t *d2)
+{
+    (void) d2;
+    return d1;
+}
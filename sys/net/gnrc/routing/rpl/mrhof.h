@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc_rpl
+ * @{
+ * @file
+ * @brief       Minimum Rank with Hysteresis Objective Function.
+ *
+ * Header-file, which defines all functions for the implementation of the
+ * Minimum Rank with Hysteresis Objective Function (MRHOF) using the
+ * expected transmission count (ETX) as link metric.
+ *
+ * @see <a href="https://tools.ietf.org/html/rfc6719">
+ *          RFC 6719
+ *      </a>
+ */
+
+#ifndef MRHOF_H
+#define MRHOF_H
+
+#include "net/gnrc/rpl/structs.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Objective Code Point of MRHOF
+ */
+#define GNRC_RPL_MRHOF_OCP                      (1)
+
+/**
+ * @brief   Fixed point divisor of ETX link metrics (ETX of 1.0)
+ *
+ * @see <a href="https://tools.ietf.org/html/rfc6551#section-4.3.2">
+ *          RFC 6551, section 4.3.2
+ *      </a>
+ */
+#define GNRC_RPL_MRHOF_ETX_DIVISOR              (128U)
+
+/**
+ * @brief   ETX assumed for links without a measurement yet
+ */
+#ifndef GNRC_RPL_MRHOF_DEFAULT_ETX
+#define GNRC_RPL_MRHOF_DEFAULT_ETX              (2U * GNRC_RPL_MRHOF_ETX_DIVISOR)
+#endif
+
+/**
+ * @brief   Links with a higher ETX are not used for parent selection
+ *
+ * @see <a href="https://tools.ietf.org/html/rfc6719#section-5">
+ *          RFC 6719, section 5
+ *      </a>
+ */
+#ifndef GNRC_RPL_MRHOF_MAX_LINK_METRIC
+#define GNRC_RPL_MRHOF_MAX_LINK_METRIC          (512U)
+#endif
+
+/**
+ * @brief   Minimum ETX difference of the path costs to switch the preferred
+ *          parent
+ *
+ * @see <a href="https://tools.ietf.org/html/rfc6719#section-5">
+ *          RFC 6719, section 5
+ *      </a>
+ */
+#ifndef GNRC_RPL_MRHOF_PARENT_SWITCH_THRESHOLD
+#define GNRC_RPL_MRHOF_PARENT_SWITCH_THRESHOLD  (192U)
+#endif
+
+/**
+ * @brief   Return the address to the MRHOF objective function
+ *
+ * @return  Address of the MRHOF objective function
+ */
+gnrc_rpl_of_t *gnrc_rpl_get_of_mrhof(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MRHOF_H */
+/** @} */
@@ -0,0 +1,315 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ * @brief   Source route tree of a non-storing mode DODAG root
+ *
+ * Every node keeps the index of its DODAG parent, so a route is found by
+ * following at most @ref GNRC_RPL_SRH_TREE_MAX_HOPS parent indexes instead of
+ * searching a route table per hop. Nodes are found by address through a
+ * chained hash table, routes of recently used destinations are cached.
+ */
+
+#include <assert.h>
+#include <errno.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "mutex.h"
+#include "net/gnrc/rpl/srh.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+#if ENABLE_DEBUG
+static char addr_str[IPV6_ADDR_MAX_STR_LEN];
+#endif
+
+#if GNRC_RPL_SRH_TREE_SIZE >= 0xfffe
+#error "GNRC_RPL_SRH_TREE_SIZE too large"
+#endif
+
+#if GNRC_RPL_SRH_TREE_CACHE_SIZE >= 0xff
+#error "GNRC_RPL_SRH_TREE_CACHE_SIZE too large"
+#endif
+
+#define NODE_NONE       (0xffff)    /**< no or unknown node */
+#define NODE_ROOT       (0xfffe)    /**< the DODAG root */
+#define CACHE_NONE      (0xff)      /**< no cached route */
+
+/**
+ * @brief   Node of the source route tree
+ */
+typedef struct {
+    ipv6_addr_t addr;   /**< address of the node */
+    uint16_t parent;    /**< index of the parent, NODE_ROOT, or NODE_NONE */
+    uint16_t next;      /**< next node in the same hash bucket or free list */
+    uint8_t cache;      /**< index of the cached route to this node */
+    uint8_t used;       /**< node is in use */
+} _node_t;
+
+/**
+ * @brief   Cached route, from the first hop after the root to the destination
+ */
+typedef struct {
+    uint16_t path[GNRC_RPL_SRH_TREE_MAX_HOPS];  /**< node indexes of the route */
+    uint16_t dst;                               /**< destination or NODE_NONE */
+    uint8_t hops;                               /**< number of hops */
+} _route_t;
+
+static _node_t _nodes[GNRC_RPL_SRH_TREE_SIZE];
+static uint16_t _buckets[GNRC_RPL_SRH_TREE_SIZE];
+static _route_t _cache[GNRC_RPL_SRH_TREE_CACHE_SIZE];
+static uint16_t _free;
+static uint8_t _cache_next;
+static ipv6_addr_t _root;
+static bool _initialized;
+static mutex_t _mutex = MUTEX_INIT;
+
+static unsigned _hash(const ipv6_addr_t *addr)
+{
+    /* nodes of a DODAG mostly share the prefix, so only mix the IID */
+    uint32_t h = addr->u32[2].u32 ^ addr->u32[3].u32;
+
+    h ^= h >> 16;
+    h *= 0x45d9f3bU;
+    h ^= h >> 16;
+    return h % GNRC_RPL_SRH_TREE_SIZE;
+}
+
+static uint16_t _find(const ipv6_addr_t *addr)
+{
+    for (uint16_t i = _buckets[_hash(addr)]; i != NODE_NONE; i = _nodes[i].next) {
+        if (ipv6_addr_equal(&_nodes[i].addr, addr)) {
+            return i;
+        }
+    }
+    return NODE_NONE;
+}
+
+static uint16_t _find_or_add(const ipv6_addr_t *addr)
+{
+    uint16_t idx = _find(addr);
+
+    if ((idx == NODE_NONE) && (_free != NODE_NONE)) {
+        unsigned bucket = _hash(addr);
+
+        idx = _free;
+        _free = _nodes[idx].next;
+        _nodes[idx].addr = *addr;
+        _nodes[idx].parent = NODE_NONE;
+        _nodes[idx].cache = CACHE_NONE;
+        _nodes[idx].used = 1;
+        _nodes[idx].next = _buckets[bucket];
+        _buckets[bucket] = idx;
+    }
+    return idx;
+}
+
+/* drop all cached routes that pass through node idx */
+static void _invalidate(uint16_t idx)
+{
+    for (unsigned i = 0; i < GNRC_RPL_SRH_TREE_CACHE_SIZE; i++) {
+        _route_t *route = &_cache[i];
+
+        if (route->dst == NODE_NONE) {
+            continue;
+        }
+        for (unsigned j = 0; j < route->hops; j++) {
+            if (route->path[j] == idx) {
+                _nodes[route->dst].cache = CACHE_NONE;
+                route->dst = NODE_NONE;
+                break;
+            }
+        }
+    }
+}
+
+static _route_t *_route(uint16_t dst)
+{
+    uint16_t path[GNRC_RPL_SRH_TREE_MAX_HOPS];
+    uint16_t cur = dst;
+    uint8_t hops = 0;
+    _route_t *route;
+
+    if (_nodes[dst].cache != CACHE_NONE) {
+        return &_cache[_nodes[dst].cache];
+    }
+
+    while (cur != NODE_ROOT) {
+        /* unknown parent, or the path is too long (or a loop) */
+        if ((cur == NODE_NONE) || (hops == GNRC_RPL_SRH_TREE_MAX_HOPS)) {
+            return NULL;
+        }
+        path[hops++] = cur;
+        cur = _nodes[cur].parent;
+    }
+
+    route = &_cache[_cache_next];
+    if (route->dst != NODE_NONE) {
+        _nodes[route->dst].cache = CACHE_NONE;
+    }
+    for (unsigned i = 0; i < hops; i++) {
+        route->path[i] = path[hops - 1 - i];
+    }
+    route->hops = hops;
+    route->dst = dst;
+    _nodes[dst].cache = _cache_next;
+    _cache_next = (_cache_next + 1) % GNRC_RPL_SRH_TREE_CACHE_SIZE;
+
+    return route;
+}
+
+void gnrc_rpl_srh_tree_init(const ipv6_addr_t *root)
+{
+    mutex_lock(&_mutex);
+    _root = *root;
+    memset(_nodes, 0, sizeof(_nodes));
+    for (unsigned i = 0; i < GNRC_RPL_SRH_TREE_SIZE; i++) {
+        _nodes[i].next = i + 1;
+        _buckets[i] = NODE_NONE;
+    }
+    _nodes[GNRC_RPL_SRH_TREE_SIZE - 1].next = NODE_NONE;
+    _free = 0;
+    for (unsigned i = 0; i < GNRC_RPL_SRH_TREE_CACHE_SIZE; i++) {
+        _cache[i].dst = NODE_NONE;
+    }
+    _cache_next = 0;
+    _initialized = true;
+    mutex_unlock(&_mutex);
+}
+
+int gnrc_rpl_srh_tree_update(const ipv6_addr_t *target, const ipv6_addr_t *parent)
+{
+    uint16_t t, p = NODE_ROOT;
+
+    assert(_initialized);
+
+    if (ipv6_addr_equal(target, &_root) || ipv6_addr_equal(target, parent)) {
+        return -EINVAL;
+    }
+
+    mutex_lock(&_mutex);
+    if ((t = _find_or_add(target)) == NODE_NONE) {
+        mutex_unlock(&_mutex);
+        DEBUG("RPL SRH: tree full, dropping %s\n",
+              ipv6_addr_to_str(addr_str, target, sizeof(addr_str)));
+        return -ENOMEM;
+    }
+    if (!ipv6_addr_equal(parent, &_root) && ((p = _find_or_add(parent)) == NODE_NONE)) {
+        /* keep the target, but it is unreachable until its parent is known */
+        p = NODE_NONE;
+    }
+    if (_nodes[t].parent != p) {
+        _nodes[t].parent = p;
+        _invalidate(t);
+    }
+    mutex_unlock(&_mutex);
+
+    return (p == NODE_NONE) ? -ENOMEM : 0;
+}
+
+int gnrc_rpl_srh_tree_remove(const ipv6_addr_t *target)
+{
+    uint16_t t, *prev;
+
+    assert(_initialized);
+
+    mutex_lock(&_mutex);
+    if ((t = _find(target)) == NODE_NONE) {
+        mutex_unlock(&_mutex);
+        return -ENOENT;
+    }
+    _invalidate(t);
+    for (unsigned i = 0; i < GNRC_RPL_SRH_TREE_SIZE; i++) {
+        if (_nodes[i].used && (_nodes[i].parent == t)) {
+            _nodes[i].parent = NODE_NONE;
+        }
+    }
+    for (prev = &_buckets[_hash(target)]; *prev != t; prev = &_nodes[*prev].next) {}
+    *prev = _nodes[t].next;
+    _nodes[t].used = 0;
+    _nodes[t].next = _free;
+    _free = t;
+    mutex_unlock(&_mutex);
+
+    return 0;
+}
+
+int gnrc_rpl_srh_tree_build(const ipv6_addr_t *dst, ipv6_addr_t *next_hop,
+                            gnrc_rpl_srh_t *srh, size_t srh_len)
+{
+    _route_t *route;
+    uint8_t *vec;
+    unsigned n, cmpr = 15, addr_len, vec_len, pad;
+    uint16_t d;
+
+    if (!_initialized) {
+        return -ENOENT;
+    }
+
+    mutex_lock(&_mutex);
+    if ((d = _find(dst)) == NODE_NONE) {
+        mutex_unlock(&_mutex);
+        return -ENOENT;
+    }
+    if ((route = _route(d)) == NULL) {
+        mutex_unlock(&_mutex);
+        return -EHOSTUNREACH;
+    }
+
+    *next_hop = _nodes[route->path[0]].addr;
+    n = route->hops - 1;
+    if (n == 0) {
+        mutex_unlock(&_mutex);
+        return 0;
+    }
+
+    /* all hops are reconstructed from the previous one, so elide the prefix
+     * they all share */
+    for (unsigned i = 1; i <= n; i++) {
+        unsigned match = ipv6_addr_match_prefix(next_hop,
+                                                &_nodes[route->path[i]].addr) / 8;
+        if (match < cmpr) {
+            cmpr = match;
+        }
+    }
+    addr_len = sizeof(ipv6_addr_t) - cmpr;
+    vec_len = n * addr_len;
+    pad = (8 - (vec_len & 0x7)) & 0x7;
+
+    if (srh == NULL) {
+        mutex_unlock(&_mutex);
+        return sizeof(gnrc_rpl_srh_t) + vec_len + pad;
+    }
+    if (srh_len < (sizeof(gnrc_rpl_srh_t) + vec_len + pad)) {
+        mutex_unlock(&_mutex);
+        return -ENOBUFS;
+    }
+
+    srh->len = (vec_len + pad) / 8;
+    srh->type = GNRC_RPL_SRH_TYPE;
+    srh->seg_left = n;
+    srh->compr = (cmpr << 4) | cmpr;
+    srh->pad_resv = pad << 4;
+    srh->resv = 0;
+    vec = (uint8_t *)(srh + 1);
+    for (unsigned i = 1; i <= n; i++) {
+        memcpy(vec, &_nodes[route->path[i]].addr.u8[cmpr], addr_len);
+        vec += addr_len;
+    }
+    memset(vec, 0, pad);
+    mutex_unlock(&_mutex);
+
+    return sizeof(gnrc_rpl_srh_t) + vec_len + pad;
+}
+
+/** @} */
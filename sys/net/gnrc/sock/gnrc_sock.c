@@ -44,10 +44,34 @@ static void _callback_put(void *arg)
 }
 #endif
 
+#ifdef MODULE_SOCK_ASYNC
+static void _netapi_cb(uint16_t cmd, gnrc_pktsnip_t *pkt, void *ctx)
+{
+    gnrc_sock_reg_t *reg = ctx;
+    msg_t msg = { .type = cmd, .content = { .ptr = pkt } };
+
+    if ((cmd != GNRC_NETAPI_MSG_TYPE_RCV) || !mbox_try_put(&reg->mbox, &msg)) {
+        /* only received packets are queued and the mbox might be full */
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+    if (reg->async_cb.generic != NULL) {
+        reg->async_cb.generic(reg, SOCK_ASYNC_MSG_RECV, reg->async_cb_arg);
+    }
+}
+#endif
+
 void gnrc_sock_create(gnrc_sock_reg_t *reg, gnrc_nettype_t type, uint32_t demux_ctx)
 {
     mbox_init(&reg->mbox, reg->mbox_queue, SOCK_MBOX_SIZE);
+#ifdef MODULE_SOCK_ASYNC
+    /* the async callback is kept, as it might be set before an implicit bind */
+    reg->netreg_cb.cb = _netapi_cb;
+    reg->netreg_cb.ctx = reg;
+    gnrc_netreg_entry_init_cb(&reg->entry, demux_ctx, &reg->netreg_cb);
+#else
     gnrc_netreg_entry_init_mbox(&reg->entry, demux_ctx, &reg->mbox);
+#endif
     gnrc_netreg_register(type, &reg->entry);
 }
 
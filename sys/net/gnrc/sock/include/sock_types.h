@@ -31,27 +31,89 @@
 #include "net/gnrc/netreg.h"
 #include "net/sock/ip.h"
 #include "net/sock/udp.h"
+#ifdef MODULE_GNRC_SOCK_TCP
+#include "mutex.h"
+#include "net/gnrc/tcp.h"
+#include "net/sock/tcp.h"
+#endif
+#ifdef MODULE_SOCK_ASYNC
+#include "net/sock/async.h"
+#endif
+#ifdef MODULE_SOCK_ASYNC_EVENT
+#include "net/sock/async_event.h"
+#endif
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/**
+ * @brief   GNRC provides an own sock_udp_send_batch(), which prepares the end
+ *          points only once for all messages
+ */
+#define SOCK_HAS_UDP_SEND_BATCH
+
 #ifndef SOCK_MBOX_SIZE
 #define SOCK_MBOX_SIZE      (8)         /**< Size for gnrc_sock_reg_t::mbox_queue */
 #endif
 
+#ifndef SOCK_TCP_QUEUE_MBOX_SIZE
+/**
+ * @brief   Size for sock_tcp_queue::mbox_queue
+ *
+ * Also the maximum length of a TCP listening queue, sock_tcp_listen() returns
+ * -ENOMEM for longer queues. Must be a power of 2.
+ */
+#define SOCK_TCP_QUEUE_MBOX_SIZE    (4)
+#endif
+
+/**
+ * @brief   Forward declaration
+ * @internal
+ */
+typedef struct gnrc_sock_reg gnrc_sock_reg_t;
+
+#if defined(MODULE_SOCK_ASYNC) || defined(DOXYGEN)
+/**
+ * @brief   Event callback for @ref gnrc_sock_reg_t
+ * @internal
+ */
+typedef void (*gnrc_sock_reg_cb_t)(gnrc_sock_reg_t *sock,
+                                   sock_async_flags_t flags,
+                                   void *arg);
+#endif
+
 /**
  * @brief   sock @ref net_gnrc_netreg info
  * @internal
  */
-typedef struct gnrc_sock_reg {
+struct gnrc_sock_reg {
 #ifdef MODULE_GNRC_SOCK_CHECK_REUSE
     struct gnrc_sock_reg *next;         /**< list-like for internal storage */
 #endif
     gnrc_netreg_entry_t entry;          /**< @ref net_gnrc_netreg entry for mbox */
     mbox_t mbox;                        /**< @ref core_mbox target for the sock */
     msg_t mbox_queue[SOCK_MBOX_SIZE];   /**< queue for gnrc_sock_reg_t::mbox */
-} gnrc_sock_reg_t;
+#if defined(MODULE_SOCK_ASYNC) || defined(DOXYGEN)
+    /**
+     * @brief   netreg callback, that queues received packets in
+     *          gnrc_sock_reg_t::mbox and calls gnrc_sock_reg_t::async_cb
+     */
+    gnrc_netreg_entry_cbd_t netreg_cb;
+    /**
+     * @brief   asynchronous event callback of the sock
+     */
+    union {
+        gnrc_sock_reg_cb_t generic;     /**< generic version */
+        sock_ip_cb_t ip;                /**< raw IP version */
+        sock_udp_cb_t udp;              /**< UDP version */
+    } async_cb;
+    void *async_cb_arg;                 /**< argument for async_cb */
+#endif
+#if defined(MODULE_SOCK_ASYNC_EVENT) || defined(DOXYGEN)
+    sock_async_ctx_t async_ctx;         /**< asynchronous event context */
+#endif
+};
 
 /**
  * @brief   Raw IP sock type
@@ -75,6 +137,34 @@ struct sock_udp {
     uint16_t flags;                     /**< option flags */
 };
 
+#if defined(MODULE_GNRC_SOCK_TCP) || defined(DOXYGEN)
+/**
+ * @brief   TCP sock type
+ * @internal
+ */
+struct sock_tcp {
+    gnrc_tcp_tcb_t tcb;                 /**< transmission control block */
+    sock_tcp_queue_t *queue;            /**< listening queue the sock belongs
+                                         *   to, NULL for active connections */
+    bool accepted;                      /**< the sock was returned by
+                                         *   sock_tcp_accept() */
+};
+
+/**
+ * @brief   TCP listening queue type
+ * @internal
+ */
+struct sock_tcp_queue {
+    mutex_t mutex;                      /**< lock for the queue */
+    sock_tcp_t *array;                  /**< socks listening for connections */
+    unsigned len;                       /**< length of sock_tcp_queue::array */
+    sock_tcp_ep_t local;                /**< local end-point */
+    mbox_t mbox;                        /**< established connections */
+    msg_t mbox_queue[SOCK_TCP_QUEUE_MBOX_SIZE]; /**< queue for sock_tcp_queue::mbox */
+    uint16_t flags;                     /**< option flags */
+};
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -36,6 +36,10 @@ int sock_ip_create(sock_ip_t *sock, const sock_ip_ep_t *local,
         (local->netif != remote->netif)) {
         return -EINVAL;
     }
+#ifdef MODULE_SOCK_ASYNC
+    sock->reg.async_cb.generic = NULL;
+    sock->reg.async_cb_arg = NULL;
+#endif
     memset(&sock->local, 0, sizeof(sock_ip_ep_t));
     if (local != NULL) {
         if (gnrc_af_not_supported(local->family)) {
@@ -192,7 +196,30 @@ ssize_t sock_ip_send(sock_ip_t *sock, const void *data, size_t len,
     if (res <= 0) {
         return res;
     }
+#ifdef MODULE_SOCK_ASYNC
+    if ((sock != NULL) && (sock->reg.async_cb.ip != NULL)) {
+        sock->reg.async_cb.ip(sock, SOCK_ASYNC_MSG_SENT,
+                              sock->reg.async_cb_arg);
+    }
+#endif
     return res;
 }
 
+#ifdef MODULE_SOCK_ASYNC
+void sock_ip_set_cb(sock_ip_t *sock, sock_ip_cb_t cb, void *arg)
+{
+    assert(sock != NULL);
+    /* set the argument first, the callback might be called any time */
+    sock->reg.async_cb_arg = arg;
+    sock->reg.async_cb.ip = cb;
+}
+#endif
+
+#ifdef MODULE_SOCK_ASYNC_EVENT
+sock_async_ctx_t *sock_ip_get_async_ctx(sock_ip_t *sock)
+{
+    return &sock->reg.async_ctx;
+}
+#endif
+
 /** @} */
@@ -0,0 +1,271 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ * @brief       GNRC implementation of @ref net_sock_tcp
+ *
+ * Every sock of a listening queue holds a passively opened TCB. Several TCBs
+ * can listen on the same port, each of them takes one incoming connection and
+ * reports it to the mbox of the queue, from which sock_tcp_accept() takes it.
+ */
+
+#include <errno.h>
+
+#include "net/af.h"
+#include "net/gnrc/sock/tcp.h"
+#include "net/gnrc/tcp.h"
+#include "net/sock/tcp.h"
+#include "xtimer.h"
+
+#include "sock_types.h"
+
+#define _TIMEOUT_MAGIC      (0xF38A0B64U)
+#define _TIMEOUT_MSG_TYPE   (0x8475)
+
+static void _callback_put(void *arg)
+{
+    msg_t timeout_msg = { .sender_pid = KERNEL_PID_UNDEF,
+                          .type = _TIMEOUT_MSG_TYPE,
+                          .content = { .value = _TIMEOUT_MAGIC } };
+    sock_tcp_queue_t *queue = arg;
+
+    mbox_try_put(&queue->mbox, &timeout_msg);
+}
+
+static int _listen(sock_tcp_queue_t *queue, sock_tcp_t *sock)
+{
+    const uint8_t *addr = NULL;
+
+    gnrc_tcp_tcb_init(&sock->tcb);
+    sock->queue = queue;
+    sock->accepted = false;
+    if (!ipv6_addr_is_unspecified((ipv6_addr_t *)&queue->local.addr.ipv6)) {
+        addr = queue->local.addr.ipv6;
+    }
+    return gnrc_tcp_listen(&sock->tcb, queue->local.family, addr,
+                           queue->local.port, &queue->mbox);
+}
+
+int sock_tcp_connect(sock_tcp_t *sock, const sock_tcp_ep_t *remote,
+                     uint16_t local_port, uint16_t flags)
+{
+    assert(sock != NULL);
+    assert((remote != NULL) && (remote->port != 0));
+
+    /* the port reuse check is done by gnrc_tcp itself */
+    (void)flags;
+    gnrc_tcp_tcb_init(&sock->tcb);
+    sock->queue = NULL;
+    sock->accepted = false;
+    if (ipv6_addr_is_unspecified((ipv6_addr_t *)&remote->addr.ipv6)) {
+        return -EINVAL;
+    }
+    return gnrc_tcp_open_active(&sock->tcb, remote->family,
+                                remote->addr.ipv6, remote->port, local_port);
+}
+
+int sock_tcp_listen(sock_tcp_queue_t *queue, const sock_tcp_ep_t *local,
+                    sock_tcp_t *queue_array, unsigned queue_len,
+                    uint16_t flags)
+{
+    int res = 0;
+
+    assert(queue != NULL);
+    assert((local != NULL) && (local->port != 0));
+    assert((queue_array != NULL) && (queue_len != 0));
+
+    if (local->family != AF_INET6) {
+        return -EAFNOSUPPORT;
+    }
+    /* every listening sock needs a slot in the mbox to report its
+     * connection */
+    if (queue_len > SOCK_TCP_QUEUE_MBOX_SIZE) {
+        return -ENOMEM;
+    }
+    mutex_init(&queue->mutex);
+    mbox_init(&queue->mbox, queue->mbox_queue, SOCK_TCP_QUEUE_MBOX_SIZE);
+    memcpy(&queue->local, local, sizeof(sock_tcp_ep_t));
+    queue->array = queue_array;
+    queue->len = queue_len;
+    queue->flags = flags;
+
+    mutex_lock(&queue->mutex);
+    for (unsigned i = 0; (i < queue_len) && (res == 0); i++) {
+        res = _listen(queue, &queue_array[i]);
+    }
+    mutex_unlock(&queue->mutex);
+    if (res < 0) {
+        sock_tcp_stop_listen(queue);
+    }
+    return res;
+}
+
+void sock_tcp_disconnect(sock_tcp_t *sock)
+{
+    sock_tcp_queue_t *queue;
+
+    assert(sock != NULL);
+
+    gnrc_tcp_close(&sock->tcb);
+    queue = sock->queue;
+    if (queue != NULL) {
+        mutex_lock(&queue->mutex);
+        /* make the sock of a listening queue ready for the next connection,
+         * unless the queue stopped listening in the meantime */
+        if (sock->queue != NULL) {
+            _listen(queue, sock);
+        }
+        mutex_unlock(&queue->mutex);
+    }
+}
+
+void sock_tcp_stop_listen(sock_tcp_queue_t *queue)
+{
+    msg_t msg;
+
+    assert(queue != NULL);
+
+    mutex_lock(&queue->mutex);
+    for (unsigned i = 0; i < queue->len; i++) {
+        sock_tcp_t *sock = &queue->array[i];
+
+        /* accepted socks stay connected until they are disconnected */
+        if (!sock->accepted) {
+            gnrc_tcp_abort(&sock->tcb);
+        }
+        sock->queue = NULL;
+    }
+    while (mbox_try_get(&queue->mbox, &msg)) {}
+    queue->array = NULL;
+    queue->len = 0;
+    mutex_unlock(&queue->mutex);
+}
+
+int sock_tcp_get_local(sock_tcp_t *sock, sock_tcp_ep_t *ep)
+{
+    assert((sock != NULL) && (ep != NULL));
+
+    if (sock->tcb.local_port == 0) {
+        return -EADDRNOTAVAIL;
+    }
+    memset(ep, 0, sizeof(sock_tcp_ep_t));
+    ep->family = sock->tcb.address_family;
+    memcpy(&ep->addr.ipv6, sock->tcb.local_addr, sizeof(ep->addr.ipv6));
+    ep->port = sock->tcb.local_port;
+    return 0;
+}
+
+int sock_tcp_get_remote(sock_tcp_t *sock, sock_tcp_ep_t *ep)
+{
+    assert((sock != NULL) && (ep != NULL));
+
+    if (sock->tcb.peer_port == 0) {
+        return -ENOTCONN;
+    }
+    memset(ep, 0, sizeof(sock_tcp_ep_t));
+    ep->family = sock->tcb.address_family;
+    memcpy(&ep->addr.ipv6, sock->tcb.peer_addr, sizeof(ep->addr.ipv6));
+    ep->port = sock->tcb.peer_port;
+    return 0;
+}
+
+int sock_tcp_queue_get_local(sock_tcp_queue_t *queue, sock_tcp_ep_t *ep)
+{
+    assert((queue != NULL) && (ep != NULL));
+
+    if (queue->array == NULL) {
+        return -EADDRNOTAVAIL;
+    }
+    memcpy(ep, &queue->local, sizeof(sock_tcp_ep_t));
+    return 0;
+}
+
+int sock_tcp_accept(sock_tcp_queue_t *queue, sock_tcp_t **sock,
+                    uint32_t timeout)
+{
+    xtimer_t timeout_timer = { .callback = _callback_put, .arg = queue };
+    msg_t msg;
+
+    assert((queue != NULL) && (sock != NULL));
+
+    if (queue->array == NULL) {
+        return -EINVAL;
+    }
+    if ((timeout != SOCK_NO_TIMEOUT) && (timeout != 0)) {
+        xtimer_set(&timeout_timer, timeout);
+    }
+    if (timeout != 0) {
+        mbox_get(&queue->mbox, &msg);
+    }
+    else if (!mbox_try_get(&queue->mbox, &msg)) {
+        return -EAGAIN;
+    }
+    xtimer_remove(&timeout_timer);
+    switch (msg.type) {
+        case GNRC_TCP_MSG_TYPE_ESTABLISHED:
+            /* the TCB is the first member of the sock */
+            mutex_lock(&queue->mutex);
+            *sock = msg.content.ptr;
+            (*sock)->accepted = true;
+            mutex_unlock(&queue->mutex);
+            return 0;
+        case _TIMEOUT_MSG_TYPE:
+            if (msg.content.value == _TIMEOUT_MAGIC) {
+                return -ETIMEDOUT;
+            }
+            /* Falls Through. */
+        default:
+            return -EINVAL;
+    }
+}
+
+ssize_t sock_tcp_read(sock_tcp_t *sock, void *data, size_t max_len,
+                      uint32_t timeout)
+{
+    ssize_t res;
+
+    assert((sock != NULL) && (data != NULL) && (max_len > 0));
+
+    do {
+        res = gnrc_tcp_recv(&sock->tcb, data, max_len, timeout);
+        /* gnrc_tcp_recv() always times out, so just wait again */
+    } while ((res == -ETIMEDOUT) && (timeout == SOCK_NO_TIMEOUT));
+    return res;
+}
+
+ssize_t sock_tcp_write(sock_tcp_t *sock, const void *data, size_t len)
+{
+    size_t written = 0;
+
+    assert(sock != NULL);
+    assert((len == 0) || (data != NULL));
+
+    /* gnrc_tcp_send() returns after one segment was acknowledged */
+    while (written < len) {
+        ssize_t res = gnrc_tcp_send(&sock->tcb, (const uint8_t *)data + written,
+                                    len - written, 0);
+
+        if (res < 0) {
+            return (written > 0) ? (ssize_t)written : res;
+        }
+        written += res;
+    }
+    return written;
+}
+
+ssize_t gnrc_sock_tcp_write_pkt(sock_tcp_t *sock, gnrc_pktsnip_t *payload)
+{
+    assert((sock != NULL) && (payload != NULL));
+
+    return gnrc_tcp_send_pkt(&sock->tcb, payload, 0);
+}
+
+/** @} */
@@ -36,30 +36,16 @@ static uint16_t _dyn_port_next = 0;
 /**
  * @brief   Checks if a given UDP port is already used by another sock
  */
-static bool _dyn_port_used(uint16_t port)
+static inline bool _dyn_port_used(uint16_t port)
 {
 #ifdef MODULE_GNRC_SOCK_CHECK_REUSE
-    for (sock_udp_t *ptr = _udp_socks; ptr != NULL;
-         ptr = (sock_udp_t *)ptr->reg.next) {
-        bool spec_addr = false;
-        for (unsigned i = 0; i < sizeof(ptr->local.addr); i++) {
-            const uint8_t *const p = (uint8_t *)&ptr->local.addr;
-            if (p[i] != 0) {
-                spec_addr = true;
-            }
-        }
-        if (spec_addr) {
-            continue;
-        }
-        if (ptr->local.port == port) {
-            /* port already in use by another sock */
-            return true;
-        }
-    }
+    /* the UDP registry is hashed by port, so this does not depend on the
+     * number of socks */
+    return (gnrc_netreg_lookup(GNRC_NETTYPE_UDP, port) != NULL);
 #else
     (void) port;
-#endif /* MODULE_GNRC_SOCK_CHECK_REUSE */
     return false;
+#endif /* MODULE_GNRC_SOCK_CHECK_REUSE */
 }
 
 /**
@@ -95,6 +81,10 @@ int sock_udp_create(sock_udp_t *sock, const sock_udp_ep_t *local,
         (local->netif != remote->netif)) {
         return -EINVAL;
     }
+#ifdef MODULE_SOCK_ASYNC
+    sock->reg.async_cb.generic = NULL;
+    sock->reg.async_cb_arg = NULL;
+#endif
     memset(&sock->local, 0, sizeof(sock_udp_ep_t));
     if (local != NULL) {
 #ifdef MODULE_GNRC_SOCK_CHECK_REUSE
@@ -209,17 +199,15 @@ ssize_t sock_udp_recv(sock_udp_t *sock, void *data, size_t max_len,
     return (int)pkt->size;
 }
 
-ssize_t sock_udp_send(sock_udp_t *sock, const void *data, size_t len,
-                      const sock_udp_ep_t *remote)
+/**
+ * @brief   Resolves the end points for sending with @p sock and binds it
+ *          implicitly if required
+ */
+static int _send_prepare(sock_udp_t *sock, const sock_udp_ep_t *remote,
+                         sock_ip_ep_t *local, sock_ip_ep_t **rem,
+                         uint16_t *src_port, uint16_t *dst_port)
 {
-    int res;
-    gnrc_pktsnip_t *payload, *pkt;
-    uint16_t src_port = 0, dst_port;
-    sock_ip_ep_t local;
-    sock_ip_ep_t *rem;
-
     assert((sock != NULL) || (remote != NULL));
-    assert((len == 0) || (data != NULL)); /* (len != 0) => (data != NULL) */
 
     if (remote != NULL) {
         if (remote->port == 0) {
@@ -246,20 +234,20 @@ ssize_t sock_udp_send(sock_udp_t *sock, const void *data, size_t len,
      * cppcheck is being weird here anyways) */
     if ((sock == NULL) || (sock->local.family == AF_UNSPEC)) {
         /* no sock or sock currently unbound */
-        memset(&local, 0, sizeof(local));
-        if ((src_port = _get_dyn_port(sock)) == GNRC_SOCK_DYN_PORTRANGE_ERR) {
+        memset(local, 0, sizeof(*local));
+        if ((*src_port = _get_dyn_port(sock)) == GNRC_SOCK_DYN_PORTRANGE_ERR) {
             return -EINVAL;
         }
         if (sock != NULL) {
             /* bind sock object implicitly */
-            sock->local.port = src_port;
+            sock->local.port = *src_port;
             if (remote == NULL) {
                 sock->local.family = sock->remote.family;
             }
             else {
                 sock->local.family = remote->family;
             }
-            gnrc_sock_create(&sock->reg, GNRC_NETTYPE_UDP, src_port);
+            gnrc_sock_create(&sock->reg, GNRC_NETTYPE_UDP, *src_port);
 #ifdef MODULE_GNRC_SOCK_CHECK_REUSE
             /* prepend to current socks */
             sock->reg.next = (gnrc_sock_reg_t *)_udp_socks;
@@ -268,25 +256,35 @@ ssize_t sock_udp_send(sock_udp_t *sock, const void *data, size_t len,
         }
     }
     else {
-        src_port = sock->local.port;
-        memcpy(&local, &sock->local, sizeof(local));
+        *src_port = sock->local.port;
+        memcpy(local, &sock->local, sizeof(*local));
     }
     /* sock can't be NULL at this point */
     if (remote == NULL) {
-        rem = (sock_ip_ep_t *)&sock->remote;
-        dst_port = sock->remote.port;
+        *rem = (sock_ip_ep_t *)&sock->remote;
+        *dst_port = sock->remote.port;
     }
     else {
-        rem = (sock_ip_ep_t *)remote;
-        dst_port = remote->port;
+        *rem = (sock_ip_ep_t *)remote;
+        *dst_port = remote->port;
     }
     /* check for matching address families in local and remote */
-    if (local.family == AF_UNSPEC) {
-        local.family = rem->family;
+    if (local->family == AF_UNSPEC) {
+        local->family = (*rem)->family;
     }
-    else if (local.family != rem->family) {
+    else if (local->family != (*rem)->family) {
         return -EINVAL;
     }
+    return 0;
+}
+
+static ssize_t _send(const void *data, size_t len, sock_ip_ep_t *local,
+                     const sock_ip_ep_t *rem, uint16_t src_port,
+                     uint16_t dst_port)
+{
+    gnrc_pktsnip_t *payload, *pkt;
+    ssize_t res;
+
     /* generate payload and header snips */
     payload = gnrc_pktbuf_add(NULL, (void *)data, len, GNRC_NETTYPE_UNDEF);
     if (payload == NULL) {
@@ -297,11 +295,114 @@ ssize_t sock_udp_send(sock_udp_t *sock, const void *data, size_t len,
         gnrc_pktbuf_release(payload);
         return -ENOMEM;
     }
-    res = gnrc_sock_send(pkt, &local, rem, PROTNUM_UDP);
+    res = gnrc_sock_send(pkt, local, rem, PROTNUM_UDP);
     if (res > 0) {
         res -= sizeof(udp_hdr_t);
     }
     return res;
 }
 
+static inline void _sent(sock_udp_t *sock)
+{
+#ifdef MODULE_SOCK_ASYNC
+    if ((sock != NULL) && (sock->reg.async_cb.udp != NULL)) {
+        sock->reg.async_cb.udp(sock, SOCK_ASYNC_MSG_SENT,
+                               sock->reg.async_cb_arg);
+    }
+#else
+    (void)sock;
+#endif
+}
+
+ssize_t sock_udp_send(sock_udp_t *sock, const void *data, size_t len,
+                      const sock_udp_ep_t *remote)
+{
+    ssize_t res;
+    uint16_t src_port = 0, dst_port;
+    sock_ip_ep_t local;
+    sock_ip_ep_t *rem;
+
+    assert((len == 0) || (data != NULL)); /* (len != 0) => (data != NULL) */
+
+    res = _send_prepare(sock, remote, &local, &rem, &src_port, &dst_port);
+    if (res < 0) {
+        return res;
+    }
+    res = _send(data, len, &local, rem, src_port, dst_port);
+    if (res >= 0) {
+        _sent(sock);
+    }
+    return res;
+}
+
+ssize_t sock_udp_send_batch(sock_udp_t *sock, const sock_udp_msg_t *msgs,
+                            size_t numof, const sock_udp_ep_t *remote)
+{
+    size_t i;
+    uint16_t src_port = 0, dst_port;
+    sock_ip_ep_t local;
+    sock_ip_ep_t *rem;
+    int res;
+
+    assert((msgs != NULL) && (numof > 0));
+
+    res = _send_prepare(sock, remote, &local, &rem, &src_port, &dst_port);
+    if (res < 0) {
+        return res;
+    }
+#if defined(MODULE_GNRC_IPV6_NETIF) && defined(SOCK_HAS_IPV6)
+    /* select the source address once for all messages if the interface is
+     * known, so the IPv6 thread does not have to do it for every packet */
+    if ((local.family == AF_INET6) &&
+        ipv6_addr_is_unspecified((ipv6_addr_t *)&local.addr.ipv6)) {
+        kernel_pid_t iface = (local.netif != SOCK_ADDR_ANY_NETIF) ?
+                             (kernel_pid_t)local.netif :
+                             (kernel_pid_t)rem->netif;
+
+        if (iface != SOCK_ADDR_ANY_NETIF) {
+            ipv6_addr_t *src = gnrc_ipv6_netif_find_best_src_addr(
+                    iface, (ipv6_addr_t *)&rem->addr.ipv6, false
+                );
+
+            if (src != NULL) {
+                memcpy(&local.addr.ipv6, src, sizeof(ipv6_addr_t));
+            }
+        }
+    }
+#endif
+    for (i = 0; i < numof; i++) {
+        ssize_t sent;
+
+        assert((msgs[i].len == 0) || (msgs[i].data != NULL));
+        sent = _send(msgs[i].data, msgs[i].len, &local, rem, src_port,
+                     dst_port);
+        if (sent < 0) {
+            if (i == 0) {
+                return sent;
+            }
+            break;
+        }
+    }
+    /* notify only once for the whole batch */
+    _sent(sock);
+    return i;
+}
+
+#ifdef MODULE_SOCK_ASYNC
+void sock_udp_set_cb(sock_udp_t *sock, sock_udp_cb_t cb, void *arg)
+{
+    assert(sock != NULL);
+    /* set the argument first, the callback might be called any time */
+    sock->reg.async_cb_arg = arg;
+    sock->reg.async_cb.udp = cb;
+}
+#endif
+
+#ifdef MODULE_SOCK_ASYNC_EVENT
+sock_async_ctx_t *sock_udp_get_async_ctx(sock_udp_t *sock)
+{
+    return &sock->reg.async_ctx;
+}
+#endif
+
 /** @} */
@@ -59,42 +59,6 @@ gnrc_tcp_tcb_t *_list_tcb_head;
  */
 mutex_t _list_tcb_lock;
 
-/**
- * @brief Helper struct, holding all argument data for_cb_mbox_put_msg.
- */
-typedef struct _cb_arg {
-    uint32_t msg_type;   /**< Message Type to Put into mbox behind mbox_ptr */
-    mbox_t *mbox_ptr;    /**< Pointer to mbox */
-} cb_arg_t;
-
-/**
- * @brief Callback for xtimer, puts a message in a mbox.
- *
- * @param[in] arg   Ptr to cb_arg_t. Must not be NULL or anything else.
- */
-static void _cb_mbox_put_msg(void *arg)
-{
-    msg_t msg;
-    msg.type = ((cb_arg_t *) arg)->msg_type;
-    mbox_try_put(((cb_arg_t *) arg)->mbox_ptr, &msg);
-}
-
-/**
- * @brief Setup timer with a callback function.
- *
- * @param[in/out] timer   Ptr to timer, which should be set.
- * @param[in] duration    Duration after @p timer expires.
- * @param[in] cb          Function to be called after @p duration.
- * @param[in] arg         Arguments for @p cb.
- */
-static void _setup_timeout(xtimer_t *timer, const uint32_t duration, const xtimer_callback_t cb,
-                           cb_arg_t *arg)
-{
-    timer->callback = cb;
-    timer->arg = arg;
-    xtimer_set(timer, duration);
-}
-
 /**
  * @brief   Establishes a new TCP connection
  *
@@ -116,8 +80,7 @@ static int _gnrc_tcp_open(gnrc_tcp_tcb_t *tcb, const uint8_t *target_addr, uint1
                           const uint8_t *local_addr, uint16_t local_port, uint8_t passive)
 {
     msg_t msg;
-    xtimer_t connection_timeout;
-    cb_arg_t connection_timeout_arg = {MSG_TYPE_CONNECTION_TIMEOUT, &(tcb->mbox)};
+    gnrc_tcp_timer_t connection_timeout;
     int8_t ret = 0;
 
     /* Lock the TCB for this function call */
@@ -136,6 +99,9 @@ static int _gnrc_tcp_open(gnrc_tcp_tcb_t *tcb, const uint8_t *target_addr, uint1
     while (mbox_try_get(&(tcb->mbox), &msg) != 0) {
     }
 
+    /* Timers put their timeout messages into the TCBs mbox */
+    _timer_init(&connection_timeout, tcb, &(tcb->mbox));
+
     /* Setup passive connection */
     if (passive) {
         /* Mark connection as passive opend */
@@ -165,8 +131,8 @@ static int _gnrc_tcp_open(gnrc_tcp_tcb_t *tcb, const uint8_t *target_addr, uint1
         tcb->peer_port = target_port;
 
         /* Setup connection timeout: Put timeout message in TCBs mbox on expiration */
-        _setup_timeout(&connection_timeout, GNRC_TCP_CONNECTION_TIMEOUT_DURATION,
-                       _cb_mbox_put_msg, &connection_timeout_arg);
+        _timer_set(&connection_timeout, GNRC_TCP_CONNECTION_TIMEOUT_DURATION,
+                   MSG_TYPE_CONNECTION_TIMEOUT);
     }
 
     /* Call FSM with event: CALL_OPEN */
@@ -199,7 +165,7 @@ static int _gnrc_tcp_open(gnrc_tcp_tcb_t *tcb, const uint8_t *target_addr, uint1
     }
 
     /* Cleanup */
-    xtimer_remove(&connection_timeout);
+    _timer_del(&connection_timeout);
     if (tcb->state == FSM_STATE_CLOSED && ret == 0) {
         ret = -ECONNREFUSED;
     }
@@ -222,6 +188,7 @@ int gnrc_tcp_init(void)
     /* Initialize TCB list */
     _list_tcb_head = NULL;
     _rcvbuf_init();
+    _eventloop_init();
 
     /* Start TCP processing thread */
     return thread_create(_stack, sizeof(_stack), TCP_EVENTLOOP_PRIO,
@@ -241,6 +208,7 @@ void gnrc_tcp_tcb_init(gnrc_tcp_tcb_t *tcb)
     tcb->srtt = RTO_UNINITIALIZED;
     tcb->rto = RTO_UNINITIALIZED;
     mbox_init(&(tcb->mbox), tcb->mbox_raw, GNRC_TCP_TCB_MBOX_SIZE);
+    _timer_init(&(tcb->tim_tout), tcb, NULL);
     mutex_init(&(tcb->fsm_lock));
     mutex_init(&(tcb->function_lock));
 }
@@ -294,19 +262,77 @@ int gnrc_tcp_open_passive(gnrc_tcp_tcb_t *tcb,  const uint8_t address_family,
     return _gnrc_tcp_open(tcb, NULL, 0, local_addr, local_port, 1);
 }
 
-ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
-                      const uint32_t timeout_duration_us)
+int gnrc_tcp_listen(gnrc_tcp_tcb_t *tcb, const uint8_t address_family,
+                    const uint8_t *local_addr, const uint16_t local_port,
+                    mbox_t *mbox)
 {
     assert(tcb != NULL);
-    assert(data != NULL);
+    assert(local_port != PORT_UNSPEC);
+
+    int ret = 0;
+
+    /* Check AF-Family support if local address was supplied */
+    if (local_addr != NULL) {
+#ifdef MODULE_GNRC_IPV6
+        if (address_family != AF_INET6) {
+            return -EAFNOSUPPORT;
+        }
+#else
+        return -EAFNOSUPPORT;
+#endif
+        /* Check if AF-Family matches internally used AF-Family */
+        if (tcb->address_family != address_family) {
+            return -EINVAL;
+        }
+    }
+
+    /* Lock the TCB for this function call */
+    mutex_lock(&(tcb->function_lock));
 
+    /* Connection is already connected: Return -EISCONN */
+    if (tcb->state != FSM_STATE_CLOSED) {
+        mutex_unlock(&(tcb->function_lock));
+        return -EISCONN;
+    }
+
+    /* Setup passive connection like _gnrc_tcp_open(), but don't wait for it */
+    tcb->status |= STATUS_PASSIVE;
+    if (local_addr == NULL) {
+        tcb->status |= STATUS_ALLOW_ANY_ADDR;
+    }
+#ifdef MODULE_GNRC_IPV6
+    else if (tcb->address_family == AF_INET6) {
+        memcpy(tcb->local_addr, local_addr, sizeof(ipv6_addr_t));
+    }
+#endif
+    tcb->local_port = local_port;
+    tcb->listen_mbox = mbox;
+
+    /* Call FSM with event: CALL_OPEN, T: CLOSED -> LISTEN */
+    ret = _fsm(tcb, FSM_EVENT_CALL_OPEN, NULL, NULL, 0);
+    mutex_unlock(&(tcb->function_lock));
+    return ret;
+}
+
+/**
+ * @brief   Transmits data or a snip and waits until it was acknowledged.
+ *
+ * @param[in,out] tcb                   TCB holding the connection information.
+ * @param[in]     pkt                   Snip to send without copying, or NULL.
+ * @param[in]     data                  Data to copy if @p pkt is NULL.
+ * @param[in]     len                   Length of @p data.
+ * @param[in]     timeout_duration_us   User timeout, zero for none.
+ *
+ * @returns   See gnrc_tcp_send(). -EMSGSIZE if @p pkt does not fit into a
+ *            segment.
+ */
+static ssize_t _gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt, const void *data,
+                              const size_t len, const uint32_t timeout_duration_us)
+{
     msg_t msg;
-    xtimer_t connection_timeout;
-    cb_arg_t connection_timeout_arg = {MSG_TYPE_CONNECTION_TIMEOUT, &(tcb->mbox)};
-    xtimer_t user_timeout;
-    cb_arg_t user_timeout_arg = {MSG_TYPE_USER_SPEC_TIMEOUT, &(tcb->mbox)};
-    xtimer_t probe_timeout;
-    cb_arg_t probe_timeout_arg = {MSG_TYPE_PROBE_TIMEOUT, &(tcb->mbox)};
+    gnrc_tcp_timer_t connection_timeout;
+    gnrc_tcp_timer_t user_timeout;
+    gnrc_tcp_timer_t probe_timeout;
     uint32_t probe_timeout_duration_us = 0;
     ssize_t ret = 0;
     bool probing_mode = false;
@@ -327,13 +353,18 @@ ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
     while (mbox_try_get(&(tcb->mbox), &msg) != 0) {
     }
 
+    /* Timers put their timeout messages into the TCBs mbox */
+    _timer_init(&connection_timeout, tcb, &(tcb->mbox));
+    _timer_init(&user_timeout, tcb, &(tcb->mbox));
+    _timer_init(&probe_timeout, tcb, &(tcb->mbox));
+
     /* Setup connection timeout: Put timeout message in tcb's mbox on expiration */
-    _setup_timeout(&connection_timeout, GNRC_TCP_CONNECTION_TIMEOUT_DURATION,
-                   _cb_mbox_put_msg, &connection_timeout_arg);
+    _timer_set(&connection_timeout, GNRC_TCP_CONNECTION_TIMEOUT_DURATION,
+               MSG_TYPE_CONNECTION_TIMEOUT);
 
     /* Setup user specified timeout if timeout_us is greater than zero */
     if (timeout_duration_us > 0) {
-        _setup_timeout(&user_timeout, timeout_duration_us, _cb_mbox_put_msg, &user_timeout_arg);
+        _timer_set(&user_timeout, timeout_duration_us, MSG_TYPE_USER_SPEC_TIMEOUT);
     }
 
     /* Loop until something was sent and acked */
@@ -352,13 +383,16 @@ ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
                 probe_timeout_duration_us = tcb->rto;
             }
             /* Setup probe timeout */
-            _setup_timeout(&probe_timeout, timeout_duration_us, _cb_mbox_put_msg,
-                           &probe_timeout_arg);
+            _timer_set(&probe_timeout, probe_timeout_duration_us, MSG_TYPE_PROBE_TIMEOUT);
         }
 
         /* Try to send data in case there nothing has been sent and we are not probing */
         if (ret == 0 && !probing_mode) {
-            ret = _fsm(tcb, FSM_EVENT_CALL_SEND, NULL, (void *) data, len);
+            ret = _fsm(tcb, FSM_EVENT_CALL_SEND, pkt, (void *) data, len);
+            /* Segment was not built: Don't wait for its acknowledgment */
+            if (ret < 0) {
+                break;
+            }
         }
 
         /* Wait for responses */
@@ -395,13 +429,13 @@ ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
                 DEBUG("gnrc_tcp.c : gnrc_tcp_send() : NOTIFY_USER\n");
 
                 /* Connection is alive: Reset Connection Timeout */
-                _setup_timeout(&connection_timeout, GNRC_TCP_CONNECTION_TIMEOUT_DURATION,
-                               _cb_mbox_put_msg, &connection_timeout_arg);
+                _timer_set(&connection_timeout, GNRC_TCP_CONNECTION_TIMEOUT_DURATION,
+                           MSG_TYPE_CONNECTION_TIMEOUT);
 
                 /* If the window re-opened and we are probing: Stop it */
                 if (tcb->snd_wnd > 0 && probing_mode) {
                     probing_mode = false;
-                    xtimer_remove(&probe_timeout);
+                    _timer_del(&probe_timeout);
                 }
                 break;
 
@@ -411,14 +445,46 @@ ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
     }
 
     /* Cleanup */
-    xtimer_remove(&probe_timeout);
-    xtimer_remove(&connection_timeout);
-    xtimer_remove(&user_timeout);
+    _timer_del(&probe_timeout);
+    _timer_del(&connection_timeout);
+    _timer_del(&user_timeout);
     tcb->status &= ~STATUS_WAIT_FOR_MSG;
     mutex_unlock(&(tcb->function_lock));
     return ret;
 }
 
+ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
+                      const uint32_t timeout_duration_us)
+{
+    assert(tcb != NULL);
+    assert(data != NULL);
+
+    return _gnrc_tcp_send(tcb, NULL, data, len, timeout_duration_us);
+}
+
+ssize_t gnrc_tcp_send_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *payload,
+                          const uint32_t timeout_duration_us)
+{
+    assert(tcb != NULL);
+    assert((payload != NULL) && (payload->next == NULL));
+
+    /* The FSM holds its own reference if the snip is sent as a segment */
+    ssize_t ret = _gnrc_tcp_send(tcb, payload, NULL, payload->size, timeout_duration_us);
+
+    /* Larger than a segment: Send the data segment-wise */
+    if (ret == -EMSGSIZE) {
+        size_t sent = 0;
+        do {
+            ret = _gnrc_tcp_send(tcb, NULL, (uint8_t *)payload->data + sent,
+                                 payload->size - sent, timeout_duration_us);
+            sent += (ret > 0) ? ret : 0;
+        } while ((ret > 0) && (sent < payload->size));
+        ret = (ret < 0) ? ret : (ssize_t)sent;
+    }
+    gnrc_pktbuf_release(payload);
+    return ret;
+}
+
 ssize_t gnrc_tcp_recv(gnrc_tcp_tcb_t *tcb, void *data, const size_t max_len,
                       const uint32_t timeout_duration_us)
 {
@@ -426,10 +492,8 @@ ssize_t gnrc_tcp_recv(gnrc_tcp_tcb_t *tcb, void *data, const size_t max_len,
     assert(data != NULL);
 
     msg_t msg;
-    xtimer_t connection_timeout;
-    cb_arg_t connection_timeout_arg = {MSG_TYPE_CONNECTION_TIMEOUT, &(tcb->mbox)};
-    xtimer_t user_timeout;
-    cb_arg_t user_timeout_arg = {MSG_TYPE_USER_SPEC_TIMEOUT, &(tcb->mbox)};
+    gnrc_tcp_timer_t connection_timeout;
+    gnrc_tcp_timer_t user_timeout;
     ssize_t ret = 0;
 
     /* Lock the TCB for this function call */
@@ -459,12 +523,16 @@ ssize_t gnrc_tcp_recv(gnrc_tcp_tcb_t *tcb, void *data, const size_t max_len,
     while (mbox_try_get(&(tcb->mbox), &msg) != 0) {
     }
 
+    /* Timers put their timeout messages into the TCBs mbox */
+    _timer_init(&connection_timeout, tcb, &(tcb->mbox));
+    _timer_init(&user_timeout, tcb, &(tcb->mbox));
+
     /* Setup connection timeout: Put timeout message in tcb's mbox on expiration */
-    _setup_timeout(&connection_timeout, GNRC_TCP_CONNECTION_TIMEOUT_DURATION,
-                   _cb_mbox_put_msg, &connection_timeout_arg);
+    _timer_set(&connection_timeout, GNRC_TCP_CONNECTION_TIMEOUT_DURATION,
+               MSG_TYPE_CONNECTION_TIMEOUT);
 
     /* Setup user specified timeout */
-    _setup_timeout(&user_timeout, timeout_duration_us, _cb_mbox_put_msg, &user_timeout_arg);
+    _timer_set(&user_timeout, timeout_duration_us, MSG_TYPE_USER_SPEC_TIMEOUT);
 
     /* Processing loop */
     while (ret == 0) {
@@ -504,8 +572,8 @@ ssize_t gnrc_tcp_recv(gnrc_tcp_tcb_t *tcb, void *data, const size_t max_len,
     }
 
     /* Cleanup */
-    xtimer_remove(&connection_timeout);
-    xtimer_remove(&user_timeout);
+    _timer_del(&connection_timeout);
+    _timer_del(&user_timeout);
     tcb->status &= ~STATUS_WAIT_FOR_MSG;
     mutex_unlock(&(tcb->function_lock));
     return ret;
@@ -516,8 +584,7 @@ void gnrc_tcp_close(gnrc_tcp_tcb_t *tcb)
     assert(tcb != NULL);
 
     msg_t msg;
-    xtimer_t connection_timeout;
-    cb_arg_t connection_timeout_arg = {MSG_TYPE_CONNECTION_TIMEOUT, &(tcb->mbox)};
+    gnrc_tcp_timer_t connection_timeout;
 
     /* Lock the TCB for this function call */
     mutex_lock(&(tcb->function_lock));
@@ -535,9 +602,12 @@ void gnrc_tcp_close(gnrc_tcp_tcb_t *tcb)
     while (mbox_try_get(&(tcb->mbox), &msg) != 0) {
     }
 
+    /* Timers put their timeout messages into the TCBs mbox */
+    _timer_init(&connection_timeout, tcb, &(tcb->mbox));
+
     /* Setup connection timeout: Put timeout message in tcb's mbox on expiration */
-    _setup_timeout(&connection_timeout, GNRC_TCP_CONNECTION_TIMEOUT_DURATION,
-                   _cb_mbox_put_msg, &connection_timeout_arg);
+    _timer_set(&connection_timeout, GNRC_TCP_CONNECTION_TIMEOUT_DURATION,
+               MSG_TYPE_CONNECTION_TIMEOUT);
 
     /* Start connection teardown sequence */
     _fsm(tcb, FSM_EVENT_CALL_CLOSE, NULL, NULL, 0);
@@ -561,7 +631,7 @@ void gnrc_tcp_close(gnrc_tcp_tcb_t *tcb)
     }
 
     /* Cleanup */
-    xtimer_remove(&connection_timeout);
+    _timer_del(&connection_timeout);
     tcb->status &= ~STATUS_WAIT_FOR_MSG;
     mutex_unlock(&(tcb->function_lock));
 }
@@ -17,6 +17,7 @@
  * @}
  */
 
+#include <string.h>
 #include <utlist.h>
 #include <errno.h>
 #include "net/af.h"
@@ -35,6 +36,56 @@
 
 static msg_t _eventloop_msg_queue[TCP_EVENTLOOP_MSG_QUEUE_SIZE];
 
+/**
+ * @brief Event timer holding the timers of all TCBs and blocked user calls.
+ */
+static evtimer_t _timers;
+
+/**
+ * @brief Event timer callback, reports an expired timer.
+ *
+ * @param[in] event   The expired timer.
+ */
+static void _timer_cb(evtimer_event_t *event)
+{
+    gnrc_tcp_timer_t *timer = (gnrc_tcp_timer_t *)event;
+
+    if (timer->mbox != NULL) {
+        mbox_try_put(timer->mbox, &timer->msg);
+    }
+    else if (msg_send_int(&timer->msg, gnrc_tcp_pid) <= 0) {
+        DEBUG("gnrc_tcp_eventloop.c : _timer_cb() : message queue full\n");
+    }
+}
+
+void _eventloop_init(void)
+{
+    evtimer_init(&_timers, _timer_cb);
+}
+
+void _timer_init(gnrc_tcp_timer_t *timer, gnrc_tcp_tcb_t *tcb, mbox_t *mbox)
+{
+    memset(timer, 0, sizeof(gnrc_tcp_timer_t));
+    timer->msg.content.ptr = (void *)tcb;
+    timer->mbox = mbox;
+}
+
+void _timer_set(gnrc_tcp_timer_t *timer, uint32_t duration_us, uint16_t type)
+{
+    evtimer_del(&_timers, &timer->event);
+    timer->msg.type = type;
+    /* Round up: Never expire earlier than requested. Computed in 64 bit, so
+     * long durations like UINT32_MAX don't overflow to an immediate timeout */
+    timer->event.offset = (uint32_t)(((uint64_t)duration_us + US_PER_MS - 1) /
+                                     US_PER_MS);
+    evtimer_add(&_timers, &timer->event);
+}
+
+void _timer_del(gnrc_tcp_timer_t *timer)
+{
+    evtimer_del(&_timers, &timer->event);
+}
+
 /**
  * @brief Send function, pass paket down the network stack.
  *
@@ -19,11 +19,13 @@
 
 #include "random.h"
 #include "net/af.h"
+#include "net/gnrc/tcp.h"
 #include "internal/common.h"
 #include "internal/pkt.h"
 #include "internal/option.h"
 #include "internal/rcvbuf.h"
 #include "internal/fsm.h"
+#include "internal/eventloop.h"
 
 #ifdef MODULE_GNRC_IPV6
 #include "net/gnrc/ipv6.h"
@@ -82,7 +84,7 @@ static int _clear_retransmit(gnrc_tcp_tcb_t *tcb)
 {
     if (tcb->pkt_retransmit != NULL) {
         gnrc_pktbuf_release(tcb->pkt_retransmit);
-        xtimer_remove(&(tcb->tim_tout));
+        _timer_del(&(tcb->tim_tout));
         tcb->pkt_retransmit = NULL;
     }
     return 0;
@@ -97,10 +99,7 @@ static int _clear_retransmit(gnrc_tcp_tcb_t *tcb)
  */
 static int _restart_timewait_timer(gnrc_tcp_tcb_t *tcb)
 {
-    xtimer_remove(&tcb->tim_tout);
-    tcb->msg_tout.type = MSG_TYPE_TIMEWAIT;
-    tcb->msg_tout.content.ptr = (void *)tcb;
-    xtimer_set_msg(&tcb->tim_tout, 2 * GNRC_TCP_MSL, &tcb->msg_tout, gnrc_tcp_pid);
+    _timer_set(&tcb->tim_tout, 2 * GNRC_TCP_MSL, MSG_TYPE_TIMEWAIT);
     return 0;
 }
 
@@ -120,8 +119,9 @@ static int _transition_to(gnrc_tcp_tcb_t *tcb, fsm_state_t state)
 
     switch (state) {
         case FSM_STATE_CLOSED:
-            /* Clear retransmit queue */
+            /* Clear retransmit queue and stop a running timewait timer */
             _clear_retransmit(tcb);
+            _timer_del(&(tcb->tim_tout));
 
             /* Remove connection from active connections */
             mutex_lock(&_list_tcb_lock);
@@ -191,6 +191,13 @@ static int _transition_to(gnrc_tcp_tcb_t *tcb, fsm_state_t state)
         case FSM_STATE_ESTABLISHED:
         case FSM_STATE_CLOSE_WAIT:
             tcb->status |= STATUS_NOTIFY_USER;
+            /* Notify listener about a passively opened connection */
+            if ((tcb->state == FSM_STATE_SYN_RCVD) && (tcb->listen_mbox != NULL)) {
+                msg_t msg;
+                msg.type = GNRC_TCP_MSG_TYPE_ESTABLISHED;
+                msg.content.ptr = (void *)tcb;
+                mbox_try_put(tcb->listen_mbox, &msg);
+            }
             break;
 
         case FSM_STATE_TIME_WAIT:
@@ -254,12 +261,16 @@ static int _fsm_call_open(gnrc_tcp_tcb_t *tcb)
  * @brief FSM Handling function for sending data.
  *
  * @param[in,out] tcb   TCB holding the connection information.
+ * @param[in]     pkt   Snip to send as a whole without copying it. If NULL,
+ *                      @p buf is copied.
  * @param[in,out] buf   Buffer containing data to send.
  * @param[in]     len   Maximum Number of Bytes to send from @p buf.
  *
  * @returns   Number of successfully transmitted bytes.
+ *            -EMSGSIZE if @p pkt does not fit into the next segment.
+ *            -ENOMEM if the segment could not be allocated.
  */
-static int _fsm_call_send(gnrc_tcp_tcb_t *tcb, void *buf, size_t len)
+static int _fsm_call_send(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt, void *buf, size_t len)
 {
     DEBUG("gnrc_tcp_fsm.c : _fsm_call_send()\n");
 
@@ -270,12 +281,29 @@ static int _fsm_call_send(gnrc_tcp_tcb_t *tcb, void *buf, size_t len)
         /* Calculate segment size */
         payload = (payload < GNRC_TCP_MSS) ? payload : GNRC_TCP_MSS;
         payload = (payload < tcb->mss) ? payload : tcb->mss;
-        payload = (payload < len) ? payload : len;
 
-        /* Calculate payload size for this segment */
         gnrc_pktsnip_t *out_pkt = NULL;
         uint16_t seq_con = 0;
-        _pkt_build(tcb, &out_pkt, &seq_con, MSK_ACK, tcb->snd_nxt, tcb->rcv_nxt, buf, payload);
+        if (pkt != NULL) {
+            /* Reference a snip only if it fits into this segment */
+            if (pkt->size > payload) {
+                return -EMSGSIZE;
+            }
+            payload = pkt->size;
+            gnrc_pktbuf_hold(pkt, 1);
+            if (_pkt_build_snip(tcb, &out_pkt, &seq_con, MSK_ACK, tcb->snd_nxt, tcb->rcv_nxt,
+                                pkt) < 0) {
+                return -ENOMEM;
+            }
+        }
+        else {
+            /* Calculate payload size for this segment */
+            payload = (payload < len) ? payload : len;
+            if (_pkt_build(tcb, &out_pkt, &seq_con, MSK_ACK, tcb->snd_nxt, tcb->rcv_nxt,
+                           buf, payload) < 0) {
+                return -ENOMEM;
+            }
+        }
         _pkt_setup_retransmit(tcb, out_pkt, false);
         _pkt_send(tcb, out_pkt, seq_con, false);
         return payload;
@@ -836,7 +864,7 @@ static int _fsm_unprotected(gnrc_tcp_tcb_t *tcb, fsm_event_t event, gnrc_pktsnip
             ret = _fsm_call_open(tcb);
             break;
         case FSM_EVENT_CALL_SEND :
-            ret = _fsm_call_send(tcb, buf, len);
+            ret = _fsm_call_send(tcb, in_pkt, buf, len);
             break;
         case FSM_EVENT_CALL_RECV :
             ret = _fsm_call_recv(tcb, buf, len);
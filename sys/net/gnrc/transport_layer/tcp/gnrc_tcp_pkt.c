@@ -25,6 +25,7 @@
 #include "internal/common.h"
 #include "internal/option.h"
 #include "internal/pkt.h"
+#include "internal/eventloop.h"
 
 #ifdef MODULE_GNRC_IPV6
 #include "net/gnrc/ipv6.h"
@@ -120,9 +121,6 @@ int _pkt_build(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t **out_pkt, uint16_t *seq_con,
                void *payload, const size_t payload_len)
 {
     gnrc_pktsnip_t *pay_snp = NULL;
-    gnrc_pktsnip_t *tcp_snp = NULL;
-    tcp_hdr_t tcp_hdr;
-    uint8_t offset = TCP_HDR_OFFSET_MIN;
 
     /* Add payload, if supplied */
     if (payload != NULL && payload_len > 0) {
@@ -133,6 +131,16 @@ int _pkt_build(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t **out_pkt, uint16_t *seq_con,
             return -ENOMEM;
         }
     }
+    return _pkt_build_snip(tcb, out_pkt, seq_con, ctl, seq_num, ack_num, pay_snp);
+}
+
+int _pkt_build_snip(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t **out_pkt, uint16_t *seq_con,
+                    const uint16_t ctl, const uint32_t seq_num, const uint32_t ack_num,
+                    gnrc_pktsnip_t *pay_snp)
+{
+    gnrc_pktsnip_t *tcp_snp = NULL;
+    tcp_hdr_t tcp_hdr;
+    uint8_t offset = TCP_HDR_OFFSET_MIN;
 
     /* Fill TCP header */
     tcp_hdr.src_port = byteorder_htons(tcb->local_port);
@@ -204,7 +212,7 @@ int _pkt_build(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t **out_pkt, uint16_t *seq_con,
         if (ctl & MSK_FIN) {
             *seq_con += 1;
         }
-        *seq_con += payload_len;
+        *seq_con += gnrc_pkt_len(pay_snp);
     }
     return 0;
 }
@@ -359,9 +367,7 @@ int _pkt_setup_retransmit(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt, const bool r
     }
 
     /* Setup retransmission timer, msg to TCP thread with ptr to TCB */
-    tcb->msg_tout.type = MSG_TYPE_RETRANSMISSION;
-    tcb->msg_tout.content.ptr = (void *) tcb;
-    xtimer_set_msg(&tcb->tim_tout, tcb->rto, &tcb->msg_tout, gnrc_tcp_pid);
+    _timer_set(&tcb->tim_tout, tcb->rto, MSG_TYPE_RETRANSMISSION);
     return 0;
 }
 
@@ -385,7 +391,7 @@ int _pkt_acknowledge(gnrc_tcp_tcb_t *tcb, const uint32_t ack)
 
     /* If segment can be acknowledged -> stop timer, release packet from pktbuf and update rto. */
     if (LSS_32_BIT(seg, ack)) {
-        xtimer_remove(&(tcb->tim_tout));
+        _timer_del(&(tcb->tim_tout));
         gnrc_pktbuf_release(tcb->pkt_retransmit);
         tcb->pkt_retransmit = NULL;
 
@@ -55,7 +55,9 @@ extern "C" {
  * @brief Defines for "eventloop" thread settings.
  * @{
  */
-#define TCP_EVENTLOOP_MSG_QUEUE_SIZE (8U)
+#ifndef TCP_EVENTLOOP_MSG_QUEUE_SIZE
+#define TCP_EVENTLOOP_MSG_QUEUE_SIZE (16U)
+#endif
 #define TCP_EVENTLOOP_PRIO           (THREAD_PRIORITY_MAIN - 2U)
 #define TCP_EVENTLOOP_STACK_SIZE     (THREAD_STACKSIZE_DEFAULT)
 /** @} */
@@ -22,10 +22,45 @@
 #ifndef EVENTLOOP_H
 #define EVENTLOOP_H
 
+#include <stdint.h>
+#include "mbox.h"
+#include "net/gnrc/tcp/tcb.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/**
+ * @brief Initializes the event timer, which holds all timers of GNRC TCP.
+ */
+void _eventloop_init(void);
+
+/**
+ * @brief Initializes a timer.
+ *
+ * @param[out] timer   Timer to initialize.
+ * @param[in]  tcb     TCB the timer belongs to. Content of the timeout message.
+ * @param[in]  mbox    Mbox to put the timeout message in. NULL to send it to
+ *                     the TCP thread.
+ */
+void _timer_init(gnrc_tcp_timer_t *timer, gnrc_tcp_tcb_t *tcb, mbox_t *mbox);
+
+/**
+ * @brief Starts a timer. A running timer is restarted.
+ *
+ * @param[in,out] timer         Timer to start.
+ * @param[in]     duration_us   Duration in microseconds until @p timer expires.
+ * @param[in]     type          Type of the timeout message.
+ */
+void _timer_set(gnrc_tcp_timer_t *timer, uint32_t duration_us, uint16_t type);
+
+/**
+ * @brief Stops a timer. Does nothing if the timer is not running.
+ *
+ * @param[in,out] timer   Timer to stop.
+ */
+void _timer_del(gnrc_tcp_timer_t *timer);
+
 /**
  * @brief GNRC TCPs main processing thread.
  *
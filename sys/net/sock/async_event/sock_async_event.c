@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ * @brief   Stack independent implementation of @ref net_sock_async_event
+ *
+ * The stack calls the sock callbacks in its own context, so they only note the
+ * event type and post the event of the sock, if it is not already queued.
+ *
+ * @}
+ */
+
+#include <assert.h>
+
+#include "irq.h"
+#include "net/sock/async_event.h"
+#include "net/sock/ip.h"
+#include "net/sock/udp.h"
+
+/* fetches and clears the pending event types */
+static unsigned _get_type(sock_event_t *event)
+{
+    unsigned state = irq_disable();
+    unsigned type = event->type;
+
+    event->type = 0;
+    irq_restore(state);
+    return type;
+}
+
+static void _post(sock_async_ctx_t *ctx, sock_async_flags_t type)
+{
+    sock_event_t *event = &ctx->event;
+    unsigned state = irq_disable();
+
+    event->type |= type;
+    /* a queued event will handle the new type as well */
+    if (event->super.list_node.next == NULL) {
+        event_post(event->queue, &event->super);
+    }
+    irq_restore(state);
+}
+
+static void _init(sock_async_ctx_t *ctx, void *sock, event_queue_t *ev_queue,
+                  event_handler_t event_handler, void *handler_arg)
+{
+    assert(ev_queue != NULL);
+    ctx->event.super.list_node.next = NULL;
+    ctx->event.super.handler = event_handler;
+    ctx->event.cb_arg = handler_arg;
+    ctx->event.sock = sock;
+    ctx->event.queue = ev_queue;
+    ctx->event.type = 0;
+}
+
+#ifdef MODULE_SOCK_IP
+static void _ip_event_handler(event_t *ev)
+{
+    sock_event_t *event = (sock_event_t *)ev;
+    unsigned type = _get_type(event);
+
+    if (type != 0) {
+        event->cb.ip(event->sock, (sock_async_flags_t)type, event->cb_arg);
+    }
+}
+
+static void _ip_cb(sock_ip_t *sock, sock_async_flags_t type, void *arg)
+{
+    (void)sock;
+    _post(arg, type);
+}
+
+void sock_ip_event_init(sock_ip_t *sock, event_queue_t *ev_queue,
+                        sock_ip_cb_t handler, void *handler_arg)
+{
+    sock_async_ctx_t *ctx = sock_ip_get_async_ctx(sock);
+
+    assert(handler != NULL);
+    _init(ctx, sock, ev_queue, _ip_event_handler, handler_arg);
+    ctx->event.cb.ip = handler;
+    sock_ip_set_cb(sock, _ip_cb, ctx);
+}
+#endif
+
+#ifdef MODULE_SOCK_UDP
+static void _udp_event_handler(event_t *ev)
+{
+    sock_event_t *event = (sock_event_t *)ev;
+    unsigned type = _get_type(event);
+
+    if (type != 0) {
+        event->cb.udp(event->sock, (sock_async_flags_t)type, event->cb_arg);
+    }
+}
+
+static void _udp_cb(sock_udp_t *sock, sock_async_flags_t type, void *arg)
+{
+    (void)sock;
+    _post(arg, type);
+}
+
+void sock_udp_event_init(sock_udp_t *sock, event_queue_t *ev_queue,
+                         sock_udp_cb_t handler, void *handler_arg)
+{
+    sock_async_ctx_t *ctx = sock_udp_get_async_ctx(sock);
+
+    assert(handler != NULL);
+    _init(ctx, sock, ev_queue, _udp_event_handler, handler_arg);
+    ctx->event.cb.udp = handler;
+    sock_udp_set_cb(sock, _udp_cb, ctx);
+}
+#endif
+
+void sock_event_close(sock_async_ctx_t *ctx)
+{
+    event_cancel(ctx->event.queue, &ctx->event.super);
+    ctx->event.type = 0;
+}
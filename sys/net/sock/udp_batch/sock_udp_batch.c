@@ -0,0 +1,62 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ * @brief   Generic batch functions for UDP socks
+ *
+ * Built on the single-datagram functions of the stack's sock implementation.
+ */
+
+#include <assert.h>
+
+#include "net/sock/udp.h"
+
+ssize_t sock_udp_recv_batch(sock_udp_t *sock, sock_udp_msg_t *msgs,
+                            size_t numof, uint32_t timeout)
+{
+    size_t i = 0;
+
+    assert((sock != NULL) && (msgs != NULL) && (numof > 0));
+    do {
+        ssize_t res = sock_udp_recv(sock, msgs[i].data, msgs[i].len, timeout,
+                                    &msgs[i].remote);
+
+        if (res < 0) {
+            /* report errors only if nothing was received yet, the remaining
+             * messages stay queued for the next call */
+            return (i > 0) ? (ssize_t)i : res;
+        }
+        msgs[i].len = res;
+        /* only wait for the first message */
+        timeout = 0;
+    } while (++i < numof);
+    return i;
+}
+
+#ifndef SOCK_HAS_UDP_SEND_BATCH
+ssize_t sock_udp_send_batch(sock_udp_t *sock, const sock_udp_msg_t *msgs,
+                            size_t numof, const sock_udp_ep_t *remote)
+{
+    size_t i;
+
+    assert((msgs != NULL) && (numof > 0));
+    for (i = 0; i < numof; i++) {
+        ssize_t res = sock_udp_send(sock, msgs[i].data, msgs[i].len, remote);
+
+        if (res < 0) {
+            return (i > 0) ? (ssize_t)i : res;
+        }
+    }
+    return i;
+}
+#endif
+
+/** @} */
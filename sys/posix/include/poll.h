@@ -0,0 +1,69 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @file
+ * @ingroup posix
+ * @brief   POSIX compatible poll.h definitions
+ *
+ * poll() is provided for sockets by the `posix_select` module. Only datagram
+ * and raw sockets are supported, for stream sockets it fails with
+ * `EOPNOTSUPP`. Any number of threads may wait for the same socket, all of
+ * them are woken up when a packet arrives.
+ *
+ * @see http://pubs.opengroup.org/onlinepubs/9699919799/basedefs/poll.h.html
+ */
+
+#ifndef DOXYGEN
+#ifdef CPU_NATIVE
+/* If building on native we need to use the system header instead */
+#pragma GCC system_header
+/* without the GCC pragma above #include_next will trigger a pedantic error */
+#include_next <poll.h>
+#ifdef MODULE_POSIX_SELECT
+/* the sockets' poll() must not replace the one of the host's libc */
+int posix_poll(struct pollfd fds[], nfds_t nfds, int timeout);
+#define poll    posix_poll
+#endif
+#else
+#ifndef POLL_H
+#define POLL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define POLLIN      0x0001  /* Data other than high-priority data may be read */
+#define POLLPRI     0x0002  /* High-priority data may be read */
+#define POLLOUT     0x0004  /* Normal data may be written */
+#define POLLERR     0x0008  /* An error has occurred (revents only) */
+#define POLLHUP     0x0010  /* Device has been disconnected (revents only) */
+#define POLLNVAL    0x0020  /* Invalid fd member (revents only) */
+#define POLLRDNORM  POLLIN  /* Normal data may be read */
+#define POLLWRNORM  POLLOUT /* Equivalent to POLLOUT */
+
+typedef unsigned int nfds_t;
+
+struct pollfd {
+    int fd;                 /* The following descriptor being polled */
+    short events;           /* The input event flags */
+    short revents;          /* The output event flags */
+};
+
+int poll(struct pollfd fds[], nfds_t nfds, int timeout);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* POLL_H */
+
+#endif /* CPU_NATIVE */
+
+#endif /* DOXYGEN */
+/** @} */
@@ -0,0 +1,71 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @file
+ * @ingroup posix
+ * @brief   POSIX compatible sys/select.h definitions
+ *
+ * select() is provided for sockets by the `posix_select` module. Only datagram
+ * and raw sockets are supported, for stream sockets it fails with
+ * `EOPNOTSUPP`. Any number of threads may wait for the same socket, all of
+ * them are woken up when a packet arrives.
+ *
+ * @see http://pubs.opengroup.org/onlinepubs/9699919799/basedefs/sys_select.h.html
+ */
+
+#ifndef DOXYGEN
+#if defined(CPU_NATIVE) || MODULE_NEWLIB
+/* If building on native or newlib we need to use the system header instead */
+#pragma GCC system_header
+/* without the GCC pragma above #include_next will trigger a pedantic error */
+#include_next <sys/select.h>
+#if defined(CPU_NATIVE) && defined(MODULE_POSIX_SELECT)
+/* the sockets' select() must not replace the one of the host's libc */
+int posix_select(int nfds, fd_set *readfds, fd_set *writefds,
+                 fd_set *errorfds, struct timeval *timeout);
+#define select  posix_select
+#endif
+#else
+#ifndef SYS_SELECT_H
+#define SYS_SELECT_H
+
+#include <stdint.h>
+#include <string.h>
+#include <sys/time.h>   /* for struct timeval */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef FD_SETSIZE
+#define FD_SETSIZE  (32)    /* Maximum number of file descriptors in an fd_set */
+#endif
+
+typedef struct {
+    uint32_t fds_bits[(FD_SETSIZE + 31) / 32];
+} fd_set;
+
+#define FD_CLR(fd, set)     ((set)->fds_bits[(fd) / 32] &= ~(1UL << ((fd) % 32)))
+#define FD_ISSET(fd, set)   (((set)->fds_bits[(fd) / 32] & (1UL << ((fd) % 32))) != 0)
+#define FD_SET(fd, set)     ((set)->fds_bits[(fd) / 32] |= (1UL << ((fd) % 32)))
+#define FD_ZERO(set)        memset((set), 0, sizeof(fd_set))
+
+int select(int nfds, fd_set *readfds, fd_set *writefds, fd_set *errorfds,
+           struct timeval *timeout);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SYS_SELECT_H */
+
+#endif /* CPU_NATIVE || MODULE_NEWLIB */
+
+#endif /* DOXYGEN */
+/** @} */
@@ -19,6 +19,7 @@
 #include <assert.h>
 #include <arpa/inet.h>
 #include <errno.h>
+#include <fcntl.h>
 #include <stdbool.h>
 #include <string.h>
 
@@ -36,6 +37,25 @@
 #include "net/sock/udp.h"
 #include "net/sock/tcp.h"
 
+#ifdef MODULE_POSIX_SELECT
+#include <poll.h>
+#include <sys/select.h>
+
+#include "irq.h"
+#include "net/sock/async.h"
+#include "thread.h"
+#include "thread_flags.h"
+#include "utlist.h"
+#include "xtimer.h"
+
+/**
+ * @brief   Thread flag used to wake up a thread blocking in poll() or select()
+ */
+#ifndef POSIX_SELECT_THREAD_FLAG
+#define POSIX_SELECT_THREAD_FLAG    (1U << 8)
+#endif
+#endif
+
 /* enough to create sockets both with socket() and accept() */
 #define _ACTUAL_SOCKET_POOL_SIZE   (SOCKET_POOL_SIZE + \
                                     (SOCKET_POOL_SIZE * SOCKET_TCP_QUEUE_SIZE))
@@ -70,6 +90,10 @@ typedef struct {
     int type;
     int protocol;
     bool bound;
+    bool nonblocking;
+#ifdef MODULE_POSIX_SELECT
+    unsigned readable;          /* number of packets queued for receiving */
+#endif
 #ifdef POSIX_SETSOCKOPT
     uint32_t recv_timeout;
 #endif
@@ -316,9 +340,24 @@ static inline ssize_t socket_write(vfs_file_t *filp, const void *buf, size_t n)
     return socket_sendto(filp->private_data.ptr, buf, n, 0, NULL, 0);
 }
 
+static int socket_fcntl(vfs_file_t *filp, int cmd, int arg)
+{
+    socket_t *s = filp->private_data.ptr;
+
+    switch (cmd) {
+        case F_SETFL:
+            /* only O_NONBLOCK can be changed */
+            s->nonblocking = (arg & O_NONBLOCK);
+            filp->flags = (filp->flags & ~O_NONBLOCK) | (arg & O_NONBLOCK);
+            return 0;
+        default:
+            return -EINVAL;
+    }
+}
+
 static const vfs_file_ops_t socket_ops = {
     .close = socket_close,
-    .fcntl = NULL,          /* TODO: provide when needed */
+    .fcntl = socket_fcntl,
     .fstat = socket_fstat,
     .lseek = socket_lseek,
     .read = socket_read,
@@ -360,6 +399,10 @@ int socket(int domain, int type, int protocol)
                 break;
             }
             s->bound = false;
+            s->nonblocking = false;
+#ifdef MODULE_POSIX_SELECT
+            s->readable = 0;
+#endif
             s->sock = NULL;
 #ifdef POSIX_SETSOCKOPT
             s->recv_timeout = SOCK_NO_TIMEOUT;
@@ -406,9 +449,9 @@ int accept(int socket, struct sockaddr *restrict address,
     }
 
 #ifdef POSIX_SETSOCKOPT
-    const uint32_t recv_timeout = s->recv_timeout;
+    const uint32_t recv_timeout = (s->nonblocking) ? 0 : s->recv_timeout;
 #else
-    const uint32_t recv_timeout = SOCK_NO_TIMEOUT;
+    const uint32_t recv_timeout = (s->nonblocking) ? 0 : SOCK_NO_TIMEOUT;
 #endif
 
     switch (s->type) {
@@ -456,6 +499,10 @@ int accept(int socket, struct sockaddr *restrict address,
                 new_s->type = s->type;
                 new_s->protocol = s->protocol;
                 new_s->bound = true;
+                new_s->nonblocking = false;
+#ifdef MODULE_POSIX_SELECT
+                new_s->readable = 0;
+#endif
                 new_s->queue_array = NULL;
                 new_s->queue_array_len = 0;
                 memset(&s->local, 0, sizeof(sock_tcp_ep_t));
@@ -526,6 +573,92 @@ int bind(int socket, const struct sockaddr *address, socklen_t address_len)
     return 0;
 }
 
+#ifdef MODULE_POSIX_SELECT
+/**
+ * @brief   A thread waiting in poll() or select()
+ */
+typedef struct _poller {
+    struct _poller *next;       /**< next waiting thread */
+    thread_t *thread;           /**< the waiting thread */
+    const struct pollfd *fds;   /**< file descriptors the thread waits for */
+    nfds_t nfds;                /**< number of file descriptors in fds */
+} _poller_t;
+
+static _poller_t *_pollers;
+static mutex_t _pollers_mutex = MUTEX_INIT;
+
+static void _readable(socket_t *s)
+{
+    unsigned state = irq_disable();
+
+    s->readable++;
+    irq_restore(state);
+    /* any number of threads may wait for the same socket */
+    mutex_lock(&_pollers_mutex);
+    for (_poller_t *p = _pollers; p != NULL; p = p->next) {
+        for (nfds_t i = 0; i < p->nfds; i++) {
+            if (p->fds[i].fd == s->fd) {
+                thread_flags_set(p->thread, POSIX_SELECT_THREAD_FLAG);
+                break;
+            }
+        }
+    }
+    mutex_unlock(&_pollers_mutex);
+}
+
+#ifdef MODULE_SOCK_IP
+static void _ip_cb(sock_ip_t *sock, sock_async_flags_t flags, void *arg)
+{
+    (void)sock;
+    if (flags & SOCK_ASYNC_MSG_RECV) {
+        _readable(arg);
+    }
+}
+#endif
+
+#ifdef MODULE_SOCK_UDP
+static void _udp_cb(sock_udp_t *sock, sock_async_flags_t flags, void *arg)
+{
+    (void)sock;
+    if (flags & SOCK_ASYNC_MSG_RECV) {
+        _readable(arg);
+    }
+}
+#endif
+
+static void _set_cb(socket_t *s)
+{
+    switch (s->type) {
+#ifdef MODULE_SOCK_IP
+        case SOCK_RAW:
+            sock_ip_set_cb(&s->sock->raw, _ip_cb, s);
+            break;
+#endif
+#ifdef MODULE_SOCK_UDP
+        case SOCK_DGRAM:
+            sock_udp_set_cb(&s->sock->udp, _udp_cb, s);
+            break;
+#endif
+        default:
+            break;
+    }
+}
+
+/* keeps track of the packets left in the sock after a receive call */
+static void _consumed(socket_t *s, int res)
+{
+    unsigned state = irq_disable();
+
+    if (res == -EAGAIN) {
+        s->readable = 0;
+    }
+    else if ((res != -ETIMEDOUT) && (s->readable > 0)) {
+        s->readable--;
+    }
+    irq_restore(state);
+}
+#endif
+
 static int _bind_connect(socket_t *s, const struct sockaddr *address,
                          socklen_t address_len)
 {
@@ -591,6 +724,9 @@ static int _bind_connect(socket_t *s, const struct sockaddr *address,
         return -1;
     }
     s->sock = sock;
+#ifdef MODULE_POSIX_SELECT
+    _set_cb(s);
+#endif
     return 0;
 }
 
@@ -832,9 +968,9 @@ static ssize_t socket_recvfrom(socket_t *s, void *restrict buffer,
     }
 
 #ifdef POSIX_SETSOCKOPT
-    const uint32_t recv_timeout = s->recv_timeout;
+    const uint32_t recv_timeout = (s->nonblocking) ? 0 : s->recv_timeout;
 #else
-    const uint32_t recv_timeout = SOCK_NO_TIMEOUT;
+    const uint32_t recv_timeout = (s->nonblocking) ? 0 : SOCK_NO_TIMEOUT;
 #endif
 
     switch (s->type) {
@@ -863,6 +999,9 @@ static ssize_t socket_recvfrom(socket_t *s, void *restrict buffer,
             res = -EOPNOTSUPP;
             break;
     }
+#ifdef MODULE_POSIX_SELECT
+    _consumed(s, res);
+#endif
     if ((res >= 0) && (address != NULL) && (address_len != NULL)) {
         switch (s->type) {
 #ifdef MODULE_SOCK_TCP
@@ -1046,6 +1185,204 @@ int setsockopt(int socket, int level, int option_name, const void *option_value,
 #endif
 }
 
+#ifdef MODULE_POSIX_SELECT
+static short _revents(socket_t *s, short events)
+{
+    switch (s->type) {
+#ifdef MODULE_SOCK_IP
+        case SOCK_RAW:
+#endif
+#ifdef MODULE_SOCK_UDP
+        case SOCK_DGRAM:
+#endif
+#if defined(MODULE_SOCK_IP) || defined(MODULE_SOCK_UDP)
+            /* sending never blocks for datagram sockets */
+            return events & (((s->readable > 0) ? POLLIN : 0) | POLLOUT);
+#endif
+        default:
+            /* stream sockets are rejected by _poll() */
+            (void)events;
+            return POLLNVAL;
+    }
+}
+
+/* readiness can only be tracked for datagram sockets, so stream sockets are
+ * rejected instead of being reported as never ready */
+static int _poll_check(struct pollfd fds[], nfds_t nfds)
+{
+    int res = 0;
+
+    mutex_lock(&_socket_pool_mutex);
+    for (nfds_t i = 0; i < nfds; i++) {
+        socket_t *s = (fds[i].fd < 0) ? NULL : _get_socket(fds[i].fd);
+
+        if ((s != NULL) && (s->type == SOCK_STREAM)) {
+            errno = EOPNOTSUPP;
+            res = -1;
+            break;
+        }
+    }
+    mutex_unlock(&_socket_pool_mutex);
+    return res;
+}
+
+/* checks all fds, returns the number of fds with events */
+static int _poll_scan(struct pollfd fds[], nfds_t nfds)
+{
+    int res = 0;
+
+    mutex_lock(&_socket_pool_mutex);
+    for (nfds_t i = 0; i < nfds; i++) {
+        socket_t *s;
+
+        fds[i].revents = 0;
+        if (fds[i].fd < 0) {
+            continue;
+        }
+        s = _get_socket(fds[i].fd);
+        if (s == NULL) {
+            fds[i].revents = POLLNVAL;
+        }
+        else {
+            unsigned state = irq_disable();
+
+            fds[i].revents = _revents(s, fds[i].events);
+            irq_restore(state);
+        }
+        if (fds[i].revents != 0) {
+            res++;
+        }
+    }
+    mutex_unlock(&_socket_pool_mutex);
+    return res;
+}
+
+static int _poll(struct pollfd fds[], nfds_t nfds, uint32_t timeout)
+{
+    _poller_t poller = { .thread = (thread_t *)sched_active_thread,
+                         .fds = fds, .nfds = nfds };
+    xtimer_t timer = { .callback = NULL };
+    int res;
+
+    if (_poll_check(fds, nfds) < 0) {
+        return -1;
+    }
+    thread_flags_clear(POSIX_SELECT_THREAD_FLAG | THREAD_FLAG_TIMEOUT);
+    if ((timeout != 0) && (timeout != SOCK_NO_TIMEOUT)) {
+        xtimer_set_timeout_flag(&timer, timeout);
+    }
+    /* register before scanning: a notification between scanning and waiting
+     * is kept in the thread flags, so no packet gets lost */
+    mutex_lock(&_pollers_mutex);
+    LL_PREPEND(_pollers, &poller);
+    mutex_unlock(&_pollers_mutex);
+    while (((res = _poll_scan(fds, nfds)) == 0) && (timeout != 0)) {
+        if (thread_flags_wait_any(POSIX_SELECT_THREAD_FLAG |
+                                  THREAD_FLAG_TIMEOUT) & THREAD_FLAG_TIMEOUT) {
+            res = _poll_scan(fds, nfds);
+            break;
+        }
+    }
+    xtimer_remove(&timer);
+    mutex_lock(&_pollers_mutex);
+    LL_DELETE(_pollers, &poller);
+    mutex_unlock(&_pollers_mutex);
+    return res;
+}
+
+int poll(struct pollfd fds[], nfds_t nfds, int timeout)
+{
+    if (timeout < 0) {
+        return _poll(fds, nfds, SOCK_NO_TIMEOUT);
+    }
+    if ((uint32_t)timeout > ((SOCK_NO_TIMEOUT - 1) / US_PER_MS)) {
+        timeout = (SOCK_NO_TIMEOUT - 1) / US_PER_MS;
+    }
+    return _poll(fds, nfds, (uint32_t)timeout * US_PER_MS);
+}
+
+int select(int nfds, fd_set *readfds, fd_set *writefds, fd_set *errorfds,
+           struct timeval *timeout)
+{
+    struct pollfd fds[_ACTUAL_SOCKET_POOL_SIZE];
+    uint32_t timeout_us = SOCK_NO_TIMEOUT;
+    nfds_t numof = 0;
+    int res = 0;
+
+    if ((nfds < 0) || (nfds > FD_SETSIZE)) {
+        errno = EINVAL;
+        return -1;
+    }
+    for (int fd = 0; fd < nfds; fd++) {
+        short events = 0;
+
+        if ((readfds != NULL) && FD_ISSET(fd, readfds)) {
+            events |= POLLIN;
+        }
+        if ((writefds != NULL) && FD_ISSET(fd, writefds)) {
+            events |= POLLOUT;
+        }
+        if (events == 0) {
+            continue;
+        }
+        if (numof >= _ACTUAL_SOCKET_POOL_SIZE) {
+            /* can not be a socket, as there are not that many */
+            errno = EBADF;
+            return -1;
+        }
+        fds[numof].fd = fd;
+        fds[numof].events = events;
+        numof++;
+    }
+    if (timeout != NULL) {
+        if ((timeout->tv_sec < 0) || (timeout->tv_usec < 0)) {
+            errno = EINVAL;
+            return -1;
+        }
+        if ((uint32_t)timeout->tv_sec < ((SOCK_NO_TIMEOUT - 1) / US_PER_SEC)) {
+            timeout_us = (timeout->tv_sec * US_PER_SEC) + timeout->tv_usec;
+        }
+        else {
+            timeout_us = SOCK_NO_TIMEOUT - 1;
+        }
+    }
+    if (_poll(fds, numof, timeout_us) < 0) {
+        return -1;
+    }
+    for (nfds_t i = 0; i < numof; i++) {
+        if (fds[i].revents & POLLNVAL) {
+            errno = EBADF;
+            return -1;
+        }
+    }
+    /* only report the ready file descriptors */
+    for (nfds_t i = 0; i < numof; i++) {
+        int fd = fds[i].fd;
+
+        if (readfds != NULL) {
+            if (fds[i].revents & POLLIN) {
+                res++;
+            }
+            else {
+                FD_CLR(fd, readfds);
+            }
+        }
+        if (writefds != NULL) {
+            if (fds[i].revents & POLLOUT) {
+                res++;
+            }
+            else {
+                FD_CLR(fd, writefds);
+            }
+        }
+    }
+    if (errorfds != NULL) {
+        FD_ZERO(errorfds);
+    }
+    return res;
+}
+#endif
+
 /**
  * @}
  */
@@ -208,6 +208,15 @@ int _stats(void)
     printf("DAO-ACK   #bytes: %10" PRIu32 " / %-10" PRIu32 "  %10" PRIu32 " / %-10" PRIu32 "\n",
            gnrc_rpl_netstats.dao_ack_rx_ucast_bytes, gnrc_rpl_netstats.dao_ack_tx_ucast_bytes,
            gnrc_rpl_netstats.dao_ack_rx_mcast_bytes, gnrc_rpl_netstats.dao_ack_tx_mcast_bytes);
+    printf("DAO retransmitted: %" PRIu32 ", unacknowledged: %" PRIu32 ", merged: %" PRIu32
+           ", rejected: %" PRIu32 "\n",
+           gnrc_rpl_netstats.dao_retransmissions, gnrc_rpl_netstats.dao_ack_timeouts,
+           gnrc_rpl_netstats.dao_merged, gnrc_rpl_netstats.dao_rejected);
+    printf("Last %us         RX / TX\n", (unsigned)GNRC_RPL_NETSTATS_INTERVAL);
+    printf("all     #packets: %10" PRIu32 " / %-10" PRIu32 "\n",
+           gnrc_rpl_netstats.interval_rx_count, gnrc_rpl_netstats.interval_tx_count);
+    printf("all       #bytes: %10" PRIu32 " / %-10" PRIu32 "\n",
+           gnrc_rpl_netstats.interval_rx_bytes, gnrc_rpl_netstats.interval_tx_bytes);
     return 0;
 }
 #endif
@@ -272,9 +281,8 @@ int _gnrc_rpl_dodag_show(void)
                 gnrc_rpl_instances[i].mop, gnrc_rpl_instances[i].of->ocp,
                 gnrc_rpl_instances[i].min_hop_rank_inc, gnrc_rpl_instances[i].max_rank_inc);
 
-        tc = (((uint64_t) dodag->trickle.msg_timer.long_target << 32)
-                | dodag->trickle.msg_timer.target) - xnow;
-        tc = (int64_t) tc < 0 ? 0 : tc / US_PER_SEC;
+        tc = dodag->trickle.msg_time - (xnow / US_PER_MS);
+        tc = (int64_t) tc < 0 ? 0 : tc / MS_PER_SEC;
 
         cleanup = dodag->instance->cleanup < 0 ? 0 : dodag->instance->cleanup;
 
@@ -298,9 +306,10 @@ int _gnrc_rpl_dodag_show(void)
 
         gnrc_rpl_parent_t *parent;
         LL_FOREACH(gnrc_rpl_instances[i].dodag.parents, parent) {
-            printf("\t\tparent [addr: %s | rank: %d | lifetime: %" PRIu32 "s]\n",
+            printf("\t\tparent [addr: %s | rank: %d | lifetime: %" PRIu32 "s"
+                   " | link metric: %u]\n",
                     ipv6_addr_to_str(addr_str, &parent->addr, sizeof(addr_str)),
-                    parent->rank, parent->lifetime);
+                    parent->rank, parent->lifetime, (unsigned) parent->link_metric);
         }
     }
     return 0;
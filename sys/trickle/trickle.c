@@ -21,6 +21,9 @@
 #define ENABLE_DEBUG        (0)
 #include "debug.h"
 
+/* queue of all trickle timers */
+static evtimer_msg_t _evtimer;
+
 void trickle_callback(trickle_t *trickle)
 {
     /* Handle k=0 like k=infinity (according to RFC6206, section 6.5) */
@@ -51,9 +54,13 @@ void trickle_interval(trickle_t *trickle)
     /* old_interval == trickle->I / 2 */
     trickle->t = random_uint32_range(old_interval, trickle->I);
 
-    trickle->msg_time = (trickle->t + diff) * MS_PER_SEC;
-    xtimer_set_msg64(&trickle->msg_timer, trickle->msg_time, &trickle->msg,
-                     trickle->pid);
+    /* the event may still be queued if a reset raced with its expiry */
+    trickle_stop(trickle);
+    trickle->msg_event.event.offset = trickle->t + diff;
+    trickle->msg_event.msg.sender_pid = trickle->pid;
+    trickle->msg_time = (xtimer_now_usec64() / US_PER_MS) + trickle->t + diff;
+    trickle->msg_time += evtimer_add_coalesced(&_evtimer, &trickle->msg_event.event,
+                                               TRICKLE_TIMER_SLACK);
 }
 
 void trickle_reset_timer(trickle_t *trickle)
@@ -71,7 +78,9 @@ void trickle_start(kernel_pid_t pid, trickle_t *trickle, uint16_t msg_type,
     assert(Imin > 0);
     assert((Imin << Imax) < (UINT32_MAX / 2));
 
-    trickle->pid = pid;
+    if (_evtimer.callback == NULL) {
+        evtimer_init_msg(&_evtimer);
+    }
 
     trickle->c = 0;
     trickle->k = k;
@@ -80,15 +89,15 @@ void trickle_start(kernel_pid_t pid, trickle_t *trickle, uint16_t msg_type,
     trickle->I = trickle->t = random_uint32_range(trickle->Imin,
                                                   4 * trickle->Imin);
     trickle->pid = pid;
-    trickle->msg.content.ptr = trickle;
-    trickle->msg.type = msg_type;
+    trickle->msg_event.msg.content.ptr = trickle;
+    trickle->msg_event.msg.type = msg_type;
 
     trickle_interval(trickle);
 }
 
 void trickle_stop(trickle_t *trickle)
 {
-    xtimer_remove(&trickle->msg_timer);
+    evtimer_del(&_evtimer, &trickle->msg_event.event);
 }
 
 void trickle_increment_counter(trickle_t *trickle)
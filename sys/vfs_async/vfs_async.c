@@ -0,0 +1,216 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_vfs_async
+ * @{
+ *
+ * @file
+ * @brief       I/O worker thread of the asynchronous VFS
+ *
+ * The requests are queued as events in the queue of the worker thread. When
+ * a write is handled, the queue is searched for further writes to the same
+ * file descriptor. Requests for other file descriptors are skipped, the
+ * search stops at the first other request for the same file descriptor.
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include "irq.h"
+#include "thread.h"
+#include "thread_flags.h"
+#include "vfs.h"
+#include "vfs_async.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+static char _stack[VFS_ASYNC_STACK_SIZE];
+static kernel_pid_t _pid = KERNEL_PID_UNDEF;
+static event_queue_t _queue;
+
+/* only used by the worker thread */
+static uint8_t _merge_buf[VFS_ASYNC_MERGE_SIZE];
+
+typedef struct {
+    vfs_async_req_t *reqs[VFS_ASYNC_MERGE_NUMOF];
+    unsigned numof;
+    size_t len;
+} _batch_t;
+
+static void _complete(vfs_async_req_t *req, ssize_t res)
+{
+    req->res = res;
+    req->done = 1;
+    if (req->queue) {
+        event_post(req->queue, req->event);
+    }
+    else {
+        thread_flags_set(req->thread, THREAD_FLAG_VFS_ASYNC);
+    }
+}
+
+static int _collect(clist_node_t *node, void *arg)
+{
+    _batch_t *batch = arg;
+    vfs_async_req_t *req = (vfs_async_req_t *)node;
+
+    if (req->fd != batch->reqs[0]->fd) {
+        /* other file descriptors may be overtaken */
+        return 0;
+    }
+    if ((req->op != VFS_ASYNC_WRITE) ||
+        (batch->len + req->count > VFS_ASYNC_MERGE_SIZE)) {
+        return 1;
+    }
+    batch->reqs[batch->numof++] = req;
+    batch->len += req->count;
+    return (batch->numof == VFS_ASYNC_MERGE_NUMOF);
+}
+
+static void _write(vfs_async_req_t *req)
+{
+    _batch_t batch = { .reqs = { req }, .numof = 1, .len = req->count };
+
+    if (batch.len < VFS_ASYNC_MERGE_SIZE) {
+        unsigned state = irq_disable();
+        clist_foreach(&_queue.event_list, _collect, &batch);
+        for (unsigned i = 1; i < batch.numof; i++) {
+            clist_remove(&_queue.event_list, &batch.reqs[i]->super.list_node);
+            batch.reqs[i]->super.list_node.next = NULL;
+        }
+        irq_restore(state);
+    }
+
+    if (batch.numof == 1) {
+        _complete(req, vfs_write(req->fd, req->buf, req->count));
+        return;
+    }
+
+    DEBUG("vfs_async: merged %u writes to fd %d (%u bytes)\n", batch.numof,
+          req->fd, (unsigned)batch.len);
+    uint8_t *pos = _merge_buf;
+    for (unsigned i = 0; i < batch.numof; i++) {
+        memcpy(pos, batch.reqs[i]->buf, batch.reqs[i]->count);
+        pos += batch.reqs[i]->count;
+    }
+
+    ssize_t res = vfs_write(req->fd, _merge_buf, batch.len);
+
+    /* on short writes the bytes are accounted to the requests in order */
+    for (unsigned i = 0; i < batch.numof; i++) {
+        if (res < 0) {
+            _complete(batch.reqs[i], res);
+        }
+        else {
+            size_t count = batch.reqs[i]->count;
+
+            if (count > (size_t)res) {
+                count = res;
+            }
+            res -= count;
+            _complete(batch.reqs[i], count);
+        }
+    }
+}
+
+static void _handler(event_t *event)
+{
+    vfs_async_req_t *req = (vfs_async_req_t *)event;
+
+    switch (req->op) {
+        case VFS_ASYNC_READ:
+            _complete(req, vfs_read(req->fd, req->buf, req->count));
+            break;
+        case VFS_ASYNC_WRITE:
+            _write(req);
+            break;
+        case VFS_ASYNC_FSYNC:
+            _complete(req, vfs_fsync(req->fd));
+            break;
+    }
+}
+
+static void *_worker(void *arg)
+{
+    (void)arg;
+
+    while (1) {
+        event_t *event;
+
+        /* event_loop() can't be used, as merged writes are removed from the
+         * queue without clearing THREAD_FLAG_EVENT */
+        thread_flags_wait_any(THREAD_FLAG_EVENT);
+        while ((event = event_get(&_queue))) {
+            event->handler(event);
+        }
+    }
+    return NULL;
+}
+
+kernel_pid_t vfs_async_init(void)
+{
+    if (_pid != KERNEL_PID_UNDEF) {
+        return -EEXIST;
+    }
+    _pid = thread_create(_stack, sizeof(_stack), VFS_ASYNC_PRIO,
+                         THREAD_CREATE_STACKTEST, _worker, NULL, "vfs_async");
+    /* the worker may not run before the first request is posted */
+    memset(&_queue, 0, sizeof(_queue));
+    _queue.waiter = (thread_t *)thread_get(_pid);
+    return _pid;
+}
+
+void vfs_async_req_init(vfs_async_req_t *req, event_queue_t *queue,
+                        event_t *event)
+{
+    memset(req, 0, sizeof(*req));
+    req->super.handler = _handler;
+    req->queue = queue;
+    req->event = event;
+}
+
+static void _submit(vfs_async_req_t *req, vfs_async_op_t op, int fd,
+                    void *buf, size_t count)
+{
+    req->op = op;
+    req->fd = fd;
+    req->buf = buf;
+    req->count = count;
+    req->res = 0;
+    req->done = 0;
+    req->thread = (thread_t *)sched_active_thread;
+    event_post(&_queue, &req->super);
+}
+
+void vfs_async_read(vfs_async_req_t *req, int fd, void *dest, size_t count)
+{
+    _submit(req, VFS_ASYNC_READ, fd, dest, count);
+}
+
+void vfs_async_write(vfs_async_req_t *req, int fd, const void *src,
+                     size_t count)
+{
+    _submit(req, VFS_ASYNC_WRITE, fd, (void *)src, count);
+}
+
+void vfs_async_fsync(vfs_async_req_t *req, int fd)
+{
+    _submit(req, VFS_ASYNC_FSYNC, fd, NULL, 0);
+}
+
+ssize_t vfs_async_wait(vfs_async_req_t *req)
+{
+    while (!req->done) {
+        thread_flags_wait_any(THREAD_FLAG_VFS_ASYNC);
+    }
+    return req->res;
+}
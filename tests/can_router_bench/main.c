@@ -0,0 +1,128 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup tests
+ * @{
+ *
+ * @file
+ * @brief   CAN router frame rate benchmark
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <inttypes.h>
+
+#include "can/raw.h"
+#include "msg.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#ifndef FILTERS_NUMOF
+#define FILTERS_NUMOF   (256U)
+#endif
+
+#define MASKED_NUMOF    (4U)
+#define FRAMES_NUMOF    (20000U)
+#define FIRST_ID        (0x100U)
+#define RX_IFNUM        (0)
+#define TX_IFNUM        (1)
+#define RX_TIMEOUT      (US_PER_SEC)
+#define QUEUE_SIZE      (64U)
+
+static char _rx_stack[THREAD_STACKSIZE_DEFAULT];
+static msg_t _rx_queue[QUEUE_SIZE];
+static msg_t _main_queue[QUEUE_SIZE];
+static volatile unsigned _received;
+
+static void *_rx_thread(void *arg)
+{
+    (void)arg;
+    msg_t msg;
+
+    msg_init_queue(_rx_queue, QUEUE_SIZE);
+    while (1) {
+        msg_receive(&msg);
+        if (msg.type == CAN_MSG_RX_INDICATION) {
+            raw_can_free_frame(msg.content.ptr);
+            _received++;
+        }
+    }
+
+    return NULL;
+}
+
+static int _subscribe(kernel_pid_t pid)
+{
+    struct can_filter filter;
+
+    for (unsigned i = 0; i < FILTERS_NUMOF; i++) {
+        filter.can_id = FIRST_ID + i;
+        filter.can_mask = 0xFFFFFFFF;
+        if (raw_can_subscribe_rx(RX_IFNUM, &filter, pid, NULL) < 0) {
+            return -1;
+        }
+    }
+    /* masked filters that never match, checked for every frame */
+    for (unsigned i = 0; i < MASKED_NUMOF; i++) {
+        filter.can_id = CAN_EFF_FLAG | ((i + 1) << 20);
+        filter.can_mask = CAN_EFF_FLAG | 0x1FF00000;
+        if (raw_can_subscribe_rx(RX_IFNUM, &filter, pid, NULL) < 0) {
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+int main(void)
+{
+    struct can_frame frame = { .can_dlc = 8 };
+    kernel_pid_t rx_pid;
+    uint32_t start, end, elapsed;
+    msg_t msg;
+
+    msg_init_queue(_main_queue, QUEUE_SIZE);
+    rx_pid = thread_create(_rx_stack, sizeof(_rx_stack), THREAD_PRIORITY_MAIN - 1,
+                           THREAD_CREATE_STACKTEST, _rx_thread, NULL, "can_rx");
+    if (_subscribe(rx_pid) < 0) {
+        puts("[FAILED] could not subscribe");
+        return 1;
+    }
+    printf("Sending %u frames to %u single ID and %u masked filters\n",
+           FRAMES_NUMOF, FILTERS_NUMOF, MASKED_NUMOF);
+
+    start = xtimer_now_usec();
+    for (unsigned i = 0; i < FRAMES_NUMOF; i++) {
+        frame.can_id = FIRST_ID + (i % FILTERS_NUMOF);
+        frame.data[0] = i;
+        if (raw_can_send(TX_IFNUM, &frame, thread_getpid()) < 0) {
+            puts("[FAILED] could not send");
+            return 1;
+        }
+        /* wait for the confirmation, so the device queue never overflows */
+        do {
+            msg_receive(&msg);
+        } while ((msg.type != CAN_MSG_TX_CONFIRMATION) && (msg.type != CAN_MSG_TX_ERROR));
+    }
+    end = xtimer_now_usec();
+    /* give the receiver some time to catch up with the last frames */
+    for (uint32_t sent = end; (_received < FRAMES_NUMOF) &&
+         ((end - sent) < RX_TIMEOUT); end = xtimer_now_usec()) {
+        xtimer_usleep(1000);
+    }
+    elapsed = end - start;
+
+    printf("Received %u frames in %" PRIu32 " us: %" PRIu32 " frames/s\n",
+           _received, elapsed,
+           (uint32_t)(((uint64_t)_received * US_PER_SEC) / elapsed));
+    puts((_received == FRAMES_NUMOF) ? "[SUCCESS]" : "[FAILED]");
+
+    return 0;
+}
@@ -22,6 +22,8 @@
 #include "sdcard_spi_internal.h"
 #include "sdcard_spi_params.h"
 #include "fmt.h"
+#include "xtimer.h"
+#include <inttypes.h>
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
@@ -333,6 +335,62 @@ static int _copy(int argc, char **argv)
     return 0;
 }
 
+static void _print_rate(const char *name, int nblocks, uint32_t elapsed)
+{
+    uint32_t kib_s = ((uint64_t)nblocks * SD_HC_BLOCK_SIZE * US_PER_SEC) /
+                     (SDCARD_SPI_IEC_KIBI * (elapsed ? elapsed : 1));
+    printf("%s: %d blocks in %" PRIu32 " us: %" PRIu32 " KiB/s\n",
+           name, nblocks, elapsed, kib_s);
+}
+
+static int _bench(int argc, char **argv)
+{
+    int bladdr;
+    int nblocks;
+    sd_rw_response_t state;
+    uint32_t start;
+
+    if (argc != 3) {
+        printf("usage: %s blockaddr nblocks\n", argv[0]);
+        return -1;
+    }
+
+    bladdr = atoi(argv[1]);
+    nblocks = atoi(argv[2]);
+    memset(buffer, 0xA5, sizeof(buffer));
+
+    /* one transaction per block, like a block device layer without streaming */
+    start = xtimer_now_usec();
+    for (int i = 0; i < nblocks; i++) {
+        if (sdcard_spi_write_blocks(card, bladdr + i, buffer, SD_HC_BLOCK_SIZE, 1, &state) != 1) {
+            printf("write error %d (block %d)\n", state, bladdr + i);
+            return -1;
+        }
+    }
+    _print_rate("single block writes", nblocks, xtimer_now_usec() - start);
+
+    /* one multi-block write kept open across calls, with pre-erase hint */
+    start = xtimer_now_usec();
+    if (sdcard_spi_write_stream_start(card, bladdr, nblocks) != SD_RW_OK) {
+        puts("write stream start [FAILED]");
+        return -1;
+    }
+    for (int i = 0; i < nblocks; i += MAX_BLOCKS_IN_BUFFER) {
+        int n = (nblocks - i < MAX_BLOCKS_IN_BUFFER) ? (nblocks - i) : MAX_BLOCKS_IN_BUFFER;
+        if (sdcard_spi_write_stream(card, buffer, SD_HC_BLOCK_SIZE, n, &state) != n) {
+            printf("write error %d (block %d)\n", state, bladdr + i);
+            return -1;
+        }
+    }
+    state = sdcard_spi_stream_stop(card);
+    if (state != SD_RW_OK) {
+        printf("write stream stop error %d\n", state);
+        return -1;
+    }
+    _print_rate("streamed writes", nblocks, xtimer_now_usec() - start);
+    return 0;
+}
+
 static int _sector_count(int argc, char **argv)
 {
     printf("available sectors on card: %li\n", sdcard_spi_get_sector_count(card));
@@ -351,6 +409,8 @@ static const shell_command_t shell_commands[] = {
     { "write", "'write n data' writes data to block n. Append -r option to "
                "repeatedly write data to coplete block", _write },
     { "copy", "'copy src dst' copies block src to block dst", _copy },
+    { "bench", "'bench n m' measures sequential write bandwidth for m blocks starting "
+               "at block n", _bench },
     { NULL, NULL, NULL }
 };
 
@@ -361,7 +421,7 @@ int main(void)
     card->init_done = false;
 
     puts("insert SD-card and use 'init' command to set card to spi mode");
-    puts("WARNING: using 'write' or 'copy' commands WILL overwrite data on your sd-card and");
+    puts("WARNING: using 'write', 'copy' or 'bench' commands WILL overwrite data on your sd-card and");
     puts("almost for sure corrupt existing filesystems, partitions and contained data!");
     char line_buf[SHELL_DEFAULT_BUFSIZE];
     shell_run(shell_commands, line_buf, SHELL_DEFAULT_BUFSIZE);
@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup tests
+ * @{
+ *
+ * @file
+ * @brief    evtimer_add_coalesced() test application
+ *
+ * Event "b" expires within the slack before the already queued event "a" and
+ * must be handled together with it. Event "c" expires too early and event
+ * "d" has no later event to be deferred to, so both must expire on time.
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+
+#include "evtimer.h"
+#include "xtimer.h"
+
+#define SLACK           (10U)
+/* events handled by the same timer interrupt are this close at most */
+#define SAME_IRQ_US     (1000U)
+
+typedef struct {
+    evtimer_event_t event;
+    uint32_t fired;
+} test_event_t;
+
+static evtimer_t evtimer;
+static test_event_t a, b, c, d;
+
+static void _handler(evtimer_event_t *event)
+{
+    ((test_event_t *)event)->fired = xtimer_now_usec();
+}
+
+static int _check(const char *msg, int cond)
+{
+    if (!cond) {
+        printf("error: %s\n", msg);
+    }
+    return cond ? 0 : 1;
+}
+
+int main(void)
+{
+    uint32_t delay_b, delay_c, delay_d, start;
+    int errors = 0;
+
+    puts("evtimer_add_coalesced() test");
+    evtimer_init(&evtimer, _handler);
+
+    start = xtimer_now_usec();
+    a.event.offset = 100;
+    evtimer_add(&evtimer, &a.event);
+    b.event.offset = 95;
+    delay_b = evtimer_add_coalesced(&evtimer, &b.event, SLACK);
+    c.event.offset = 60;
+    delay_c = evtimer_add_coalesced(&evtimer, &c.event, SLACK);
+    d.event.offset = 200;
+    delay_d = evtimer_add_coalesced(&evtimer, &d.event, SLACK);
+
+    errors += _check("b not deferred", (delay_b > 0) && (delay_b <= SLACK));
+    errors += _check("b does not expire with a",
+                     evtimer_remaining(&evtimer, &a.event) ==
+                     evtimer_remaining(&evtimer, &b.event));
+    errors += _check("c deferred", delay_c == 0);
+    errors += _check("d deferred", delay_d == 0);
+
+    xtimer_usleep(300U * US_PER_MS);
+
+    errors += _check("an event did not fire",
+                     a.fired && b.fired && c.fired && d.fired);
+    errors += _check("a and b fired apart",
+                     (uint32_t)(b.fired - a.fired + SAME_IRQ_US) <
+                     (2 * SAME_IRQ_US));
+    errors += _check("c fired late",
+                     (c.fired - start) < ((95U - SLACK) * US_PER_MS));
+    errors += _check("c fired with a",
+                     (a.fired - c.fired) > (SLACK * US_PER_MS));
+    errors += _check("d fired with a",
+                     (d.fired - a.fired) > (SLACK * US_PER_MS));
+    printf("a: %" PRIu32 " us, b: %" PRIu32 " us, c: %" PRIu32 " us, "
+           "d: %" PRIu32 " us\n", a.fired - start, b.fired - start,
+           c.fired - start, d.fired - start);
+
+    puts(errors ? "[FAILED]" : "[SUCCESS]");
+    return 0;
+}
@@ -0,0 +1,256 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test for the GNRC implementation of TCP socks
+ *
+ * The connections are made over the IPv6 loopback address, so no network
+ * interface is needed.
+ *
+ * @}
+ */
+
+#include <assert.h>
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "mutex.h"
+#include "net/ipv6/addr.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/sock/tcp.h"
+#include "net/sock/tcp.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define _TEST_PORT          (0x4b1d)
+#define _TEST_TIMEOUT       (10U * US_PER_MS)
+#define _TEST_QUEUE_LEN     (2U)
+
+static char _disconnect_stack[THREAD_STACKSIZE_DEFAULT];
+static char _write_stack[THREAD_STACKSIZE_DEFAULT];
+static mutex_t _disconnected = MUTEX_INIT_LOCKED;
+static mutex_t _written = MUTEX_INIT_LOCKED;
+static char _test_buffer[16];
+static sock_tcp_queue_t _queue;
+static sock_tcp_t _queue_array[_TEST_QUEUE_LEN];
+static sock_tcp_t _client;
+static sock_tcp_t *_server;
+
+#define CALL(fn)            puts("Calling " # fn); set_up(); fn; tear_down()
+
+static void set_up(void)
+{
+    static const sock_tcp_ep_t local = { .family = AF_INET6,
+                                         .port = _TEST_PORT };
+
+    assert(0 == sock_tcp_listen(&_queue, &local, _queue_array,
+                                _TEST_QUEUE_LEN, 0));
+    _server = NULL;
+}
+
+static void *_disconnect(void *arg)
+{
+    sock_tcp_disconnect(arg);
+    mutex_unlock(&_disconnected);
+    return NULL;
+}
+
+/* closing blocks until both ends closed, so the server end is closed by
+ * another thread */
+static void _disconnect_both(void)
+{
+    thread_create(_disconnect_stack, sizeof(_disconnect_stack),
+                  THREAD_PRIORITY_MAIN - 1, THREAD_CREATE_STACKTEST,
+                  _disconnect, _server, "disconnect");
+    sock_tcp_disconnect(&_client);
+    mutex_lock(&_disconnected);
+    _server = NULL;
+}
+
+static void tear_down(void)
+{
+    if (_server != NULL) {
+        _disconnect_both();
+    }
+    sock_tcp_stop_listen(&_queue);
+}
+
+static void _connect(void)
+{
+    sock_tcp_ep_t remote = { .family = AF_INET6, .port = _TEST_PORT };
+
+    memcpy(remote.addr.ipv6, &ipv6_addr_loopback, sizeof(remote.addr.ipv6));
+
+    assert(0 == sock_tcp_connect(&_client, &remote, 0, 0));
+    /* the connection was established when connect returned */
+    assert(0 == sock_tcp_accept(&_queue, &_server, 0));
+    assert(_server != NULL);
+}
+
+static void test_sock_tcp_listen__EAFNOSUPPORT(void)
+{
+    static const sock_tcp_ep_t local = { .family = AF_INET,
+                                         .port = _TEST_PORT + 1 };
+    sock_tcp_queue_t queue;
+    sock_tcp_t array[1];
+
+    assert(-EAFNOSUPPORT == sock_tcp_listen(&queue, &local, array, 1, 0));
+}
+
+static void test_sock_tcp_listen__ENOMEM(void)
+{
+    static const sock_tcp_ep_t local = { .family = AF_INET6,
+                                         .port = _TEST_PORT + 1 };
+    static sock_tcp_t array[SOCK_TCP_QUEUE_MBOX_SIZE + 1];
+    sock_tcp_queue_t queue;
+
+    /* the listening queue is limited by SOCK_TCP_QUEUE_MBOX_SIZE */
+    assert(-ENOMEM == sock_tcp_listen(&queue, &local, array,
+                                      SOCK_TCP_QUEUE_MBOX_SIZE + 1, 0));
+}
+
+static void test_sock_tcp_accept__EAGAIN(void)
+{
+    assert(-EAGAIN == sock_tcp_accept(&_queue, &_server, 0));
+}
+
+static void test_sock_tcp_accept__ETIMEDOUT(void)
+{
+    uint32_t start = xtimer_now_usec();
+
+    assert(-ETIMEDOUT == sock_tcp_accept(&_queue, &_server, _TEST_TIMEOUT));
+    assert((xtimer_now_usec() - start) >= _TEST_TIMEOUT);
+}
+
+static void test_sock_tcp_connect__accept(void)
+{
+    sock_tcp_ep_t local, remote, queue_local;
+
+    _connect();
+    assert(0 == sock_tcp_get_local(&_client, &local));
+    assert(0 == sock_tcp_get_remote(&_client, &remote));
+    assert(AF_INET6 == remote.family);
+    assert(ipv6_addr_is_loopback((ipv6_addr_t *)&remote.addr.ipv6));
+    assert(_TEST_PORT == remote.port);
+    /* the ends of the connection match */
+    assert(0 == sock_tcp_get_local(_server, &remote));
+    assert(_TEST_PORT == remote.port);
+    assert(0 == sock_tcp_get_remote(_server, &remote));
+    assert(local.port == remote.port);
+    assert(0 == sock_tcp_queue_get_local(&_queue, &queue_local));
+    assert(_TEST_PORT == queue_local.port);
+}
+
+static void test_sock_tcp_read__EAGAIN(void)
+{
+    _connect();
+    assert(-EAGAIN == sock_tcp_read(_server, _test_buffer,
+                                    sizeof(_test_buffer), 0));
+}
+
+static void test_sock_tcp_read__ETIMEDOUT(void)
+{
+    uint32_t start;
+
+    _connect();
+    start = xtimer_now_usec();
+    assert(-ETIMEDOUT == sock_tcp_read(_server, _test_buffer,
+                                       sizeof(_test_buffer), _TEST_TIMEOUT));
+    assert((xtimer_now_usec() - start) >= _TEST_TIMEOUT);
+}
+
+static void test_sock_tcp_read_write(void)
+{
+    _connect();
+    /* write returns when the data was acknowledged, so it can be read */
+    assert(sizeof("ABCD") == sock_tcp_write(&_client, "ABCD", sizeof("ABCD")));
+    assert(sizeof("ABCD") == sock_tcp_read(_server, _test_buffer,
+                                           sizeof(_test_buffer),
+                                           SOCK_NO_TIMEOUT));
+    assert(memcmp(_test_buffer, "ABCD", sizeof("ABCD")) == 0);
+    assert(sizeof("EFG") == sock_tcp_write(_server, "EFG", sizeof("EFG")));
+    assert(sizeof("EFG") == sock_tcp_read(&_client, _test_buffer,
+                                          sizeof(_test_buffer),
+                                          _TEST_TIMEOUT));
+    assert(memcmp(_test_buffer, "EFG", sizeof("EFG")) == 0);
+}
+
+static void test_gnrc_sock_tcp_write_pkt(void)
+{
+    gnrc_pktsnip_t *pkt;
+
+    _connect();
+    pkt = gnrc_pktbuf_add(NULL, "HIJK", sizeof("HIJK"), GNRC_NETTYPE_UNDEF);
+    assert(pkt != NULL);
+    assert(sizeof("HIJK") == gnrc_sock_tcp_write_pkt(&_client, pkt));
+    assert(sizeof("HIJK") == sock_tcp_read(_server, _test_buffer,
+                                           sizeof(_test_buffer),
+                                           _TEST_TIMEOUT));
+    assert(memcmp(_test_buffer, "HIJK", sizeof("HIJK")) == 0);
+}
+
+static void *_delayed_write(void *arg)
+{
+    xtimer_usleep(_TEST_TIMEOUT);
+    assert(sizeof("LMNO") == sock_tcp_write(arg, "LMNO", sizeof("LMNO")));
+    mutex_unlock(&_written);
+    return NULL;
+}
+
+static void test_sock_tcp_read__no_timeout(void)
+{
+    uint32_t start;
+
+    _connect();
+    /* the writer has a lower priority than this thread, so it never runs if
+     * the read busy-waits instead of blocking */
+    thread_create(_write_stack, sizeof(_write_stack),
+                  THREAD_PRIORITY_MAIN + 1, THREAD_CREATE_STACKTEST,
+                  _delayed_write, _server, "write");
+    start = xtimer_now_usec();
+    assert(sizeof("LMNO") == sock_tcp_read(&_client, _test_buffer,
+                                           sizeof(_test_buffer),
+                                           SOCK_NO_TIMEOUT));
+    assert((xtimer_now_usec() - start) >= _TEST_TIMEOUT);
+    assert(memcmp(_test_buffer, "LMNO", sizeof("LMNO")) == 0);
+    mutex_lock(&_written);
+}
+
+static void test_sock_tcp_disconnect__listen_again(void)
+{
+    /* a sock of the queue listens again after it was disconnected, so more
+     * connections than socks in the queue can be accepted */
+    for (unsigned i = 0; i <= _TEST_QUEUE_LEN; i++) {
+        _connect();
+        _disconnect_both();
+    }
+}
+
+int main(void)
+{
+    CALL(test_sock_tcp_listen__EAFNOSUPPORT());
+    CALL(test_sock_tcp_listen__ENOMEM());
+    CALL(test_sock_tcp_accept__EAGAIN());
+    CALL(test_sock_tcp_accept__ETIMEDOUT());
+    CALL(test_sock_tcp_connect__accept());
+    CALL(test_sock_tcp_read__EAGAIN());
+    CALL(test_sock_tcp_read__ETIMEDOUT());
+    CALL(test_sock_tcp_read__no_timeout());
+    CALL(test_sock_tcp_read_write());
+    CALL(test_gnrc_sock_tcp_write_pkt());
+    CALL(test_sock_tcp_disconnect__listen_again());
+
+    puts("ALL TESTS SUCCESSFUL");
+
+    return 0;
+}
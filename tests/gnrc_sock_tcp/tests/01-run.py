@@ -0,0 +1,32 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2017 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import os
+import sys
+
+sys.path.append(os.path.join(os.environ['RIOTBASE'], 'dist/tools/testrunner'))
+import testrunner
+
+
+def testfunc(child):
+    child.expect_exact(u"Calling test_sock_tcp_listen__EAFNOSUPPORT()")
+    child.expect_exact(u"Calling test_sock_tcp_listen__ENOMEM()")
+    child.expect_exact(u"Calling test_sock_tcp_accept__EAGAIN()")
+    child.expect_exact(u"Calling test_sock_tcp_accept__ETIMEDOUT()")
+    child.expect_exact(u"Calling test_sock_tcp_connect__accept()")
+    child.expect_exact(u"Calling test_sock_tcp_read__EAGAIN()")
+    child.expect_exact(u"Calling test_sock_tcp_read__ETIMEDOUT()")
+    child.expect_exact(u"Calling test_sock_tcp_read__no_timeout()")
+    child.expect_exact(u"Calling test_sock_tcp_read_write()")
+    child.expect_exact(u"Calling test_gnrc_sock_tcp_write_pkt()")
+    child.expect_exact(u"Calling test_sock_tcp_disconnect__listen_again()")
+    child.expect_exact(u"ALL TESTS SUCCESSFUL")
+
+
+if __name__ == "__main__":
+    sys.exit(testrunner.run(testfunc))
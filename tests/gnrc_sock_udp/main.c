@@ -22,6 +22,7 @@
 #include <stdint.h>
 #include <stdio.h>
 
+#include "net/sock/async_event.h"
 #include "net/sock/udp.h"
 #include "xtimer.h"
 
@@ -32,6 +33,8 @@
 
 static uint8_t _test_buffer[_TEST_BUFFER_SIZE];
 static sock_udp_t _sock, _sock2;
+static event_queue_t _ev_queue;
+static unsigned _ev_flags;
 
 #define CALL(fn)            puts("Calling " # fn); fn; tear_down()
 
@@ -379,6 +382,38 @@ static void test_sock_udp_recv__non_blocking(void)
     assert(_check_net());
 }
 
+static void test_sock_udp_recv_batch(void)
+{
+    static const ipv6_addr_t src_addr = { .u8 = _TEST_ADDR_REMOTE };
+    static const ipv6_addr_t dst_addr = { .u8 = _TEST_ADDR_LOCAL };
+    static const sock_udp_ep_t local = { .family = AF_INET6,
+                                         .port = _TEST_PORT_LOCAL };
+    static char buf[3][sizeof("EFGH")];
+    sock_udp_msg_t msgs[3];
+
+    for (unsigned i = 0; i < 3; i++) {
+        msgs[i].data = buf[i];
+        msgs[i].len = sizeof(buf[i]);
+    }
+    assert(0 == sock_udp_create(&_sock, &local, NULL, SOCK_FLAGS_REUSE_EP));
+    assert(_inject_packet(&src_addr, &dst_addr, _TEST_PORT_REMOTE,
+                          _TEST_PORT_LOCAL, "ABCD", sizeof("ABCD"),
+                          _TEST_NETIF));
+    assert(_inject_packet(&src_addr, &dst_addr, _TEST_PORT_REMOTE + 1,
+                          _TEST_PORT_LOCAL, "EFG", sizeof("EFG"),
+                          _TEST_NETIF));
+    assert(2 == sock_udp_recv_batch(&_sock, msgs, 3, 0));
+    assert(sizeof("ABCD") == msgs[0].len);
+    assert(memcmp("ABCD", buf[0], sizeof("ABCD")) == 0);
+    assert(_TEST_PORT_REMOTE == msgs[0].remote.port);
+    assert(sizeof("EFG") == msgs[1].len);
+    assert(memcmp("EFG", buf[1], sizeof("EFG")) == 0);
+    assert(_TEST_PORT_REMOTE + 1 == msgs[1].remote.port);
+    assert(memcmp(&msgs[1].remote.addr, &src_addr, sizeof(src_addr)) == 0);
+    assert(-EAGAIN == sock_udp_recv_batch(&_sock, msgs, 3, 0));
+    assert(_check_net());
+}
+
 static void test_sock_udp_send__EAFNOSUPPORT(void)
 {
     static const sock_udp_ep_t remote = { .addr = { .ipv6 = _TEST_ADDR_REMOTE },
@@ -651,6 +686,120 @@ static void test_sock_udp_send__no_sock(void)
     assert(_check_net());
 }
 
+static void test_sock_udp_send_batch(void)
+{
+    static const ipv6_addr_t src_addr = { .u8 = _TEST_ADDR_LOCAL };
+    static const ipv6_addr_t dst_addr = { .u8 = _TEST_ADDR_REMOTE };
+    static const sock_udp_ep_t local = { .addr = { .ipv6 = _TEST_ADDR_LOCAL },
+                                         .family = AF_INET6,
+                                         .netif = _TEST_NETIF,
+                                         .port = _TEST_PORT_LOCAL };
+    static const sock_udp_ep_t remote = { .addr = { .ipv6 = _TEST_ADDR_REMOTE },
+                                          .family = AF_INET6,
+                                          .port = _TEST_PORT_REMOTE };
+    static const sock_udp_msg_t msgs[] = {
+        { .data = "ABCD", .len = sizeof("ABCD") },
+        { .data = "EFG", .len = sizeof("EFG") },
+    };
+
+    assert(0 == sock_udp_create(&_sock, &local, NULL, SOCK_FLAGS_REUSE_EP));
+    assert(2 == sock_udp_send_batch(&_sock, msgs, 2, &remote));
+    assert(_check_packet(&src_addr, &dst_addr, _TEST_PORT_LOCAL,
+                         _TEST_PORT_REMOTE, "ABCD", sizeof("ABCD"),
+                         _TEST_NETIF, false));
+    assert(_check_packet(&src_addr, &dst_addr, _TEST_PORT_LOCAL,
+                         _TEST_PORT_REMOTE, "EFG", sizeof("EFG"),
+                         _TEST_NETIF, false));
+    xtimer_usleep(1000);    /* let GNRC stack finish */
+    assert(_check_net());
+}
+
+static void _event_handler(sock_udp_t *sock, sock_async_flags_t flags,
+                           void *arg)
+{
+    assert(sock == &_sock);
+    assert(arg == &_ev_queue);
+    _ev_flags |= flags;
+}
+
+/* handles the queued event of the sock, returns false if there was none */
+static bool _handle_event(void)
+{
+    event_t *ev = event_get(&_ev_queue);
+
+    _ev_flags = 0;
+    if (ev == NULL) {
+        return false;
+    }
+    ev->handler(ev);
+    return true;
+}
+
+static void test_sock_udp_event__recv(void)
+{
+    static const ipv6_addr_t src_addr = { .u8 = _TEST_ADDR_REMOTE };
+    static const ipv6_addr_t dst_addr = { .u8 = _TEST_ADDR_LOCAL };
+    static const sock_udp_ep_t local = { .family = AF_INET6,
+                                         .port = _TEST_PORT_LOCAL };
+
+    assert(0 == sock_udp_create(&_sock, &local, NULL, SOCK_FLAGS_REUSE_EP));
+    event_queue_init(&_ev_queue);
+    sock_udp_event_init(&_sock, &_ev_queue, _event_handler, &_ev_queue);
+    assert(!_handle_event());
+    assert(_inject_packet(&src_addr, &dst_addr, _TEST_PORT_REMOTE,
+                          _TEST_PORT_LOCAL, "ABCD", sizeof("ABCD"),
+                          _TEST_NETIF));
+    assert(_inject_packet(&src_addr, &dst_addr, _TEST_PORT_REMOTE,
+                          _TEST_PORT_LOCAL, "EFG", sizeof("EFG"),
+                          _TEST_NETIF));
+    /* both packets are reported by a single event */
+    assert(_handle_event());
+    assert(SOCK_ASYNC_MSG_RECV == _ev_flags);
+    assert(!_handle_event());
+    assert(sizeof("ABCD") == sock_udp_recv(&_sock, _test_buffer,
+                                           sizeof(_test_buffer), 0, NULL));
+    assert(sizeof("EFG") == sock_udp_recv(&_sock, _test_buffer,
+                                          sizeof(_test_buffer), 0, NULL));
+    assert(-EAGAIN == sock_udp_recv(&_sock, _test_buffer,
+                                    sizeof(_test_buffer), 0, NULL));
+    sock_event_close(sock_udp_get_async_ctx(&_sock));
+    assert(_check_net());
+}
+
+static void test_sock_udp_event__send(void)
+{
+    static const ipv6_addr_t src_addr = { .u8 = _TEST_ADDR_LOCAL };
+    static const ipv6_addr_t dst_addr = { .u8 = _TEST_ADDR_REMOTE };
+    static const sock_udp_ep_t local = { .addr = { .ipv6 = _TEST_ADDR_LOCAL },
+                                         .family = AF_INET6,
+                                         .netif = _TEST_NETIF,
+                                         .port = _TEST_PORT_LOCAL };
+    static const sock_udp_ep_t remote = { .addr = { .ipv6 = _TEST_ADDR_REMOTE },
+                                          .family = AF_INET6,
+                                          .port = _TEST_PORT_REMOTE };
+
+    assert(0 == sock_udp_create(&_sock, &local, &remote, SOCK_FLAGS_REUSE_EP));
+    event_queue_init(&_ev_queue);
+    sock_udp_event_init(&_sock, &_ev_queue, _event_handler, &_ev_queue);
+    assert(sizeof("ABCD") == sock_udp_send(&_sock, "ABCD", sizeof("ABCD"),
+                                           NULL));
+    assert(_handle_event());
+    assert(SOCK_ASYNC_MSG_SENT == _ev_flags);
+    assert(_check_packet(&src_addr, &dst_addr, _TEST_PORT_LOCAL,
+                         _TEST_PORT_REMOTE, "ABCD", sizeof("ABCD"),
+                         _TEST_NETIF, false));
+    /* an event that is closed while queued is not handled */
+    assert(sizeof("ABCD") == sock_udp_send(&_sock, "ABCD", sizeof("ABCD"),
+                                           NULL));
+    sock_event_close(sock_udp_get_async_ctx(&_sock));
+    assert(!_handle_event());
+    assert(_check_packet(&src_addr, &dst_addr, _TEST_PORT_LOCAL,
+                         _TEST_PORT_REMOTE, "ABCD", sizeof("ABCD"),
+                         _TEST_NETIF, false));
+    xtimer_usleep(1000);    /* let GNRC stack finish */
+    assert(_check_net());
+}
+
 int main(void)
 {
     _net_init();
@@ -680,6 +829,7 @@ int main(void)
     CALL(test_sock_udp_recv__unsocketed_with_remote());
     CALL(test_sock_udp_recv__with_timeout());
     CALL(test_sock_udp_recv__non_blocking());
+    CALL(test_sock_udp_recv_batch());
     _prepare_send_checks();
     CALL(test_sock_udp_send__EAFNOSUPPORT());
     CALL(test_sock_udp_send__EINVAL_addr());
@@ -697,6 +847,9 @@ int main(void)
     CALL(test_sock_udp_send__unsocketed());
     CALL(test_sock_udp_send__no_sock_no_netif());
     CALL(test_sock_udp_send__no_sock());
+    CALL(test_sock_udp_send_batch());
+    CALL(test_sock_udp_event__recv());
+    CALL(test_sock_udp_event__send());
 
     puts("ALL TESTS SUCCESSFUL");
 
@@ -53,6 +53,8 @@ def testfunc(child):
     child.expect_exact(u"Calling test_sock_udp_send__unsocketed()")
     child.expect_exact(u"Calling test_sock_udp_send__no_sock_no_netif()")
     child.expect_exact(u"Calling test_sock_udp_send__no_sock()")
+    child.expect_exact(u"Calling test_sock_udp_event__recv()")
+    child.expect_exact(u"Calling test_sock_udp_event__send()")
     child.expect_exact(u"ALL TESTS SUCCESSFUL")
 
 if __name__ == "__main__":
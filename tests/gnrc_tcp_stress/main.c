@@ -0,0 +1,206 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup tests
+ * @{
+ *
+ * @file
+ * @brief   GNRC TCP stress test with many simultaneous connections
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <stdio.h>
+#include <inttypes.h>
+#include <string.h>
+
+#include "mbox.h"
+#include "msg.h"
+#include "net/af.h"
+#include "net/ipv6/addr.h"
+#include "net/gnrc/tcp.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#ifndef CONNS
+#define CONNS           (64U)
+#endif
+
+#ifndef WORKERS
+#define WORKERS         (4U)
+#endif
+
+#define PORT            (8080U)
+#define ROUNDS          (16U)
+#define CHUNK_SIZE      (GNRC_TCP_MSS)
+/* must be a power of two */
+#define ACCEPT_QUEUE    (64U)
+
+static gnrc_tcp_tcb_t _clients[CONNS];
+static gnrc_tcp_tcb_t _servers[CONNS];
+/* server end of every client */
+static gnrc_tcp_tcb_t *_peers[CONNS];
+static msg_t _accept_queue[ACCEPT_QUEUE];
+static mbox_t _accept_mbox;
+static uint8_t _payload[WORKERS][CHUNK_SIZE];
+static uint8_t _rx_buf[WORKERS][CHUNK_SIZE];
+static char _stacks[WORKERS][THREAD_STACKSIZE_DEFAULT];
+static kernel_pid_t _main_pid;
+
+static int _open(void)
+{
+    const ipv6_addr_t loopback = IPV6_ADDR_LOOPBACK;
+    msg_t msg;
+
+    mbox_init(&_accept_mbox, _accept_queue, ACCEPT_QUEUE);
+    for (unsigned i = 0; i < CONNS; i++) {
+        gnrc_tcp_tcb_init(&_servers[i]);
+        if (gnrc_tcp_listen(&_servers[i], AF_INET6, NULL, PORT, &_accept_mbox) < 0) {
+            puts("[FAILED] could not listen");
+            return -1;
+        }
+    }
+    for (unsigned i = 0; i < CONNS; i++) {
+        gnrc_tcp_tcb_init(&_clients[i]);
+        if (gnrc_tcp_open_active(&_clients[i], AF_INET6, loopback.u8, PORT, 0) < 0) {
+            printf("[FAILED] could not connect #%u\n", i);
+            return -1;
+        }
+    }
+    /* pair every client with the server TCB that accepted it */
+    for (unsigned i = 0; i < CONNS; i++) {
+        gnrc_tcp_tcb_t *server;
+
+        mbox_get(&_accept_mbox, &msg);
+        server = msg.content.ptr;
+        for (unsigned j = 0; j < CONNS; j++) {
+            if (_clients[j].local_port == server->peer_port) {
+                _peers[j] = server;
+                break;
+            }
+        }
+    }
+    for (unsigned i = 0; i < CONNS; i++) {
+        if (_peers[i] == NULL) {
+            printf("[FAILED] connection #%u was not accepted\n", i);
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+static int _transfer(unsigned worker, unsigned conn, unsigned round)
+{
+    uint8_t *payload = _payload[worker];
+    uint8_t *rx_buf = _rx_buf[worker];
+    size_t sent = 0, rcvd = 0;
+
+    payload[0] = conn;
+    payload[1] = round;
+    while (sent < CHUNK_SIZE) {
+        ssize_t res = gnrc_tcp_send(&_clients[conn], payload + sent,
+                                    CHUNK_SIZE - sent, 0);
+
+        if (res < 0) {
+            printf("[FAILED] send on #%u: %d\n", conn, (int)res);
+            return -1;
+        }
+        sent += res;
+    }
+    /* the segments were acknowledged, so their data is already buffered */
+    while (rcvd < CHUNK_SIZE) {
+        ssize_t res = gnrc_tcp_recv(_peers[conn], rx_buf + rcvd,
+                                    CHUNK_SIZE - rcvd, 0);
+
+        if (res < 0) {
+            printf("[FAILED] recv on #%u: %d\n", conn, (int)res);
+            return -1;
+        }
+        rcvd += res;
+    }
+    if (memcmp(rx_buf, payload, CHUNK_SIZE)) {
+        printf("[FAILED] invalid data on #%u\n", conn);
+        return -1;
+    }
+
+    return 0;
+}
+
+/* every worker transfers over every WORKERS-th connection */
+static void *_worker(void *arg)
+{
+    unsigned worker = (unsigned)(uintptr_t)arg;
+    msg_t msg = { .content = { .value = 0 } };
+
+    for (unsigned i = 0; i < CHUNK_SIZE; i++) {
+        _payload[worker][i] = i * 7;
+    }
+    for (unsigned round = 0; round < ROUNDS; round++) {
+        for (unsigned i = worker; i < CONNS; i += WORKERS) {
+            if (_transfer(worker, i, round) < 0) {
+                msg.content.value = 1;
+                break;
+            }
+        }
+    }
+    msg_send(&msg, _main_pid);
+    return NULL;
+}
+
+int main(void)
+{
+    uint32_t start, elapsed;
+    uint64_t bytes = (uint64_t)CONNS * ROUNDS * CHUNK_SIZE;
+    /* the workers' stacks and buffers are shared by all connections */
+    unsigned worker_mem = sizeof(_stacks) + sizeof(_payload) + sizeof(_rx_buf);
+    unsigned failed = 0;
+    msg_t msg;
+
+    printf("Memory per connection end: %u bytes TCB + %u bytes receive "
+           "buffer\n", (unsigned)sizeof(gnrc_tcp_tcb_t),
+           (unsigned)GNRC_TCP_RCV_BUF_SIZE);
+    printf("Memory of %u workers: %u bytes stacks and buffers, %u bytes per "
+           "connection\n", WORKERS, worker_mem, worker_mem / CONNS);
+
+    start = xtimer_now_usec();
+    if (_open() < 0) {
+        return 1;
+    }
+    elapsed = xtimer_now_usec() - start;
+    printf("Opened %u connections in %" PRIu32 " us\n", CONNS, elapsed);
+
+    _main_pid = thread_getpid();
+    start = xtimer_now_usec();
+    for (unsigned i = 0; i < WORKERS; i++) {
+        thread_create(_stacks[i], sizeof(_stacks[i]), THREAD_PRIORITY_MAIN + 1,
+                      THREAD_CREATE_STACKTEST, _worker, (void *)(uintptr_t)i,
+                      "worker");
+    }
+    for (unsigned i = 0; i < WORKERS; i++) {
+        msg_receive(&msg);
+        failed += msg.content.value;
+    }
+    if (failed) {
+        return 1;
+    }
+    elapsed = xtimer_now_usec() - start;
+    printf("%u connections, %u workers: %" PRIu32 " bytes in %" PRIu32
+           " us: %" PRIu32 " bytes/s\n", CONNS, WORKERS, (uint32_t)bytes,
+           elapsed, (uint32_t)((bytes * US_PER_SEC) / elapsed));
+
+    for (unsigned i = 0; i < CONNS; i++) {
+        gnrc_tcp_abort(&_clients[i]);
+        gnrc_tcp_abort(&_servers[i]);
+    }
+    puts("[SUCCESS]");
+
+    return 0;
+}
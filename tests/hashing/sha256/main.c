@@ -40,6 +40,13 @@ const uint16_t hashbitlen = 256;
 /* Array with the lengths of the messages to be hashed */
 const size_t databytelens[] = { 64, 100, 1024, 10240 };
 
+/* Length and number of the messages for the throughput benchmark */
+#define THROUGHPUT_LEN      (1024U)
+#define THROUGHPUT_RUNS     (64U)
+
+/* Messages for the throughput benchmark, one per lane of sha256_multi() */
+static char throughput_data[SHA256_MULTI_LANES][THROUGHPUT_LEN];
+
 typedef struct {
     sha256_context_t* ctx;
     char* data;
@@ -224,6 +231,51 @@ void sha256_benchmark(size_t databytelen, char* datastring) {
 
 }
 
+static void print_throughput(const char *name, uint32_t elapsed)
+{
+    uint64_t bytes = (uint64_t)THROUGHPUT_RUNS * SHA256_MULTI_LANES * THROUGHPUT_LEN;
+
+    printf("\t%s: %" PRIu32 " us, %" PRIu32 " bytes/s\n", name, elapsed,
+           (uint32_t)((bytes * US_PER_SEC) / elapsed));
+}
+
+/* Throughput of hashing the messages one by one and side by side */
+void sha256_throughput_benchmark(void)
+{
+    const void *data[SHA256_MULTI_LANES];
+    size_t len[SHA256_MULTI_LANES];
+    char hashval[SHA256_MULTI_LANES][SHA256_DIGEST_LENGTH];
+    void *digest[SHA256_MULTI_LANES];
+    uint32_t start, elapsed;
+
+    printf("Measure throughput of SHA-256 for %u messages of %u bytes.\n",
+           SHA256_MULTI_LANES, THROUGHPUT_LEN);
+    for (unsigned i = 0; i < SHA256_MULTI_LANES; i++) {
+        for (unsigned j = 0; j < THROUGHPUT_LEN; j++) {
+            throughput_data[i][j] = random_uint32_range(0x00, 0xff);
+        }
+        data[i] = throughput_data[i];
+        len[i] = THROUGHPUT_LEN;
+        digest[i] = hashval[i];
+    }
+
+    start = xtimer_now_usec();
+    for (unsigned r = 0; r < THROUGHPUT_RUNS; r++) {
+        for (unsigned i = 0; i < SHA256_MULTI_LANES; i++) {
+            sha256(data[i], len[i], digest[i]);
+        }
+    }
+    elapsed = xtimer_now_usec() - start;
+    print_throughput("sha256()", elapsed);
+
+    start = xtimer_now_usec();
+    for (unsigned r = 0; r < THROUGHPUT_RUNS; r++) {
+        sha256_multi(data, len, digest, SHA256_MULTI_LANES);
+    }
+    elapsed = xtimer_now_usec() - start;
+    print_throughput("sha256_multi()", elapsed);
+}
+
 int main(void) {
 
     printf( "\n\nMeasure performance of SHA256 in ticks needed to calculate "
@@ -247,6 +299,8 @@ int main(void) {
 
     }
 
+    sha256_throughput_benchmark();
+
     printf("\n\nAll benchmarks finished!\n\n");
 
     return 0;
@@ -0,0 +1,91 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup tests
+ * @{
+ *
+ * @file
+ * @brief   Internet Checksum throughput benchmark
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <inttypes.h>
+
+#include "net/inet_csum.h"
+#include "xtimer.h"
+
+#define BUF_LEN         (1280U)
+#define RUNS            (1000U)
+
+static uint8_t _buf[BUF_LEN + 1];
+
+/* byte-wise reference, as inet_csum() was implemented before */
+static uint16_t _ref_csum(uint16_t sum, const uint8_t *buf, uint16_t len)
+{
+    uint32_t csum = sum;
+
+    for (unsigned i = 0; i < len; i++) {
+        csum += (i & 1) ? buf[i] : (buf[i] << 8);
+    }
+    while (csum >> 16) {
+        csum = (csum & 0xffff) + (csum >> 16);
+    }
+    return csum;
+}
+
+static uint32_t _bench(const char *name, const uint8_t *buf,
+                       uint16_t (*csum)(uint16_t, const uint8_t *, uint16_t))
+{
+    uint32_t start, time;
+    uint16_t sum = 0;
+
+    start = xtimer_now_usec();
+    for (unsigned i = 0; i < RUNS; i++) {
+        sum = csum(sum, buf, BUF_LEN);
+    }
+    time = xtimer_now_usec() - start;
+    printf("%s: %" PRIu32 " us for %u x %u bytes (sum 0x%04x)\n", name, time,
+           RUNS, BUF_LEN, sum);
+    return time;
+}
+
+static uint16_t _inet_csum(uint16_t sum, const uint8_t *buf, uint16_t len)
+{
+    return inet_csum(sum, buf, len);
+}
+
+int main(void)
+{
+    uint32_t ref, aligned, unaligned;
+
+    puts("inet_csum benchmark");
+
+    for (unsigned i = 0; i < sizeof(_buf); i++) {
+        _buf[i] = (uint8_t)((i * 131U) ^ (i >> 3));
+    }
+    if ((inet_csum(0, _buf, BUF_LEN) != _ref_csum(0, _buf, BUF_LEN)) ||
+        (inet_csum(0, &_buf[1], BUF_LEN) != _ref_csum(0, &_buf[1], BUF_LEN))) {
+        puts("checksums differ");
+        puts("[FAILED]");
+        return 1;
+    }
+
+    ref = _bench("byte-wise          ", _buf, _ref_csum);
+    aligned = _bench("inet_csum          ", _buf, _inet_csum);
+    unaligned = _bench("inet_csum unaligned", &_buf[1], _inet_csum);
+
+    if ((aligned > ref) || (unaligned > ref)) {
+        puts("[FAILED]");
+        return 1;
+    }
+    puts("[SUCCESS]");
+    return 0;
+}
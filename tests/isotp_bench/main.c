@@ -0,0 +1,165 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup tests
+ * @{
+ *
+ * @file
+ * @brief   ISO-TP throughput benchmark
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include "can/isotp.h"
+#include "msg.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define TRANSFERS_NUMOF (32U)
+#define PAYLOAD_SIZE    (4095U)
+#define RX_IFNUM        (0)
+#define TX_IFNUM        (1)
+#define RX_ID           (0x7E0U)
+#define TX_ID           (0x7E8U)
+#define RX_BS           (16U)
+#define RX_STMIN        (0U)
+#define TIMEOUT         (5U * US_PER_SEC)
+#define QUEUE_SIZE      (16U)
+
+static msg_t _main_queue[QUEUE_SIZE];
+static uint8_t _payload[PAYLOAD_SIZE];
+static uint8_t _rx_buf[2][PAYLOAD_SIZE / 2 + 1];
+static const struct iovec _rx_iov[] = {
+    { .iov_base = _rx_buf[0], .iov_len = sizeof(_rx_buf[0]) },
+    { .iov_base = _rx_buf[1], .iov_len = sizeof(_rx_buf[1]) },
+};
+static struct isotp _sender, _receiver;
+
+static int _bind(struct isotp *isotp, int ifnum, canid_t tx_id, canid_t rx_id,
+                 uint16_t flags)
+{
+    can_reg_entry_t entry = { .ifnum = ifnum };
+
+    entry.target.pid = thread_getpid();
+    memset(isotp, 0, sizeof(*isotp));
+    isotp->opt.tx_id = tx_id;
+    isotp->opt.rx_id = rx_id;
+    isotp->opt.flags = flags;
+
+    return isotp_bind(isotp, &entry, isotp);
+}
+
+static int _check(const can_rx_data_t *rx)
+{
+    size_t len = sizeof(_rx_buf[0]);
+
+    if ((rx->data.iov_base != NULL) || (rx->data.iov_len != PAYLOAD_SIZE)) {
+        return -1;
+    }
+    if (memcmp(_rx_buf[0], _payload, len) ||
+        memcmp(_rx_buf[1], &_payload[len], PAYLOAD_SIZE - len)) {
+        return -1;
+    }
+
+    return 0;
+}
+
+static int _transfer(void)
+{
+    unsigned pending = 2;
+    msg_t msg;
+
+    if (isotp_send(&_sender, _payload, PAYLOAD_SIZE, 0) < 0) {
+        return -1;
+    }
+    while (pending) {
+        if (xtimer_msg_receive_timeout(&msg, TIMEOUT) < 0) {
+            puts("timeout");
+            return -1;
+        }
+        switch (msg.type) {
+            case CAN_MSG_TX_CONFIRMATION:
+                pending--;
+                break;
+            case CAN_MSG_RX_INDICATION: {
+                can_rx_data_t *rx = msg.content.ptr;
+                int res = _check(rx);
+
+                isotp_free_rx(rx);
+                if (res < 0) {
+                    puts("invalid data received");
+                    return -1;
+                }
+                pending--;
+                break;
+            }
+            case CAN_MSG_TX_ERROR:
+                puts("transmission failed");
+                return -1;
+            default:
+                break;
+        }
+    }
+
+    return 0;
+}
+
+static int _run(const char *name, uint16_t flags)
+{
+    uint32_t start, elapsed;
+    int res = 0;
+
+    if ((_bind(&_receiver, RX_IFNUM, TX_ID, RX_ID, 0) < 0) ||
+        (_bind(&_sender, TX_IFNUM, RX_ID, TX_ID, flags) < 0)) {
+        puts("[FAILED] could not bind");
+        return -1;
+    }
+    _receiver.rxfc.bs = RX_BS;
+    _receiver.rxfc.stmin = RX_STMIN;
+    isotp_set_rx_iov(&_receiver, _rx_iov, sizeof(_rx_iov) / sizeof(_rx_iov[0]));
+
+    start = xtimer_now_usec();
+    for (unsigned i = 0; (i < TRANSFERS_NUMOF) && (res == 0); i++) {
+        _payload[0] = i;
+        res = _transfer();
+    }
+    elapsed = xtimer_now_usec() - start;
+
+    isotp_release(&_sender);
+    isotp_release(&_receiver);
+    if (res < 0) {
+        printf("[FAILED] %s\n", name);
+        return -1;
+    }
+    printf("%s: %u x %u bytes in %" PRIu32 " us: %" PRIu32 " bytes/s\n",
+           name, TRANSFERS_NUMOF, PAYLOAD_SIZE, elapsed,
+           (uint32_t)(((uint64_t)TRANSFERS_NUMOF * PAYLOAD_SIZE * US_PER_SEC) / elapsed));
+
+    return 0;
+}
+
+int main(void)
+{
+    msg_init_queue(_main_queue, QUEUE_SIZE);
+    for (unsigned i = 0; i < PAYLOAD_SIZE; i++) {
+        _payload[i] = i * 7;
+    }
+
+    if ((_run("default", 0) < 0) ||
+        (_run("high throughput", CAN_ISOTP_HIGH_THROUGHPUT) < 0)) {
+        return 1;
+    }
+    puts("[SUCCESS]");
+
+    return 0;
+}
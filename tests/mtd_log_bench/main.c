@@ -0,0 +1,234 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Compares the append-only record log with SPIFFS
+ *
+ * RECORDS sensor records are stored on the emulated flash of native, once
+ * with mtd_log_append() and once with vfs_write() and vfs_fsync() to a file
+ * on SPIFFS, so every record is on the flash before the next one is taken in
+ * both cases. The flash latency model of mtd_native is configured in the
+ * Makefile. The image is memory mapped by the `mtd_native_mmap` module, so
+ * no host system calls are measured, and it is written to the host with
+ * mtd_native_flush() after each run. The test prints the mean and the
+ * worst-case time per record and the time to find a record by its time
+ * stamp.
+ *
+ * @}
+ */
+
+#include <fcntl.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "board.h"
+#include "fs/spiffs_fs.h"
+#include "mtd.h"
+#include "mtd_log.h"
+#include "mtd_native.h"
+#include "vfs.h"
+#include "xtimer.h"
+
+#define RECORDS         (1024U)
+#define RECORD_SIZE     (32U)
+#define LOG_NUMOF       (32U)
+
+typedef struct {
+    uint32_t total;
+    uint32_t worst;
+    uint32_t seek;
+} result_t;
+
+static uint8_t record[RECORD_SIZE];
+static mtd_log_sector_t sectors[LOG_NUMOF];
+
+static mtd_log_t log_store = {
+    .first_sector = 0,
+    .sector_numof = LOG_NUMOF,
+    .sectors = sectors,
+};
+
+static struct spiffs_desc spiffs_desc = {
+    .lock = MUTEX_INIT,
+};
+
+static vfs_mount_t spiffs_mount = {
+    .fs = &spiffs_file_system,
+    .mount_point = "/spiffs",
+    .private_data = &spiffs_desc,
+};
+
+static void _erase_all(void)
+{
+    mtd_dev_t *dev = MTD_0;
+
+    mtd_init(dev);
+    mtd_erase(dev, 0, dev->sector_count * dev->pages_per_sector *
+              dev->page_size);
+}
+
+static int _flush(void)
+{
+    return mtd_native_flush((mtd_native_dev_t *)MTD_0);
+}
+
+static void _fill(uint32_t i)
+{
+    memset(record, i, sizeof(record));
+    memcpy(record, &i, sizeof(i));
+}
+
+static uint32_t _index(void)
+{
+    uint32_t i;
+
+    memcpy(&i, record, sizeof(i));
+    return i;
+}
+
+static void _update(result_t *res, uint32_t start)
+{
+    uint32_t time = xtimer_now_usec() - start;
+
+    if (time > res->worst) {
+        res->worst = time;
+    }
+    res->total += time;
+}
+
+static void _print(const char *name, const result_t *res)
+{
+    printf("%s: %" PRIu32 " us per record, worst case %" PRIu32 " us, "
+           "seek %" PRIu32 " us\n", name, res->total / RECORDS, res->worst,
+           res->seek);
+}
+
+static int _bench_log(result_t *res)
+{
+    mtd_log_iter_t iter;
+    uint32_t time;
+    unsigned count = 0;
+
+    log_store.mtd = MTD_0;
+    if (mtd_log_mount(&log_store) < 0) {
+        return -1;
+    }
+    for (unsigned i = 0; i < RECORDS; i++) {
+        uint32_t start = xtimer_now_usec();
+
+        _fill(i);
+        if (mtd_log_append(&log_store, i, record, sizeof(record)) < 0) {
+            return -1;
+        }
+        _update(res, start);
+    }
+
+    uint32_t start = xtimer_now_usec();
+    if (mtd_log_iter_seek(&log_store, &iter, RECORDS / 2) < 0) {
+        return -1;
+    }
+    res->seek = xtimer_now_usec() - start;
+
+    while (mtd_log_iter_next(&log_store, &iter, record, sizeof(record),
+                             &time) == RECORD_SIZE) {
+        if ((time != RECORDS / 2 + count) || (_index() != time)) {
+            return -1;
+        }
+        count++;
+    }
+    return (count == RECORDS / 2) ? 0 : -1;
+}
+
+/* SPIFFS has no time index, the records are searched by bisection */
+static int _seek_spiffs(int fd, uint32_t time)
+{
+    unsigned lo = 0, hi = RECORDS;
+
+    while (lo < hi) {
+        unsigned mid = (lo + hi) / 2;
+
+        vfs_lseek(fd, mid * RECORD_SIZE, SEEK_SET);
+        if (vfs_read(fd, record, sizeof(record)) != RECORD_SIZE) {
+            return -1;
+        }
+        if (_index() < time) {
+            lo = mid + 1;
+        }
+        else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+static int _bench_spiffs(result_t *res)
+{
+#if SPIFFS_HAL_CALLBACK_EXTRA == 1
+    spiffs_desc.dev = MTD_0;
+#endif
+    if (vfs_mount(&spiffs_mount) < 0) {
+        return -1;
+    }
+    int fd = vfs_open("/spiffs/log", O_CREAT | O_RDWR | O_APPEND, 0);
+    if (fd < 0) {
+        return -1;
+    }
+    for (unsigned i = 0; i < RECORDS; i++) {
+        uint32_t start = xtimer_now_usec();
+
+        _fill(i);
+        if ((vfs_write(fd, record, sizeof(record)) != RECORD_SIZE) ||
+            (vfs_fsync(fd) < 0)) {
+            return -1;
+        }
+        _update(res, start);
+    }
+
+    uint32_t start = xtimer_now_usec();
+    int pos = _seek_spiffs(fd, RECORDS / 2);
+    res->seek = xtimer_now_usec() - start;
+
+    vfs_close(fd);
+    vfs_umount(&spiffs_mount);
+    return (pos == RECORDS / 2) ? 0 : -1;
+}
+
+int main(void)
+{
+    result_t log_res = { 0 }, spiffs_res = { 0 };
+
+    puts("mtd_log benchmark");
+
+    _erase_all();
+    if ((_bench_log(&log_res) < 0) || (_flush() < 0)) {
+        puts("mtd_log failed");
+        puts("[FAILED]");
+        return 1;
+    }
+    _print("mtd_log", &log_res);
+
+    _erase_all();
+    if ((_bench_spiffs(&spiffs_res) < 0) || (_flush() < 0)) {
+        puts("SPIFFS failed");
+        puts("[FAILED]");
+        return 1;
+    }
+    _print("SPIFFS ", &spiffs_res);
+
+    if (log_res.total > spiffs_res.total) {
+        puts("[FAILED]");
+        return 1;
+    }
+    puts("[SUCCESS]");
+    return 0;
+}
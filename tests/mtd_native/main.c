@@ -0,0 +1,148 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test for the memory mapped flash emulation of native
+ *
+ * The image file is removed before the test, so mtd_init() has to create
+ * and erase it. After mtd_native_flush() the file is read back on the host.
+ *
+ * @}
+ */
+
+#include <assert.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "board.h"
+#include "mtd.h"
+#include "mtd_native.h"
+
+#include "native_internal.h"
+
+#define CALL(fn)            puts("Calling " # fn); fn
+
+static mtd_dev_t *_dev;
+static uint32_t _sector_size;
+static uint8_t _buf[64];
+static uint8_t _check[sizeof(_buf)];
+
+static void test_mtd_native_init(void)
+{
+    _dev = MTD_0;
+    _sector_size = _dev->pages_per_sector * _dev->page_size;
+
+    real_unlink(MTD_NATIVE_FILENAME);
+    assert(0 == mtd_init(_dev));
+    /* a second init keeps the mapping */
+    assert(0 == mtd_init(_dev));
+
+    /* a new image is erased */
+    assert(sizeof(_check) == mtd_read(_dev, _check, 0, sizeof(_check)));
+    for (unsigned i = 0; i < sizeof(_check); i++) {
+        assert(0xff == _check[i]);
+    }
+    assert(sizeof(_check) == mtd_read(_dev, _check,
+                                      _dev->sector_count * _sector_size -
+                                      sizeof(_check), sizeof(_check)));
+    for (unsigned i = 0; i < sizeof(_check); i++) {
+        assert(0xff == _check[i]);
+    }
+}
+
+static void test_mtd_native_write__unaligned(void)
+{
+    for (unsigned i = 0; i < sizeof(_buf); i++) {
+        _buf[i] = i;
+    }
+    /* neither the start nor the end are word aligned */
+    assert(sizeof(_buf) - 6 == mtd_write(_dev, &_buf[3], 3,
+                                         sizeof(_buf) - 6));
+    assert(sizeof(_check) == mtd_read(_dev, _check, 0, sizeof(_check)));
+    assert(0xff == _check[0]);
+    assert(0 == memcmp(&_buf[3], &_check[3], sizeof(_buf) - 6));
+    assert(0xff == _check[sizeof(_check) - 1]);
+}
+
+static void test_mtd_native_write__clears_bits(void)
+{
+    uint32_t addr = _sector_size;
+
+    /* programming can only clear bits, like on NOR flash */
+    memset(_buf, 0xf0, sizeof(_buf));
+    assert(sizeof(_buf) == mtd_write(_dev, _buf, addr, sizeof(_buf)));
+    memset(_buf, 0x3c, sizeof(_buf));
+    assert(sizeof(_buf) == mtd_write(_dev, _buf, addr, sizeof(_buf)));
+    assert(sizeof(_check) == mtd_read(_dev, _check, addr, sizeof(_check)));
+    for (unsigned i = 0; i < sizeof(_check); i++) {
+        assert(0x30 == _check[i]);
+    }
+}
+
+static void test_mtd_native_write__EOVERFLOW(void)
+{
+    assert(-EOVERFLOW == mtd_write(_dev, _buf, _sector_size - 1, 2));
+    assert(-EOVERFLOW == mtd_write(_dev, _buf,
+                                   _dev->sector_count * _sector_size, 1));
+    assert(-EOVERFLOW == mtd_erase(_dev, 1, _sector_size));
+}
+
+static void test_mtd_native_erase(void)
+{
+    assert(0 == mtd_erase(_dev, _sector_size, _sector_size));
+    assert(sizeof(_check) == mtd_read(_dev, _check, _sector_size,
+                                      sizeof(_check)));
+    for (unsigned i = 0; i < sizeof(_check); i++) {
+        assert(0xff == _check[i]);
+    }
+    /* the sector before is untouched */
+    assert(sizeof(_check) == mtd_read(_dev, _check, 0, sizeof(_check)));
+    assert((0xff == _check[0]) && (3 == _check[3]));
+}
+
+static void test_mtd_native_flush(void)
+{
+    int fd;
+
+    for (unsigned i = 0; i < sizeof(_buf); i++) {
+        _buf[i] = ~i;
+    }
+    assert(sizeof(_buf) == mtd_write(_dev, _buf, 2 * _sector_size,
+                                     sizeof(_buf)));
+    assert(0 == mtd_native_flush((mtd_native_dev_t *)_dev));
+
+    fd = real_open(MTD_NATIVE_FILENAME, O_RDONLY);
+    assert(fd >= 0);
+    assert((off_t)(_dev->sector_count * _sector_size) ==
+           real_lseek(fd, 0, SEEK_END));
+    assert((off_t)(2 * _sector_size) ==
+           real_lseek(fd, 2 * _sector_size, SEEK_SET));
+    assert(sizeof(_check) == real_read(fd, _check, sizeof(_check)));
+    real_close(fd);
+    assert(0 == memcmp(_buf, _check, sizeof(_buf)));
+}
+
+int main(void)
+{
+    CALL(test_mtd_native_init());
+    CALL(test_mtd_native_write__unaligned());
+    CALL(test_mtd_native_write__clears_bits());
+    CALL(test_mtd_native_write__EOVERFLOW());
+    CALL(test_mtd_native_erase());
+    CALL(test_mtd_native_flush());
+
+    puts("ALL TESTS SUCCESSFUL");
+
+    return 0;
+}
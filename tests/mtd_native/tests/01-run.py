@@ -0,0 +1,27 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2017 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import os
+import sys
+
+sys.path.append(os.path.join(os.environ['RIOTBASE'], 'dist/tools/testrunner'))
+import testrunner
+
+
+def testfunc(child):
+    child.expect_exact(u"Calling test_mtd_native_init()")
+    child.expect_exact(u"Calling test_mtd_native_write__unaligned()")
+    child.expect_exact(u"Calling test_mtd_native_write__clears_bits()")
+    child.expect_exact(u"Calling test_mtd_native_write__EOVERFLOW()")
+    child.expect_exact(u"Calling test_mtd_native_erase()")
+    child.expect_exact(u"Calling test_mtd_native_flush()")
+    child.expect_exact(u"ALL TESTS SUCCESSFUL")
+
+
+if __name__ == "__main__":
+    sys.exit(testrunner.run(testfunc))
@@ -0,0 +1,267 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test for poll(), select() and O_NONBLOCK on sockets
+ *
+ * The datagrams are sent to the IPv6 loopback address, so no network
+ * interface is needed.
+ *
+ * @}
+ */
+
+#include <assert.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+
+#include "msg.h"
+#include "thread.h"
+#include "vfs.h"
+#include "xtimer.h"
+
+#define _TEST_PORT          (0x4b1d)
+#define _TEST_DATA          "test data"
+#define _TEST_DELAY         (100U * US_PER_MS)
+#define _TEST_TIMEOUT_MS    (1000)
+
+static char _sender_stack[THREAD_STACKSIZE_DEFAULT];
+static char _poller_stack[THREAD_STACKSIZE_DEFAULT];
+static kernel_pid_t _main_pid;
+static char _buf[sizeof(_TEST_DATA)];
+static int _recv_fd = -1, _send_fd = -1;
+
+#define CALL(fn)            puts("Calling " # fn); set_up(); fn; tear_down()
+
+static void set_up(void)
+{
+    struct sockaddr_in6 addr = { .sin6_family = AF_INET6,
+                                 .sin6_port = htons(_TEST_PORT) };
+
+    memcpy(&addr.sin6_addr, &in6addr_loopback, sizeof(addr.sin6_addr));
+    _recv_fd = socket(AF_INET6, SOCK_DGRAM, 0);
+    assert(_recv_fd >= 0);
+    assert(bind(_recv_fd, (struct sockaddr *)&addr, sizeof(addr)) == 0);
+    _send_fd = socket(AF_INET6, SOCK_DGRAM, 0);
+    assert(_send_fd >= 0);
+}
+
+static void tear_down(void)
+{
+    close(_recv_fd);
+    close(_send_fd);
+    _recv_fd = _send_fd = -1;
+}
+
+static void _send(void)
+{
+    struct sockaddr_in6 addr = { .sin6_family = AF_INET6,
+                                 .sin6_port = htons(_TEST_PORT) };
+
+    memcpy(&addr.sin6_addr, &in6addr_loopback, sizeof(addr.sin6_addr));
+    assert(sendto(_send_fd, _TEST_DATA, sizeof(_TEST_DATA), 0,
+                  (struct sockaddr *)&addr, sizeof(addr)) ==
+           sizeof(_TEST_DATA));
+}
+
+static void _recv(void)
+{
+    assert(recv(_recv_fd, _buf, sizeof(_buf), 0) == sizeof(_TEST_DATA));
+    assert(memcmp(_buf, _TEST_DATA, sizeof(_TEST_DATA)) == 0);
+}
+
+static void *_sender(void *arg)
+{
+    (void)arg;
+    xtimer_usleep(_TEST_DELAY);
+    _send();
+    return NULL;
+}
+
+/* polls the receiving socket next to the main thread and reports if the
+ * datagram was seen */
+static void *_poller(void *arg)
+{
+    struct pollfd fds[] = { { .fd = _recv_fd, .events = POLLIN } };
+    msg_t msg;
+
+    (void)arg;
+    msg.content.value = (poll(fds, 1, _TEST_TIMEOUT_MS) == 1) &&
+                        (fds[0].revents == POLLIN);
+    msg_send(&msg, _main_pid);
+    return NULL;
+}
+
+static void test_poll__timeout(void)
+{
+    struct pollfd fds[] = { { .fd = _recv_fd, .events = POLLIN } };
+    uint32_t start = xtimer_now_usec();
+
+    assert(poll(fds, 1, 0) == 0);
+    assert(fds[0].revents == 0);
+    assert(poll(fds, 1, _TEST_DELAY / US_PER_MS) == 0);
+    assert(fds[0].revents == 0);
+    assert((xtimer_now_usec() - start) >= _TEST_DELAY);
+}
+
+static void test_poll__pollin(void)
+{
+    struct pollfd fds[] = { { .fd = _recv_fd, .events = POLLIN } };
+
+    _send();
+    assert(poll(fds, 1, _TEST_TIMEOUT_MS) == 1);
+    assert(fds[0].revents == POLLIN);
+    _recv();
+    /* the datagram was consumed */
+    assert(poll(fds, 1, 0) == 0);
+}
+
+static void test_poll__pollout(void)
+{
+    struct pollfd fds[] = { { .fd = _recv_fd, .events = POLLIN | POLLOUT },
+                            { .fd = -1, .events = POLLIN } };
+
+    /* sending never blocks for datagram sockets, negative fds are ignored */
+    assert(poll(fds, 2, 0) == 1);
+    assert(fds[0].revents == POLLOUT);
+    assert(fds[1].revents == 0);
+}
+
+static void test_poll__wakeup(void)
+{
+    struct pollfd fds[] = { { .fd = _recv_fd, .events = POLLIN } };
+
+    thread_create(_sender_stack, sizeof(_sender_stack),
+                  THREAD_PRIORITY_MAIN - 1, THREAD_CREATE_STACKTEST,
+                  _sender, NULL, "sender");
+    /* blocks until the datagram of the sender arrives */
+    assert(poll(fds, 1, -1) == 1);
+    assert(fds[0].revents == POLLIN);
+    _recv();
+}
+
+static void test_poll__two_pollers(void)
+{
+    struct pollfd fds[] = { { .fd = _recv_fd, .events = POLLIN } };
+    msg_t msg;
+
+    _main_pid = thread_getpid();
+    /* has a higher priority, so it waits in poll() before the main thread */
+    thread_create(_poller_stack, sizeof(_poller_stack),
+                  THREAD_PRIORITY_MAIN - 1, THREAD_CREATE_STACKTEST,
+                  _poller, NULL, "poller");
+    thread_create(_sender_stack, sizeof(_sender_stack),
+                  THREAD_PRIORITY_MAIN - 1, THREAD_CREATE_STACKTEST,
+                  _sender, NULL, "sender");
+    /* both threads are woken up by the same datagram */
+    assert(poll(fds, 1, _TEST_TIMEOUT_MS) == 1);
+    assert(fds[0].revents == POLLIN);
+    msg_receive(&msg);
+    assert(msg.content.value == 1);
+    _recv();
+}
+
+static void test_poll__POLLNVAL(void)
+{
+    struct pollfd fds[] = { { .fd = _recv_fd, .events = POLLIN },
+                            { .fd = _send_fd + 16, .events = POLLIN } };
+
+    assert(poll(fds, 2, 0) == 1);
+    assert(fds[0].revents == 0);
+    assert(fds[1].revents == POLLNVAL);
+}
+
+static void test_poll__EOPNOTSUPP(void)
+{
+    int fd = socket(AF_INET6, SOCK_STREAM, 0);
+    struct pollfd fds[] = { { .fd = fd, .events = POLLIN } };
+    fd_set readfds;
+
+    assert(fd >= 0);
+    /* readiness of stream sockets is not supported */
+    assert(poll(fds, 1, 0) == -1);
+    assert(errno == EOPNOTSUPP);
+    FD_ZERO(&readfds);
+    FD_SET(fd, &readfds);
+    assert(select(fd + 1, &readfds, NULL, NULL, NULL) == -1);
+    assert(errno == EOPNOTSUPP);
+    close(fd);
+}
+
+static void test_select__timeout(void)
+{
+    struct timeval timeout = { .tv_usec = _TEST_DELAY };
+    fd_set readfds;
+
+    FD_ZERO(&readfds);
+    FD_SET(_recv_fd, &readfds);
+    assert(select(_recv_fd + 1, &readfds, NULL, NULL, &timeout) == 0);
+    assert(!FD_ISSET(_recv_fd, &readfds));
+}
+
+static void test_select__readable(void)
+{
+    struct timeval timeout = { .tv_sec = _TEST_TIMEOUT_MS / MS_PER_SEC };
+    fd_set readfds, writefds;
+    int nfds = ((_recv_fd > _send_fd) ? _recv_fd : _send_fd) + 1;
+
+    _send();
+    FD_ZERO(&readfds);
+    FD_SET(_recv_fd, &readfds);
+    FD_SET(_send_fd, &readfds);
+    FD_ZERO(&writefds);
+    FD_SET(_send_fd, &writefds);
+    assert(select(nfds, &readfds, &writefds, NULL, &timeout) == 2);
+    assert(FD_ISSET(_recv_fd, &readfds));
+    assert(!FD_ISSET(_send_fd, &readfds));
+    assert(FD_ISSET(_send_fd, &writefds));
+    _recv();
+}
+
+static void test_nonblock__EAGAIN(void)
+{
+    assert(vfs_fcntl(_recv_fd, F_SETFL, O_NONBLOCK) == 0);
+    assert(vfs_fcntl(_recv_fd, F_GETFL, 0) & O_NONBLOCK);
+    assert(recv(_recv_fd, _buf, sizeof(_buf), 0) == -1);
+    assert(errno == EAGAIN);
+    _send();
+    xtimer_usleep(_TEST_DELAY);
+    _recv();
+    assert(recv(_recv_fd, _buf, sizeof(_buf), 0) == -1);
+    assert(errno == EAGAIN);
+}
+
+int main(void)
+{
+    CALL(test_poll__timeout());
+    CALL(test_poll__pollin());
+    CALL(test_poll__pollout());
+    CALL(test_poll__wakeup());
+    CALL(test_poll__two_pollers());
+    CALL(test_poll__POLLNVAL());
+    CALL(test_poll__EOPNOTSUPP());
+    CALL(test_select__timeout());
+    CALL(test_select__readable());
+    CALL(test_nonblock__EAGAIN());
+
+    puts("ALL TESTS SUCCESSFUL");
+
+    return 0;
+}
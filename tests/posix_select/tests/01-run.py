@@ -0,0 +1,31 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2017 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import os
+import sys
+
+sys.path.append(os.path.join(os.environ['RIOTBASE'], 'dist/tools/testrunner'))
+import testrunner
+
+
+def testfunc(child):
+    child.expect_exact(u"Calling test_poll__timeout()")
+    child.expect_exact(u"Calling test_poll__pollin()")
+    child.expect_exact(u"Calling test_poll__pollout()")
+    child.expect_exact(u"Calling test_poll__wakeup()")
+    child.expect_exact(u"Calling test_poll__two_pollers()")
+    child.expect_exact(u"Calling test_poll__POLLNVAL()")
+    child.expect_exact(u"Calling test_poll__EOPNOTSUPP()")
+    child.expect_exact(u"Calling test_select__timeout()")
+    child.expect_exact(u"Calling test_select__readable()")
+    child.expect_exact(u"Calling test_nonblock__EAGAIN()")
+    child.expect_exact(u"ALL TESTS SUCCESSFUL")
+
+
+if __name__ == "__main__":
+    sys.exit(testrunner.run(testfunc))
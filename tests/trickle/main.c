@@ -30,6 +30,10 @@
 #define TR_REDCONST     (10)
 #define FIRST_ROUND     (5)
 #define SECOND_ROUND    (12)
+#define COALESCE_TRIES  (32)
+/* messages sent by the same timer interrupt are received this close at most */
+#define SAME_IRQ_US     (1000U)
+#define MSG_QUEUE_SIZE  (4)
 
 static uint32_t prev_now = 0, prev_diff = 0;
 static bool error = false;
@@ -55,12 +59,50 @@ static void callback(void *args)
 
 static trickle_t trickle = { .callback.func = &callback,
                              .callback.args = NULL };
+static trickle_t trickle2 = { .callback.func = &callback,
+                              .callback.args = NULL };
+static msg_t msg_queue[MSG_QUEUE_SIZE];
+
+/* Resets both trickle timers until the interval of the second is deferred to
+ * end together with the first one, which both must then signal at once */
+static int coalesce(void)
+{
+    msg_t msg;
+    uint32_t received[2];
+    unsigned tries = 0;
+
+    trickle_start(sched_active_pid, &trickle2, TRICKLE_MSG, TR_IMIN,
+                  TR_IDOUBLINGS, TR_REDCONST);
+    do {
+        if (++tries > COALESCE_TRIES) {
+            return -1;
+        }
+        trickle_reset_timer(&trickle);
+        trickle_reset_timer(&trickle2);
+    } while (trickle.msg_time != trickle2.msg_time);
+
+    for (unsigned i = 0; i < 2; i++) {
+        msg_receive(&msg);
+        received[i] = xtimer_now_usec();
+        if (msg.type != TRICKLE_MSG) {
+            return -1;
+        }
+    }
+    trickle_stop(&trickle);
+    trickle_stop(&trickle2);
+
+    printf("coalesced after %u tries, diff = %" PRIu32 "\n", tries,
+           received[1] - received[0]);
+
+    return ((received[1] - received[0]) < SAME_IRQ_US) ? 0 : -1;
+}
 
 int main(void)
 {
     msg_t msg;
     unsigned counter = 0;
 
+    msg_init_queue(msg_queue, MSG_QUEUE_SIZE);
     trickle_start(sched_active_pid, &trickle, TRICKLE_MSG, TR_IMIN,
                   TR_IDOUBLINGS, TR_REDCONST);
 
@@ -73,6 +115,10 @@ int main(void)
             puts("[TRICKLE_RESET]");
         }
         else if (counter == SECOND_ROUND) {
+            puts("[TRICKLE_COALESCE]");
+            if (coalesce() < 0) {
+                break;
+            }
             puts("[SUCCESS]");
             return 0;
         }
@@ -23,6 +23,8 @@ def testfunc(child):
     for i in range(7):
         child.expect(u"now = \d+, prev_now = \d+, diff = \d+")
 
+    child.expect_exact("[TRICKLE_COALESCE]")
+    child.expect(u"coalesced after \d+ tries, diff = \d+")
     child.expect_exact("[SUCCESS]")
 
 if __name__ == "__main__":
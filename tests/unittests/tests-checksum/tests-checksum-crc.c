@@ -0,0 +1,206 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "embUnit/embUnit.h"
+#include "xtimer.h"
+
+#include "checksum/crc.h"
+#include "checksum/crc16_ccitt.h"
+#include "checksum/ucrc16.h"
+
+#include "tests-checksum.h"
+
+#define CRC32_POLY          (0xedb88320)
+#define CRC32C_POLY         (0x82f63b78)
+#define CRC16_KERMIT_POLY   (0x8408)
+
+#define TEST_LEN            (300U)
+#define BENCH_LEN           (1024U)
+#define BENCH_RUNS          (64U)
+
+static const uint8_t check[] = "123456789";
+static uint8_t data[BENCH_LEN];
+static crc_table_t table;
+
+static void set_up(void)
+{
+    for (unsigned i = 0; i < sizeof(data); i++) {
+        data[i] = (i * 7) ^ (i >> 8);
+    }
+}
+
+/* bit-wise reference implementation */
+static uint32_t crc_reference(uint32_t poly, uint32_t crc, const uint8_t *buf,
+                              size_t len)
+{
+    while (len--) {
+        crc ^= *buf++;
+        for (unsigned bit = 0; bit < 8; bit++) {
+            crc = (crc >> 1) ^ ((crc & 1) ? poly : 0);
+        }
+    }
+    return crc;
+}
+
+static void test_checksum_crc32_check(void)
+{
+    TEST_ASSERT_EQUAL_INT(0, crc32_calc(check, 0));
+    TEST_ASSERT(0xcbf43926 == crc32_calc(check, sizeof(check) - 1));
+}
+
+static void test_checksum_crc32c_check(void)
+{
+    TEST_ASSERT_EQUAL_INT(0, crc32c_calc(check, 0));
+    TEST_ASSERT(0xe3069283 == crc32c_calc(check, sizeof(check) - 1));
+}
+
+static void test_checksum_crc16_kermit_check(void)
+{
+    TEST_ASSERT_EQUAL_INT(0, crc16_kermit_calc(check, 0));
+    TEST_ASSERT_EQUAL_INT(0x2189, crc16_kermit_calc(check, sizeof(check) - 1));
+}
+
+static void test_checksum_crc16_kermit_ieee802154_frame(void)
+{
+    /* same frame as in the ucrc16 tests */
+    uint8_t buf[] = { 0x41, 0xcc, 0xa4, 0xff, 0xff, 0x8a, 0x18, 0x00,
+                      0xff, 0xff, 0xda, 0x1c, 0x00, 0x88, 0x18, 0x00,
+                      0xff, 0xff, 0xda, 0x1c, 0x00, 0x41, 0x60, 0x00,
+                      0x00, 0x00, 0x00, 0x19, 0x11, 0x40, 0xfe, 0x80,
+                      0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1c,
+                      0xda, 0xff, 0xff, 0x00, 0x18, 0x88, 0xfe, 0x80,
+                      0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1c,
+                      0xda, 0xff, 0xff, 0x00, 0x18, 0x8a, 0x04, 0x01,
+                      0xf0, 0xb1, 0x00, 0x19, 0xea, 0x8a, 0x48, 0x65,
+                      0x6c, 0x6c, 0x6f, 0x20, 0x30, 0x30, 0x33, 0x20,
+                      0x30, 0x78, 0x43, 0x35, 0x39, 0x41, 0x0a };
+
+    TEST_ASSERT_EQUAL_INT(0x31f9, crc16_kermit_calc(buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL_INT(ucrc16_calc_le(buf, sizeof(buf),
+                                         UCRC16_CCITT_POLY_LE, 0),
+                          crc16_kermit_calc(buf, sizeof(buf)));
+}
+
+/* all lengths and alignments, so that every tail of the slicing is hit */
+static void test_checksum_crc_reference(void)
+{
+    for (unsigned off = 0; off < 8; off++) {
+        for (unsigned len = 0; len < TEST_LEN; len++) {
+            const uint8_t *buf = &data[off];
+
+            TEST_ASSERT(crc32_calc(buf, len) ==
+                        ~crc_reference(CRC32_POLY, 0xffffffff, buf, len));
+            TEST_ASSERT(crc32c_calc(buf, len) ==
+                        ~crc_reference(CRC32C_POLY, 0xffffffff, buf, len));
+            TEST_ASSERT(crc16_kermit_calc(buf, len) ==
+                        crc_reference(CRC16_KERMIT_POLY, 0, buf, len));
+        }
+    }
+}
+
+static void test_checksum_crc_incremental(void)
+{
+    uint32_t crc32 = crc32_calc(data, TEST_LEN);
+    uint32_t crc32c = crc32c_calc(data, TEST_LEN);
+    uint16_t crc16 = crc16_kermit_calc(data, TEST_LEN);
+
+    for (unsigned split = 0; split <= TEST_LEN; split++) {
+        size_t rest = TEST_LEN - split;
+
+        TEST_ASSERT(crc32 == crc32_update(crc32_calc(data, split),
+                                          &data[split], rest));
+        TEST_ASSERT(crc32c == crc32c_update(crc32c_calc(data, split),
+                                            &data[split], rest));
+        TEST_ASSERT_EQUAL_INT(crc16,
+                              crc16_kermit_update(crc16_kermit_calc(data, split),
+                                                  &data[split], rest));
+    }
+}
+
+static void test_checksum_crc_custom_table(void)
+{
+    /* CRC-16/ARC, reflected 0x8005 */
+    crc_table_init(&table, 0xa001);
+    TEST_ASSERT_EQUAL_INT(0xbb3d, crc_update(&table, 0, check,
+                                             sizeof(check) - 1));
+
+    crc_table_init(&table, CRC32_POLY);
+    TEST_ASSERT(crc32_calc(data, TEST_LEN) ==
+                ~crc_update(&table, 0xffffffff, data, TEST_LEN));
+}
+
+static void _print(const char *name, uint32_t elapsed)
+{
+    uint32_t rate = ((uint64_t)BENCH_RUNS * BENCH_LEN * US_PER_SEC) / elapsed;
+
+    printf("\n%s: %u x %u bytes in %" PRIu32 " us: %" PRIu32 ".%03"
+           PRIu32 " MB/s\n", name, BENCH_RUNS, BENCH_LEN, elapsed,
+           rate / 1000000, (rate / 1000) % 1000);
+}
+
+static void test_checksum_crc_throughput(void)
+{
+    volatile uint32_t sink = 0;
+    uint32_t start;
+
+    start = xtimer_now_usec();
+    for (unsigned i = 0; i < BENCH_RUNS; i++) {
+        sink ^= ucrc16_calc_le(data, BENCH_LEN, UCRC16_CCITT_POLY_LE, 0);
+    }
+    _print("ucrc16 (bit-wise)", xtimer_now_usec() - start);
+
+    start = xtimer_now_usec();
+    for (unsigned i = 0; i < BENCH_RUNS; i++) {
+        sink ^= crc16_ccitt_calc(data, BENCH_LEN);
+    }
+    _print("CRC16-CCITT (byte-wise)", xtimer_now_usec() - start);
+
+    start = xtimer_now_usec();
+    for (unsigned i = 0; i < BENCH_RUNS; i++) {
+        sink ^= crc16_kermit_calc(data, BENCH_LEN);
+    }
+    _print("CRC-16/KERMIT", xtimer_now_usec() - start);
+
+    start = xtimer_now_usec();
+    for (unsigned i = 0; i < BENCH_RUNS; i++) {
+        sink ^= crc32_calc(data, BENCH_LEN);
+    }
+    _print("CRC-32", xtimer_now_usec() - start);
+
+    start = xtimer_now_usec();
+    for (unsigned i = 0; i < BENCH_RUNS; i++) {
+        sink ^= crc32c_calc(data, BENCH_LEN);
+    }
+    _print("CRC-32C", xtimer_now_usec() - start);
+
+    (void)sink;
+}
+
+Test *tests_checksum_crc_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        /* check values of the CRC catalogue
+         * http://reveng.sourceforge.net/crc-catalogue/ */
+        new_TestFixture(test_checksum_crc32_check),
+        new_TestFixture(test_checksum_crc32c_check),
+        new_TestFixture(test_checksum_crc16_kermit_check),
+        new_TestFixture(test_checksum_crc16_kermit_ieee802154_frame),
+        new_TestFixture(test_checksum_crc_reference),
+        new_TestFixture(test_checksum_crc_incremental),
+        new_TestFixture(test_checksum_crc_custom_table),
+        new_TestFixture(test_checksum_crc_throughput),
+    };
+
+    EMB_UNIT_TESTCALLER(checksum_crc_tests, set_up, NULL, fixtures);
+
+    return (Test *)&checksum_crc_tests;
+}
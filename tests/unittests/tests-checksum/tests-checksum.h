@@ -29,6 +29,13 @@ extern "C" {
  */
 void tests_checksum(void);
 
+/**
+ * @brief   Generates tests for checksum/crc.h
+ *
+ * @return  embUnit tests if successful, NULL if not.
+ */
+Test *tests_checksum_crc_tests(void);
+
 /**
  * @brief   Generates tests for checksum/crc16_ccitt.h
  *
@@ -7,6 +7,7 @@
  */
 
 #include <limits.h>
+#include <string.h>
 
 #include "embUnit.h"
 #include "crypto/aes.h"
@@ -83,11 +84,38 @@ static void test_crypto_aes_decrypt(void)
     TEST_ASSERT_MESSAGE(1 == compare(TEST_1_INP, data, AES_BLOCK_SIZE), "wrong plaintext");
 }
 
+static void test_crypto_aes_blocks(void)
+{
+    cipher_context_t ctx;
+    int err;
+    /* more blocks than the AES-NI backend has in flight, plus a remainder */
+    uint8_t data[7 * AES_BLOCK_SIZE];
+
+    for (unsigned i = 0; i < sizeof(data); i += AES_BLOCK_SIZE) {
+        memcpy(&data[i], TEST_1_INP, AES_BLOCK_SIZE);
+    }
+    err = aes_init(&ctx, TEST_1_KEY, AES_KEY_SIZE);
+    TEST_ASSERT_EQUAL_INT(1, err);
+
+    err = aes_encrypt_blocks(&ctx, data, data, sizeof(data) / AES_BLOCK_SIZE);
+    TEST_ASSERT_EQUAL_INT(1, err);
+    for (unsigned i = 0; i < sizeof(data); i += AES_BLOCK_SIZE) {
+        TEST_ASSERT_MESSAGE(1 == compare(TEST_1_ENC, &data[i], AES_BLOCK_SIZE), "wrong ciphertext");
+    }
+
+    err = aes_decrypt_blocks(&ctx, data, data, sizeof(data) / AES_BLOCK_SIZE);
+    TEST_ASSERT_EQUAL_INT(1, err);
+    for (unsigned i = 0; i < sizeof(data); i += AES_BLOCK_SIZE) {
+        TEST_ASSERT_MESSAGE(1 == compare(TEST_1_INP, &data[i], AES_BLOCK_SIZE), "wrong plaintext");
+    }
+}
+
 Test* tests_crypto_aes_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
         new_TestFixture(test_crypto_aes_encrypt),
                         new_TestFixture(test_crypto_aes_decrypt),
+                        new_TestFixture(test_crypto_aes_blocks),
     };
 
     EMB_UNIT_TESTCALLER(crypto_aes_tests, NULL, NULL, fixtures);
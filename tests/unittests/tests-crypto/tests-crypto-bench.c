@@ -0,0 +1,145 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "embUnit.h"
+#include "crypto/chacha20poly1305.h"
+#include "crypto/ciphers.h"
+#include "crypto/modes/cbc.h"
+#include "crypto/modes/ccm.h"
+#include "crypto/modes/ctr.h"
+#include "crypto/modes/gcm.h"
+#include "xtimer.h"
+
+#include "tests-crypto.h"
+
+#define BENCH_LEN           (1024U)
+#define BENCH_RUNS          (32U)
+#define BENCH_MAC_LEN       (8U)
+#define BENCH_TAG_LEN       (16U)
+
+static const uint8_t KEY[16] = {
+    0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6,
+    0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c
+};
+static const uint8_t CHACHA_KEY[32];
+static uint8_t _nonce[13];
+static uint8_t _iv[16];
+static uint8_t _plain[BENCH_LEN];
+static uint8_t _cipher[BENCH_LEN + BENCH_TAG_LEN];
+static cipher_t _aes;
+
+static void set_up(void)
+{
+    for (unsigned i = 0; i < BENCH_LEN; i++) {
+        _plain[i] = i;
+    }
+    cipher_init(&_aes, CIPHER_AES_128, KEY, sizeof(KEY));
+}
+
+static void _print(const char *mode, uint32_t elapsed)
+{
+    uint32_t rate = ((uint64_t)BENCH_RUNS * BENCH_LEN * US_PER_SEC) / elapsed;
+
+    printf("\n%s: %u x %u bytes in %" PRIu32 " us: %" PRIu32 ".%03"
+           PRIu32 " MB/s\n", mode, BENCH_RUNS, BENCH_LEN, elapsed,
+           rate / 1000000, (rate / 1000) % 1000);
+}
+
+static void test_crypto_bench_ctr(void)
+{
+    uint8_t ctr[16] = { 0 };
+    uint32_t start = xtimer_now_usec();
+
+    for (unsigned i = 0; i < BENCH_RUNS; i++) {
+        int len = cipher_encrypt_ctr(&_aes, ctr, 0, _plain, BENCH_LEN, _cipher);
+
+        TEST_ASSERT_EQUAL_INT(BENCH_LEN, len);
+    }
+    _print("AES-128-CTR", xtimer_now_usec() - start);
+}
+
+static void test_crypto_bench_cbc_encrypt(void)
+{
+    uint32_t start = xtimer_now_usec();
+
+    for (unsigned i = 0; i < BENCH_RUNS; i++) {
+        int len = cipher_encrypt_cbc(&_aes, _iv, _plain, BENCH_LEN, _cipher);
+
+        TEST_ASSERT_EQUAL_INT(BENCH_LEN, len);
+    }
+    _print("AES-128-CBC encrypt", xtimer_now_usec() - start);
+}
+
+static void test_crypto_bench_cbc_decrypt(void)
+{
+    uint32_t start = xtimer_now_usec();
+
+    for (unsigned i = 0; i < BENCH_RUNS; i++) {
+        int len = cipher_decrypt_cbc(&_aes, _iv, _plain, BENCH_LEN, _cipher);
+
+        TEST_ASSERT_EQUAL_INT(BENCH_LEN, len);
+    }
+    _print("AES-128-CBC decrypt", xtimer_now_usec() - start);
+}
+
+static void test_crypto_bench_ccm(void)
+{
+    uint32_t start = xtimer_now_usec();
+
+    for (unsigned i = 0; i < BENCH_RUNS; i++) {
+        int len = cipher_encrypt_ccm(&_aes, NULL, 0, BENCH_MAC_LEN, 2, _nonce,
+                                     sizeof(_nonce), _plain, BENCH_LEN, _cipher);
+
+        TEST_ASSERT_EQUAL_INT(BENCH_LEN + BENCH_MAC_LEN, len);
+    }
+    _print("AES-128-CCM", xtimer_now_usec() - start);
+}
+
+static void test_crypto_bench_gcm(void)
+{
+    uint32_t start = xtimer_now_usec();
+
+    for (unsigned i = 0; i < BENCH_RUNS; i++) {
+        int len = cipher_encrypt_gcm(&_aes, NULL, 0, BENCH_TAG_LEN, _nonce, 12,
+                                     _plain, BENCH_LEN, _cipher);
+
+        TEST_ASSERT_EQUAL_INT(BENCH_LEN + BENCH_TAG_LEN, len);
+    }
+    _print("AES-128-GCM", xtimer_now_usec() - start);
+}
+
+static void test_crypto_bench_chacha20poly1305(void)
+{
+    uint32_t start = xtimer_now_usec();
+
+    for (unsigned i = 0; i < BENCH_RUNS; i++) {
+        chacha20poly1305_encrypt(_cipher, _plain, BENCH_LEN, NULL, 0,
+                                 CHACHA_KEY, _nonce);
+    }
+    _print("ChaCha20-Poly1305", xtimer_now_usec() - start);
+}
+
+Test *tests_crypto_bench_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_crypto_bench_ctr),
+        new_TestFixture(test_crypto_bench_cbc_encrypt),
+        new_TestFixture(test_crypto_bench_cbc_decrypt),
+        new_TestFixture(test_crypto_bench_ccm),
+        new_TestFixture(test_crypto_bench_gcm),
+        new_TestFixture(test_crypto_bench_chacha20poly1305),
+    };
+
+    EMB_UNIT_TESTCALLER(crypto_bench_tests, set_up, NULL, fixtures);
+
+    return (Test *)&crypto_bench_tests;
+}
@@ -0,0 +1,200 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include <string.h>
+
+#include "embUnit.h"
+#include "crypto/chacha20poly1305.h"
+#include "crypto/poly1305.h"
+#include "tests-crypto.h"
+
+/* RFC 8439, section 2.5.2 */
+static const uint8_t TEST_POLY1305_KEY[] = {
+    0x85, 0xD6, 0xBE, 0x78, 0x57, 0x55, 0x6D, 0x33,
+    0x7F, 0x44, 0x52, 0xFE, 0x42, 0xD5, 0x06, 0xA8,
+    0x01, 0x03, 0x80, 0x8A, 0xFB, 0x0D, 0xB2, 0xFD,
+    0x4A, 0xBF, 0xF6, 0xAF, 0x41, 0x49, 0xF5, 0x1B
+};
+
+static const char TEST_POLY1305_MSG[] = "Cryptographic Forum Research Group";
+static const uint8_t TEST_POLY1305_TAG[] = {
+    0xA8, 0x06, 0x1D, 0xC1, 0x30, 0x51, 0x36, 0xC6,
+    0xC2, 0x2B, 0x8B, 0xAF, 0x0C, 0x01, 0x27, 0xA9
+};
+
+/* RFC 8439, section 2.8.2 */
+static const uint8_t TEST_AEAD_KEY[] = {
+    0x80, 0x81, 0x82, 0x83, 0x84, 0x85, 0x86, 0x87,
+    0x88, 0x89, 0x8A, 0x8B, 0x8C, 0x8D, 0x8E, 0x8F,
+    0x90, 0x91, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97,
+    0x98, 0x99, 0x9A, 0x9B, 0x9C, 0x9D, 0x9E, 0x9F
+};
+static const uint8_t TEST_AEAD_NONCE[] = {
+    0x07, 0x00, 0x00, 0x00, 0x40, 0x41, 0x42, 0x43,
+    0x44, 0x45, 0x46, 0x47
+};
+static const uint8_t TEST_AEAD_ADATA[] = {
+    0x50, 0x51, 0x52, 0x53, 0xC0, 0xC1, 0xC2, 0xC3,
+    0xC4, 0xC5, 0xC6, 0xC7
+};
+static const uint8_t TEST_AEAD_PLAIN[] = {
+    0x4C, 0x61, 0x64, 0x69, 0x65, 0x73, 0x20, 0x61,
+    0x6E, 0x64, 0x20, 0x47, 0x65, 0x6E, 0x74, 0x6C,
+    0x65, 0x6D, 0x65, 0x6E, 0x20, 0x6F, 0x66, 0x20,
+    0x74, 0x68, 0x65, 0x20, 0x63, 0x6C, 0x61, 0x73,
+    0x73, 0x20, 0x6F, 0x66, 0x20, 0x27, 0x39, 0x39,
+    0x3A, 0x20, 0x49, 0x66, 0x20, 0x49, 0x20, 0x63,
+    0x6F, 0x75, 0x6C, 0x64, 0x20, 0x6F, 0x66, 0x66,
+    0x65, 0x72, 0x20, 0x79, 0x6F, 0x75, 0x20, 0x6F,
+    0x6E, 0x6C, 0x79, 0x20, 0x6F, 0x6E, 0x65, 0x20,
+    0x74, 0x69, 0x70, 0x20, 0x66, 0x6F, 0x72, 0x20,
+    0x74, 0x68, 0x65, 0x20, 0x66, 0x75, 0x74, 0x75,
+    0x72, 0x65, 0x2C, 0x20, 0x73, 0x75, 0x6E, 0x73,
+    0x63, 0x72, 0x65, 0x65, 0x6E, 0x20, 0x77, 0x6F,
+    0x75, 0x6C, 0x64, 0x20, 0x62, 0x65, 0x20, 0x69,
+    0x74, 0x2E
+};
+static const uint8_t TEST_AEAD_CIPHER[] = {
+    0xD3, 0x1A, 0x8D, 0x34, 0x64, 0x8E, 0x60, 0xDB,
+    0x7B, 0x86, 0xAF, 0xBC, 0x53, 0xEF, 0x7E, 0xC2,
+    0xA4, 0xAD, 0xED, 0x51, 0x29, 0x6E, 0x08, 0xFE,
+    0xA9, 0xE2, 0xB5, 0xA7, 0x36, 0xEE, 0x62, 0xD6,
+    0x3D, 0xBE, 0xA4, 0x5E, 0x8C, 0xA9, 0x67, 0x12,
+    0x82, 0xFA, 0xFB, 0x69, 0xDA, 0x92, 0x72, 0x8B,
+    0x1A, 0x71, 0xDE, 0x0A, 0x9E, 0x06, 0x0B, 0x29,
+    0x05, 0xD6, 0xA5, 0xB6, 0x7E, 0xCD, 0x3B, 0x36,
+    0x92, 0xDD, 0xBD, 0x7F, 0x2D, 0x77, 0x8B, 0x8C,
+    0x98, 0x03, 0xAE, 0xE3, 0x28, 0x09, 0x1B, 0x58,
+    0xFA, 0xB3, 0x24, 0xE4, 0xFA, 0xD6, 0x75, 0x94,
+    0x55, 0x85, 0x80, 0x8B, 0x48, 0x31, 0xD7, 0xBC,
+    0x3F, 0xF4, 0xDE, 0xF0, 0x8E, 0x4B, 0x7A, 0x9D,
+    0xE5, 0x76, 0xD2, 0x65, 0x86, 0xCE, 0xC6, 0x4B,
+    0x61, 0x16, 0x1A, 0xE1, 0x0B, 0x59, 0x4F, 0x09,
+    0xE2, 0x6A, 0x7E, 0x90, 0x2E, 0xCB, 0xD0, 0x60,
+    0x06, 0x91
+};
+
+static uint8_t data[sizeof(TEST_AEAD_CIPHER)];
+
+static void set_up(void)
+{
+    memset(data, 0, sizeof(data));
+}
+
+static void test_crypto_poly1305(void)
+{
+    uint8_t tag[POLY1305_TAG_SIZE];
+    poly1305_ctx_t ctx;
+
+    poly1305_auth(tag, (const uint8_t *)TEST_POLY1305_MSG,
+                  sizeof(TEST_POLY1305_MSG) - 1, TEST_POLY1305_KEY);
+    TEST_ASSERT(memcmp(TEST_POLY1305_TAG, tag, sizeof(tag)) == 0);
+
+    /* incremental, with a chunk that does not fill a block */
+    memset(tag, 0, sizeof(tag));
+    poly1305_init(&ctx, TEST_POLY1305_KEY);
+    poly1305_update(&ctx, (const uint8_t *)TEST_POLY1305_MSG, 5);
+    poly1305_update(&ctx, (const uint8_t *)&TEST_POLY1305_MSG[5],
+                    sizeof(TEST_POLY1305_MSG) - 1 - 5);
+    poly1305_finish(&ctx, tag);
+    TEST_ASSERT(memcmp(TEST_POLY1305_TAG, tag, sizeof(tag)) == 0);
+}
+
+static void test_crypto_chacha20poly1305_encrypt(void)
+{
+    chacha20poly1305_encrypt(data, TEST_AEAD_PLAIN, sizeof(TEST_AEAD_PLAIN),
+                             TEST_AEAD_ADATA, sizeof(TEST_AEAD_ADATA),
+                             TEST_AEAD_KEY, TEST_AEAD_NONCE);
+    TEST_ASSERT(memcmp(TEST_AEAD_CIPHER, data, sizeof(TEST_AEAD_CIPHER)) == 0);
+}
+
+static void test_crypto_chacha20poly1305_decrypt(void)
+{
+    uint8_t input[sizeof(TEST_AEAD_CIPHER)];
+    size_t len = 0;
+
+    TEST_ASSERT_EQUAL_INT(1, chacha20poly1305_decrypt(TEST_AEAD_CIPHER,
+                                                      sizeof(TEST_AEAD_CIPHER),
+                                                      data, &len,
+                                                      TEST_AEAD_ADATA,
+                                                      sizeof(TEST_AEAD_ADATA),
+                                                      TEST_AEAD_KEY,
+                                                      TEST_AEAD_NONCE));
+    TEST_ASSERT_EQUAL_INT(sizeof(TEST_AEAD_PLAIN), len);
+    TEST_ASSERT(memcmp(TEST_AEAD_PLAIN, data, len) == 0);
+
+    /* a modified additional data must be detected */
+    memcpy(input, TEST_AEAD_CIPHER, sizeof(input));
+    TEST_ASSERT_EQUAL_INT(0, chacha20poly1305_decrypt(input, sizeof(input),
+                                                      data, &len,
+                                                      TEST_AEAD_ADATA,
+                                                      sizeof(TEST_AEAD_ADATA) - 1,
+                                                      TEST_AEAD_KEY,
+                                                      TEST_AEAD_NONCE));
+    for (unsigned i = 0; i < sizeof(TEST_AEAD_PLAIN); i++) {
+        TEST_ASSERT_EQUAL_INT(0, data[i]);
+    }
+}
+
+/* feeds the data in chunks that never line up with the blocks */
+static void test_crypto_chacha20poly1305_incremental(void)
+{
+    static const size_t chunks[] = { 1, 63, 64, 13 };
+    uint8_t tag[CHACHA20POLY1305_TAG_BYTES];
+    chacha20poly1305_ctx_t ctx;
+    size_t offset = 0;
+
+    chacha20poly1305_init(&ctx, TEST_AEAD_KEY, TEST_AEAD_NONCE);
+    chacha20poly1305_update_aad(&ctx, TEST_AEAD_ADATA, 3);
+    chacha20poly1305_update_aad(&ctx, &TEST_AEAD_ADATA[3],
+                                sizeof(TEST_AEAD_ADATA) - 3);
+    for (unsigned i = 0; offset < sizeof(TEST_AEAD_PLAIN); i++) {
+        size_t len = chunks[i % (sizeof(chunks) / sizeof(chunks[0]))];
+
+        if (len > sizeof(TEST_AEAD_PLAIN) - offset) {
+            len = sizeof(TEST_AEAD_PLAIN) - offset;
+        }
+        chacha20poly1305_encrypt_update(&ctx, &TEST_AEAD_PLAIN[offset], len,
+                                        &data[offset]);
+        offset += len;
+    }
+    chacha20poly1305_finish(&ctx, tag);
+    TEST_ASSERT(memcmp(TEST_AEAD_CIPHER, data, sizeof(TEST_AEAD_PLAIN)) == 0);
+    TEST_ASSERT(memcmp(&TEST_AEAD_CIPHER[sizeof(TEST_AEAD_PLAIN)], tag,
+                       sizeof(tag)) == 0);
+
+    /* decrypt in place with the same chunks */
+    chacha20poly1305_init(&ctx, TEST_AEAD_KEY, TEST_AEAD_NONCE);
+    chacha20poly1305_update_aad(&ctx, TEST_AEAD_ADATA, sizeof(TEST_AEAD_ADATA));
+    offset = 0;
+    for (unsigned i = 0; offset < sizeof(TEST_AEAD_PLAIN); i++) {
+        size_t len = chunks[i % (sizeof(chunks) / sizeof(chunks[0]))];
+
+        if (len > sizeof(TEST_AEAD_PLAIN) - offset) {
+            len = sizeof(TEST_AEAD_PLAIN) - offset;
+        }
+        chacha20poly1305_decrypt_update(&ctx, &data[offset], len, &data[offset]);
+        offset += len;
+    }
+    TEST_ASSERT(chacha20poly1305_verify(&ctx, tag));
+    TEST_ASSERT(memcmp(TEST_AEAD_PLAIN, data, sizeof(TEST_AEAD_PLAIN)) == 0);
+}
+
+Test *tests_crypto_chacha20poly1305_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_crypto_poly1305),
+        new_TestFixture(test_crypto_chacha20poly1305_encrypt),
+        new_TestFixture(test_crypto_chacha20poly1305_decrypt),
+        new_TestFixture(test_crypto_chacha20poly1305_incremental),
+    };
+
+    EMB_UNIT_TESTCALLER(crypto_chacha20poly1305_tests, set_up, NULL, fixtures);
+
+    return (Test *)&crypto_chacha20poly1305_tests;
+}
@@ -7,6 +7,7 @@
  */
 
 #include <limits.h>
+#include <string.h>
 
 #include "embUnit.h"
 #include "crypto/ciphers.h"
@@ -59,11 +60,40 @@ static void test_crypto_cipher_aes_decrypt(void)
     TEST_ASSERT_MESSAGE(1 == cmp , "wrong plaintext");
 }
 
+static void test_crypto_cipher_aes_blocks(void)
+{
+    cipher_t cipher;
+    int err, cmp;
+    uint8_t input[5 * 16], data[5 * 16], block[16];
+
+    for (unsigned i = 0; i < sizeof(input); i++) {
+        input[i] = i * 3;
+    }
+    err = cipher_init(&cipher, CIPHER_AES_128, TEST_KEY, 16);
+    TEST_ASSERT_EQUAL_INT(1, err);
+
+    err = cipher_encrypt_blocks(&cipher, input, data, 5);
+    TEST_ASSERT_EQUAL_INT(1, err);
+    for (unsigned i = 0; i < 5; i++) {
+        err = cipher_encrypt(&cipher, &input[i * 16], block);
+        TEST_ASSERT_EQUAL_INT(1, err);
+        cmp = compare(block, &data[i * 16], 16);
+        TEST_ASSERT_MESSAGE(1 == cmp , "wrong ciphertext");
+    }
+
+    /* decrypt in place */
+    err = cipher_decrypt_blocks(&cipher, data, data, 5);
+    TEST_ASSERT_EQUAL_INT(1, err);
+    cmp = compare(input, data, sizeof(input));
+    TEST_ASSERT_MESSAGE(1 == cmp , "wrong plaintext");
+}
+
 Test* tests_crypto_cipher_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
         new_TestFixture(test_crypto_cipher_aes_encrypt),
-        new_TestFixture(test_crypto_cipher_aes_decrypt)
+        new_TestFixture(test_crypto_cipher_aes_decrypt),
+        new_TestFixture(test_crypto_cipher_aes_blocks)
     };
 
     EMB_UNIT_TESTCALLER(crypto_cipher_tests, NULL, NULL, fixtures);
@@ -13,6 +13,7 @@
 #include <string.h>
 
 #include "embUnit.h"
+#include "crypto/aes.h"
 #include "crypto/ciphers.h"
 #include "crypto/modes/cbc.h"
 #include "tests-crypto.h"
@@ -61,15 +62,15 @@ static uint8_t TEST_1_CIPHER[] = {
 };
 static uint8_t TEST_1_CIPHER_LEN = 64;
 
-static void test_encrypt_op(uint8_t* key, uint8_t key_len, uint8_t iv[16],
-                            uint8_t* input, uint8_t input_len, uint8_t* output,
-                            uint8_t output_len)
+static void test_encrypt_op(cipher_id_t id, uint8_t* key, uint8_t key_len,
+                            uint8_t iv[16], uint8_t* input, uint8_t input_len,
+                            uint8_t* output, uint8_t output_len)
 {
     cipher_t cipher;
     int len, err, cmp;
     uint8_t data[64];
 
-    err = cipher_init(&cipher, CIPHER_AES_128, key, key_len);
+    err = cipher_init(&cipher, id, key, key_len);
     TEST_ASSERT_EQUAL_INT(1, err);
 
     len = cipher_encrypt_cbc(&cipher, iv, input, input_len, data);
@@ -81,15 +82,15 @@ static void test_encrypt_op(uint8_t* key, uint8_t key_len, uint8_t iv[16],
 
 }
 
-static void test_decrypt_op(uint8_t* key, uint8_t key_len, uint8_t iv[16],
-                            uint8_t* input, uint8_t input_len, uint8_t* output,
-                            uint8_t output_len)
+static void test_decrypt_op(cipher_id_t id, uint8_t* key, uint8_t key_len,
+                            uint8_t iv[16], uint8_t* input, uint8_t input_len,
+                            uint8_t* output, uint8_t output_len)
 {
     cipher_t cipher;
     int len, err, cmp;
     uint8_t data[64];
 
-    err = cipher_init(&cipher, CIPHER_AES_128, key, key_len);
+    err = cipher_init(&cipher, id, key, key_len);
     TEST_ASSERT_EQUAL_INT(1, err);
 
     len = cipher_decrypt_cbc(&cipher, iv, input, input_len, data);
@@ -103,22 +104,105 @@ static void test_decrypt_op(uint8_t* key, uint8_t key_len, uint8_t iv[16],
 
 static void test_crypto_modes_cbc_encrypt(void)
 {
-    test_encrypt_op(TEST_1_KEY, TEST_1_KEY_LEN, TEST_1_IV, TEST_1_PLAIN,
-                    TEST_1_PLAIN_LEN, TEST_1_CIPHER, TEST_1_CIPHER_LEN);
+    test_encrypt_op(CIPHER_AES_128, TEST_1_KEY, TEST_1_KEY_LEN, TEST_1_IV,
+                    TEST_1_PLAIN, TEST_1_PLAIN_LEN, TEST_1_CIPHER,
+                    TEST_1_CIPHER_LEN);
 }
 
 static void test_crypto_modes_cbc_decrypt(void)
 {
-    test_decrypt_op(TEST_1_KEY, TEST_1_KEY_LEN, TEST_1_IV, TEST_1_CIPHER,
+    test_decrypt_op(CIPHER_AES_128, TEST_1_KEY, TEST_1_KEY_LEN, TEST_1_IV,
+                    TEST_1_CIPHER, TEST_1_CIPHER_LEN, TEST_1_PLAIN,
+                    TEST_1_PLAIN_LEN);
+}
+
+static void test_crypto_modes_cbc_decrypt_in_place(void)
+{
+    cipher_t cipher;
+    int len, err, cmp;
+    uint8_t data[64];
+
+    memcpy(data, TEST_1_CIPHER, TEST_1_CIPHER_LEN);
+    err = cipher_init(&cipher, CIPHER_AES_128, TEST_1_KEY, TEST_1_KEY_LEN);
+    TEST_ASSERT_EQUAL_INT(1, err);
+
+    len = cipher_decrypt_cbc(&cipher, TEST_1_IV, data, TEST_1_CIPHER_LEN, data);
+    TEST_ASSERT_EQUAL_INT(TEST_1_PLAIN_LEN, len);
+    cmp = compare(TEST_1_PLAIN, data, len);
+    TEST_ASSERT_MESSAGE(1 == cmp , "wrong plaintext");
+}
+
+#ifdef MODULE_CRYPTO_AES_NI
+static void test_vectors(cipher_id_t id)
+{
+    test_encrypt_op(id, TEST_1_KEY, TEST_1_KEY_LEN, TEST_1_IV, TEST_1_PLAIN,
+                    TEST_1_PLAIN_LEN, TEST_1_CIPHER, TEST_1_CIPHER_LEN);
+    test_decrypt_op(id, TEST_1_KEY, TEST_1_KEY_LEN, TEST_1_IV, TEST_1_CIPHER,
                     TEST_1_CIPHER_LEN, TEST_1_PLAIN, TEST_1_PLAIN_LEN);
 }
 
+/*
+ * Runs the test vectors through the T-table and the AES-NI implementation,
+ * then encrypts more blocks than either processes at once with both and
+ * decrypts each ciphertext with the other implementation
+ * Expected result: both produce the test vectors, the same ciphertext and
+ * the input again
+ */
+static void test_crypto_modes_cbc_aes_ni(void)
+{
+    cipher_t ttable, ni;
+    int len, err, cmp;
+    uint8_t input[(CIPHER_BATCH_BLOCKS * 3 + 1) * 16];
+    uint8_t output_ttable[sizeof(input)], output_ni[sizeof(input)];
+
+    test_vectors(CIPHER_AES_128_TTABLE);
+    if (!aes_ni_available()) {
+        /* only the T-table implementation can run on this host */
+        err = cipher_init(&ni, CIPHER_AES_128_NI, TEST_1_KEY, TEST_1_KEY_LEN);
+        TEST_ASSERT_EQUAL_INT(CIPHER_ERR_BAD_CONTEXT_SIZE, err);
+        return;
+    }
+    test_vectors(CIPHER_AES_128_NI);
+
+    for (unsigned i = 0; i < sizeof(input); i++) {
+        input[i] = i;
+    }
+    err = cipher_init(&ttable, CIPHER_AES_128_TTABLE, TEST_1_KEY,
+                      TEST_1_KEY_LEN);
+    TEST_ASSERT_EQUAL_INT(1, err);
+    err = cipher_init(&ni, CIPHER_AES_128_NI, TEST_1_KEY, TEST_1_KEY_LEN);
+    TEST_ASSERT_EQUAL_INT(1, err);
+
+    len = cipher_encrypt_cbc(&ttable, TEST_1_IV, input, sizeof(input),
+                             output_ttable);
+    TEST_ASSERT_EQUAL_INT(sizeof(input), len);
+    len = cipher_encrypt_cbc(&ni, TEST_1_IV, input, sizeof(input), output_ni);
+    TEST_ASSERT_EQUAL_INT(sizeof(input), len);
+    cmp = compare(output_ttable, output_ni, sizeof(input));
+    TEST_ASSERT_MESSAGE(1 == cmp , "wrong ciphertext");
+
+    len = cipher_decrypt_cbc(&ni, TEST_1_IV, output_ttable, sizeof(input),
+                             output_ttable);
+    TEST_ASSERT_EQUAL_INT(sizeof(input), len);
+    len = cipher_decrypt_cbc(&ttable, TEST_1_IV, output_ni, sizeof(input),
+                             output_ni);
+    TEST_ASSERT_EQUAL_INT(sizeof(input), len);
+    cmp = compare(input, output_ttable, sizeof(input));
+    TEST_ASSERT_MESSAGE(1 == cmp , "wrong plaintext");
+    cmp = compare(input, output_ni, sizeof(input));
+    TEST_ASSERT_MESSAGE(1 == cmp , "wrong plaintext");
+}
+#endif
 
 Test* tests_crypto_modes_cbc_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
         new_TestFixture(test_crypto_modes_cbc_encrypt),
-                        new_TestFixture(test_crypto_modes_cbc_decrypt)
+                        new_TestFixture(test_crypto_modes_cbc_decrypt),
+                        new_TestFixture(test_crypto_modes_cbc_decrypt_in_place),
+#ifdef MODULE_CRYPTO_AES_NI
+                        new_TestFixture(test_crypto_modes_cbc_aes_ni),
+#endif
     };
 
     EMB_UNIT_TESTCALLER(crypto_modes_cbc_tests, NULL, NULL, fixtures);
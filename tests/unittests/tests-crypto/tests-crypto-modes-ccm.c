@@ -79,6 +79,62 @@ static uint8_t TEST_2_EXPECTED[] = {
 };
 static uint8_t TEST_2_EXPECTED_LEN = 40;
 
+/* PACKET VECTOR #3: L = 3 with a plaintext of more than 255 bytes, so the
+ * length field has more than two octets. Generated with OpenSSL, the key and
+ * the additional data are the ones of PACKET VECTOR #1 and the plaintext
+ * consists of the bytes 0x00, 0x01, ... 0xFF, 0x00, ... */
+static uint8_t TEST_3_NONCE[] = {
+    0x00, 0x00, 0x00, 0x05, 0x04, 0x03, 0x02, 0xA0,
+    0xA1, 0xA2, 0xA3, 0xA4
+};
+static uint8_t TEST_3_NONCE_LEN = 12;
+static uint8_t TEST_3_L = 3;
+
+static const size_t TEST_3_INPUT_LEN = 300;
+
+static uint8_t TEST_3_EXPECTED[] = {
+    0xAB, 0x6A, 0x20, 0x50, 0xAD, 0xC9, 0x77, 0x0F,
+    0x3A, 0x56, 0x15, 0xD9, 0x98, 0xEB, 0xA2, 0x14,
+    0xE5, 0x9A, 0x90, 0x6A, 0xFB, 0x19, 0xE9, 0xA5,
+    0x27, 0xAC, 0xCD, 0xD1, 0xD3, 0x09, 0x97, 0x1D,
+    0xF4, 0x7B, 0x48, 0xEF, 0x18, 0xBF, 0x5D, 0x3A,
+    0x19, 0x49, 0x8E, 0xC5, 0xC7, 0xDB, 0x73, 0xA0,
+    0x4F, 0xB8, 0xC9, 0xB5, 0xA5, 0xEE, 0x52, 0xC3,
+    0xCD, 0x36, 0x97, 0xE3, 0xEE, 0x3E, 0xA1, 0x51,
+    0x7D, 0x14, 0x5C, 0x7E, 0x02, 0x56, 0x91, 0xE7,
+    0x7C, 0x9D, 0xE2, 0x2E, 0xBD, 0xEB, 0xE7, 0x3B,
+    0xD8, 0xC4, 0x1D, 0xE9, 0x21, 0x69, 0x44, 0x23,
+    0x07, 0x1D, 0xB4, 0x95, 0x8F, 0x25, 0xE9, 0xFE,
+    0x8A, 0xD2, 0xF4, 0x2A, 0xB2, 0x78, 0x12, 0x4D,
+    0xA8, 0x58, 0xDC, 0x13, 0xCB, 0xD1, 0x6E, 0x9F,
+    0x16, 0x61, 0xB5, 0x1B, 0x08, 0x8D, 0x02, 0x47,
+    0x8D, 0x42, 0x67, 0xCD, 0xC3, 0x46, 0xAB, 0x13,
+    0x63, 0x94, 0xA7, 0x3B, 0x55, 0x0D, 0x46, 0xC0,
+    0x4D, 0x73, 0xC5, 0x77, 0x28, 0x06, 0x25, 0x49,
+    0x4A, 0xFB, 0x80, 0x92, 0x29, 0x44, 0x65, 0x06,
+    0xDA, 0x6B, 0x0B, 0xBE, 0x73, 0x32, 0x60, 0xDF,
+    0x4B, 0x39, 0xFF, 0xDF, 0x96, 0xDB, 0x40, 0x51,
+    0x83, 0xDF, 0xF7, 0x2D, 0xA0, 0xF1, 0x8F, 0xF4,
+    0x52, 0x9A, 0xEB, 0x22, 0x4F, 0xD8, 0x64, 0x9A,
+    0xAA, 0x0D, 0x0D, 0xA2, 0xEB, 0x40, 0xBE, 0x19,
+    0x39, 0xF6, 0x93, 0x9C, 0xBA, 0x9D, 0x20, 0x63,
+    0x7C, 0xA7, 0xB8, 0xE9, 0x40, 0x7A, 0xFE, 0x2A,
+    0xE5, 0x23, 0x21, 0xD6, 0x05, 0xAA, 0x15, 0xE5,
+    0x4D, 0x57, 0x4B, 0x9E, 0xD1, 0xE4, 0xA2, 0xAD,
+    0x6F, 0x24, 0x07, 0x41, 0x34, 0x08, 0x0F, 0xCE,
+    0x79, 0xEA, 0xE8, 0x02, 0xDF, 0x1B, 0xBF, 0xA0,
+    0xB4, 0x13, 0xEA, 0x8C, 0x77, 0x00, 0xEA, 0x1C,
+    0x50, 0xDE, 0x55, 0xA0, 0x14, 0xE2, 0x66, 0x42,
+    0x13, 0x95, 0x82, 0xBD, 0xCF, 0xCB, 0xAB, 0xD1,
+    0x5E, 0x41, 0xE3, 0x46, 0xB0, 0x7F, 0xF4, 0xC0,
+    0xF1, 0x37, 0xC0, 0xCA, 0x94, 0x73, 0x73, 0x50,
+    0xFE, 0x55, 0x36, 0xF5, 0xBA, 0x43, 0x29, 0x3F,
+    0xA5, 0x12, 0xB3, 0xCA, 0xFE, 0x4B, 0x29, 0xED,
+    0xCF, 0x55, 0x28, 0x33, 0x91, 0x1E, 0x22, 0x33,
+    0xE2, 0x3D, 0x6E, 0xC8
+};
+static const size_t TEST_3_EXPECTED_LEN = 308;
+
 static void test_encrypt_op(uint8_t* key, uint8_t key_len, uint8_t* adata,
                             uint8_t adata_len, uint8_t* nonce, uint8_t nonce_len, uint8_t* plain,
                             uint8_t plain_len, uint8_t* output_expected, uint8_t output_expected_len)
@@ -147,12 +203,41 @@ static void test_crypto_modes_ccm_decrypt(void)
                     TEST_2_INPUT_LEN);
 }
 
+static void test_crypto_modes_ccm_long(void)
+{
+    static uint8_t plain[300], data[sizeof(TEST_3_EXPECTED)];
+    cipher_t cipher;
+    int len;
+
+    for (unsigned i = 0; i < TEST_3_INPUT_LEN; i++) {
+        plain[i] = i;
+    }
+
+    TEST_ASSERT_EQUAL_INT(1, cipher_init(&cipher, CIPHER_AES_128, TEST_1_KEY,
+                                         TEST_1_KEY_LEN));
+
+    len = cipher_encrypt_ccm(&cipher, TEST_1_INPUT, TEST_1_ADATA_LEN, 8,
+                             TEST_3_L, TEST_3_NONCE, TEST_3_NONCE_LEN, plain,
+                             TEST_3_INPUT_LEN, data);
+    TEST_ASSERT_EQUAL_INT(TEST_3_EXPECTED_LEN, len);
+    /* compare() is limited to 255 bytes */
+    TEST_ASSERT_MESSAGE(0 == memcmp(TEST_3_EXPECTED, data, len),
+                        "wrong ciphertext");
+
+    len = cipher_decrypt_ccm(&cipher, TEST_1_INPUT, TEST_1_ADATA_LEN, 8,
+                             TEST_3_L, TEST_3_NONCE, TEST_3_NONCE_LEN,
+                             TEST_3_EXPECTED, TEST_3_EXPECTED_LEN, data);
+    TEST_ASSERT_EQUAL_INT(TEST_3_INPUT_LEN, len);
+    TEST_ASSERT_MESSAGE(0 == memcmp(plain, data, len), "wrong plaintext");
+}
+
 
 Test* tests_crypto_modes_ccm_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
         new_TestFixture(test_crypto_modes_ccm_encrypt),
-                        new_TestFixture(test_crypto_modes_ccm_decrypt)
+                        new_TestFixture(test_crypto_modes_ccm_decrypt),
+                        new_TestFixture(test_crypto_modes_ccm_long)
     };
 
     EMB_UNIT_TESTCALLER(crypto_modes_ccm_tests, NULL, NULL, fixtures);
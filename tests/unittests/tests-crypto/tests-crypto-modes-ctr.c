@@ -13,6 +13,7 @@
 #include <string.h>
 
 #include "embUnit.h"
+#include "crypto/aes.h"
 #include "crypto/ciphers.h"
 #include "crypto/modes/ctr.h"
 #include "tests-crypto.h"
@@ -61,15 +62,15 @@ static uint8_t TEST_1_CIPHER[] = {
 };
 static uint8_t TEST_1_CIPHER_LEN = 64;
 
-static void test_encrypt_op(uint8_t* key, uint8_t key_len, uint8_t ctr[16],
-                            uint8_t* input, uint8_t input_len, uint8_t* output,
-                            uint8_t output_len)
+static void test_encrypt_op(cipher_id_t id, uint8_t* key, uint8_t key_len,
+                            uint8_t ctr[16], uint8_t* input, uint8_t input_len,
+                            uint8_t* output, uint8_t output_len)
 {
     cipher_t cipher;
     int len, err, cmp;
     uint8_t data[64];
 
-    err = cipher_init(&cipher, CIPHER_AES_128, key, key_len);
+    err = cipher_init(&cipher, id, key, key_len);
     TEST_ASSERT_EQUAL_INT(1, err);
 
     len = cipher_encrypt_ctr(&cipher, ctr, 0, input, input_len, data);
@@ -81,15 +82,15 @@ static void test_encrypt_op(uint8_t* key, uint8_t key_len, uint8_t ctr[16],
 
 }
 
-static void test_decrypt_op(uint8_t* key, uint8_t key_len, uint8_t ctr[16],
-                            uint8_t* input, uint8_t input_len, uint8_t* output,
-                            uint8_t output_len)
+static void test_decrypt_op(cipher_id_t id, uint8_t* key, uint8_t key_len,
+                            uint8_t ctr[16], uint8_t* input, uint8_t input_len,
+                            uint8_t* output, uint8_t output_len)
 {
     cipher_t cipher;
     int len, err, cmp;
     uint8_t data[64];
 
-    err = cipher_init(&cipher, CIPHER_AES_128, key, key_len);
+    err = cipher_init(&cipher, id, key, key_len);
     TEST_ASSERT_EQUAL_INT(1, err);
 
     len = cipher_decrypt_ctr(&cipher, ctr, 0, input, input_len, data);
@@ -106,8 +107,9 @@ static void test_crypto_modes_ctr_encrypt(void)
     uint8_t ctr[16];
 
     memcpy(ctr, TEST_1_COUNTER, 16);
-    test_encrypt_op(TEST_1_KEY, TEST_1_KEY_LEN, ctr, TEST_1_PLAIN,
-                    TEST_1_PLAIN_LEN, TEST_1_CIPHER, TEST_1_CIPHER_LEN);
+    test_encrypt_op(CIPHER_AES_128, TEST_1_KEY, TEST_1_KEY_LEN, ctr,
+                    TEST_1_PLAIN, TEST_1_PLAIN_LEN, TEST_1_CIPHER,
+                    TEST_1_CIPHER_LEN);
 }
 
 static void test_crypto_modes_ctr_decrypt(void)
@@ -115,16 +117,138 @@ static void test_crypto_modes_ctr_decrypt(void)
     uint8_t ctr[16];
 
     memcpy(ctr, TEST_1_COUNTER, 16);
-    test_decrypt_op(TEST_1_KEY, TEST_1_KEY_LEN, ctr, TEST_1_CIPHER,
+    test_decrypt_op(CIPHER_AES_128, TEST_1_KEY, TEST_1_KEY_LEN, ctr,
+                    TEST_1_CIPHER, TEST_1_CIPHER_LEN, TEST_1_PLAIN,
+                    TEST_1_PLAIN_LEN);
+}
+
+/*
+ * Encrypts an unaligned buffer with a partial last block
+ * Expected result: the ciphertext is the prefix of the test vector and the
+ * counter was incremented once per (partial) block
+ */
+static void test_crypto_modes_ctr_unaligned(void)
+{
+    cipher_t cipher;
+    int len, err, cmp;
+    uint8_t ctr[16], input[64], output[64];
+    const uint8_t ctr_end[] = { 0xfc, 0xfd, 0xff, 0x03 };
+
+    memcpy(ctr, TEST_1_COUNTER, 16);
+    memcpy(input + 1, TEST_1_PLAIN, TEST_1_PLAIN_LEN - 3);
+    err = cipher_init(&cipher, CIPHER_AES_128, TEST_1_KEY, TEST_1_KEY_LEN);
+    TEST_ASSERT_EQUAL_INT(1, err);
+
+    len = cipher_encrypt_ctr(&cipher, ctr, 0, input + 1, TEST_1_PLAIN_LEN - 3,
+                             output + 3);
+    TEST_ASSERT_EQUAL_INT(TEST_1_PLAIN_LEN - 3, len);
+    cmp = compare(TEST_1_CIPHER, output + 3, len);
+    TEST_ASSERT_MESSAGE(1 == cmp , "wrong ciphertext");
+    TEST_ASSERT_EQUAL_INT(0, memcmp(&ctr[12], ctr_end, sizeof(ctr_end)));
+}
+
+/*
+ * Encrypts more blocks than the modes pass to the cipher at once, with one
+ * call and block by block
+ * Expected result: both ciphertexts are equal
+ */
+static void test_crypto_modes_ctr_many_blocks(void)
+{
+    cipher_t cipher;
+    int len, err, cmp;
+    uint8_t ctr_a[16], ctr_b[16];
+    uint8_t input[(CIPHER_BATCH_BLOCKS * 3 + 1) * 16 + 5];
+    uint8_t output_a[sizeof(input)], output_b[sizeof(input)];
+
+    for (unsigned i = 0; i < sizeof(input); i++) {
+        input[i] = i;
+    }
+    memcpy(ctr_a, TEST_1_COUNTER, 16);
+    memcpy(ctr_b, TEST_1_COUNTER, 16);
+    err = cipher_init(&cipher, CIPHER_AES_128, TEST_1_KEY, TEST_1_KEY_LEN);
+    TEST_ASSERT_EQUAL_INT(1, err);
+
+    len = cipher_encrypt_ctr(&cipher, ctr_a, 0, input, sizeof(input), output_a);
+    TEST_ASSERT_EQUAL_INT(sizeof(input), len);
+    for (unsigned offset = 0; offset < sizeof(input); offset += 16) {
+        unsigned chunk = ((sizeof(input) - offset) > 16) ? 16 : (sizeof(input) - offset);
+
+        len = cipher_encrypt_ctr(&cipher, ctr_b, 0, input + offset, chunk,
+                                 output_b + offset);
+        TEST_ASSERT_EQUAL_INT(chunk, len);
+    }
+    cmp = compare(output_a, output_b, sizeof(input));
+    TEST_ASSERT_MESSAGE(1 == cmp , "wrong ciphertext");
+    TEST_ASSERT_EQUAL_INT(0, memcmp(ctr_a, ctr_b, 16));
+}
+
+#ifdef MODULE_CRYPTO_AES_NI
+static void test_vectors(cipher_id_t id)
+{
+    uint8_t ctr[16];
+
+    memcpy(ctr, TEST_1_COUNTER, 16);
+    test_encrypt_op(id, TEST_1_KEY, TEST_1_KEY_LEN, ctr, TEST_1_PLAIN,
+                    TEST_1_PLAIN_LEN, TEST_1_CIPHER, TEST_1_CIPHER_LEN);
+    memcpy(ctr, TEST_1_COUNTER, 16);
+    test_decrypt_op(id, TEST_1_KEY, TEST_1_KEY_LEN, ctr, TEST_1_CIPHER,
                     TEST_1_CIPHER_LEN, TEST_1_PLAIN, TEST_1_PLAIN_LEN);
 }
 
+/*
+ * Runs the test vectors through the T-table and the AES-NI implementation,
+ * then encrypts more blocks than either processes at once with both
+ * Expected result: both produce the test vectors and the same ciphertext
+ */
+static void test_crypto_modes_ctr_aes_ni(void)
+{
+    cipher_t ttable, ni;
+    int len, err, cmp;
+    uint8_t ctr_ttable[16], ctr_ni[16];
+    uint8_t input[(CIPHER_BATCH_BLOCKS * 3 + 1) * 16 + 5];
+    uint8_t output_ttable[sizeof(input)], output_ni[sizeof(input)];
+
+    test_vectors(CIPHER_AES_128_TTABLE);
+    if (!aes_ni_available()) {
+        /* only the T-table implementation can run on this host */
+        err = cipher_init(&ni, CIPHER_AES_128_NI, TEST_1_KEY, TEST_1_KEY_LEN);
+        TEST_ASSERT_EQUAL_INT(CIPHER_ERR_BAD_CONTEXT_SIZE, err);
+        return;
+    }
+    test_vectors(CIPHER_AES_128_NI);
+
+    for (unsigned i = 0; i < sizeof(input); i++) {
+        input[i] = i;
+    }
+    memcpy(ctr_ttable, TEST_1_COUNTER, 16);
+    memcpy(ctr_ni, TEST_1_COUNTER, 16);
+    err = cipher_init(&ttable, CIPHER_AES_128_TTABLE, TEST_1_KEY,
+                      TEST_1_KEY_LEN);
+    TEST_ASSERT_EQUAL_INT(1, err);
+    err = cipher_init(&ni, CIPHER_AES_128_NI, TEST_1_KEY, TEST_1_KEY_LEN);
+    TEST_ASSERT_EQUAL_INT(1, err);
+
+    len = cipher_encrypt_ctr(&ttable, ctr_ttable, 0, input, sizeof(input),
+                             output_ttable);
+    TEST_ASSERT_EQUAL_INT(sizeof(input), len);
+    len = cipher_encrypt_ctr(&ni, ctr_ni, 0, input, sizeof(input), output_ni);
+    TEST_ASSERT_EQUAL_INT(sizeof(input), len);
+    cmp = compare(output_ttable, output_ni, sizeof(input));
+    TEST_ASSERT_MESSAGE(1 == cmp , "wrong ciphertext");
+    TEST_ASSERT_EQUAL_INT(0, memcmp(ctr_ttable, ctr_ni, 16));
+}
+#endif
 
 Test* tests_crypto_modes_ctr_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
         new_TestFixture(test_crypto_modes_ctr_encrypt),
-                        new_TestFixture(test_crypto_modes_ctr_decrypt)
+                        new_TestFixture(test_crypto_modes_ctr_decrypt),
+                        new_TestFixture(test_crypto_modes_ctr_unaligned),
+                        new_TestFixture(test_crypto_modes_ctr_many_blocks),
+#ifdef MODULE_CRYPTO_AES_NI
+                        new_TestFixture(test_crypto_modes_ctr_aes_ni),
+#endif
     };
 
     EMB_UNIT_TESTCALLER(crypto_modes_ctr_tests, NULL, NULL, fixtures);
@@ -0,0 +1,239 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include <string.h>
+
+#include "embUnit.h"
+#include "crypto/ciphers.h"
+#include "crypto/modes/gcm.h"
+#include "tests-crypto.h"
+
+#define TAG_LEN         (16U)
+
+/* Test Case 2 of "The Galois/Counter Mode of Operation (GCM)", McGrew and
+ * Viega */
+static const uint8_t TEST_1_KEY[] = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+};
+static const uint8_t TEST_1_IV[] = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00
+};
+static const uint8_t TEST_1_PLAIN[] = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+};
+static const uint8_t TEST_1_CIPHER[] = {
+    0x03, 0x88, 0xDA, 0xCE, 0x60, 0xB6, 0xA3, 0x92,
+    0xF3, 0x28, 0xC2, 0xB9, 0x71, 0xB2, 0xFE, 0x78,
+    0xAB, 0x6E, 0x47, 0xD4, 0x2C, 0xEC, 0x13, 0xBD,
+    0xF5, 0x3A, 0x67, 0xB2, 0x12, 0x57, 0xBD, 0xDF
+};
+
+/* Test Case 4: additional data and a partial last block */
+static const uint8_t TEST_2_KEY[] = {
+    0xFE, 0xFF, 0xE9, 0x92, 0x86, 0x65, 0x73, 0x1C,
+    0x6D, 0x6A, 0x8F, 0x94, 0x67, 0x30, 0x83, 0x08
+};
+static const uint8_t TEST_2_IV[] = {
+    0xCA, 0xFE, 0xBA, 0xBE, 0xFA, 0xCE, 0xDB, 0xAD,
+    0xDE, 0xCA, 0xF8, 0x88
+};
+static const uint8_t TEST_2_ADATA[] = {
+    0xFE, 0xED, 0xFA, 0xCE, 0xDE, 0xAD, 0xBE, 0xEF,
+    0xFE, 0xED, 0xFA, 0xCE, 0xDE, 0xAD, 0xBE, 0xEF,
+    0xAB, 0xAD, 0xDA, 0xD2
+};
+static const uint8_t TEST_2_PLAIN[] = {
+    0xD9, 0x31, 0x32, 0x25, 0xF8, 0x84, 0x06, 0xE5,
+    0xA5, 0x59, 0x09, 0xC5, 0xAF, 0xF5, 0x26, 0x9A,
+    0x86, 0xA7, 0xA9, 0x53, 0x15, 0x34, 0xF7, 0xDA,
+    0x2E, 0x4C, 0x30, 0x3D, 0x8A, 0x31, 0x8A, 0x72,
+    0x1C, 0x3C, 0x0C, 0x95, 0x95, 0x68, 0x09, 0x53,
+    0x2F, 0xCF, 0x0E, 0x24, 0x49, 0xA6, 0xB5, 0x25,
+    0xB1, 0x6A, 0xED, 0xF5, 0xAA, 0x0D, 0xE6, 0x57,
+    0xBA, 0x63, 0x7B, 0x39
+};
+static const uint8_t TEST_2_CIPHER[] = {
+    0x42, 0x83, 0x1E, 0xC2, 0x21, 0x77, 0x74, 0x24,
+    0x4B, 0x72, 0x21, 0xB7, 0x84, 0xD0, 0xD4, 0x9C,
+    0xE3, 0xAA, 0x21, 0x2F, 0x2C, 0x02, 0xA4, 0xE0,
+    0x35, 0xC1, 0x7E, 0x23, 0x29, 0xAC, 0xA1, 0x2E,
+    0x21, 0xD5, 0x14, 0xB2, 0x54, 0x66, 0x93, 0x1C,
+    0x7D, 0x8F, 0x6A, 0x5A, 0xAC, 0x84, 0xAA, 0x05,
+    0x1B, 0xA3, 0x0B, 0x39, 0x6A, 0x0A, 0xAC, 0x97,
+    0x3D, 0x58, 0xE0, 0x91, 0x5B, 0xC9, 0x4F, 0xBC,
+    0x32, 0x21, 0xA5, 0xDB, 0x94, 0xFA, 0xE9, 0x5A,
+    0xE7, 0x12, 0x1A, 0x47
+};
+
+/* Test Case 6: same key, data and additional data as test case 4, but a
+ * 60 octet IV */
+static const uint8_t TEST_3_IV[] = {
+    0x93, 0x13, 0x22, 0x5D, 0xF8, 0x84, 0x06, 0xE5,
+    0x55, 0x90, 0x9C, 0x5A, 0xFF, 0x52, 0x69, 0xAA,
+    0x6A, 0x7A, 0x95, 0x38, 0x53, 0x4F, 0x7D, 0xA1,
+    0xE4, 0xC3, 0x03, 0xD2, 0xA3, 0x18, 0xA7, 0x28,
+    0xC3, 0xC0, 0xC9, 0x51, 0x56, 0x80, 0x95, 0x39,
+    0xFC, 0xF0, 0xE2, 0x42, 0x9A, 0x6B, 0x52, 0x54,
+    0x16, 0xAE, 0xDB, 0xF5, 0xA0, 0xDE, 0x6A, 0x57,
+    0xA6, 0x37, 0xB3, 0x9B
+};
+static const uint8_t TEST_3_CIPHER[] = {
+    0x8C, 0xE2, 0x49, 0x98, 0x62, 0x56, 0x15, 0xB6,
+    0x03, 0xA0, 0x33, 0xAC, 0xA1, 0x3F, 0xB8, 0x94,
+    0xBE, 0x91, 0x12, 0xA5, 0xC3, 0xA2, 0x11, 0xA8,
+    0xBA, 0x26, 0x2A, 0x3C, 0xCA, 0x7E, 0x2C, 0xA7,
+    0x01, 0xE4, 0xA9, 0xA4, 0xFB, 0xA4, 0x3C, 0x90,
+    0xCC, 0xDC, 0xB2, 0x81, 0xD4, 0x8C, 0x7C, 0x6F,
+    0xD6, 0x28, 0x75, 0xD2, 0xAC, 0xA4, 0x17, 0x03,
+    0x4C, 0x34, 0xAE, 0xE5, 0x61, 0x9C, 0xC5, 0xAE,
+    0xFF, 0xFE, 0x0B, 0xFA, 0x46, 0x2A, 0xF4, 0x3C,
+    0x16, 0x99, 0xD0, 0x50
+};
+
+static uint8_t data[sizeof(TEST_2_CIPHER)];
+
+static void set_up(void)
+{
+    memset(data, 0, sizeof(data));
+}
+
+static void test_encrypt_op(const uint8_t *key, const uint8_t *iv,
+                            size_t iv_len, const uint8_t *adata,
+                            size_t adata_len, const uint8_t *plain,
+                            size_t plain_len, const uint8_t *expected)
+{
+    cipher_t cipher;
+    int len;
+
+    TEST_ASSERT_EQUAL_INT(1, cipher_init(&cipher, CIPHER_AES_128, key, 16));
+    len = cipher_encrypt_gcm(&cipher, adata, adata_len, TAG_LEN, iv, iv_len,
+                             plain, plain_len, data);
+    TEST_ASSERT_EQUAL_INT(plain_len + TAG_LEN, len);
+    TEST_ASSERT(memcmp(expected, data, len) == 0);
+}
+
+static void test_decrypt_op(const uint8_t *key, const uint8_t *iv,
+                            size_t iv_len, const uint8_t *adata,
+                            size_t adata_len, const uint8_t *cipher_text,
+                            size_t cipher_len, const uint8_t *expected)
+{
+    cipher_t cipher;
+    int len;
+
+    TEST_ASSERT_EQUAL_INT(1, cipher_init(&cipher, CIPHER_AES_128, key, 16));
+    len = cipher_decrypt_gcm(&cipher, adata, adata_len, TAG_LEN, iv, iv_len,
+                             cipher_text, cipher_len, data);
+    TEST_ASSERT_EQUAL_INT(cipher_len - TAG_LEN, len);
+    TEST_ASSERT(memcmp(expected, data, len) == 0);
+}
+
+static void test_crypto_modes_gcm_encrypt(void)
+{
+    test_encrypt_op(TEST_1_KEY, TEST_1_IV, sizeof(TEST_1_IV), NULL, 0,
+                    TEST_1_PLAIN, sizeof(TEST_1_PLAIN), TEST_1_CIPHER);
+    test_encrypt_op(TEST_2_KEY, TEST_2_IV, sizeof(TEST_2_IV), TEST_2_ADATA,
+                    sizeof(TEST_2_ADATA), TEST_2_PLAIN, sizeof(TEST_2_PLAIN),
+                    TEST_2_CIPHER);
+    test_encrypt_op(TEST_2_KEY, TEST_3_IV, sizeof(TEST_3_IV), TEST_2_ADATA,
+                    sizeof(TEST_2_ADATA), TEST_2_PLAIN, sizeof(TEST_2_PLAIN),
+                    TEST_3_CIPHER);
+}
+
+static void test_crypto_modes_gcm_decrypt(void)
+{
+    test_decrypt_op(TEST_1_KEY, TEST_1_IV, sizeof(TEST_1_IV), NULL, 0,
+                    TEST_1_CIPHER, sizeof(TEST_1_CIPHER), TEST_1_PLAIN);
+    test_decrypt_op(TEST_2_KEY, TEST_2_IV, sizeof(TEST_2_IV), TEST_2_ADATA,
+                    sizeof(TEST_2_ADATA), TEST_2_CIPHER, sizeof(TEST_2_CIPHER),
+                    TEST_2_PLAIN);
+    test_decrypt_op(TEST_2_KEY, TEST_3_IV, sizeof(TEST_3_IV), TEST_2_ADATA,
+                    sizeof(TEST_2_ADATA), TEST_3_CIPHER, sizeof(TEST_3_CIPHER),
+                    TEST_2_PLAIN);
+}
+
+static void test_crypto_modes_gcm_decrypt_invalid_tag(void)
+{
+    uint8_t input[sizeof(TEST_2_CIPHER)];
+    cipher_t cipher;
+    int len;
+
+    memcpy(input, TEST_2_CIPHER, sizeof(input));
+    input[sizeof(input) - 1] ^= 0x01;
+    TEST_ASSERT_EQUAL_INT(1, cipher_init(&cipher, CIPHER_AES_128, TEST_2_KEY, 16));
+    len = cipher_decrypt_gcm(&cipher, TEST_2_ADATA, sizeof(TEST_2_ADATA),
+                             TAG_LEN, TEST_2_IV, sizeof(TEST_2_IV), input,
+                             sizeof(input), data);
+    TEST_ASSERT_EQUAL_INT(GCM_ERR_INVALID_TAG, len);
+    /* no unauthenticated plaintext is released */
+    for (unsigned i = 0; i < sizeof(TEST_2_PLAIN); i++) {
+        TEST_ASSERT_EQUAL_INT(0, data[i]);
+    }
+}
+
+/* feeds the data in chunks that never line up with the blocks */
+static void test_crypto_modes_gcm_incremental(void)
+{
+    static const size_t chunks[] = { 1, 7, 16, 3, 33 };
+    uint8_t tag[TAG_LEN];
+    cipher_t cipher;
+    gcm_ctx_t gcm;
+    size_t offset = 0;
+
+    TEST_ASSERT_EQUAL_INT(1, cipher_init(&cipher, CIPHER_AES_128, TEST_2_KEY, 16));
+    TEST_ASSERT_EQUAL_INT(0, gcm_init(&gcm, &cipher, TEST_2_IV,
+                                      sizeof(TEST_2_IV)));
+    gcm_update_aad(&gcm, TEST_2_ADATA, 5);
+    gcm_update_aad(&gcm, &TEST_2_ADATA[5], sizeof(TEST_2_ADATA) - 5);
+    for (unsigned i = 0; offset < sizeof(TEST_2_PLAIN); i++) {
+        size_t len = chunks[i % (sizeof(chunks) / sizeof(chunks[0]))];
+
+        if (len > sizeof(TEST_2_PLAIN) - offset) {
+            len = sizeof(TEST_2_PLAIN) - offset;
+        }
+        TEST_ASSERT_EQUAL_INT(len, gcm_encrypt_update(&gcm, &TEST_2_PLAIN[offset],
+                                                      len, &data[offset]));
+        offset += len;
+    }
+    TEST_ASSERT_EQUAL_INT(0, gcm_finish(&gcm, tag, sizeof(tag)));
+    TEST_ASSERT(memcmp(TEST_2_CIPHER, data, sizeof(TEST_2_PLAIN)) == 0);
+    TEST_ASSERT(memcmp(&TEST_2_CIPHER[sizeof(TEST_2_PLAIN)], tag, sizeof(tag)) == 0);
+
+    /* decrypt in place with the same chunks */
+    TEST_ASSERT_EQUAL_INT(0, gcm_init(&gcm, &cipher, TEST_2_IV,
+                                      sizeof(TEST_2_IV)));
+    gcm_update_aad(&gcm, TEST_2_ADATA, sizeof(TEST_2_ADATA));
+    offset = 0;
+    for (unsigned i = 0; offset < sizeof(TEST_2_PLAIN); i++) {
+        size_t len = chunks[i % (sizeof(chunks) / sizeof(chunks[0]))];
+
+        if (len > sizeof(TEST_2_PLAIN) - offset) {
+            len = sizeof(TEST_2_PLAIN) - offset;
+        }
+        gcm_decrypt_update(&gcm, &data[offset], len, &data[offset]);
+        offset += len;
+    }
+    TEST_ASSERT_EQUAL_INT(0, gcm_verify(&gcm, tag, sizeof(tag)));
+    TEST_ASSERT(memcmp(TEST_2_PLAIN, data, sizeof(TEST_2_PLAIN)) == 0);
+}
+
+Test *tests_crypto_modes_gcm_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_crypto_modes_gcm_encrypt),
+        new_TestFixture(test_crypto_modes_gcm_decrypt),
+        new_TestFixture(test_crypto_modes_gcm_decrypt_invalid_tag),
+        new_TestFixture(test_crypto_modes_gcm_incremental),
+    };
+
+    EMB_UNIT_TESTCALLER(crypto_modes_gcm_tests, set_up, NULL, fixtures);
+
+    return (Test *)&crypto_modes_gcm_tests;
+}
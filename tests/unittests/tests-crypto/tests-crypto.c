@@ -18,4 +18,7 @@ void tests_crypto(void)
     TESTS_RUN(tests_crypto_modes_ecb_tests());
     TESTS_RUN(tests_crypto_modes_cbc_tests());
     TESTS_RUN(tests_crypto_modes_ctr_tests());
+    TESTS_RUN(tests_crypto_modes_gcm_tests());
+    TESTS_RUN(tests_crypto_chacha20poly1305_tests());
+    TESTS_RUN(tests_crypto_bench_tests());
 }
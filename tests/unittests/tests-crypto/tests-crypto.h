@@ -57,6 +57,9 @@ Test* tests_crypto_modes_ccm_tests(void);
 Test* tests_crypto_modes_ecb_tests(void);
 Test* tests_crypto_modes_cbc_tests(void);
 Test* tests_crypto_modes_ctr_tests(void);
+Test* tests_crypto_modes_gcm_tests(void);
+Test* tests_crypto_chacha20poly1305_tests(void);
+Test* tests_crypto_bench_tests(void);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,132 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+
+#include "net/gnrc/ipv6/nib.h"
+
+#include "_nib-internal.h"
+
+#include "tests-gnrc_ipv6_nib.h"
+
+/* number of events in the queue for test_evtimer_many(), each event is its
+ * own context, so no NIB entries are needed for them */
+#define EVENTS_NUMOF        (1024U)
+/* far enough in the future to never expire during the tests */
+#define OFFSET_BASE         (3600U * MS_PER_SEC)
+
+static _nib_onl_entry_t _entries[2];
+static evtimer_msg_event_t _events[EVENTS_NUMOF];
+
+static void set_up(void)
+{
+    while (_nib_evtimer.events != NULL) {
+        evtimer_del((evtimer_t *)(&_nib_evtimer), _nib_evtimer.events);
+    }
+    _nib_init();
+}
+
+static void tear_down(void)
+{
+    set_up();
+}
+
+/* spread the offsets, so the events are not added in order. 7919 is coprime
+ * to the modulus, so all offsets differ */
+static uint32_t _offset(unsigned i)
+{
+    return OFFSET_BASE + ((i * 7919U) % (EVENTS_NUMOF * 10U));
+}
+
+/*
+ * Adds an event and looks it up by its context and by another type of the same
+ * event
+ * Expected result: the lookup returns the offset for the queued type and
+ * UINT32_MAX for the other type and after the event was removed
+ */
+static void test_evtimer_lookup(void)
+{
+    uint32_t remaining;
+
+    _evtimer_add(&_entries[0], GNRC_IPV6_NIB_REACH_TIMEOUT,
+                 &_entries[0].nud_timeout, OFFSET_BASE);
+    remaining = _evtimer_lookup(&_entries[0], GNRC_IPV6_NIB_REACH_TIMEOUT);
+    TEST_ASSERT(remaining <= OFFSET_BASE);
+    TEST_ASSERT(remaining > (OFFSET_BASE - MS_PER_SEC));
+    TEST_ASSERT_EQUAL_INT(UINT32_MAX,
+                          _evtimer_lookup(&_entries[0], GNRC_IPV6_NIB_SND_MC_NS));
+    TEST_ASSERT_EQUAL_INT(UINT32_MAX,
+                          _evtimer_lookup(&_entries[1], GNRC_IPV6_NIB_REACH_TIMEOUT));
+    evtimer_del((evtimer_t *)(&_nib_evtimer), &_entries[0].nud_timeout.event);
+    TEST_ASSERT_EQUAL_INT(UINT32_MAX,
+                          _evtimer_lookup(&_entries[0], GNRC_IPV6_NIB_REACH_TIMEOUT));
+    TEST_ASSERT_NULL(_nib_evtimer.events);
+}
+
+/*
+ * Adds EVENTS_NUMOF events, looks all of them up, removes every second one and
+ * then all others by always removing the next event to expire
+ * Expected result: all lookups return their offset, the other events are
+ * removed in the order of their offsets, the event timer is empty in the end
+ */
+static void test_evtimer_many(void)
+{
+    uint32_t prev = 0;
+
+    for (unsigned i = 0; i < EVENTS_NUMOF; i++) {
+        _evtimer_add(&_events[i], GNRC_IPV6_NIB_REACH_TIMEOUT, &_events[i],
+                     _offset(i));
+    }
+    for (unsigned i = 0; i < EVENTS_NUMOF; i++) {
+        uint32_t remaining = _evtimer_lookup(&_events[i],
+                                             GNRC_IPV6_NIB_REACH_TIMEOUT);
+
+        TEST_ASSERT(remaining <= _offset(i));
+        TEST_ASSERT(remaining > (_offset(i) - MS_PER_SEC));
+    }
+    for (unsigned i = 0; i < EVENTS_NUMOF; i += 2) {
+        evtimer_del((evtimer_t *)(&_nib_evtimer), &_events[i].event);
+        TEST_ASSERT_EQUAL_INT(UINT32_MAX,
+                              _evtimer_lookup(&_events[i],
+                                              GNRC_IPV6_NIB_REACH_TIMEOUT));
+    }
+
+    for (unsigned i = 0; i < (EVENTS_NUMOF / 2); i++) {
+        evtimer_event_t *next = _nib_evtimer.events;
+        evtimer_msg_event_t *ctx;
+        unsigned idx;
+
+        TEST_ASSERT_NOT_NULL(next);
+        ctx = ((evtimer_msg_event_t *)next)->msg.content.ptr;
+        idx = ctx - _events;
+        /* only the events with odd indexes are left */
+        TEST_ASSERT_EQUAL_INT(1, idx & 1);
+        /* the next event to expire has the smallest offset left */
+        TEST_ASSERT(_offset(idx) > prev);
+        prev = _offset(idx);
+        evtimer_del((evtimer_t *)(&_nib_evtimer), next);
+    }
+    TEST_ASSERT_NULL(_nib_evtimer.events);
+}
+
+Test *tests_gnrc_ipv6_nib_evtimer_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_evtimer_lookup),
+        new_TestFixture(test_evtimer_many),
+    };
+
+    EMB_UNIT_TESTCALLER(tests, set_up, tear_down,
+                        fixtures);
+
+    return (Test *)&tests;
+}
@@ -64,6 +64,13 @@ Test *tests_gnrc_ipv6_nib_nc_tests(void);
  */
 Test *tests_gnrc_ipv6_nib_pl_tests(void);
 
+/**
+ * @brief   Generates tests for the event timer of the NIB
+ *
+ * @return  embUnit tests if successful, NULL if not.
+ */
+Test *tests_gnrc_ipv6_nib_evtimer_tests(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -200,16 +200,66 @@ static void test_hashes_sha256_hash_sequence_failing_compare(void)
                     hfailing_compare));
 }
 
+static const char long_sequence[] =
+    "RIOT is an open-source microkernel-based operating system, designed"
+    " to match the requirements of Internet of Things (IoT) devices and"
+    " other embedded devices. These requirements include a very low memory"
+    " footprint (on the order of a few kilobytes), high energy efficiency"
+    ", real-time capabilities, communication stacks for both wireless and"
+    " wired networks, and support for a wide range of low-power hardware.";
+
 static void test_hashes_sha256_hash_long_sequence(void)
 {
-    TEST_ASSERT(calc_and_compare_hash(
-                    "RIOT is an open-source microkernel-based operating system, designed"
-                    " to match the requirements of Internet of Things (IoT) devices and"
-                    " other embedded devices. These requirements include a very low memory"
-                    " footprint (on the order of a few kilobytes), high energy efficiency"
-                    ", real-time capabilities, communication stacks for both wireless and"
-                    " wired networks, and support for a wide range of low-power hardware.",
-                    hlong_sequence));
+    TEST_ASSERT(calc_and_compare_hash(long_sequence, hlong_sequence));
+}
+
+static void test_hashes_sha256_hash_long_sequence_chunked(void)
+{
+    /* chunks that leave partial blocks and pass complete blocks at
+     * unaligned addresses */
+    static const size_t chunks[] = { 1, 70, 5, 128, 3 };
+    unsigned char hash[SHA256_DIGEST_LENGTH];
+    size_t offset = 0, len = strlen(long_sequence);
+    sha256_context_t sha256;
+
+    sha256_init(&sha256);
+    for (unsigned i = 0; offset < len; i++) {
+        size_t chunk = chunks[i % (sizeof(chunks) / sizeof(chunks[0]))];
+
+        if (chunk > len - offset) {
+            chunk = len - offset;
+        }
+        sha256_update(&sha256, &long_sequence[offset], chunk);
+        offset += chunk;
+    }
+    sha256_final(&sha256, hash);
+    TEST_ASSERT(memcmp(hlong_sequence, hash, SHA256_DIGEST_LENGTH) == 0);
+}
+
+static void test_hashes_sha256_multi(void)
+{
+    /* more messages than lanes, of different lengths */
+    const void *data[] = {
+        long_sequence, "1234567890_1",
+        "0123456789abcde-0123456789abcde-0123456789abcde-0123456789abcde-",
+        "", "Franz jagt im komplett verwahrlosten Taxi quer durch Bayern",
+        long_sequence,
+    };
+    const unsigned char *expected[] = {
+        hlong_sequence, h01, hdigits_letters, hempty, hpangramm, hlong_sequence,
+    };
+    unsigned char hash[sizeof(data) / sizeof(data[0])][SHA256_DIGEST_LENGTH];
+    void *digest[sizeof(data) / sizeof(data[0])];
+    size_t len[sizeof(data) / sizeof(data[0])];
+
+    for (unsigned i = 0; i < sizeof(data) / sizeof(data[0]); i++) {
+        len[i] = strlen(data[i]);
+        digest[i] = hash[i];
+    }
+    sha256_multi(data, len, digest, sizeof(data) / sizeof(data[0]));
+    for (unsigned i = 0; i < sizeof(data) / sizeof(data[0]); i++) {
+        TEST_ASSERT(memcmp(expected[i], hash[i], SHA256_DIGEST_LENGTH) == 0);
+    }
 }
 
 Test *tests_hashes_sha256_tests(void)
@@ -227,6 +277,8 @@ Test *tests_hashes_sha256_tests(void)
         new_TestFixture(test_hashes_sha256_hash_sequence_failing_compare),
 
         new_TestFixture(test_hashes_sha256_hash_long_sequence),
+        new_TestFixture(test_hashes_sha256_hash_long_sequence_chunked),
+        new_TestFixture(test_hashes_sha256_multi),
     };
 
     EMB_UNIT_TESTCALLER(hashes_sha256_tests, NULL, NULL,
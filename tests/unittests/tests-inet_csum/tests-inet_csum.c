@@ -13,10 +13,12 @@
  */
 #include <errno.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "embUnit.h"
 
 #include "net/inet_csum.h"
+#include "net/ipv6/hdr.h"
 
 #include "unittests-constants.h"
 #include "tests-inet_csum.h"
@@ -165,6 +167,97 @@ static void test_inet_csum__empty_app_buffer(void)
     TEST_ASSERT_EQUAL_INT(hdr_expected, pyld_sum);
 }
 
+#define BUF_SIZE        (64U)
+
+static uint8_t _buf[BUF_SIZE + sizeof(uint32_t)];
+
+/* byte-wise reference implementation of inet_csum_slice() */
+static uint16_t _ref_csum(uint16_t sum, const uint8_t *buf, uint16_t len,
+                          size_t accum_len)
+{
+    uint32_t csum = sum;
+
+    for (unsigned i = 0; i < len; i++) {
+        csum += ((accum_len + i) & 1) ? buf[i] : (buf[i] << 8);
+    }
+    while (csum >> 16) {
+        csum = (csum & 0xffff) + (csum >> 16);
+    }
+    return csum;
+}
+
+static void _fill_buf(void)
+{
+    for (unsigned i = 0; i < sizeof(_buf); i++) {
+        _buf[i] = (uint8_t)((i * 131U) ^ (i >> 3));
+    }
+}
+
+static void test_inet_csum__unaligned(void)
+{
+    _fill_buf();
+    /* every start alignment, odd and even positions in the domain and lengths
+     * around the word and unrolled loop sizes */
+    for (unsigned offset = 0; offset < sizeof(uint32_t); offset++) {
+        for (unsigned accum_len = 0; accum_len < 2; accum_len++) {
+            for (uint16_t len = 0; len <= BUF_SIZE; len++) {
+                TEST_ASSERT_EQUAL_INT(_ref_csum(0x1234, &_buf[offset], len,
+                                                accum_len),
+                                      inet_csum_slice(0x1234, &_buf[offset],
+                                                      len, accum_len));
+            }
+        }
+    }
+}
+
+static void test_inet_csum__slices(void)
+{
+    uint16_t sum = 0;
+    size_t accum_len = 0;
+    /* slices of odd and even sizes at odd and even offsets */
+    static const uint16_t slices[] = { 3, 8, 1, 5, 16, 2, 29 };
+
+    _fill_buf();
+    for (unsigned i = 0; i < sizeof(slices) / sizeof(slices[0]); i++) {
+        sum = inet_csum_slice(sum, &_buf[accum_len], slices[i], accum_len);
+        accum_len += slices[i];
+    }
+    TEST_ASSERT_EQUAL_INT(inet_csum(0, _buf, accum_len), sum);
+}
+
+static void test_inet_csum__update(void)
+{
+    uint8_t data[] = {
+        0x00, 0x01, 0xf2, 0x03, 0xf4, 0xf5, 0xf6, 0xf7
+    };
+    uint16_t sum = inet_csum(0, data, sizeof(data));
+
+    /* change the word 0xf203 to 0x1234 */
+    data[2] = 0x12;
+    data[3] = 0x34;
+    TEST_ASSERT_EQUAL_INT(inet_csum(0, data, sizeof(data)),
+                          inet_csum_update(sum, 0xf203, 0x1234));
+}
+
+static void test_inet_csum__ipv6_hdr(void)
+{
+    ipv6_hdr_t hdr;
+    /* addresses, upper-layer length and next header */
+    uint8_t pseudo_hdr[2 * sizeof(ipv6_addr_t) + 8] = { 0 };
+
+    _fill_buf();
+    memcpy(&hdr.src, &_buf[0], 2 * sizeof(ipv6_addr_t));
+    memcpy(pseudo_hdr, &_buf[0], 2 * sizeof(ipv6_addr_t));
+    pseudo_hdr[sizeof(pseudo_hdr) - 1] = 17;
+    /* lengths around the overflow of the 16-bit sum */
+    for (uint16_t len = 0xfff0; len != 0x0010; len++) {
+        pseudo_hdr[sizeof(pseudo_hdr) - 6] = len >> 8;
+        pseudo_hdr[sizeof(pseudo_hdr) - 5] = len & 0xff;
+        TEST_ASSERT_EQUAL_INT(inet_csum(0xfedc, pseudo_hdr, sizeof(pseudo_hdr)),
+                              ipv6_hdr_inet_csum(0xfedc, &hdr, 17, len));
+    }
+}
+
 Test *tests_inet_csum_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -176,6 +269,10 @@ Test *tests_inet_csum_tests(void)
         new_TestFixture(test_inet_csum__odd_len),
         new_TestFixture(test_inet_csum__two_app_snips),
         new_TestFixture(test_inet_csum__empty_app_buffer),
+        new_TestFixture(test_inet_csum__unaligned),
+        new_TestFixture(test_inet_csum__slices),
+        new_TestFixture(test_inet_csum__update),
+        new_TestFixture(test_inet_csum__ipv6_hdr),
     };
 
     EMB_UNIT_TESTCALLER(inet_csum_tests, NULL, NULL, fixtures);
@@ -0,0 +1,368 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <string.h>
+#include <errno.h>
+
+#include "embUnit.h"
+
+#include "mtd.h"
+#include "mtd_cache.h"
+#include "board.h"
+
+#include "tests-mtd_cache.h"
+
+#define SECTOR_COUNT    (8U)
+#define PAGE_PER_SECTOR (4U)
+#define PAGE_SIZE       (64U)
+#define SECTOR_SIZE     (PAGE_PER_SECTOR * PAGE_SIZE)
+#define CACHE_NUMOF     (4U)
+
+/* Test mock object implementing a RAM-based flash, which counts the
+ * accesses */
+static uint8_t dummy_memory[SECTOR_COUNT * SECTOR_SIZE];
+static unsigned reads, writes, erases;
+
+static int init(mtd_dev_t *dev)
+{
+    (void)dev;
+
+    memset(dummy_memory, 0xff, sizeof(dummy_memory));
+    return 0;
+}
+
+static int read(mtd_dev_t *dev, void *buff, uint32_t addr, uint32_t size)
+{
+    (void)dev;
+
+    if (addr + size > sizeof(dummy_memory)) {
+        return -EOVERFLOW;
+    }
+    memcpy(buff, dummy_memory + addr, size);
+    reads++;
+
+    return size;
+}
+
+static int write(mtd_dev_t *dev, const void *buff, uint32_t addr, uint32_t size)
+{
+    (void)dev;
+
+    if (addr + size > sizeof(dummy_memory)) {
+        return -EOVERFLOW;
+    }
+    if ((addr % PAGE_SIZE) + size > PAGE_SIZE) {
+        return -EOVERFLOW;
+    }
+    for (unsigned i = 0; i < size; i++) {
+        dummy_memory[addr + i] &= ((const uint8_t *)buff)[i];
+    }
+    writes++;
+
+    return size;
+}
+
+static int erase(mtd_dev_t *dev, uint32_t addr, uint32_t size)
+{
+    (void)dev;
+
+    if ((size % SECTOR_SIZE != 0) || (addr % SECTOR_SIZE != 0)) {
+        return -EOVERFLOW;
+    }
+    if (addr + size > sizeof(dummy_memory)) {
+        return -EOVERFLOW;
+    }
+    memset(dummy_memory + addr, 0xff, size);
+    erases++;
+
+    return 0;
+}
+
+static int power(mtd_dev_t *dev, enum mtd_power_state power)
+{
+    (void)dev;
+    (void)power;
+    return 0;
+}
+
+static const mtd_desc_t driver = {
+    .init = init,
+    .read = read,
+    .write = write,
+    .erase = erase,
+    .power = power,
+};
+
+static mtd_dev_t parent = {
+    .driver = &driver,
+    .sector_count = SECTOR_COUNT,
+    .pages_per_sector = PAGE_PER_SECTOR,
+    .page_size = PAGE_SIZE,
+};
+
+static uint8_t cache_buf[CACHE_NUMOF * PAGE_SIZE];
+static mtd_cache_page_t cache_pages[CACHE_NUMOF];
+
+static mtd_cache_t cache = {
+    .base = { .driver = &mtd_cache_driver },
+    .parent = &parent,
+    .pages = cache_pages,
+    .buf = cache_buf,
+    .numof = CACHE_NUMOF,
+};
+
+static mtd_dev_t *dev = (mtd_dev_t *)&cache;
+
+static uint8_t buf[2 * PAGE_SIZE];
+
+static void set_up(void)
+{
+    mtd_init(dev);
+    reads = 0;
+    writes = 0;
+    erases = 0;
+}
+
+static void test_mtd_cache_init(void)
+{
+    TEST_ASSERT_EQUAL_INT(SECTOR_COUNT, dev->sector_count);
+    TEST_ASSERT_EQUAL_INT(PAGE_PER_SECTOR, dev->pages_per_sector);
+    TEST_ASSERT_EQUAL_INT(PAGE_SIZE, dev->page_size);
+    TEST_ASSERT_EQUAL_INT(0, cache.stats.hits);
+    TEST_ASSERT_EQUAL_INT(0, cache.stats.misses);
+}
+
+static void test_mtd_cache_read_hit(void)
+{
+    dummy_memory[5] = 0x42;
+
+    /* reading a page in small pieces only reads it from the parent once */
+    for (unsigned i = 0; i < PAGE_SIZE; i += 8) {
+        TEST_ASSERT_EQUAL_INT(8, mtd_read(dev, buf, i, 8));
+    }
+    TEST_ASSERT_EQUAL_INT(1, reads);
+    TEST_ASSERT_EQUAL_INT(1, cache.stats.misses);
+    TEST_ASSERT_EQUAL_INT(PAGE_SIZE / 8 - 1, cache.stats.hits);
+
+    TEST_ASSERT_EQUAL_INT(1, mtd_read(dev, buf, 5, 1));
+    TEST_ASSERT_EQUAL_INT(0x42, buf[0]);
+
+    /* out of bounds */
+    TEST_ASSERT_EQUAL_INT(-EOVERFLOW, mtd_read(dev, buf,
+                                               sizeof(dummy_memory) - 4, 8));
+}
+
+static void test_mtd_cache_write_coalescing(void)
+{
+    for (unsigned i = 0; i < PAGE_SIZE; i++) {
+        buf[i] = i;
+    }
+    for (unsigned i = 0; i < PAGE_SIZE; i += 4) {
+        TEST_ASSERT_EQUAL_INT(4, mtd_write(dev, &buf[i], PAGE_SIZE + i, 4));
+    }
+    TEST_ASSERT_EQUAL_INT(0, writes);
+    TEST_ASSERT_EQUAL_INT(1, reads);
+
+    TEST_ASSERT_EQUAL_INT(0, mtd_cache_flush(&cache));
+    TEST_ASSERT_EQUAL_INT(1, writes);
+    TEST_ASSERT_EQUAL_INT(1, cache.stats.writes);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(buf, &dummy_memory[PAGE_SIZE], PAGE_SIZE));
+
+    /* nothing left to write */
+    TEST_ASSERT_EQUAL_INT(0, mtd_cache_flush(&cache));
+    TEST_ASSERT_EQUAL_INT(1, writes);
+}
+
+static void test_mtd_cache_write_full_page(void)
+{
+    memset(buf, 0x5a, sizeof(buf));
+
+    /* two whole pages, not aligned to the start of the sector */
+    TEST_ASSERT_EQUAL_INT(2 * PAGE_SIZE,
+                          mtd_write(dev, buf, 2 * PAGE_SIZE, 2 * PAGE_SIZE));
+    TEST_ASSERT_EQUAL_INT(0, reads);
+    TEST_ASSERT_EQUAL_INT(0, mtd_cache_flush(&cache));
+    TEST_ASSERT_EQUAL_INT(2, writes);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(buf, &dummy_memory[2 * PAGE_SIZE],
+                                    2 * PAGE_SIZE));
+}
+
+static void test_mtd_cache_write_across_pages(void)
+{
+    const char text[] = "ABCDEFGHIJK";
+
+    TEST_ASSERT_EQUAL_INT(sizeof(text), mtd_write(dev, text, PAGE_SIZE - 4,
+                                                  sizeof(text)));
+    memset(buf, 0, sizeof(buf));
+    TEST_ASSERT_EQUAL_INT(sizeof(text), mtd_read(dev, buf, PAGE_SIZE - 4,
+                                                 sizeof(text)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(text, buf, sizeof(text)));
+
+    TEST_ASSERT_EQUAL_INT(0, mtd_cache_flush(&cache));
+    TEST_ASSERT_EQUAL_INT(2, writes);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(text, &dummy_memory[PAGE_SIZE - 4],
+                                    sizeof(text)));
+}
+
+static void test_mtd_cache_deferred_erase(void)
+{
+    memset(buf, 0, PAGE_SIZE);
+    mtd_write(dev, buf, SECTOR_SIZE, PAGE_SIZE);
+    mtd_cache_flush(&cache);
+    writes = 0;
+
+    /* the erase voids the cached page and is not yet performed */
+    TEST_ASSERT_EQUAL_INT(0, mtd_erase(dev, SECTOR_SIZE, SECTOR_SIZE));
+    TEST_ASSERT_EQUAL_INT(-EOVERFLOW, mtd_erase(dev, PAGE_SIZE, SECTOR_SIZE));
+    TEST_ASSERT_EQUAL_INT(0, erases);
+    TEST_ASSERT_EQUAL_INT(0x00, dummy_memory[SECTOR_SIZE]);
+
+    /* the erased sector reads as 0xff without reading the parent */
+    TEST_ASSERT_EQUAL_INT(PAGE_SIZE, mtd_read(dev, buf, SECTOR_SIZE + 3,
+                                              PAGE_SIZE));
+    for (unsigned i = 0; i < PAGE_SIZE; i++) {
+        TEST_ASSERT_EQUAL_INT(0xff, buf[i]);
+    }
+    TEST_ASSERT_EQUAL_INT(0, reads);
+
+    /* the erase precedes the write back */
+    buf[0] = 0x12;
+    mtd_write(dev, buf, SECTOR_SIZE + 1, 1);
+    TEST_ASSERT_EQUAL_INT(0, mtd_cache_flush(&cache));
+    TEST_ASSERT_EQUAL_INT(1, erases);
+    TEST_ASSERT_EQUAL_INT(1, cache.stats.erases);
+    TEST_ASSERT_EQUAL_INT(1, writes);
+    TEST_ASSERT_EQUAL_INT(0xff, dummy_memory[SECTOR_SIZE]);
+    TEST_ASSERT_EQUAL_INT(0x12, dummy_memory[SECTOR_SIZE + 1]);
+    TEST_ASSERT_EQUAL_INT(0, reads);
+}
+
+static void test_mtd_cache_erase_all(void)
+{
+    /* more sectors than erases can be deferred */
+    TEST_ASSERT_EQUAL_INT(0, mtd_erase(dev, 0, sizeof(dummy_memory)));
+    TEST_ASSERT_EQUAL_INT(SECTOR_COUNT - MTD_CACHE_ERASE_NUMOF, erases);
+    TEST_ASSERT_EQUAL_INT(0, mtd_cache_flush(&cache));
+    TEST_ASSERT_EQUAL_INT(SECTOR_COUNT, erases);
+}
+
+static void test_mtd_cache_lru(void)
+{
+    /* fill the cache with pages 0 to 3, page 0 is used most recently */
+    for (unsigned i = 0; i < CACHE_NUMOF; i++) {
+        mtd_read(dev, buf, i * PAGE_SIZE, 1);
+    }
+    mtd_read(dev, buf, 0, 1);
+    TEST_ASSERT_EQUAL_INT(CACHE_NUMOF, reads);
+
+    /* page 4 evicts page 1 */
+    buf[0] = 0xaa;
+    mtd_write(dev, buf, 4 * PAGE_SIZE, 1);
+    mtd_read(dev, buf, 0, 1);
+    TEST_ASSERT_EQUAL_INT(CACHE_NUMOF + 1, reads);
+    mtd_read(dev, buf, PAGE_SIZE, 1);
+    TEST_ASSERT_EQUAL_INT(CACHE_NUMOF + 2, reads);
+
+    /* page 2 is evicted now, the dirty page 4 stays cached */
+    TEST_ASSERT_EQUAL_INT(0, writes);
+    mtd_read(dev, buf, 4 * PAGE_SIZE, 1);
+    TEST_ASSERT_EQUAL_INT(CACHE_NUMOF + 2, reads);
+    TEST_ASSERT_EQUAL_INT(0xaa, buf[0]);
+
+    /* reading pages 5 to 8 evicts the dirty page */
+    for (unsigned i = 5; i < 5 + CACHE_NUMOF; i++) {
+        mtd_read(dev, buf, i * PAGE_SIZE, 1);
+    }
+    TEST_ASSERT_EQUAL_INT(1, writes);
+    TEST_ASSERT_EQUAL_INT(0xaa, dummy_memory[4 * PAGE_SIZE]);
+}
+
+static void test_mtd_cache_power_down(void)
+{
+    buf[0] = 0x55;
+    mtd_write(dev, buf, 0, 1);
+    TEST_ASSERT_EQUAL_INT(0, mtd_power(dev, MTD_POWER_DOWN));
+    TEST_ASSERT_EQUAL_INT(1, writes);
+    TEST_ASSERT_EQUAL_INT(0x55, dummy_memory[0]);
+}
+
+#ifdef MTD_0
+/* size of the cache pages for the MTD of the board, can be raised for boards
+ * with larger pages */
+#ifndef BOARD_PAGE_SIZE_MAX
+#define BOARD_PAGE_SIZE_MAX (256U)
+#endif
+
+static void test_mtd_cache_board_mtd(void)
+{
+    static uint8_t board_buf[CACHE_NUMOF * BOARD_PAGE_SIZE_MAX];
+    mtd_cache_t board_cache = {
+        .base = { .driver = &mtd_cache_driver },
+        .parent = MTD_0,
+        .pages = cache_pages,
+        .buf = board_buf,
+        .numof = CACHE_NUMOF,
+    };
+    mtd_dev_t *bdev = (mtd_dev_t *)&board_cache;
+
+    /* the cache doesn't know the size of its buffer, so the page size of the
+     * board is checked before the cache can write beyond it */
+    TEST_ASSERT_EQUAL_INT(0, mtd_init(MTD_0));
+    TEST_ASSERT_MESSAGE(MTD_0->page_size <= BOARD_PAGE_SIZE_MAX,
+                        "page size of MTD_0 exceeds BOARD_PAGE_SIZE_MAX");
+    TEST_ASSERT_EQUAL_INT(0, mtd_init(bdev));
+    uint32_t sector_size = bdev->pages_per_sector * bdev->page_size;
+
+    for (unsigned i = 0; i < sizeof(buf); i++) {
+        buf[i] = i * 3;
+    }
+    TEST_ASSERT_EQUAL_INT(0, mtd_erase(bdev, 0, sector_size));
+    for (unsigned i = 0; i < sizeof(buf); i += 16) {
+        TEST_ASSERT_EQUAL_INT(16, mtd_write(bdev, &buf[i], 7 + i, 16));
+    }
+    TEST_ASSERT_EQUAL_INT(0, mtd_cache_flush(&board_cache));
+
+    uint8_t check[sizeof(buf)];
+    TEST_ASSERT_EQUAL_INT(sizeof(check), mtd_read(MTD_0, check, 7,
+                                                  sizeof(check)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(buf, check, sizeof(buf)));
+}
+#endif
+
+Test *tests_mtd_cache_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_mtd_cache_init),
+        new_TestFixture(test_mtd_cache_read_hit),
+        new_TestFixture(test_mtd_cache_write_coalescing),
+        new_TestFixture(test_mtd_cache_write_full_page),
+        new_TestFixture(test_mtd_cache_write_across_pages),
+        new_TestFixture(test_mtd_cache_deferred_erase),
+        new_TestFixture(test_mtd_cache_erase_all),
+        new_TestFixture(test_mtd_cache_lru),
+        new_TestFixture(test_mtd_cache_power_down),
+#ifdef MTD_0
+        new_TestFixture(test_mtd_cache_board_mtd),
+#endif
+    };
+
+    EMB_UNIT_TESTCALLER(mtd_cache_tests, set_up, NULL, fixtures);
+
+    return (Test *)&mtd_cache_tests;
+}
+
+void tests_mtd_cache(void)
+{
+    TESTS_RUN(tests_mtd_cache_tests());
+}
+/** @} */
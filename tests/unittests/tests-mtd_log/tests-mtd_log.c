@@ -0,0 +1,371 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <string.h>
+#include <errno.h>
+
+#include "embUnit.h"
+
+#include "mtd.h"
+#include "mtd_log.h"
+
+#include "tests-mtd_log.h"
+
+#define SECTOR_COUNT    (5U)
+#define PAGE_PER_SECTOR (4U)
+#define PAGE_SIZE       (64U)
+#define SECTOR_SIZE     (PAGE_PER_SECTOR * PAGE_SIZE)
+#define LOG_NUMOF       (4U)
+
+/* 20 byte payloads take 32 bytes with their header, 7 fit a sector */
+#define PAYLOAD_SIZE    (20U)
+#define RECORD_SIZE     (32U)
+#define PER_SECTOR      ((SECTOR_SIZE - MTD_LOG_SECTOR_HDR_SIZE) / RECORD_SIZE)
+
+/* Test mock object implementing a RAM-based NOR flash, which keeps its
+ * contents on init to simulate a reboot */
+static uint8_t dummy_memory[SECTOR_COUNT * SECTOR_SIZE];
+static unsigned erases;
+
+static int init(mtd_dev_t *dev)
+{
+    (void)dev;
+    return 0;
+}
+
+static int read(mtd_dev_t *dev, void *buff, uint32_t addr, uint32_t size)
+{
+    (void)dev;
+
+    if (addr + size > sizeof(dummy_memory)) {
+        return -EOVERFLOW;
+    }
+    memcpy(buff, dummy_memory + addr, size);
+
+    return size;
+}
+
+static int write(mtd_dev_t *dev, const void *buff, uint32_t addr, uint32_t size)
+{
+    (void)dev;
+
+    if (addr + size > sizeof(dummy_memory)) {
+        return -EOVERFLOW;
+    }
+    if ((addr % PAGE_SIZE) + size > PAGE_SIZE) {
+        return -EOVERFLOW;
+    }
+    for (unsigned i = 0; i < size; i++) {
+        dummy_memory[addr + i] &= ((const uint8_t *)buff)[i];
+    }
+
+    return size;
+}
+
+static int erase(mtd_dev_t *dev, uint32_t addr, uint32_t size)
+{
+    (void)dev;
+
+    if ((size % SECTOR_SIZE != 0) || (addr % SECTOR_SIZE != 0)) {
+        return -EOVERFLOW;
+    }
+    if (addr + size > sizeof(dummy_memory)) {
+        return -EOVERFLOW;
+    }
+    memset(dummy_memory + addr, 0xff, size);
+    erases++;
+
+    return 0;
+}
+
+static int power(mtd_dev_t *dev, enum mtd_power_state power)
+{
+    (void)dev;
+    (void)power;
+    return 0;
+}
+
+static const mtd_desc_t driver = {
+    .init = init,
+    .read = read,
+    .write = write,
+    .erase = erase,
+    .power = power,
+};
+
+static mtd_dev_t dev = {
+    .driver = &driver,
+    .sector_count = SECTOR_COUNT,
+    .pages_per_sector = PAGE_PER_SECTOR,
+    .page_size = PAGE_SIZE,
+};
+
+static mtd_log_sector_t sectors[LOG_NUMOF];
+
+/* the log leaves the first sector of the device untouched */
+static mtd_log_t test_log = {
+    .mtd = &dev,
+    .first_sector = 1,
+    .sector_numof = LOG_NUMOF,
+    .sectors = sectors,
+};
+
+static uint8_t buf[PAYLOAD_SIZE];
+
+static void _fill(uint8_t *data, unsigned n)
+{
+    memset(data, n, PAYLOAD_SIZE);
+    data[0] = n >> 8;
+}
+
+static void _append(unsigned from, unsigned to)
+{
+    for (unsigned i = from; i < to; i++) {
+        _fill(buf, i);
+        TEST_ASSERT_EQUAL_INT(0, mtd_log_append(&test_log, i, buf,
+                                                PAYLOAD_SIZE));
+    }
+}
+
+/* checks that the iterator yields the records from to to in order */
+static void _check(mtd_log_iter_t *iter, unsigned from, unsigned to)
+{
+    uint8_t expected[PAYLOAD_SIZE];
+    uint32_t time;
+
+    for (unsigned i = from; i < to; i++) {
+        _fill(expected, i);
+        TEST_ASSERT_EQUAL_INT(PAYLOAD_SIZE,
+                              mtd_log_iter_next(&test_log, iter, buf,
+                                                sizeof(buf), &time));
+        TEST_ASSERT_EQUAL_INT(i, time);
+        TEST_ASSERT_EQUAL_INT(0, memcmp(expected, buf, PAYLOAD_SIZE));
+    }
+    TEST_ASSERT_EQUAL_INT(-ENOENT, mtd_log_iter_next(&test_log, iter, buf,
+                                                     sizeof(buf), &time));
+}
+
+static void set_up(void)
+{
+    memset(dummy_memory, 0xff, sizeof(dummy_memory));
+    mtd_log_mount(&test_log);
+    erases = 0;
+}
+
+static void test_mtd_log_empty(void)
+{
+    mtd_log_iter_t iter;
+
+    mtd_log_iter_init(&test_log, &iter);
+    TEST_ASSERT_EQUAL_INT(-ENOENT, mtd_log_iter_next(&test_log, &iter, buf,
+                                                     sizeof(buf), NULL));
+    TEST_ASSERT_EQUAL_INT(-ENOENT, mtd_log_iter_seek(&test_log, &iter, 0));
+
+    /* too few sectors or not inside the device */
+    mtd_log_t bad = test_log;
+    bad.sector_numof = 1;
+    TEST_ASSERT_EQUAL_INT(-EINVAL, mtd_log_mount(&bad));
+    bad.sector_numof = SECTOR_COUNT;
+    TEST_ASSERT_EQUAL_INT(-EINVAL, mtd_log_mount(&bad));
+}
+
+static void test_mtd_log_append_iter(void)
+{
+    mtd_log_iter_t iter;
+
+    /* spans several pages and two sectors */
+    _append(0, PER_SECTOR + 3);
+    TEST_ASSERT_EQUAL_INT(2, erases);
+    mtd_log_iter_init(&test_log, &iter);
+    _check(&iter, 0, PER_SECTOR + 3);
+
+    /* the sector before the log is untouched */
+    for (unsigned i = 0; i < SECTOR_SIZE; i++) {
+        TEST_ASSERT_EQUAL_INT(0xff, dummy_memory[i]);
+    }
+
+    /* the iterator picks up records appended later */
+    _append(PER_SECTOR + 3, PER_SECTOR + 4);
+    _check(&iter, PER_SECTOR + 3, PER_SECTOR + 4);
+}
+
+static void test_mtd_log_remount(void)
+{
+    mtd_log_iter_t iter;
+
+    _append(0, PER_SECTOR + 2);
+    TEST_ASSERT_EQUAL_INT(0, mtd_log_mount(&test_log));
+    _append(PER_SECTOR + 2, 2 * PER_SECTOR);
+    TEST_ASSERT_EQUAL_INT(0, mtd_log_mount(&test_log));
+    _append(2 * PER_SECTOR, 2 * PER_SECTOR + 1);
+    mtd_log_iter_init(&test_log, &iter);
+    _check(&iter, 0, 2 * PER_SECTOR + 1);
+}
+
+static void test_mtd_log_rotation(void)
+{
+    mtd_log_iter_t iter;
+    unsigned total = 10 * LOG_NUMOF * PER_SECTOR + 3;
+    uint32_t min = UINT32_MAX, max = 0;
+
+    _append(0, total);
+    mtd_log_iter_init(&test_log, &iter);
+    /* the newest sector holds 3 records, the others are full */
+    _check(&iter, total - 3 - (LOG_NUMOF - 1) * PER_SECTOR, total);
+
+    /* all sectors wear evenly */
+    for (unsigned i = 0; i < LOG_NUMOF; i++) {
+        if (sectors[i].erase_count < min) {
+            min = sectors[i].erase_count;
+        }
+        if (sectors[i].erase_count > max) {
+            max = sectors[i].erase_count;
+        }
+    }
+    TEST_ASSERT(max - min <= 1);
+    TEST_ASSERT(min >= 10);
+
+    /* erase counters survive a remount */
+    TEST_ASSERT_EQUAL_INT(0, mtd_log_mount(&test_log));
+    for (unsigned i = 0; i < LOG_NUMOF; i++) {
+        TEST_ASSERT(sectors[i].erase_count >= min);
+    }
+    mtd_log_iter_init(&test_log, &iter);
+    _check(&iter, total - 3 - (LOG_NUMOF - 1) * PER_SECTOR, total);
+}
+
+static void test_mtd_log_overtaken(void)
+{
+    mtd_log_iter_t iter;
+    unsigned total = LOG_NUMOF * PER_SECTOR;
+
+    _append(0, total);
+    mtd_log_iter_init(&test_log, &iter);
+    TEST_ASSERT_EQUAL_INT(PAYLOAD_SIZE,
+                          mtd_log_iter_next(&test_log, &iter, buf,
+                                            sizeof(buf), NULL));
+
+    /* the sector of the iterator is reused, it continues at the oldest */
+    _append(total, total + 1);
+    _check(&iter, PER_SECTOR, total + 1);
+}
+
+static void test_mtd_log_seek(void)
+{
+    mtd_log_iter_t iter;
+    unsigned total = LOG_NUMOF * PER_SECTOR + 2;
+    unsigned oldest = PER_SECTOR;
+
+    _append(0, total);
+    for (unsigned i = oldest; i < total; i++) {
+        TEST_ASSERT_EQUAL_INT(0, mtd_log_iter_seek(&test_log, &iter, i));
+        _check(&iter, i, total);
+    }
+
+    /* before the oldest and after the newest record */
+    TEST_ASSERT_EQUAL_INT(0, mtd_log_iter_seek(&test_log, &iter, 0));
+    _check(&iter, oldest, total);
+    TEST_ASSERT_EQUAL_INT(-ENOENT, mtd_log_iter_seek(&test_log, &iter, total));
+}
+
+static void test_mtd_log_bad_crc(void)
+{
+    mtd_log_iter_t iter;
+    uint32_t second = SECTOR_SIZE + MTD_LOG_SECTOR_HDR_SIZE + RECORD_SIZE;
+
+    _append(0, 3);
+    /* corrupt the payload of the second record */
+    dummy_memory[second + MTD_LOG_RECORD_HDR_SIZE + 5] ^= 0x10;
+
+    mtd_log_iter_init(&test_log, &iter);
+    TEST_ASSERT_EQUAL_INT(PAYLOAD_SIZE,
+                          mtd_log_iter_next(&test_log, &iter, buf,
+                                            sizeof(buf), NULL));
+    TEST_ASSERT_EQUAL_INT(0, buf[1]);
+    _check(&iter, 2, 3);
+
+    /* a corrupted record doesn't block a too small buffer */
+    mtd_log_iter_init(&test_log, &iter);
+    TEST_ASSERT_EQUAL_INT(-ENOBUFS,
+                          mtd_log_iter_next(&test_log, &iter, buf, 4, NULL));
+    TEST_ASSERT_EQUAL_INT(PAYLOAD_SIZE,
+                          mtd_log_iter_next(&test_log, &iter, buf,
+                                            sizeof(buf), NULL));
+    TEST_ASSERT_EQUAL_INT(-ENOBUFS,
+                          mtd_log_iter_next(&test_log, &iter, buf, 4, NULL));
+}
+
+static void test_mtd_log_torn_header(void)
+{
+    mtd_log_iter_t iter;
+    uint32_t end = SECTOR_SIZE + MTD_LOG_SECTOR_HDR_SIZE + 2 * RECORD_SIZE;
+
+    _append(0, 2);
+    /* power loss while programming the length of the third record */
+    dummy_memory[end] = 0x14;
+
+    TEST_ASSERT_EQUAL_INT(0, mtd_log_mount(&test_log));
+    _append(2, 4);
+    mtd_log_iter_init(&test_log, &iter);
+    _check(&iter, 0, 4);
+    /* the appends continued in the next sector */
+    TEST_ASSERT_EQUAL_INT(2, dummy_memory[2 * SECTOR_SIZE +
+                                          MTD_LOG_SECTOR_HDR_SIZE +
+                                          MTD_LOG_RECORD_HDR_SIZE + 1]);
+}
+
+static void test_mtd_log_format(void)
+{
+    mtd_log_iter_t iter;
+
+    _append(0, PER_SECTOR + 1);
+    erases = 0;
+    TEST_ASSERT_EQUAL_INT(0, mtd_log_format(&test_log));
+    TEST_ASSERT_EQUAL_INT(LOG_NUMOF, erases);
+    TEST_ASSERT_EQUAL_INT(0, mtd_log_mount(&test_log));
+    mtd_log_iter_init(&test_log, &iter);
+    _check(&iter, 0, 0);
+
+    /* the log can't hold records larger than a sector */
+    static uint8_t big[SECTOR_SIZE];
+    TEST_ASSERT_EQUAL_INT(-EOVERFLOW, mtd_log_append(&test_log, 0, big,
+                                                     sizeof(big)));
+    TEST_ASSERT_EQUAL_INT(0, mtd_log_append(&test_log, 0, big, SECTOR_SIZE -
+                                            MTD_LOG_SECTOR_HDR_SIZE -
+                                            MTD_LOG_RECORD_HDR_SIZE));
+}
+
+Test *tests_mtd_log_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_mtd_log_empty),
+        new_TestFixture(test_mtd_log_append_iter),
+        new_TestFixture(test_mtd_log_remount),
+        new_TestFixture(test_mtd_log_rotation),
+        new_TestFixture(test_mtd_log_overtaken),
+        new_TestFixture(test_mtd_log_seek),
+        new_TestFixture(test_mtd_log_bad_crc),
+        new_TestFixture(test_mtd_log_torn_header),
+        new_TestFixture(test_mtd_log_format),
+    };
+
+    EMB_UNIT_TESTCALLER(mtd_log_tests, set_up, NULL, fixtures);
+
+    return (Test *)&mtd_log_tests;
+}
+
+void tests_mtd_log(void)
+{
+    TESTS_RUN(tests_mtd_log_tests());
+}
+/** @} */
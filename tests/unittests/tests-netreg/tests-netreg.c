@@ -21,10 +21,16 @@
 #include "unittests-constants.h"
 #include "tests-netreg.h"
 
+#define SCALE_ENTRIES_NUMOF     (512U)
+/* first demultiplexing context of the scale tests, e.g. the first port of the
+ * dynamic port range */
+#define SCALE_FIRST_CTX         (49152U)
+
 static gnrc_netreg_entry_t entries[] = {
     GNRC_NETREG_ENTRY_INIT_PID(TEST_UINT16, TEST_UINT8),
     GNRC_NETREG_ENTRY_INIT_PID(TEST_UINT16, TEST_UINT8 + 1)
 };
+static gnrc_netreg_entry_t scale_entries[SCALE_ENTRIES_NUMOF];
 
 static void set_up(void)
 {
@@ -139,6 +145,82 @@ void test_netreg_getnext__2_entries(void)
     TEST_ASSERT_NOT_NULL(gnrc_netreg_getnext(res));
 }
 
+static void _scale_register(void)
+{
+    for (unsigned i = 0; i < SCALE_ENTRIES_NUMOF; i++) {
+        gnrc_netreg_entry_init_pid(&scale_entries[i], SCALE_FIRST_CTX + i,
+                                   TEST_UINT8);
+        TEST_ASSERT_EQUAL_INT(0, gnrc_netreg_register(GNRC_NETTYPE_TEST,
+                                                      &scale_entries[i]));
+    }
+}
+
+void test_netreg_scale__lookup(void)
+{
+    _scale_register();
+    for (unsigned i = 0; i < SCALE_ENTRIES_NUMOF; i++) {
+        gnrc_netreg_entry_t *res = gnrc_netreg_lookup(GNRC_NETTYPE_TEST,
+                                                      SCALE_FIRST_CTX + i);
+
+        TEST_ASSERT(res == &scale_entries[i]);
+        TEST_ASSERT_NULL(gnrc_netreg_getnext(res));
+        TEST_ASSERT_EQUAL_INT(1, gnrc_netreg_num(GNRC_NETTYPE_TEST,
+                                                 SCALE_FIRST_CTX + i));
+    }
+    /* none of the registered contexts collides with the other tests */
+    TEST_ASSERT_NULL(gnrc_netreg_lookup(GNRC_NETTYPE_TEST, TEST_UINT16));
+    TEST_ASSERT_NULL(gnrc_netreg_lookup(GNRC_NETTYPE_TEST,
+                                        SCALE_FIRST_CTX + SCALE_ENTRIES_NUMOF));
+    TEST_ASSERT_NULL(gnrc_netreg_lookup(GNRC_NETTYPE_TEST,
+                                        GNRC_NETREG_DEMUX_CTX_ALL));
+}
+
+void test_netreg_scale__same_ctx(void)
+{
+    gnrc_netreg_entry_t *res;
+    unsigned num = 0;
+
+    _scale_register();
+    /* entries with the same context must all be found in one bucket */
+    gnrc_netreg_entry_init_pid(&entries[0], SCALE_FIRST_CTX, TEST_UINT8);
+    gnrc_netreg_entry_init_pid(&entries[1], SCALE_FIRST_CTX, TEST_UINT8 + 1);
+    TEST_ASSERT_EQUAL_INT(0, gnrc_netreg_register(GNRC_NETTYPE_TEST, &entries[0]));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_netreg_register(GNRC_NETTYPE_TEST, &entries[1]));
+    TEST_ASSERT_EQUAL_INT(3, gnrc_netreg_num(GNRC_NETTYPE_TEST, SCALE_FIRST_CTX));
+    for (res = gnrc_netreg_lookup(GNRC_NETTYPE_TEST, SCALE_FIRST_CTX);
+         res != NULL; res = gnrc_netreg_getnext(res)) {
+        TEST_ASSERT_EQUAL_INT(SCALE_FIRST_CTX, res->demux_ctx);
+        num++;
+    }
+    TEST_ASSERT_EQUAL_INT(3, num);
+    gnrc_netreg_unregister(GNRC_NETTYPE_TEST, &entries[0]);
+    gnrc_netreg_unregister(GNRC_NETTYPE_TEST, &entries[1]);
+    /* restore the entries for the other tests */
+    gnrc_netreg_entry_init_pid(&entries[0], TEST_UINT16, TEST_UINT8);
+    gnrc_netreg_entry_init_pid(&entries[1], TEST_UINT16, TEST_UINT8 + 1);
+    TEST_ASSERT_EQUAL_INT(1, gnrc_netreg_num(GNRC_NETTYPE_TEST, SCALE_FIRST_CTX));
+}
+
+void test_netreg_scale__unregister(void)
+{
+    _scale_register();
+    /* remove every second entry */
+    for (unsigned i = 0; i < SCALE_ENTRIES_NUMOF; i += 2) {
+        gnrc_netreg_unregister(GNRC_NETTYPE_TEST, &scale_entries[i]);
+    }
+    for (unsigned i = 0; i < SCALE_ENTRIES_NUMOF; i++) {
+        gnrc_netreg_entry_t *res = gnrc_netreg_lookup(GNRC_NETTYPE_TEST,
+                                                      SCALE_FIRST_CTX + i);
+
+        if (i & 1) {
+            TEST_ASSERT(res == &scale_entries[i]);
+        }
+        else {
+            TEST_ASSERT_NULL(res);
+        }
+    }
+}
+
 Test *tests_netreg_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -155,6 +237,9 @@ Test *tests_netreg_tests(void)
         new_TestFixture(test_netreg_num__2_entries),
         new_TestFixture(test_netreg_getnext__NULL),
         new_TestFixture(test_netreg_getnext__2_entries),
+        new_TestFixture(test_netreg_scale__lookup),
+        new_TestFixture(test_netreg_scale__same_ctx),
+        new_TestFixture(test_netreg_scale__unregister),
     };
 
     EMB_UNIT_TESTCALLER(netreg_tests, set_up, NULL, fixtures);
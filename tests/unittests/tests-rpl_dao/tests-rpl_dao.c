@@ -0,0 +1,315 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "net/icmpv6.h"
+#include "net/gnrc/netif.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/ipv6/netif.h"
+#include "net/gnrc/rpl.h"
+#include "net/gnrc/rpl/dodag.h"
+#include "net/gnrc/rpl/of_manager.h"
+#include "net/gnrc/rpl/structs.h"
+
+#include "unittests-constants.h"
+#include "tests-rpl_dao.h"
+
+#define TEST_IFACE          (TEST_UINT8)
+#define TEST_INSTANCE_ID    (GNRC_RPL_DEFAULT_INSTANCE)
+/* enough timer steps for all retransmissions of a DAO */
+#define TEST_TICKS          (4 * (GNRC_RPL_DAO_SEND_RETRIES + 1) * \
+                             (GNRC_RPL_DEFAULT_WAIT_FOR_DAO_ACK + \
+                              GNRC_RPL_LIFETIME_UPDATE_STEP) / \
+                             GNRC_RPL_LIFETIME_UPDATE_STEP)
+
+static const ipv6_addr_t dodag_id = { {
+        0x20, 0x01, 0x0d, 0xb8, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01
+    } };
+static const ipv6_addr_t global = { {
+        0x20, 0x01, 0x0d, 0xb8, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02
+    } };
+static const ipv6_addr_t link_local = { {
+        0xfe, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02
+    } };
+static const ipv6_addr_t parent1_addr = { {
+        0xfe, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03
+    } };
+static const ipv6_addr_t parent2_addr = { {
+        0xfe, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04
+    } };
+
+static gnrc_rpl_instance_t *inst;
+static gnrc_rpl_dodag_t *dodag;
+
+static void set_up(void)
+{
+    gnrc_rpl_parent_t *parent;
+    ipv6_addr_t addr = dodag_id;
+
+    gnrc_pktbuf_init();
+    gnrc_netif_init();
+    gnrc_ipv6_netif_init();
+    gnrc_ipv6_netif_add(TEST_IFACE);
+    gnrc_ipv6_netif_add_addr(TEST_IFACE, &link_local, 64, 0);
+    gnrc_ipv6_netif_add_addr(TEST_IFACE, &global, 64, 0);
+    memset(&gnrc_rpl_netstats, 0, sizeof(gnrc_rpl_netstats));
+
+    gnrc_rpl_instance_add(TEST_INSTANCE_ID, &inst);
+    inst->mop = GNRC_RPL_MOP_STORING_MODE_MC;
+    gnrc_rpl_dodag_init(inst, &addr, TEST_IFACE, NULL);
+    dodag = &inst->dodag;
+    /* no DAO is scheduled */
+    dodag->dao_time = GNRC_RPL_REGULAR_DAO_INTERVAL;
+
+    addr = parent1_addr;
+    gnrc_rpl_parent_add_by_addr(dodag, &addr, &parent);
+}
+
+static void tear_down(void)
+{
+    gnrc_rpl_instance_remove(inst);
+}
+
+static unsigned _pending(void)
+{
+    unsigned res = 0;
+
+    for (unsigned i = 0; i < GNRC_RPL_DAO_PIPELINE_SIZE; i++) {
+        if (dodag->dao_pending[i].timeout != 0) {
+            res++;
+        }
+    }
+    return res;
+}
+
+/* advances the DAO timers, without sending the regular DAO */
+static void _tick(void)
+{
+    gnrc_rpl_dao_update(dodag);
+    dodag->dao_time = GNRC_RPL_REGULAR_DAO_INTERVAL;
+}
+
+static void test_rpl_dao_delay_merge(void)
+{
+    uint8_t seq = dodag->dao_seq;
+
+    gnrc_rpl_delay_dao(dodag);
+    TEST_ASSERT_EQUAL_INT(GNRC_RPL_DEFAULT_DAO_DELAY, dodag->dao_time);
+    TEST_ASSERT_EQUAL_INT(0, gnrc_rpl_netstats.dao_merged);
+
+    /* further triggers neither postpone the DAO nor schedule another one */
+    gnrc_rpl_delay_dao(dodag);
+    gnrc_rpl_delay_dao(dodag);
+    TEST_ASSERT_EQUAL_INT(GNRC_RPL_DEFAULT_DAO_DELAY, dodag->dao_time);
+    TEST_ASSERT_EQUAL_INT(2, gnrc_rpl_netstats.dao_merged);
+
+    /* a single DAO for all triggers */
+    gnrc_rpl_dao_update(dodag);
+    TEST_ASSERT_EQUAL_INT(1, gnrc_rpl_netstats.dao_tx_ucast_count);
+    TEST_ASSERT_EQUAL_INT(GNRC_RPL_COUNTER_INCREMENT(seq), dodag->dao_seq);
+    TEST_ASSERT_EQUAL_INT(GNRC_RPL_REGULAR_DAO_INTERVAL, dodag->dao_time);
+    TEST_ASSERT_EQUAL_INT(1, _pending());
+
+    /* the next trigger schedules a new DAO */
+    gnrc_rpl_delay_dao(dodag);
+    TEST_ASSERT_EQUAL_INT(GNRC_RPL_DEFAULT_DAO_DELAY, dodag->dao_time);
+    TEST_ASSERT_EQUAL_INT(2, gnrc_rpl_netstats.dao_merged);
+}
+
+static void test_rpl_dao_ack(void)
+{
+    uint8_t seq1 = dodag->dao_seq, seq2;
+
+    gnrc_rpl_track_dao(dodag, NULL, dodag->default_lifetime);
+    seq2 = dodag->dao_seq;
+    gnrc_rpl_track_dao(dodag, NULL, dodag->default_lifetime);
+    TEST_ASSERT_EQUAL_INT(2, gnrc_rpl_netstats.dao_tx_ucast_count);
+    TEST_ASSERT_EQUAL_INT(2, _pending());
+
+    /* no DAO with this sequence number is outstanding */
+    gnrc_rpl_ack_dao(dodag, GNRC_RPL_COUNTER_INCREMENT(dodag->dao_seq));
+    TEST_ASSERT_EQUAL_INT(2, _pending());
+
+    /* the ACK of the older DAO leaves the newer one outstanding */
+    gnrc_rpl_ack_dao(dodag, seq1);
+    TEST_ASSERT_EQUAL_INT(1, _pending());
+    gnrc_rpl_ack_dao(dodag, seq1);
+    TEST_ASSERT_EQUAL_INT(1, _pending());
+    gnrc_rpl_ack_dao(dodag, seq2);
+    TEST_ASSERT_EQUAL_INT(0, _pending());
+
+    /* the ACK of the newer DAO also completes the older one */
+    gnrc_rpl_track_dao(dodag, NULL, dodag->default_lifetime);
+    seq2 = dodag->dao_seq;
+    gnrc_rpl_track_dao(dodag, NULL, dodag->default_lifetime);
+    TEST_ASSERT_EQUAL_INT(2, _pending());
+    gnrc_rpl_ack_dao(dodag, seq2);
+    TEST_ASSERT_EQUAL_INT(0, _pending());
+}
+
+static void test_rpl_dao_pipeline_full(void)
+{
+    uint8_t seq = dodag->dao_seq;
+
+    for (unsigned i = 0; i <= GNRC_RPL_DAO_PIPELINE_SIZE; i++) {
+        gnrc_rpl_track_dao(dodag, NULL, dodag->default_lifetime);
+    }
+    TEST_ASSERT_EQUAL_INT(GNRC_RPL_DAO_PIPELINE_SIZE, _pending());
+
+    /* the oldest DAO was replaced */
+    gnrc_rpl_ack_dao(dodag, seq);
+    TEST_ASSERT_EQUAL_INT(GNRC_RPL_DAO_PIPELINE_SIZE, _pending());
+}
+
+static void test_rpl_dao_retransmit(void)
+{
+    gnrc_rpl_track_dao(dodag, NULL, dodag->default_lifetime);
+    TEST_ASSERT_EQUAL_INT(1, gnrc_rpl_netstats.dao_tx_ucast_count);
+
+    for (unsigned i = 0; i < TEST_TICKS; i++) {
+        _tick();
+    }
+    TEST_ASSERT_EQUAL_INT(GNRC_RPL_DAO_SEND_RETRIES, gnrc_rpl_netstats.dao_retransmissions);
+    TEST_ASSERT_EQUAL_INT(1 + GNRC_RPL_DAO_SEND_RETRIES, gnrc_rpl_netstats.dao_tx_ucast_count);
+    TEST_ASSERT_EQUAL_INT(1, gnrc_rpl_netstats.dao_ack_timeouts);
+    TEST_ASSERT_EQUAL_INT(0, _pending());
+    /* nobody took the DAOs, they must have been released */
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_rpl_dao_retransmit_acked(void)
+{
+    uint8_t seq = dodag->dao_seq;
+
+    gnrc_rpl_track_dao(dodag, NULL, dodag->default_lifetime);
+    for (unsigned i = 0; (i < TEST_TICKS) &&
+         (gnrc_rpl_netstats.dao_retransmissions == 0); i++) {
+        _tick();
+    }
+    TEST_ASSERT_EQUAL_INT(1, gnrc_rpl_netstats.dao_retransmissions);
+    /* the retransmission has a new sequence number, the old one is not
+     * matched anymore */
+    TEST_ASSERT_EQUAL_INT(GNRC_RPL_COUNTER_INCREMENT(seq), dodag->dao_pending[0].seq);
+    gnrc_rpl_ack_dao(dodag, seq);
+    TEST_ASSERT_EQUAL_INT(1, _pending());
+    gnrc_rpl_ack_dao(dodag, dodag->dao_pending[0].seq);
+    TEST_ASSERT_EQUAL_INT(0, _pending());
+
+    for (unsigned i = 0; i < TEST_TICKS; i++) {
+        _tick();
+    }
+    TEST_ASSERT_EQUAL_INT(1, gnrc_rpl_netstats.dao_retransmissions);
+    TEST_ASSERT_EQUAL_INT(2, gnrc_rpl_netstats.dao_tx_ucast_count);
+    TEST_ASSERT_EQUAL_INT(0, gnrc_rpl_netstats.dao_ack_timeouts);
+}
+
+static void test_rpl_dao_superseded(void)
+{
+    gnrc_rpl_parent_t *parent;
+    ipv6_addr_t addr = parent2_addr;
+
+    gnrc_rpl_track_dao(dodag, NULL, dodag->default_lifetime);
+
+    /* the preferred parent changes, the DAO to the old one is dropped */
+    gnrc_rpl_parent_add_by_addr(dodag, &addr, &parent);
+    gnrc_rpl_parent_remove(dodag->parents);
+    for (unsigned i = 0; i < TEST_TICKS; i++) {
+        _tick();
+    }
+    TEST_ASSERT_EQUAL_INT(0, gnrc_rpl_netstats.dao_retransmissions);
+    TEST_ASSERT_EQUAL_INT(0, gnrc_rpl_netstats.dao_ack_timeouts);
+    TEST_ASSERT_EQUAL_INT(0, _pending());
+}
+
+static void test_rpl_dao_reject(void)
+{
+    uint8_t seq = dodag->dao_seq;
+    gnrc_rpl_dao_ack_t dao_ack = { .instance_id = TEST_INSTANCE_ID,
+                                   .dao_sequence = seq, .status = 128 };
+    ipv6_addr_t src = parent1_addr, dst = link_local;
+
+    gnrc_rpl_track_dao(dodag, NULL, dodag->default_lifetime);
+    gnrc_rpl_recv_DAO_ACK(&dao_ack, TEST_IFACE, &src, &dst,
+                          sizeof(icmpv6_hdr_t) + sizeof(dao_ack));
+    TEST_ASSERT_EQUAL_INT(1, gnrc_rpl_netstats.dao_rejected);
+    TEST_ASSERT_EQUAL_INT(0, _pending());
+    /* there is no other parent, so the next DAO is sent after backing off */
+    TEST_ASSERT_EQUAL_INT(GNRC_RPL_REGULAR_DAO_INTERVAL, dodag->dao_time);
+    TEST_ASSERT(ipv6_addr_equal(&parent1_addr, &dodag->parents->addr));
+
+    /* the rejected DAO is not retransmitted */
+    for (unsigned i = 0; i < TEST_TICKS; i++) {
+        _tick();
+    }
+    TEST_ASSERT_EQUAL_INT(1, gnrc_rpl_netstats.dao_tx_ucast_count);
+    TEST_ASSERT_EQUAL_INT(0, gnrc_rpl_netstats.dao_retransmissions);
+    TEST_ASSERT_EQUAL_INT(0, gnrc_rpl_netstats.dao_ack_timeouts);
+
+    /* a DAO that is not outstanding anymore can not be rejected */
+    gnrc_rpl_reject_dao(dodag, seq);
+    TEST_ASSERT_EQUAL_INT(1, gnrc_rpl_netstats.dao_rejected);
+}
+
+static void test_rpl_dao_reject_reselect(void)
+{
+    gnrc_rpl_parent_t *parent;
+    ipv6_addr_t addr = parent2_addr;
+    uint8_t seq = dodag->dao_seq;
+
+    inst->of = gnrc_rpl_get_of_for_ocp(GNRC_RPL_DEFAULT_OCP);
+    inst->min_hop_rank_inc = GNRC_RPL_DEFAULT_MIN_HOP_RANK_INCREASE;
+    dodag->parents->rank = GNRC_RPL_DEFAULT_MIN_HOP_RANK_INCREASE;
+    gnrc_rpl_parent_add_by_addr(dodag, &addr, &parent);
+    parent->rank = 2 * GNRC_RPL_DEFAULT_MIN_HOP_RANK_INCREASE;
+
+    gnrc_rpl_track_dao(dodag, NULL, dodag->default_lifetime);
+    gnrc_rpl_reject_dao(dodag, seq);
+    TEST_ASSERT_EQUAL_INT(0, _pending());
+    /* the preferred parent is replaced, a DAO to the new one is scheduled */
+    TEST_ASSERT_NOT_NULL(dodag->parents);
+    TEST_ASSERT(ipv6_addr_equal(&parent2_addr, &dodag->parents->addr));
+    TEST_ASSERT_NULL(dodag->parents->next);
+    TEST_ASSERT_EQUAL_INT(GNRC_RPL_DEFAULT_DAO_DELAY, dodag->dao_time);
+}
+
+Test *tests_rpl_dao_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_rpl_dao_delay_merge),
+        new_TestFixture(test_rpl_dao_ack),
+        new_TestFixture(test_rpl_dao_pipeline_full),
+        new_TestFixture(test_rpl_dao_retransmit),
+        new_TestFixture(test_rpl_dao_retransmit_acked),
+        new_TestFixture(test_rpl_dao_superseded),
+        new_TestFixture(test_rpl_dao_reject),
+        new_TestFixture(test_rpl_dao_reject_reselect),
+    };
+
+    EMB_UNIT_TESTCALLER(rpl_dao_tests, set_up, tear_down, fixtures);
+
+    return (Test *)&rpl_dao_tests;
+}
+
+void tests_rpl_dao(void)
+{
+    TESTS_RUN(tests_rpl_dao_tests());
+}
+/** @} */
@@ -0,0 +1,152 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "net/gnrc/rpl.h"
+#include "net/gnrc/rpl/structs.h"
+#include "mrhof.h"
+
+#include "tests-rpl_mrhof.h"
+
+#define MIN_HOP_RANK_INC    (256U)
+#define ETX(x)              ((uint16_t)((x) * GNRC_RPL_MRHOF_ETX_DIVISOR))
+
+static gnrc_rpl_instance_t instance;
+static gnrc_rpl_parent_t p1, p2;
+static gnrc_rpl_of_t *of;
+
+static void set_up(void)
+{
+    memset(&instance, 0, sizeof(instance));
+    instance.min_hop_rank_inc = MIN_HOP_RANK_INC;
+    instance.dodag.instance = &instance;
+    memset(&p1, 0, sizeof(p1));
+    memset(&p2, 0, sizeof(p2));
+    p1.dodag = &instance.dodag;
+    p2.dodag = &instance.dodag;
+    of = gnrc_rpl_get_of_mrhof();
+}
+
+static void test_rpl_mrhof_ocp(void)
+{
+    TEST_ASSERT_EQUAL_INT(GNRC_RPL_MRHOF_OCP, of->ocp);
+}
+
+static void test_rpl_mrhof_calc_rank_etx(void)
+{
+    /* a perfect link costs exactly one hop */
+    p1.rank = 512;
+    p1.link_metric = ETX(1);
+    TEST_ASSERT_EQUAL_INT(512 + MIN_HOP_RANK_INC, of->calc_rank(&p1, 0));
+
+    /* 1.5 transmissions per frame */
+    p1.link_metric = ETX(1.5);
+    TEST_ASSERT_EQUAL_INT(512 + 384, of->calc_rank(&p1, 0));
+
+    /* an unknown link is assumed to have the default ETX */
+    p1.link_metric = 0;
+    TEST_ASSERT_EQUAL_INT(512 + (GNRC_RPL_MRHOF_DEFAULT_ETX *
+                                 MIN_HOP_RANK_INC) /
+                          GNRC_RPL_MRHOF_ETX_DIVISOR,
+                          of->calc_rank(&p1, 0));
+}
+
+static void test_rpl_mrhof_calc_rank_infinite(void)
+{
+    /* links above the maximum link metric are not used */
+    p1.rank = 512;
+    p1.link_metric = GNRC_RPL_MRHOF_MAX_LINK_METRIC + 1;
+    TEST_ASSERT_EQUAL_INT(GNRC_RPL_INFINITE_RANK, of->calc_rank(&p1, 0));
+
+    /* the cost saturates */
+    p1.rank = GNRC_RPL_INFINITE_RANK - 1;
+    p1.link_metric = ETX(1);
+    TEST_ASSERT_EQUAL_INT(GNRC_RPL_INFINITE_RANK, of->calc_rank(&p1, 0));
+
+    p1.rank = GNRC_RPL_INFINITE_RANK;
+    TEST_ASSERT_EQUAL_INT(GNRC_RPL_INFINITE_RANK, of->calc_rank(&p1, 0));
+    TEST_ASSERT_EQUAL_INT(GNRC_RPL_INFINITE_RANK, of->calc_rank(NULL, 0));
+}
+
+static void test_rpl_mrhof_calc_rank_base(void)
+{
+    /* ranks advertised by the node itself increase by one hop */
+    TEST_ASSERT_EQUAL_INT(1024 + MIN_HOP_RANK_INC, of->calc_rank(&p1, 1024));
+    TEST_ASSERT_EQUAL_INT(GNRC_RPL_INFINITE_RANK,
+                          of->calc_rank(&p1, GNRC_RPL_INFINITE_RANK - 1));
+}
+
+static void test_rpl_mrhof_parent_cmp(void)
+{
+    /* the lower rank over the worse link loses */
+    p1.rank = 256;
+    p1.link_metric = ETX(3);
+    p2.rank = 512;
+    p2.link_metric = ETX(1);
+    TEST_ASSERT_EQUAL_INT(1, of->parent_cmp(&p1, &p2));
+    TEST_ASSERT_EQUAL_INT(-1, of->parent_cmp(&p2, &p1));
+
+    p1.link_metric = ETX(2);
+    TEST_ASSERT_EQUAL_INT(0, of->parent_cmp(&p1, &p2));
+}
+
+static void test_rpl_mrhof_which_parent_hysteresis(void)
+{
+    unsigned threshold = (GNRC_RPL_MRHOF_PARENT_SWITCH_THRESHOLD *
+                          MIN_HOP_RANK_INC) / GNRC_RPL_MRHOF_ETX_DIVISOR;
+
+    p1.rank = 512;
+    p1.link_metric = ETX(1);
+    p2.link_metric = ETX(1);
+
+    /* better, but not by more than the threshold */
+    p2.rank = 512 - threshold;
+    TEST_ASSERT(of->which_parent(&p1, &p2) == &p1);
+
+    /* better by more than the threshold */
+    p2.rank = 512 - threshold - 1;
+    TEST_ASSERT(of->which_parent(&p1, &p2) == &p2);
+
+    /* a worse parent is never chosen */
+    p2.rank = 1024;
+    TEST_ASSERT(of->which_parent(&p1, &p2) == &p1);
+
+    /* the current parent became unusable */
+    p1.link_metric = GNRC_RPL_MRHOF_MAX_LINK_METRIC + 1;
+    TEST_ASSERT(of->which_parent(&p1, &p2) == &p2);
+}
+
+Test *tests_rpl_mrhof_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_rpl_mrhof_ocp),
+        new_TestFixture(test_rpl_mrhof_calc_rank_etx),
+        new_TestFixture(test_rpl_mrhof_calc_rank_infinite),
+        new_TestFixture(test_rpl_mrhof_calc_rank_base),
+        new_TestFixture(test_rpl_mrhof_parent_cmp),
+        new_TestFixture(test_rpl_mrhof_which_parent_hysteresis),
+    };
+
+    EMB_UNIT_TESTCALLER(rpl_mrhof_tests, set_up, NULL, fixtures);
+
+    return (Test *)&rpl_mrhof_tests;
+}
+
+void tests_rpl_mrhof(void)
+{
+    TESTS_RUN(tests_rpl_mrhof_tests());
+}
+/** @} */
@@ -11,6 +11,7 @@
  *
  * @file
  */
+#include <errno.h>
 #include <stdlib.h>
 #include <string.h>
 #include "embUnit.h"
@@ -42,6 +43,12 @@
 
 #define SRH_SEG_LEFT        (2)
 
+/* fill the tree completely, whatever size it was configured to */
+#define TREE_NODES          (GNRC_RPL_SRH_TREE_SIZE)
+#define TREE_FANOUT         (2)
+#define TREE_SRH_BUF_LEN    (sizeof(gnrc_rpl_srh_t) + \
+                             (GNRC_RPL_SRH_TREE_MAX_HOPS * sizeof(ipv6_addr_t)))
+
 static void test_rpl_srh_nexthop_no_prefix_elided(void)
 {
     ipv6_hdr_t hdr;
@@ -105,6 +112,158 @@ static void test_rpl_srh_nexthop_prefix_elided(void)
     TEST_ASSERT(ipv6_addr_equal(&hdr.dst, &expected2));
 }
 
+static void _tree_addr(ipv6_addr_t *addr, uint16_t id)
+{
+    ipv6_addr_t prefix = IPV6_DST;
+
+    *addr = prefix;
+    addr->u8[14] = id >> 8;
+    addr->u8[15] = id & 0xff;
+}
+
+static void set_up_tree(void)
+{
+    ipv6_addr_t root;
+
+    _tree_addr(&root, 0);
+    gnrc_rpl_srh_tree_init(&root);
+}
+
+/* checks that forwarding along the source route built for dst ends at dst
+ * after the expected number of hops */
+static void _tree_check_route(uint16_t dst, uint16_t first_hop, unsigned hops)
+{
+    uint8_t buf[TREE_SRH_BUF_LEN];
+    gnrc_rpl_srh_t *srh = (gnrc_rpl_srh_t *) buf;
+    ipv6_hdr_t hdr;
+    ipv6_addr_t addr, next_hop;
+    int res;
+
+    _tree_addr(&addr, dst);
+    res = gnrc_rpl_srh_tree_build(&addr, &next_hop, srh, sizeof(buf));
+    TEST_ASSERT(res >= 0);
+    _tree_addr(&hdr.dst, first_hop);
+    TEST_ASSERT(ipv6_addr_equal(&hdr.dst, &next_hop));
+    if (hops == 1) {
+        TEST_ASSERT_EQUAL_INT(0, res);
+        return;
+    }
+    TEST_ASSERT_EQUAL_INT(0, res % 8);
+    TEST_ASSERT_EQUAL_INT(res - 8, srh->len * 8);
+    TEST_ASSERT_EQUAL_INT(hops - 1, srh->seg_left);
+    while (srh->seg_left > 0) {
+        TEST_ASSERT_EQUAL_INT(EXT_RH_CODE_FORWARD, gnrc_rpl_srh_process(&hdr, srh));
+    }
+    TEST_ASSERT(ipv6_addr_equal(&hdr.dst, &addr));
+}
+
+static void test_rpl_srh_tree_build(void)
+{
+    ipv6_addr_t a1, a2, a3, next_hop;
+    uint8_t buf[TREE_SRH_BUF_LEN];
+    gnrc_rpl_srh_t *srh = (gnrc_rpl_srh_t *) buf;
+
+    _tree_addr(&a1, 1);
+    _tree_addr(&a2, 2);
+    _tree_addr(&a3, 3);
+
+    TEST_ASSERT_EQUAL_INT(-ENOENT, gnrc_rpl_srh_tree_build(&a3, &next_hop, srh, sizeof(buf)));
+
+    /* 0 <- 1 <- 2 <- 3, announced out of order */
+    TEST_ASSERT_EQUAL_INT(0, gnrc_rpl_srh_tree_update(&a3, &a2));
+    TEST_ASSERT_EQUAL_INT(-EHOSTUNREACH, gnrc_rpl_srh_tree_build(&a3, &next_hop, srh,
+                                                                 sizeof(buf)));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_rpl_srh_tree_update(&a2, &a1));
+    _tree_addr(&next_hop, 0);
+    TEST_ASSERT_EQUAL_INT(0, gnrc_rpl_srh_tree_update(&a1, &next_hop));
+
+    _tree_check_route(1, 1, 1);
+    _tree_check_route(2, 1, 2);
+    _tree_check_route(3, 1, 3);
+
+    /* all hops share 15 bytes with the first hop: 2 addresses of 1 byte */
+    TEST_ASSERT_EQUAL_INT(16, gnrc_rpl_srh_tree_build(&a3, &next_hop, srh, sizeof(buf)));
+    TEST_ASSERT_EQUAL_INT((15 << 4) | 15, srh->compr);
+    TEST_ASSERT_EQUAL_INT(-ENOBUFS, gnrc_rpl_srh_tree_build(&a3, &next_hop, srh, 8));
+    TEST_ASSERT_EQUAL_INT(16, gnrc_rpl_srh_tree_build(&a3, &next_hop, NULL, 0));
+}
+
+static void test_rpl_srh_tree_parent_change(void)
+{
+    ipv6_addr_t root, a1, a2, a3;
+
+    _tree_addr(&root, 0);
+    _tree_addr(&a1, 1);
+    _tree_addr(&a2, 2);
+    _tree_addr(&a3, 3);
+
+    TEST_ASSERT_EQUAL_INT(0, gnrc_rpl_srh_tree_update(&a1, &root));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_rpl_srh_tree_update(&a2, &a1));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_rpl_srh_tree_update(&a3, &a2));
+    /* fill the route cache */
+    _tree_check_route(3, 1, 3);
+
+    /* 2 moves directly below the root, cached route to 3 must not be used */
+    TEST_ASSERT_EQUAL_INT(0, gnrc_rpl_srh_tree_update(&a2, &root));
+    _tree_check_route(3, 2, 2);
+    _tree_check_route(1, 1, 1);
+
+    /* 2 leaves the DODAG, its child becomes unreachable */
+    TEST_ASSERT_EQUAL_INT(0, gnrc_rpl_srh_tree_remove(&a2));
+    TEST_ASSERT_EQUAL_INT(-ENOENT, gnrc_rpl_srh_tree_remove(&a2));
+    TEST_ASSERT_EQUAL_INT(-EHOSTUNREACH, gnrc_rpl_srh_tree_build(&a3, &a1, NULL, 0));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_rpl_srh_tree_update(&a3, &a1));
+    _tree_check_route(3, 1, 2);
+}
+
+static void test_rpl_srh_tree_large(void)
+{
+    ipv6_addr_t addr, parent, next_hop;
+    uint8_t buf[TREE_SRH_BUF_LEN], cached[TREE_SRH_BUF_LEN];
+    gnrc_rpl_srh_t *srh = (gnrc_rpl_srh_t *) buf;
+
+    /* node i is a child of node (i - 1) / TREE_FANOUT, node 0 is the root */
+    for (uint16_t i = 1; i <= TREE_NODES; i++) {
+        _tree_addr(&addr, i);
+        _tree_addr(&parent, (i - 1) / TREE_FANOUT);
+        TEST_ASSERT_EQUAL_INT(0, gnrc_rpl_srh_tree_update(&addr, &parent));
+    }
+    /* the tree is full */
+    _tree_addr(&addr, TREE_NODES + 1);
+    _tree_addr(&parent, TREE_NODES / TREE_FANOUT);
+    TEST_ASSERT_EQUAL_INT(-ENOMEM, gnrc_rpl_srh_tree_update(&addr, &parent));
+    TEST_ASSERT_EQUAL_INT(-ENOENT, gnrc_rpl_srh_tree_build(&addr, &next_hop,
+                                                           NULL, 0));
+
+    for (uint16_t i = 1; i <= TREE_NODES; i++) {
+        unsigned hops = 0;
+        uint16_t first_hop = i;
+
+        for (uint16_t j = i; j != 0; j = (j - 1) / TREE_FANOUT) {
+            first_hop = j;
+            hops++;
+        }
+        _tree_check_route(i, first_hop, hops);
+    }
+
+    /* building a route again, i.e. from the cache, gives the same result.
+     * The next header field is left to the caller, so clear it beforehand */
+    memset(cached, 0, sizeof(cached));
+    memset(buf, 0, sizeof(buf));
+    for (uint16_t i = 1; i <= TREE_NODES; i++) {
+        int res;
+
+        _tree_addr(&addr, i);
+        res = gnrc_rpl_srh_tree_build(&addr, &parent, (gnrc_rpl_srh_t *)cached,
+                                      sizeof(cached));
+        TEST_ASSERT(res >= 0);
+        TEST_ASSERT_EQUAL_INT(res, gnrc_rpl_srh_tree_build(&addr, &next_hop,
+                                                           srh, sizeof(buf)));
+        TEST_ASSERT(ipv6_addr_equal(&parent, &next_hop));
+        TEST_ASSERT_EQUAL_INT(0, memcmp(cached, buf, res));
+    }
+}
+
 Test *tests_rpl_srh_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -117,8 +276,22 @@ Test *tests_rpl_srh_tests(void)
     return (Test *)&rpl_srh_tests;
 }
 
+Test *tests_rpl_srh_tree_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_rpl_srh_tree_build),
+        new_TestFixture(test_rpl_srh_tree_parent_change),
+        new_TestFixture(test_rpl_srh_tree_large),
+    };
+
+    EMB_UNIT_TESTCALLER(rpl_srh_tree_tests, set_up_tree, NULL, fixtures);
+
+    return (Test *)&rpl_srh_tree_tests;
+}
+
 void tests_rpl_srh(void)
 {
     TESTS_RUN(tests_rpl_srh_tests());
+    TESTS_RUN(tests_rpl_srh_tree_tests());
 }
 /** @} */
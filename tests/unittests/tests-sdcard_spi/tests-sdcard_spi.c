@@ -0,0 +1,643 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ * @brief       Tests the block transfers of the sdcard_spi driver against a
+ *              byte level model of an SD card in SPI mode
+ *
+ * The driver is included into this file, so its SPI and GPIO accesses are
+ * routed to the model. The model implements the commands used for block
+ * transfers after initialization: CMD12, CMD17, CMD18, CMD24, CMD25, CMD55
+ * and ACMD23, including the data tokens, CRC16 checks, data responses and
+ * busy signaling. The MTD driver is included with MTD_SDCARD_STREAM enabled,
+ * to test its flush.
+ */
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "checksum/crc16_ccitt.h"
+#include "periph/gpio.h"
+#include "periph/spi.h"
+
+#include "tests-sdcard_spi.h"
+
+#define BLOCK_SIZE      (512U)
+#define BLOCK_NUMOF     (16U)
+#define BUF_BLOCKS      (4U)
+
+/* number of bytes the card signals busy after a block was received */
+#define PROGRAM_BUSY    (20U)
+
+enum {
+    MODEL_IDLE,
+    MODEL_CMD,
+    MODEL_READ,
+    MODEL_WRITE_WAIT,
+    MODEL_WRITE_DATA,
+};
+
+static uint8_t disk[BLOCK_NUMOF][BLOCK_SIZE];
+static unsigned cmd_count[64];
+static unsigned crc_errors;
+static unsigned clocked;
+static unsigned data_bytes;                 /* bytes of written data packets */
+
+static struct {
+    unsigned state;
+    bool selected;
+    uint8_t cmd[6];
+    unsigned cmd_len;
+    uint8_t out[4];                         /* response bytes to clock out */
+    unsigned out_len;
+    unsigned out_pos;
+    unsigned busy;                          /* remaining busy bytes */
+    bool stop_pending;                      /* stop token is being processed */
+    uint8_t mode;                           /* index of the data command */
+    uint32_t block;
+    unsigned pos;
+    uint8_t data[BLOCK_SIZE + 2];           /* received block and CRC16 */
+    uint16_t crc;
+} model;
+
+static void _push(uint8_t byte)
+{
+    model.out[model.out_len++] = byte;
+}
+
+static void _command(void)
+{
+    uint8_t idx = model.cmd[0] & 0x3f;
+    uint32_t arg = ((uint32_t)model.cmd[1] << 24) | (model.cmd[2] << 16) |
+                   (model.cmd[3] << 8) | model.cmd[4];
+
+    cmd_count[idx]++;
+    model.state = MODEL_IDLE;
+    if (idx == 12) {
+        /* stuff byte, R1, then busy */
+        _push(0xff);
+        _push(0xff);
+        _push(0x00);
+        model.busy = 2;
+        return;
+    }
+    _push(0xff);
+    if (((idx == 17) || (idx == 18) || (idx == 24) || (idx == 25)) &&
+        (arg >= BLOCK_NUMOF)) {
+        /* address error */
+        _push(0x20);
+        return;
+    }
+    _push(0x00);
+    model.mode = idx;
+    model.block = arg;
+    model.pos = 0;
+    if ((idx == 17) || (idx == 18)) {
+        _push(0xff);
+        model.state = MODEL_READ;
+    }
+    else if ((idx == 24) || (idx == 25)) {
+        model.state = MODEL_WRITE_WAIT;
+    }
+}
+
+static uint8_t _card_out(void)
+{
+    uint8_t out = 0xff;
+
+    if (model.out_pos < model.out_len) {
+        out = model.out[model.out_pos++];
+        if (model.out_pos == model.out_len) {
+            model.out_pos = model.out_len = 0;
+        }
+    }
+    else if (model.busy) {
+        out = 0x00;
+        if ((--model.busy == 0) && model.stop_pending) {
+            model.stop_pending = false;
+            model.state = MODEL_IDLE;
+        }
+    }
+    else if (model.state == MODEL_READ) {
+        if (model.block >= BLOCK_NUMOF) {
+            /* error token: out of range */
+            model.state = MODEL_IDLE;
+            return 0x08;
+        }
+        if (model.pos == 0) {
+            out = 0xfe;
+            model.crc = crc16_ccitt_update(0, disk[model.block], BLOCK_SIZE);
+        }
+        else if (model.pos <= BLOCK_SIZE) {
+            out = disk[model.block][model.pos - 1];
+        }
+        else if (model.pos == BLOCK_SIZE + 1) {
+            out = model.crc >> 8;
+        }
+        else {
+            out = model.crc & 0xff;
+        }
+        if (++model.pos == BLOCK_SIZE + 3) {
+            model.pos = 0;
+            model.block++;
+            if (model.mode == 17) {
+                model.state = MODEL_IDLE;
+            }
+        }
+    }
+    return out;
+}
+
+static void _card_in(uint8_t in)
+{
+    switch (model.state) {
+        case MODEL_READ:
+            /* CMD12 aborts a multi-block read */
+            if ((in & 0xc0) != 0x40) {
+                break;
+            }
+            model.state = MODEL_IDLE;
+            /* Falls Through. */
+        case MODEL_IDLE:
+            if ((in & 0xc0) != 0x40) {
+                break;
+            }
+            model.state = MODEL_CMD;
+            model.cmd_len = 0;
+            /* Falls Through. */
+        case MODEL_CMD:
+            model.cmd[model.cmd_len++] = in;
+            if (model.cmd_len == sizeof(model.cmd)) {
+                _command();
+            }
+            break;
+        case MODEL_WRITE_WAIT:
+            if ((in == 0xfe) || (in == 0xfc)) {
+                model.state = MODEL_WRITE_DATA;
+                model.pos = 0;
+            }
+            else if (in == 0xfd) {
+                model.busy = 3;
+                model.stop_pending = true;
+            }
+            break;
+        case MODEL_WRITE_DATA:
+            data_bytes++;
+            model.data[model.pos++] = in;
+            if (model.pos == sizeof(model.data)) {
+                uint16_t crc = crc16_ccitt_update(0, model.data, BLOCK_SIZE);
+
+                if (((crc >> 8) != model.data[BLOCK_SIZE]) ||
+                    ((crc & 0xff) != model.data[BLOCK_SIZE + 1])) {
+                    crc_errors++;
+                    _push(0x0b);
+                }
+                else if (model.block >= BLOCK_NUMOF) {
+                    /* write error */
+                    _push(0x0d);
+                }
+                else {
+                    memcpy(disk[model.block++], model.data, BLOCK_SIZE);
+                    _push(0x05);
+                }
+                model.busy = PROGRAM_BUSY;
+                model.state = (model.mode == 24) ? MODEL_IDLE
+                                                 : MODEL_WRITE_WAIT;
+            }
+            break;
+    }
+}
+
+static uint8_t _card_xfer(uint8_t in)
+{
+    uint8_t out;
+
+    clocked++;
+    if (!model.selected) {
+        return 0xff;
+    }
+    out = _card_out();
+    _card_in(in);
+    return out;
+}
+
+static int _model_spi_acquire(spi_t bus, spi_cs_t cs, spi_mode_t mode,
+                              spi_clk_t clk)
+{
+    (void)bus;
+    (void)cs;
+    (void)mode;
+    (void)clk;
+    return SPI_OK;
+}
+
+static void _model_spi_release(spi_t bus)
+{
+    (void)bus;
+}
+
+static void _model_spi_init_pins(spi_t bus)
+{
+    (void)bus;
+}
+
+static uint8_t _model_spi_transfer_byte(spi_t bus, spi_cs_t cs, bool cont,
+                                        uint8_t out)
+{
+    (void)bus;
+    (void)cs;
+    (void)cont;
+    return _card_xfer(out);
+}
+
+static void _model_spi_transfer_bytes(spi_t bus, spi_cs_t cs, bool cont,
+                                      const void *out, void *in, size_t len)
+{
+    (void)bus;
+    (void)cs;
+    (void)cont;
+    for (size_t i = 0; i < len; i++) {
+        uint8_t res = _card_xfer(out ? ((const uint8_t *)out)[i] : 0xff);
+
+        if (in) {
+            ((uint8_t *)in)[i] = res;
+        }
+    }
+}
+
+/* only the chip select line is modeled */
+static int _model_gpio_init(gpio_t pin, gpio_mode_t mode)
+{
+    (void)pin;
+    (void)mode;
+    return 0;
+}
+
+static int _model_gpio_read(gpio_t pin)
+{
+    (void)pin;
+    return 0;
+}
+
+static void _model_gpio_set(gpio_t pin)
+{
+    (void)pin;
+    model.selected = false;
+}
+
+static void _model_gpio_clear(gpio_t pin)
+{
+    (void)pin;
+    model.selected = true;
+}
+
+static void _model_gpio_write(gpio_t pin, int value)
+{
+    model.selected = !value;
+    (void)pin;
+}
+
+#define spi_acquire         _model_spi_acquire
+#define spi_release         _model_spi_release
+#define spi_init_pins       _model_spi_init_pins
+#define spi_transfer_byte   _model_spi_transfer_byte
+#define spi_transfer_bytes  _model_spi_transfer_bytes
+#define gpio_init           _model_gpio_init
+#define gpio_read           _model_gpio_read
+#define gpio_set            _model_gpio_set
+#define gpio_clear          _model_gpio_clear
+#define gpio_write          _model_gpio_write
+
+#include "../../../drivers/sdcard_spi/sdcard_spi.c"
+
+/* the MTD driver streams sequential accesses through the same model */
+#undef MTD_SDCARD_STREAM
+#define MTD_SDCARD_STREAM   (1)
+#include "../../../drivers/mtd_sdcard/mtd_sdcard.c"
+
+static sdcard_spi_t card;
+static char buf[BUF_BLOCKS * BLOCK_SIZE];
+static char rbuf[BUF_BLOCKS * BLOCK_SIZE];
+
+static void set_up(void)
+{
+    memset(disk, 0, sizeof(disk));
+    memset(cmd_count, 0, sizeof(cmd_count));
+    memset(&model, 0, sizeof(model));
+    crc_errors = 0;
+    clocked = 0;
+    data_bytes = 0;
+
+    /* the card is initialized, the model doesn't implement the init
+     * sequence */
+    memset(&card, 0, sizeof(card));
+    card.use_block_addr = true;
+    card.init_done = true;
+    _dyn_spi_rxtx_byte = _hw_spi_rxtx_byte;
+
+    for (unsigned i = 0; i < sizeof(buf); i++) {
+        buf[i] = i * 7 + (i / BLOCK_SIZE);
+    }
+}
+
+static void test_sdcard_spi_write_blocks(void)
+{
+    sd_rw_response_t state;
+
+    for (unsigned i = 0; i < BUF_BLOCKS; i++) {
+        TEST_ASSERT_EQUAL_INT(1, sdcard_spi_write_blocks(&card, i,
+                                                         &buf[i * BLOCK_SIZE],
+                                                         BLOCK_SIZE, 1,
+                                                         &state));
+        TEST_ASSERT_EQUAL_INT(SD_RW_OK, state);
+    }
+    TEST_ASSERT_EQUAL_INT(BUF_BLOCKS, cmd_count[24]);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(disk[0], buf, sizeof(buf)));
+
+    TEST_ASSERT_EQUAL_INT(BUF_BLOCKS,
+                          sdcard_spi_write_blocks(&card, BUF_BLOCKS, buf,
+                                                  BLOCK_SIZE, BUF_BLOCKS,
+                                                  &state));
+    TEST_ASSERT_EQUAL_INT(SD_RW_OK, state);
+    TEST_ASSERT_EQUAL_INT(1, cmd_count[25]);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(disk[BUF_BLOCKS], buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL_INT(0, crc_errors);
+    TEST_ASSERT_EQUAL_INT(MODEL_IDLE, model.state);
+}
+
+static void test_sdcard_spi_write_stream(void)
+{
+    sd_rw_response_t state;
+    unsigned single;
+
+    for (unsigned i = 0; i < BUF_BLOCKS; i++) {
+        sdcard_spi_write_blocks(&card, i, &buf[i * BLOCK_SIZE], BLOCK_SIZE, 1,
+                                &state);
+    }
+    single = clocked;
+
+    clocked = 0;
+    TEST_ASSERT_EQUAL_INT(SD_RW_OK,
+                          sdcard_spi_write_stream_start(&card, BUF_BLOCKS,
+                                                        BUF_BLOCKS));
+    TEST_ASSERT_EQUAL_INT(1, cmd_count[23]);
+    TEST_ASSERT_EQUAL_INT(1, cmd_count[25]);
+    for (unsigned i = 0; i < BUF_BLOCKS; i += 2) {
+        TEST_ASSERT_EQUAL_INT(2, sdcard_spi_write_stream(&card,
+                                                         &buf[i * BLOCK_SIZE],
+                                                         BLOCK_SIZE, 2,
+                                                         &state));
+        TEST_ASSERT_EQUAL_INT(SD_RW_OK, state);
+    }
+    TEST_ASSERT_EQUAL_INT(SD_STREAM_WRITE, card.stream);
+    TEST_ASSERT_EQUAL_INT(2 * BUF_BLOCKS, card.stream_next);
+    TEST_ASSERT_EQUAL_INT(SD_RW_OK, sdcard_spi_stream_stop(&card));
+    TEST_ASSERT_EQUAL_INT(SD_STREAM_NONE, card.stream);
+    TEST_ASSERT_EQUAL_INT(MODEL_IDLE, model.state);
+
+    /* only the data packets are sent per block */
+    TEST_ASSERT(clocked < single);
+    TEST_ASSERT_EQUAL_INT(0, crc_errors);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(disk[BUF_BLOCKS], buf, sizeof(buf)));
+}
+
+static void test_sdcard_spi_write_stream__not_open(void)
+{
+    sd_rw_response_t state;
+
+    TEST_ASSERT_EQUAL_INT(0, sdcard_spi_write_stream(&card, buf, BLOCK_SIZE,
+                                                     1, &state));
+    TEST_ASSERT_EQUAL_INT(SD_RW_NOT_SUPPORTED, state);
+}
+
+static void _reset_counters(void)
+{
+    memset(cmd_count, 0, sizeof(cmd_count));
+    clocked = 0;
+    data_bytes = 0;
+}
+
+/* bytes clocked for commands, data tokens, responses and busy signaling */
+static unsigned _overhead(void)
+{
+    return clocked - data_bytes;
+}
+
+static unsigned _write_single(unsigned nblocks)
+{
+    sd_rw_response_t state;
+
+    _reset_counters();
+    for (unsigned i = 0; i < nblocks; i++) {
+        sdcard_spi_write_blocks(&card, i, &buf[i * BLOCK_SIZE], BLOCK_SIZE, 1,
+                                &state);
+        TEST_ASSERT_EQUAL_INT(SD_RW_OK, state);
+    }
+    /* one CMD24 per block */
+    TEST_ASSERT_EQUAL_INT(nblocks, cmd_count[24]);
+    TEST_ASSERT_EQUAL_INT(0, cmd_count[25]);
+    TEST_ASSERT_EQUAL_INT(0, cmd_count[23]);
+    TEST_ASSERT_EQUAL_INT(nblocks * (BLOCK_SIZE + 2), data_bytes);
+    return _overhead();
+}
+
+static unsigned _write_stream(unsigned nblocks)
+{
+    sd_rw_response_t state;
+
+    _reset_counters();
+    sdcard_spi_write_stream_start(&card, 0, nblocks);
+    for (unsigned i = 0; i < nblocks; i++) {
+        TEST_ASSERT_EQUAL_INT(1, sdcard_spi_write_stream(&card,
+                                                         &buf[i * BLOCK_SIZE],
+                                                         BLOCK_SIZE, 1,
+                                                         &state));
+        TEST_ASSERT_EQUAL_INT(SD_RW_OK, state);
+    }
+    sdcard_spi_stream_stop(&card);
+    /* ACMD23 and CMD25 once, then only data packets */
+    TEST_ASSERT_EQUAL_INT(0, cmd_count[24]);
+    TEST_ASSERT_EQUAL_INT(1, cmd_count[25]);
+    TEST_ASSERT_EQUAL_INT(1, cmd_count[55]);
+    TEST_ASSERT_EQUAL_INT(1, cmd_count[23]);
+    TEST_ASSERT_EQUAL_INT(nblocks * (BLOCK_SIZE + 2), data_bytes);
+    return _overhead();
+}
+
+static void test_sdcard_spi_write__bus_traffic(void)
+{
+    unsigned single_1 = _write_single(1);
+    unsigned single_n = _write_single(BUF_BLOCKS);
+    unsigned stream_1 = _write_stream(1);
+    unsigned stream_n = _write_stream(BUF_BLOCKS);
+    unsigned stream_block = (stream_n - stream_1) / (BUF_BLOCKS - 1);
+
+    /* every single-block write pays for its command again */
+    TEST_ASSERT_EQUAL_INT(BUF_BLOCKS * single_1, single_n);
+    /* a streamed block only costs its data token, data response and the busy
+     * signaling until the card accepts the next one */
+    TEST_ASSERT_EQUAL_INT(1 + 1 + PROGRAM_BUSY + 1, stream_block);
+    TEST_ASSERT(single_1 >= stream_block + sizeof(model.cmd));
+    /* the commands to open and stop the stream pay off with BUF_BLOCKS */
+    TEST_ASSERT(stream_1 > single_1);
+    TEST_ASSERT(stream_n < single_n);
+    TEST_ASSERT_EQUAL_INT(0, crc_errors);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(disk[0], buf, sizeof(buf)));
+}
+
+static void test_mtd_sdcard_stream__flush(void)
+{
+    mtd_sdcard_t dev = {
+        .base = {
+            .driver = &mtd_sdcard_driver,
+            .sector_count = BLOCK_NUMOF,
+            .pages_per_sector = 1,
+            .page_size = BLOCK_SIZE,
+        },
+        .sd_card = &card,
+    };
+
+    /* sequential writes continue one multi-block write */
+    for (unsigned i = 0; i < BUF_BLOCKS; i++) {
+        TEST_ASSERT_EQUAL_INT(BLOCK_SIZE,
+                              mtd_write(&dev.base, &buf[i * BLOCK_SIZE],
+                                        i * BLOCK_SIZE, BLOCK_SIZE));
+    }
+    TEST_ASSERT_EQUAL_INT(1, cmd_count[25]);
+    TEST_ASSERT_EQUAL_INT(0, cmd_count[24]);
+    TEST_ASSERT_EQUAL_INT(SD_STREAM_WRITE, card.stream);
+    TEST_ASSERT_EQUAL_INT(MODEL_WRITE_WAIT, model.state);
+
+    /* the flush sends the stop token and waits until the card is done */
+    TEST_ASSERT_EQUAL_INT(0, mtd_flush(&dev.base));
+    TEST_ASSERT_EQUAL_INT(SD_STREAM_NONE, card.stream);
+    TEST_ASSERT_EQUAL_INT(MODEL_IDLE, model.state);
+    TEST_ASSERT_EQUAL_INT(0, model.busy);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(disk[0], buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL_INT(0, crc_errors);
+
+    /* nothing open: flushing again does not touch the card */
+    clocked = 0;
+    TEST_ASSERT_EQUAL_INT(0, mtd_flush(&dev.base));
+    TEST_ASSERT_EQUAL_INT(0, clocked);
+}
+
+static void test_sdcard_spi_read_blocks(void)
+{
+    sd_rw_response_t state;
+
+    memcpy(disk[0], buf, sizeof(buf));
+    TEST_ASSERT_EQUAL_INT(1, sdcard_spi_read_blocks(&card, 3, rbuf,
+                                                    BLOCK_SIZE, 1, &state));
+    TEST_ASSERT_EQUAL_INT(SD_RW_OK, state);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(rbuf, &buf[3 * BLOCK_SIZE], BLOCK_SIZE));
+
+    TEST_ASSERT_EQUAL_INT(BUF_BLOCKS, sdcard_spi_read_blocks(&card, 0, rbuf,
+                                                             BLOCK_SIZE,
+                                                             BUF_BLOCKS,
+                                                             &state));
+    TEST_ASSERT_EQUAL_INT(SD_RW_OK, state);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(rbuf, buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL_INT(1, cmd_count[17]);
+    TEST_ASSERT_EQUAL_INT(1, cmd_count[18]);
+    TEST_ASSERT_EQUAL_INT(1, cmd_count[12]);
+}
+
+static void test_sdcard_spi_read_stream(void)
+{
+    sd_rw_response_t state;
+
+    memcpy(disk[BUF_BLOCKS], buf, sizeof(buf));
+    TEST_ASSERT_EQUAL_INT(SD_RW_OK,
+                          sdcard_spi_read_stream_start(&card, BUF_BLOCKS));
+    for (unsigned i = 0; i < BUF_BLOCKS; i += 2) {
+        TEST_ASSERT_EQUAL_INT(2, sdcard_spi_read_stream(&card,
+                                                        &rbuf[i * BLOCK_SIZE],
+                                                        BLOCK_SIZE, 2,
+                                                        &state));
+        TEST_ASSERT_EQUAL_INT(SD_RW_OK, state);
+    }
+    TEST_ASSERT_EQUAL_INT(0, memcmp(rbuf, buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL_INT(SD_STREAM_READ, card.stream);
+    TEST_ASSERT_EQUAL_INT(2 * BUF_BLOCKS, card.stream_next);
+    TEST_ASSERT_EQUAL_INT(1, cmd_count[18]);
+
+    TEST_ASSERT_EQUAL_INT(SD_RW_OK, sdcard_spi_stream_stop(&card));
+    TEST_ASSERT_EQUAL_INT(SD_STREAM_NONE, card.stream);
+    TEST_ASSERT_EQUAL_INT(1, cmd_count[12]);
+    TEST_ASSERT_EQUAL_INT(MODEL_IDLE, model.state);
+}
+
+static void test_sdcard_spi_stream__implicit_stop(void)
+{
+    sd_rw_response_t state;
+
+    TEST_ASSERT_EQUAL_INT(SD_RW_OK,
+                          sdcard_spi_write_stream_start(&card, 0, 1));
+    TEST_ASSERT_EQUAL_INT(1, sdcard_spi_write_stream(&card, buf, BLOCK_SIZE,
+                                                     1, &state));
+
+    /* a regular transfer stops the open one first */
+    TEST_ASSERT_EQUAL_INT(2, sdcard_spi_write_blocks(&card, 8, buf,
+                                                     BLOCK_SIZE, 2, &state));
+    TEST_ASSERT_EQUAL_INT(SD_RW_OK, state);
+    TEST_ASSERT_EQUAL_INT(SD_STREAM_NONE, card.stream);
+    TEST_ASSERT_EQUAL_INT(MODEL_IDLE, model.state);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(disk[0], buf, BLOCK_SIZE));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(disk[8], buf, 2 * BLOCK_SIZE));
+    TEST_ASSERT_EQUAL_INT(0, crc_errors);
+}
+
+static void test_sdcard_spi_read_blocks__addr_error(void)
+{
+    sd_rw_response_t state;
+
+    TEST_ASSERT_EQUAL_INT(0, sdcard_spi_read_blocks(&card, BLOCK_NUMOF, rbuf,
+                                                    BLOCK_SIZE, 1, &state));
+    TEST_ASSERT(SD_RW_OK != state);
+}
+
+static void test_sdcard_spi_crc7(void)
+{
+    static const char cmd0[] = { 0x40, 0x00, 0x00, 0x00, 0x00 };
+    static const char cmd8[] = { 0x48, 0x00, 0x00, 0x01, 0xaa };
+
+    TEST_ASSERT_EQUAL_INT(0x95, (uint8_t)_crc_7(cmd0, sizeof(cmd0)));
+    TEST_ASSERT_EQUAL_INT(0x87, (uint8_t)_crc_7(cmd8, sizeof(cmd8)));
+}
+
+Test *tests_sdcard_spi_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_sdcard_spi_write_blocks),
+        new_TestFixture(test_sdcard_spi_write_stream),
+        new_TestFixture(test_sdcard_spi_write_stream__not_open),
+        new_TestFixture(test_sdcard_spi_write__bus_traffic),
+        new_TestFixture(test_mtd_sdcard_stream__flush),
+        new_TestFixture(test_sdcard_spi_read_blocks),
+        new_TestFixture(test_sdcard_spi_read_stream),
+        new_TestFixture(test_sdcard_spi_stream__implicit_stop),
+        new_TestFixture(test_sdcard_spi_read_blocks__addr_error),
+        new_TestFixture(test_sdcard_spi_crc7),
+    };
+
+    EMB_UNIT_TESTCALLER(sdcard_spi_tests, set_up, NULL, fixtures);
+
+    return (Test *)&sdcard_spi_tests;
+}
+
+void tests_sdcard_spi(void)
+{
+    TESTS_RUN(tests_sdcard_spi_tests());
+}
+/** @} */
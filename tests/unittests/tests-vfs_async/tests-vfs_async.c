@@ -0,0 +1,238 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <errno.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "event.h"
+#include "vfs.h"
+#include "vfs_async.h"
+
+#include "tests-vfs_async.h"
+
+#define LOG_SIZE        (128U)
+#define SHORT_WRITE     (15U)
+
+/* Test mock object logging every call as "<file>:<data>|", e.g. "A:a1|".
+ * The worker has a lower priority than the test, so all submitted requests
+ * are queued until the test waits for one. */
+static char _log_buf[LOG_SIZE];
+static unsigned writes, reads;
+static size_t max_write;
+static int fd_a, fd_b;
+
+static void _record(vfs_file_t *filp, const void *data, size_t len)
+{
+    size_t pos = strlen(_log_buf);
+
+    _log_buf[pos++] = *(char *)filp->private_data.ptr;
+    _log_buf[pos++] = ':';
+    memcpy(&_log_buf[pos], data, len);
+    pos += len;
+    _log_buf[pos++] = '|';
+    _log_buf[pos] = '\0';
+}
+
+static ssize_t _mock_write(vfs_file_t *filp, const void *src, size_t nbytes)
+{
+    writes++;
+    if (nbytes > max_write) {
+        nbytes = max_write;
+    }
+    _record(filp, src, (nbytes > 16) ? 16 : nbytes);
+    return nbytes;
+}
+
+static ssize_t _mock_read(vfs_file_t *filp, void *dest, size_t nbytes)
+{
+    reads++;
+    memset(dest, *(char *)filp->private_data.ptr, nbytes);
+    _record(filp, "read", 4);
+    return nbytes;
+}
+
+static int _mock_fsync(vfs_file_t *filp)
+{
+    _record(filp, "sync", 4);
+    return 0;
+}
+
+static const vfs_file_ops_t _mock_ops = {
+    .read = _mock_read,
+    .write = _mock_write,
+    .fsync = _mock_fsync,
+};
+
+static char name_a = 'A', name_b = 'B';
+
+static void set_up(void)
+{
+    vfs_async_init();
+    _log_buf[0] = '\0';
+    writes = 0;
+    reads = 0;
+    max_write = SIZE_MAX;
+    fd_a = vfs_bind(VFS_ANY_FD, O_RDWR, &_mock_ops, &name_a);
+    fd_b = vfs_bind(VFS_ANY_FD, O_RDWR, &_mock_ops, &name_b);
+}
+
+static void tear_down(void)
+{
+    vfs_close(fd_a);
+    vfs_close(fd_b);
+}
+
+static void test_vfs_async_write(void)
+{
+    vfs_async_req_t req;
+
+    vfs_async_req_init(&req, NULL, NULL);
+    vfs_async_write(&req, fd_a, "a1", 2);
+    TEST_ASSERT_EQUAL_INT(0, vfs_async_done(&req));
+    TEST_ASSERT_EQUAL_INT(2, vfs_async_wait(&req));
+    TEST_ASSERT_EQUAL_INT(1, vfs_async_done(&req));
+    TEST_ASSERT_EQUAL_STRING("A:a1|", (char *)_log_buf);
+}
+
+static void test_vfs_async_write_merge(void)
+{
+    vfs_async_req_t req[4];
+    const char *data[] = { "a1", "a2", "a3", "a4" };
+
+    for (unsigned i = 0; i < 4; i++) {
+        vfs_async_req_init(&req[i], NULL, NULL);
+        vfs_async_write(&req[i], fd_a, data[i], 2);
+    }
+    TEST_ASSERT_EQUAL_INT(2, vfs_async_wait(&req[3]));
+    for (unsigned i = 0; i < 4; i++) {
+        TEST_ASSERT_EQUAL_INT(1, vfs_async_done(&req[i]));
+        TEST_ASSERT_EQUAL_INT(2, req[i].res);
+    }
+    TEST_ASSERT_EQUAL_INT(1, writes);
+    TEST_ASSERT_EQUAL_STRING("A:a1a2a3a4|", (char *)_log_buf);
+}
+
+static void test_vfs_async_write_large(void)
+{
+    static char big[VFS_ASYNC_MERGE_SIZE];
+    vfs_async_req_t req[2];
+
+    memset(big, 'x', sizeof(big));
+    vfs_async_req_init(&req[0], NULL, NULL);
+    vfs_async_req_init(&req[1], NULL, NULL);
+    vfs_async_write(&req[0], fd_a, big, sizeof(big));
+    vfs_async_write(&req[1], fd_a, "a1", 2);
+    TEST_ASSERT_EQUAL_INT(2, vfs_async_wait(&req[1]));
+    TEST_ASSERT_EQUAL_INT(sizeof(big), req[0].res);
+    TEST_ASSERT_EQUAL_INT(2, writes);
+}
+
+static void test_vfs_async_order(void)
+{
+    vfs_async_req_t req[5];
+
+    for (unsigned i = 0; i < 5; i++) {
+        vfs_async_req_init(&req[i], NULL, NULL);
+    }
+    vfs_async_write(&req[0], fd_a, "a1", 2);
+    vfs_async_write(&req[1], fd_b, "b1", 2);
+    vfs_async_fsync(&req[2], fd_a);
+    vfs_async_write(&req[3], fd_a, "a2", 2);
+    vfs_async_write(&req[4], fd_b, "b2", 2);
+    vfs_async_wait(&req[3]);
+    TEST_ASSERT_EQUAL_INT(1, vfs_async_done(&req[4]));
+    TEST_ASSERT_EQUAL_INT(0, req[2].res);
+    /* b2 overtakes the requests for fd A, nothing overtakes the fsync */
+    TEST_ASSERT_EQUAL_STRING("A:a1|B:b1b2|A:sync|A:a2|", (char *)_log_buf);
+}
+
+static void test_vfs_async_read(void)
+{
+    vfs_async_req_t req[2];
+    char buf[8] = { 0 };
+
+    vfs_async_req_init(&req[0], NULL, NULL);
+    vfs_async_req_init(&req[1], NULL, NULL);
+    vfs_async_write(&req[0], fd_b, "b1", 2);
+    vfs_async_read(&req[1], fd_b, buf, sizeof(buf));
+    TEST_ASSERT_EQUAL_INT(sizeof(buf), vfs_async_wait(&req[1]));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(buf, "BBBBBBBB", sizeof(buf)));
+    TEST_ASSERT_EQUAL_STRING("B:b1|B:read|", (char *)_log_buf);
+}
+
+static void test_vfs_async_short_write(void)
+{
+    vfs_async_req_t req[3];
+    const char *data[] = { "0123456789", "abcdefghij", "ABCDEFGHIJ" };
+
+    max_write = SHORT_WRITE;
+    for (unsigned i = 0; i < 3; i++) {
+        vfs_async_req_init(&req[i], NULL, NULL);
+        vfs_async_write(&req[i], fd_a, data[i], 10);
+    }
+    vfs_async_wait(&req[2]);
+    TEST_ASSERT_EQUAL_INT(10, req[0].res);
+    TEST_ASSERT_EQUAL_INT(5, req[1].res);
+    TEST_ASSERT_EQUAL_INT(0, req[2].res);
+}
+
+static void test_vfs_async_bad_fd(void)
+{
+    vfs_async_req_t req;
+
+    vfs_async_req_init(&req, NULL, NULL);
+    vfs_async_fsync(&req, VFS_MAX_OPEN_FILES);
+    TEST_ASSERT_EQUAL_INT(-EBADF, vfs_async_wait(&req));
+}
+
+static void test_vfs_async_event(void)
+{
+    event_queue_t queue;
+    event_t done = { .handler = NULL };
+    vfs_async_req_t req;
+
+    event_queue_init(&queue);
+    vfs_async_req_init(&req, &queue, &done);
+    vfs_async_write(&req, fd_a, "a1", 2);
+    TEST_ASSERT(event_wait(&queue) == &done);
+    TEST_ASSERT_EQUAL_INT(1, vfs_async_done(&req));
+    TEST_ASSERT_EQUAL_INT(2, req.res);
+}
+
+Test *tests_vfs_async_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_vfs_async_write),
+        new_TestFixture(test_vfs_async_write_merge),
+        new_TestFixture(test_vfs_async_write_large),
+        new_TestFixture(test_vfs_async_order),
+        new_TestFixture(test_vfs_async_read),
+        new_TestFixture(test_vfs_async_short_write),
+        new_TestFixture(test_vfs_async_bad_fd),
+        new_TestFixture(test_vfs_async_event),
+    };
+
+    EMB_UNIT_TESTCALLER(vfs_async_tests, set_up, tear_down, fixtures);
+
+    return (Test *)&vfs_async_tests;
+}
+
+void tests_vfs_async(void)
+{
+    TESTS_RUN(tests_vfs_async_tests());
+}
+/** @} */
@@ -0,0 +1,134 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Latency test for the asynchronous VFS
+ *
+ * A logger submits a record every PERIOD_US to a file whose backend takes
+ * BACKEND_CALL_US plus BACKEND_BYTE_US per byte for each write, like a flash
+ * file system. The time the logger is blocked per record and the time until
+ * all records are stored is compared between vfs_write() and
+ * vfs_async_write().
+ *
+ * @}
+ */
+
+#include <fcntl.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "vfs.h"
+#include "vfs_async.h"
+#include "xtimer.h"
+
+#define RECORDS             (64U)
+#define RECORD_SIZE         (32U)
+#define PERIOD_US           (1000U)
+#define BACKEND_CALL_US     (800U)
+#define BACKEND_BYTE_US     (8U)
+
+static char records[RECORDS][RECORD_SIZE];
+static vfs_async_req_t reqs[RECORDS];
+static size_t stored;
+static unsigned calls;
+
+static ssize_t _slow_write(vfs_file_t *filp, const void *src, size_t nbytes)
+{
+    (void)filp;
+    (void)src;
+
+    xtimer_usleep(BACKEND_CALL_US + nbytes * BACKEND_BYTE_US);
+    stored += nbytes;
+    calls++;
+    return nbytes;
+}
+
+static const vfs_file_ops_t _slow_ops = {
+    .write = _slow_write,
+};
+
+typedef struct {
+    uint32_t max_blocked;
+    uint32_t total;
+} result_t;
+
+static void _print(const char *name, const result_t *res)
+{
+    printf("%s: worst-case blocking %" PRIu32 " us, %u backend calls, "
+           "%u bytes in %" PRIu32 " us\n", name, res->max_blocked, calls,
+           (unsigned)stored, res->total);
+}
+
+static void _run(int fd, int async, result_t *res)
+{
+    xtimer_ticks32_t last_wakeup = xtimer_now();
+    uint32_t start = xtimer_now_usec();
+
+    res->max_blocked = 0;
+    stored = 0;
+    calls = 0;
+    for (unsigned i = 0; i < RECORDS; i++) {
+        uint32_t before = xtimer_now_usec();
+
+        if (async) {
+            vfs_async_req_init(&reqs[i], NULL, NULL);
+            vfs_async_write(&reqs[i], fd, records[i], RECORD_SIZE);
+        }
+        else {
+            vfs_write(fd, records[i], RECORD_SIZE);
+        }
+
+        uint32_t blocked = xtimer_now_usec() - before;
+        if (blocked > res->max_blocked) {
+            res->max_blocked = blocked;
+        }
+        xtimer_periodic_wakeup(&last_wakeup, PERIOD_US);
+    }
+    if (async) {
+        for (unsigned i = 0; i < RECORDS; i++) {
+            vfs_async_wait(&reqs[i]);
+        }
+    }
+    res->total = xtimer_now_usec() - start;
+}
+
+int main(void)
+{
+    result_t sync_res, async_res;
+
+    puts("vfs_async latency test");
+
+    for (unsigned i = 0; i < RECORDS; i++) {
+        memset(records[i], 'a' + (i % 26), RECORD_SIZE);
+    }
+    int fd = vfs_bind(VFS_ANY_FD, O_WRONLY, &_slow_ops, NULL);
+    if (fd < 0) {
+        puts("vfs_bind failed");
+        return 1;
+    }
+    vfs_async_init();
+
+    _run(fd, 0, &sync_res);
+    _print("vfs_write      ", &sync_res);
+    _run(fd, 1, &async_res);
+    _print("vfs_async_write", &async_res);
+
+    if ((stored != RECORDS * RECORD_SIZE) ||
+        (async_res.max_blocked * 10 > sync_res.max_blocked) ||
+        (async_res.total > sync_res.total)) {
+        puts("[FAILED]");
+        return 1;
+    }
+    puts("[SUCCESS]");
+    return 0;
+}